@@ -0,0 +1,419 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/DataArchiver/BuddyCheckpoint.h>
+
+#include <Core/Exceptions/ErrnoException.h>
+#include <Core/OS/Dir.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ProcessorGroup.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+using namespace Uintah;
+
+namespace {
+
+  const int  HEADER_TAG = 0;
+  const int  DATA_TAG   = 1;
+
+  // MPI counts are ints, larger files are sent in pieces.
+  const long CHUNK_SIZE = 1L << 30;
+
+  std::string timeStepName( int timeStep )
+  {
+    std::ostringstream name;
+    name << "t" << std::setw(5) << std::setfill('0') << timeStep;
+    return name.str();
+  }
+
+  std::string rankName( int rank )
+  {
+    std::ostringstream name;
+    name << "p" << std::setw(5) << std::setfill('0') << rank;
+    return name.str();
+  }
+
+  bool fileExists( const std::string & path )
+  {
+    struct stat st;
+    return ( stat( path.c_str(), &st ) == 0 );
+  }
+
+  void makeDir( const std::string & path )
+  {
+    if( mkdir( path.c_str(), 0777 ) != 0 && errno != EEXIST ) {
+      throw ErrnoException( "BuddyCheckpoint: creating directory " + path,
+                            errno, __FILE__, __LINE__ );
+    }
+  }
+
+  void readFile( const std::string & path, std::vector<char> & data )
+  {
+    int fd = open( path.c_str(), O_RDONLY );
+    if( fd == -1 ) {
+      throw ErrnoException( "BuddyCheckpoint: opening " + path, errno, __FILE__, __LINE__ );
+    }
+
+    struct stat st;
+    if( fstat( fd, &st ) != 0 ) {
+      close( fd );
+      throw ErrnoException( "BuddyCheckpoint: stat of " + path, errno, __FILE__, __LINE__ );
+    }
+
+    data.resize( st.st_size );
+
+    size_t done = 0;
+    while( done < data.size() ) {
+      ssize_t n = read( fd, data.data() + done, data.size() - done );
+      if( n <= 0 ) {
+        close( fd );
+        throw ErrnoException( "BuddyCheckpoint: reading " + path, errno, __FILE__, __LINE__ );
+      }
+      done += n;
+    }
+    close( fd );
+  }
+
+  void writeFile( const std::string & path, const char * data, size_t size )
+  {
+    int fd = open( path.c_str(), O_WRONLY|O_CREAT|O_TRUNC, 0666 );
+    if( fd == -1 ) {
+      throw ErrnoException( "BuddyCheckpoint: opening " + path, errno, __FILE__, __LINE__ );
+    }
+
+    size_t done = 0;
+    while( done < size ) {
+      ssize_t n = write( fd, data + done, size - done );
+      if( n <= 0 ) {
+        close( fd );
+        throw ErrnoException( "BuddyCheckpoint: writing " + path, errno, __FILE__, __LINE__ );
+      }
+      done += n;
+    }
+    close( fd );
+  }
+
+  // The l<level>.data files of a rank directory, by level.
+  std::vector< std::pair<int, std::string> > levelFiles( const std::string & dir )
+  {
+    std::vector<std::string> names;
+    Dir( dir ).getFilenamesBySuffix( ".data", names );
+
+    std::vector< std::pair<int, std::string> > files;
+    for( const std::string & name : names ) {
+      if( name.size() > 6 && name[0] == 'l' ) {
+        files.push_back( std::make_pair( atoi( name.c_str() + 1 ), name ) );
+      }
+    }
+    return files;
+  }
+
+  void removeRankDir( const std::string & dir )
+  {
+    if( fileExists( dir ) ) {
+      Dir::removeDir( dir.c_str() );
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+BuddyCheckpoint::BuddyCheckpoint( const ProcessorGroup * myworld,
+                                  const std::string    & root )
+  : d_myworld( myworld )
+  , m_root( root )
+{
+  const int nRanks = d_myworld->nRanks();
+  const int nNodes = d_myworld->nNodes();
+
+  // The ranks of each node in rank order.
+  std::vector< std::vector<int> > nodeRanks( nNodes );
+  std::vector<int>                localIndex( nRanks );
+
+  for( int r = 0; r < nRanks; ++r ) {
+    std::vector<int> & ranks = nodeRanks[ d_myworld->getNodeIndexFromRank( r ) ];
+    localIndex[r] = ranks.size();
+    ranks.push_back( r );
+  }
+
+  if( nNodes > 1 ) {
+    for( int r = 0; r < nRanks; ++r ) {
+      const int                node    = d_myworld->getNodeIndexFromRank( r );
+      const std::vector<int> & next    = nodeRanks[ (node + 1) % nNodes ];
+      const int                partner = next[ localIndex[r] % next.size() ];
+
+      if( r == d_myworld->myRank() ) {
+        m_partner = partner;
+      }
+      if( partner == d_myworld->myRank() ) {
+        m_sources.push_back( r );
+      }
+    }
+  }
+  else {
+    proc0cout << "WARNING: In-memory checkpoints on a single node are not "
+              << "copied to partner ranks and do not survive the loss of the node.\n";
+  }
+
+  Uintah::MPI::Comm_dup( d_myworld->getComm(), &m_comm );
+
+  makeDir( m_root );
+}
+
+//______________________________________________________________________
+//
+BuddyCheckpoint::~BuddyCheckpoint()
+{
+  int finalized = 0;
+  MPI_Finalized( &finalized );
+  if( m_comm != MPI_COMM_NULL && !finalized ) {
+    Uintah::MPI::Comm_free( &m_comm );
+  }
+}
+
+//______________________________________________________________________
+//
+std::string
+BuddyCheckpoint::rankDir( int timeStep, int rank ) const
+{
+  return m_root + "/" + timeStepName( timeStep ) + "/" + rankName( rank );
+}
+
+//______________________________________________________________________
+//
+void
+BuddyCheckpoint::prepare( int timeStep )
+{
+  makeDir( m_root + "/" + timeStepName( timeStep ) );
+  makeDir( rankDir( timeStep, d_myworld->myRank() ) );
+}
+
+//______________________________________________________________________
+//
+std::string
+BuddyCheckpoint::dataFile( int timeStep, int level ) const
+{
+  std::ostringstream name;
+  name << rankDir( timeStep, d_myworld->myRank() ) << "/l" << level << ".data";
+  return name.str();
+}
+
+//______________________________________________________________________
+//  Each rank sends its level files to its partner: a header with the
+//  number of files and the (level, size) of each, then the file
+//  contents.  The headers are small so they are received first, then
+//  all the receives for the contents are posted before the sends.
+void
+BuddyCheckpoint::replicate( int timeStep )
+{
+  const std::string myDir = rankDir( timeStep, d_myworld->myRank() );
+
+  const std::vector< std::pair<int, std::string> > files = levelFiles( myDir );
+
+  writeFile( myDir + "/complete", nullptr, 0 );
+
+  if( m_partner < 0 && m_sources.empty() ) {
+    return;
+  }
+
+  std::vector<MPI_Request> requests;
+
+  std::vector<long long>           header;
+  std::vector< std::vector<char> > myData( files.size() );
+
+  if( m_partner >= 0 ) {
+    header.push_back( files.size() );
+    for( size_t i = 0; i < files.size(); ++i ) {
+      readFile( myDir + "/" + files[i].second, myData[i] );
+      header.push_back( files[i].first );
+      header.push_back( myData[i].size() );
+    }
+
+    requests.push_back( MPI_REQUEST_NULL );
+    Uintah::MPI::Isend( header.data(), header.size(), MPI_LONG_LONG,
+                        m_partner, HEADER_TAG, m_comm, &requests.back() );
+  }
+
+  // Receive the headers of the sources and post the receives for
+  // their files.
+  std::vector< std::vector<long long> >              srcHeaders( m_sources.size() );
+  std::vector< std::vector< std::vector<char> > >    srcData( m_sources.size() );
+
+  for( size_t s = 0; s < m_sources.size(); ++s ) {
+    MPI_Status status;
+    int        count = 0;
+    Uintah::MPI::Probe( m_sources[s], HEADER_TAG, m_comm, &status );
+    Uintah::MPI::Get_count( &status, MPI_LONG_LONG, &count );
+
+    srcHeaders[s].resize( count );
+    Uintah::MPI::Recv( srcHeaders[s].data(), count, MPI_LONG_LONG,
+                       m_sources[s], HEADER_TAG, m_comm, &status );
+
+    const int nFiles = srcHeaders[s][0];
+    srcData[s].resize( nFiles );
+
+    for( int f = 0; f < nFiles; ++f ) {
+      std::vector<char> & data = srcData[s][f];
+      data.resize( srcHeaders[s][2 + 2*f] );
+
+      for( size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE ) {
+        requests.push_back( MPI_REQUEST_NULL );
+        Uintah::MPI::Irecv( data.data() + offset,
+                            std::min( (size_t) CHUNK_SIZE, data.size() - offset ), MPI_BYTE,
+                            m_sources[s], DATA_TAG, m_comm, &requests.back() );
+      }
+    }
+  }
+
+  // Send the own files.
+  if( m_partner >= 0 ) {
+    for( std::vector<char> & data : myData ) {
+      for( size_t offset = 0; offset < data.size(); offset += CHUNK_SIZE ) {
+        requests.push_back( MPI_REQUEST_NULL );
+        Uintah::MPI::Isend( data.data() + offset,
+                            std::min( (size_t) CHUNK_SIZE, data.size() - offset ), MPI_BYTE,
+                            m_partner, DATA_TAG, m_comm, &requests.back() );
+      }
+    }
+  }
+
+  Uintah::MPI::Waitall( requests.size(), requests.data(), MPI_STATUSES_IGNORE );
+
+  // Keep the copies of the sources.
+  for( size_t s = 0; s < m_sources.size(); ++s ) {
+    const std::string srcDir = rankDir( timeStep, m_sources[s] );
+    makeDir( srcDir );
+
+    for( size_t f = 0; f < srcData[s].size(); ++f ) {
+      std::ostringstream name;
+      name << srcDir << "/l" << srcHeaders[s][1 + 2*f] << ".data";
+      writeFile( name.str(), srcData[s][f].data(), srcData[s][f].size() );
+    }
+    writeFile( srcDir + "/complete", nullptr, 0 );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BuddyCheckpoint::expire( int timeStep )
+{
+  removeRankDir( rankDir( timeStep, d_myworld->myRank() ) );
+
+  for( int source : m_sources ) {
+    removeRankDir( rankDir( timeStep, source ) );
+  }
+
+  // Succeeds for the last rank of the node.
+  rmdir( ( m_root + "/" + timeStepName( timeStep ) ).c_str() );
+}
+
+//______________________________________________________________________
+//  The ranks that wrote the checkpoint are the ones with a p#####.xml
+//  file in one of its level directories.  The lowest rank that holds
+//  a complete copy of a rank's files copies them back.
+bool
+BuddyCheckpoint::restore( const ProcessorGroup * myworld,
+                          const std::string    & root,
+                                int              timeStep,
+                          const std::string    & checkpointDir )
+{
+  const std::string tdir = root + "/" + timeStepName( timeStep );
+
+  std::set<int> ranks;
+  for( int l = 0; fileExists( checkpointDir + "/l" + std::to_string( l ) ); ++l ) {
+    std::vector<std::string> names;
+    Dir( checkpointDir + "/l" + std::to_string( l ) ).getFilenamesBySuffix( ".xml", names );
+
+    for( const std::string & name : names ) {
+      if( name[0] == 'p' ) {
+        ranks.insert( atoi( name.c_str() + 1 ) );
+      }
+    }
+  }
+
+  if( ranks.empty() ) {
+    return true;
+  }
+
+  const int nRanks = *ranks.rbegin() + 1;
+
+  std::vector<int> held( nRanks, INT_MAX );
+  std::vector<int> holder( nRanks, INT_MAX );
+
+  for( int r : ranks ) {
+    if( fileExists( tdir + "/" + rankName( r ) + "/complete" ) ) {
+      held[r] = myworld->myRank();
+    }
+  }
+  Uintah::MPI::Allreduce( held.data(), holder.data(), nRanks, MPI_INT, MPI_MIN, myworld->getComm() );
+
+  std::ostringstream lost;
+  for( int r : ranks ) {
+    if( holder[r] == INT_MAX ) {
+      lost << " " << r;
+    }
+  }
+  if( !lost.str().empty() ) {
+    proc0cout << "The in-memory checkpoint of time step " << timeStep << " in " << root
+              << " is lost for ranks" << lost.str() << "\n";
+    return false;
+  }
+
+  for( int r : ranks ) {
+    if( holder[r] != myworld->myRank() ) {
+      continue;
+    }
+
+    const std::string rdir = tdir + "/" + rankName( r );
+
+    for( const auto & file : levelFiles( rdir ) ) {
+      std::vector<char> data;
+      readFile( rdir + "/" + file.second, data );
+
+      std::ostringstream name;
+      name << checkpointDir << "/l" << file.first << "/" << rankName( r ) << ".data";
+      writeFile( name.str(), data.data(), data.size() );
+    }
+  }
+
+  Uintah::MPI::Barrier( myworld->getComm() );
+
+  proc0cout << "Restored the in-memory checkpoint of time step " << timeStep
+            << " from " << root << " (" << ranks.size() << " ranks)\n";
+  return true;
+}
@@ -0,0 +1,127 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef UINTAH_HOMEBREW_BuddyCheckpoint_H
+#define UINTAH_HOMEBREW_BuddyCheckpoint_H
+
+#include <Core/Parallel/UintahMPI.h>
+
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+  class ProcessorGroup;
+
+  /**************************************
+
+     CLASS
+       BuddyCheckpoint
+
+     GENERAL INFORMATION
+
+       BuddyCheckpoint.h
+
+     KEYWORDS
+       DataArchiver, checkpoint, diskless checkpoint
+
+     DESCRIPTION
+       Node local ("in memory") tier of the checkpoints.  Each rank
+       writes its checkpoint data files into a directory on a node
+       local RAM file system (normally /dev/shm) instead of the uda
+       and then sends a copy of them through MPI to a partner rank,
+       which keeps it on its own node:
+
+         <root>/t#####/p<rank>/l<level>.data
+         <root>/t#####/p<rank>/complete
+
+       The partner of a rank is the rank with the same local index on
+       the next node, so a copy survives the loss of a whole node.
+       Ranks on the same node share the RAM file system, so with a
+       single node there is no partner and only the own copy is kept.
+
+       The xml meta data of the checkpoint stays in the uda.  Because
+       a RAM file system outlives the processes, a relaunch on the same
+       nodes finds the data files again; restore() copies them, from
+       the rank's own copy or from its partner's, back into the uda
+       checkpoint directory so the normal restart can read it.
+
+     WARNING
+       The constructor, replicate() and restore() are collective.
+
+  ****************************************/
+
+  class BuddyCheckpoint {
+  public:
+
+    BuddyCheckpoint( const ProcessorGroup * myworld,
+                     const std::string    & root );
+
+    ~BuddyCheckpoint();
+
+    const std::string & getRoot() const { return m_root; }
+
+    // -1 when running on a single node.
+    int getPartner() const { return m_partner; }
+
+    //! Creates this rank's directory for the time step.
+    void prepare( int timeStep );
+
+    //! Node local data file of this rank for a level.
+    std::string dataFile( int timeStep, int level ) const;
+
+    //! Marks this rank's copy complete and exchanges the data files
+    //! with the partner ranks.
+    void replicate( int timeStep );
+
+    //! Removes the copies of a time step held by this rank.
+    void expire( int timeStep );
+
+    //! Rebuilds the data files of the uda checkpoint directory of a
+    //! time step from the copies held on the nodes.  Returns false
+    //! (on all ranks) if the copies of a rank are lost.
+    static bool restore( const ProcessorGroup * myworld,
+                         const std::string    & root,
+                               int              timeStep,
+                         const std::string    & checkpointDir );
+
+  private:
+
+    std::string rankDir( int timeStep, int rank ) const;
+
+    const ProcessorGroup * d_myworld;
+    std::string            m_root;
+
+    int                    m_partner {-1};
+    std::vector<int>       m_sources;      // ranks whose partner is this rank
+
+    MPI_Comm               m_comm {MPI_COMM_NULL};
+
+    BuddyCheckpoint( const BuddyCheckpoint & ) = delete;
+    BuddyCheckpoint& operator=( const BuddyCheckpoint & ) = delete;
+  };
+
+} // End namespace Uintah
+
+#endif
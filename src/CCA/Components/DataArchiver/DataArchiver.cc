@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/DataArchiver/DataArchiver.h>
+#include <CCA/Components/DataArchiver/BuddyCheckpoint.h>
 
 #include <CCA/Components/ProblemSpecification/ProblemSpecReader.h>
 #include <CCA/Ports/DataWarehouse.h>
@@ -94,6 +95,29 @@ namespace {
 #ifdef HAVE_PIDX
   DebugStream dbgPIDX ("DataArchiverPIDX", "DataArchiver", "Data archiver PIDX debug stream", false);
 #endif
+
+  // Removes the entry of a time step directory from an index.xml.
+  // Disk and in-memory checkpoints expire independently so the entry
+  // is found by its href.
+  void removeFromIndex( ProblemSpecP & index, const string & timestepDir )
+  {
+    const string href = timestepDir.substr( timestepDir.find_last_of( '/' ) + 1 ) + "/timestep.xml";
+
+    ProblemSpecP ts = index->findBlock( "timesteps" );
+    if( ts == nullptr ) {
+      return;
+    }
+
+    for( ProblemSpecP n = ts->findBlock( "timestep" ); n != nullptr; n = n->findNextBlock( "timestep" ) ) {
+      map<string,string> attributes;
+      n->getAttributes( attributes );
+
+      if( attributes[ "href" ] == href ) {
+        ts->removeChild( n );
+        return;
+      }
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -134,6 +158,10 @@ DataArchiver::DataArchiver(const ProcessorGroup* myworld, int udaSuffix)
 
 DataArchiver::~DataArchiver()
 {
+  if( m_pendingCheckpoint && m_pendingCheckpoint->writer.joinable() ) {
+    m_pendingCheckpoint->writer.join();
+  }
+
   VarLabel::destroy( m_sync_io_label );
 
   if(m_tmpMatSubset && m_tmpMatSubset->removeReference()) {
@@ -399,7 +427,8 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
   if( checkpoint != nullptr ) {
 
     string interval, timestepInterval, wallTimeStart, wallTimeInterval,
-      wallTimeStartHours, wallTimeIntervalHours, cycle, lastTimeStep;
+      wallTimeStartHours, wallTimeIntervalHours, cycle, lastTimeStep,
+      asynchronous;
 
     attributes.clear();
     checkpoint->getAttributes( attributes );
@@ -412,6 +441,7 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     wallTimeIntervalHours = attributes[ "walltimeIntervalHours" ];
     cycle                 = attributes[ "cycle" ];
     lastTimeStep          = attributes[ "lastTimestep" ];
+    asynchronous          = attributes[ "asynchronous" ];
 
     if( interval != "" ) {
       m_checkpointInterval = atof( interval.c_str() );
@@ -437,6 +467,16 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     if( lastTimeStep == "true" ) {
       m_checkpointLastTimeStep = true;
     }
+    if( asynchronous == "true" ) {
+      if( m_outputFileFormat == PIDX ) {
+        proc0cout << "WARNING: asynchronous checkpoints are not supported with PIDX, "
+                  << "checkpoints will be written synchronously.\n";
+      }
+      else {
+        m_asyncCheckpoints = true;
+        proc0cout << "Checkpoints will be written in the background\n";
+      }
+    }
 
     // Verify that an interval was specified:
     if( interval == "" && timestepInterval == "" &&
@@ -446,6 +486,41 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     }
   }
 
+  //__________________________________
+  // In-memory checkpoints between the disk checkpoints.
+  m_memoryCheckpointTimeStepInterval = 0;
+
+  ProblemSpecP memoryCheckpoint = p->findBlock( "memoryCheckpoint" );
+  if( memoryCheckpoint != nullptr ) {
+
+    attributes.clear();
+    memoryCheckpoint->getAttributes( attributes );
+
+    if( attributes[ "timestepInterval" ] == "" ) {
+      throw ProblemSetupException( "ERROR: \n  <memoryCheckpoint> must specify timestepInterval",
+                                   __FILE__, __LINE__ );
+    }
+    m_memoryCheckpointTimeStepInterval = atoi( attributes[ "timestepInterval" ].c_str() );
+
+    if( attributes[ "directory" ] != "" ) {
+      m_memoryCheckpointDirectory = attributes[ "directory" ];
+    }
+    if( attributes[ "cycle" ] != "" ) {
+      m_memoryCheckpointCycle = atoi( attributes[ "cycle" ].c_str() );
+    }
+
+    if( m_memoryCheckpointCycle < 1 ) {
+      throw ProblemSetupException( "ERROR: \n  <memoryCheckpoint> cycle must be at least 1",
+                                   __FILE__, __LINE__ );
+    }
+
+    if( m_outputFileFormat == PIDX ) {
+      proc0cout << "WARNING: in-memory checkpoints are not supported with PIDX "
+                << "and are ignored.\n";
+      m_memoryCheckpointTimeStepInterval = 0;
+    }
+  }
+
   // Can't use both checkpointInterval and checkpointTimeStepInterval and
   // checkpointWallTimeInterval.
   if (((int) (m_checkpointInterval > 0.0) +
@@ -487,6 +562,11 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
               << m_checkpointWallTimeInterval << " wall clock seconds,"
               << " starting after " << m_checkpointWallTimeStart << " seconds.\n";
   }
+  if ( m_memoryCheckpointTimeStepInterval > 0 ) {
+    proc0cout << "Checkpointing:" << std::setw(16)<< " Every "
+              << m_memoryCheckpointTimeStepInterval << " timesteps in memory ("
+              << m_memoryCheckpointDirectory << ").\n";
+  }
 
 #ifdef HAVE_VISIT
   static bool initialized = false;
@@ -548,7 +628,8 @@ DataArchiver::initializeOutput( const ProblemSpecP & params, const GridP& grid )
       m_outputTimeStepInterval     == 0   && 
       m_checkpointInterval         == 0.0 && 
       m_checkpointTimeStepInterval == 0   && 
-      m_checkpointWallTimeInterval == 0 ) {
+      m_checkpointWallTimeInterval == 0   &&
+      m_memoryCheckpointTimeStepInterval == 0 ) {
     return;
   }
 
@@ -586,7 +667,8 @@ DataArchiver::initializeOutput( const ProblemSpecP & params, const GridP& grid )
     // create checkpoints/index.xml (if we are saving checkpoints)
     if ( m_checkpointInterval         > 0.0 || 
          m_checkpointTimeStepInterval > 0   || 
-         m_checkpointWallTimeInterval > 0 ) {
+         m_checkpointWallTimeInterval > 0   ||
+         m_memoryCheckpointTimeStepInterval > 0 ) {
       m_checkpointsDir = m_outputDir.createSubdir("checkpoints");
       createIndexXML(m_checkpointsDir);
     }
@@ -598,6 +680,16 @@ DataArchiver::initializeOutput( const ProblemSpecP & params, const GridP& grid )
   // Sync up before every rank can use the base dir.
   Uintah::MPI::Barrier( d_myworld->getComm() );
 
+  // The node local directory is named after the uda so that
+  // simulations sharing a node do not collide.
+  if( m_memoryCheckpointTimeStepInterval > 0 && !m_buddyCheckpoint ) {
+    const string udaName  = m_outputDir.getName();
+    const string basename = udaName.substr( udaName.find_last_of( '/' ) + 1 );
+
+    m_buddyCheckpoint.reset( scinew BuddyCheckpoint( d_myworld,
+                                                     m_memoryCheckpointDirectory + "/uintah_" + basename ) );
+  }
+
 #ifdef HAVE_PIDX
   // StandAlone/restart_merger calls initializeOutput but has no grid.  
   if( grid == nullptr ) {
@@ -1088,6 +1180,13 @@ DataArchiver::finalizeTimeStep( const GridP & grid,
         << " sim time = " << m_application->getSimTime()
         << " delT= " << delT << "\n";
   }
+
+  // Publish a checkpoint written in the background if all ranks are
+  // done.  A checkpoint of this time step is left alone, its tasks
+  // have not run yet.
+  if( m_pendingCheckpoint ) {
+    completeCheckpoint( false );
+  }
   
   beginOutputTimeStep( grid );
 
@@ -1122,7 +1221,8 @@ DataArchiver::finalizeTimeStep( const GridP & grid,
       // Can't do checkpoints on init timestep....
       if( m_checkpointInterval > 0.0 ||
           m_checkpointTimeStepInterval > 0 ||
-          m_checkpointWallTimeInterval > 0 ) {
+          m_checkpointWallTimeInterval > 0 ||
+          m_memoryCheckpointTimeStepInterval > 0 ) {
 
         initCheckpoints( sched );
       }
@@ -1192,7 +1292,8 @@ DataArchiver::sched_allOutputTasks( const GridP      & grid,
   if( delT != 0.0 && // m_checkpointCycle > 0 &&
       ( m_checkpointInterval > 0 ||
         m_checkpointTimeStepInterval > 0 ||
-        m_checkpointWallTimeInterval > 0 ) ) {
+        m_checkpointWallTimeInterval > 0 ||
+        m_memoryCheckpointTimeStepInterval > 0 ) ) {
     
     // Output global vars to a checkpoint file.
     Task* task = scinew Task( "DataArchiver::outputVariables (CheckpointGlobal)",
@@ -1261,10 +1362,34 @@ DataArchiver::setCheckpointTimeStep( bool val, const GridP& grid )
     
     // Create the output checkpoint directories
     if( m_isCheckpointTimeStep ) {
+
+      // Only one checkpoint is written in the background at a time.
+      // finalizeTimeStep() may be called again for the same time step
+      // (e.g. when recompiling), which keeps its pending checkpoint.
+      if( m_asyncCheckpoints && !m_isMemoryCheckpointTimeStep &&
+          !( m_pendingCheckpoint && m_pendingCheckpoint->timeStep == getTimeStepTopLevel() ) ) {
+        completeCheckpoint( true );
+
+        m_pendingCheckpoint.reset( scinew PendingCheckpoint );
+        m_pendingCheckpoint->timeStep = getTimeStepTopLevel();
+      }
+
       string timestepDir;
       makeTimeStepDirs( m_checkpointsDir, m_checkpointLabels, grid, &timestepDir );
+
+      if( m_isMemoryCheckpointTimeStep ) {
+        setMemoryCheckpointTimeStep();
+        return;
+      }
+
       m_checkpointTimeStepDirs.push_back( timestepDir );
 
+      if( m_pendingCheckpoint ) {
+        m_pendingCheckpoint->finalDir   = timestepDir;
+        m_pendingCheckpoint->partialDir = m_checkpointsDir.getName() + "/" +
+          timeStepDirName( m_pendingCheckpoint->timeStep, true );
+      }
+
       string iname = m_checkpointsDir.getName() + "/index.xml";
       
       ProblemSpecP index;
@@ -1282,9 +1407,7 @@ DataArchiver::setCheckpointTimeStep( bool val, const GridP& grid )
           (int) m_checkpointTimeStepDirs.size() > m_checkpointCycle ) {
         if( m_writeMeta ) {
           // Remove reference to outdated checkpoint directory from the checkpoint index.
-          ProblemSpecP ts = index->findBlock( "timesteps" );
-          ProblemSpecP temp = ts->getFirstChild();
-          ts->removeChild( temp );
+          removeFromIndex( index, m_checkpointTimeStepDirs.front() );
           
           index->output( iname.c_str() );
           
@@ -1327,6 +1450,38 @@ DataArchiver::setCheckpointTimeStep( bool val, const GridP& grid )
   }
 }
 
+//______________________________________________________________________
+//  Expire the oldest in-memory checkpoint, in the uda and on the
+//  nodes, and create the node local directory of this one.
+void
+DataArchiver::setMemoryCheckpointTimeStep()
+{
+  m_memoryCheckpointTimeSteps.push_back( getTimeStepTopLevel() );
+
+  if( (int) m_memoryCheckpointTimeSteps.size() > m_memoryCheckpointCycle ) {
+    const int expired = m_memoryCheckpointTimeSteps.front();
+    m_memoryCheckpointTimeSteps.pop_front();
+
+    if( m_writeMeta ) {
+      const string expiredDir = m_checkpointsDir.getName() + "/" + timeStepDirName( expired, false );
+
+      string       iname = m_checkpointsDir.getName() + "/index.xml";
+      ProblemSpecP index = loadDocument( iname );
+
+      removeFromIndex( index, expiredDir );
+      index->output( iname.c_str() );
+
+      if( !Dir::removeDir( expiredDir.c_str() ) ) {
+        cout << "\nWarning! removeDir() Failed for '" << expiredDir << "' in DataArchiver.cc::setMemoryCheckpointTimeStep()\n\n";
+      }
+    }
+
+    m_buddyCheckpoint->expire( expired );
+  }
+
+  m_buddyCheckpoint->prepare( getTimeStepTopLevel() );
+}
+
 //______________________________________________________________________
 //
 void
@@ -1342,6 +1497,7 @@ DataArchiver::beginOutputTimeStep( const GridP& grid )
 
   m_isOutputTimeStep = false;
   m_isCheckpointTimeStep = false;
+  m_isMemoryCheckpointTimeStep = false;
   
   // Do *not* update the next values here as the original values are
   // needed to compare with if there is a time step recompute.  See
@@ -1384,11 +1540,17 @@ DataArchiver::beginOutputTimeStep( const GridP& grid )
     }
   }
   
-  setCheckpointTimeStep( isCheckpointTimeStep, grid );
+  // Checkpoint in memory between the disk checkpoints.
+  m_isMemoryCheckpointTimeStep =
+    ( m_buddyCheckpoint && !isCheckpointTimeStep && delT != 0.0 &&
+      timeStep % m_memoryCheckpointTimeStepInterval == 0 );
+
+  setCheckpointTimeStep( isCheckpointTimeStep || m_isMemoryCheckpointTimeStep, grid );
 
   if (dbg.active()) {
     dbg << "    write output timestep (" << isOutputTimeStep << ")" << std::endl
         << "    write CheckPoints (" << isCheckpointTimeStep << ")" << std::endl
+        << "    write CheckPoints in memory (" << m_isMemoryCheckpointTimeStep << ")" << std::endl
         << "    end\n";
   }  
 } // end beginOutputTimeStep
@@ -1415,6 +1577,9 @@ DataArchiver::makeTimeStepDirs(       Dir                            & baseDir,
   tname << "t" << setw(5) << setfill('0') << dir_timestep;
   *pTimeStepDir = baseDir.getName() + "/" + tname.str();
 
+  // A checkpoint written in the background goes to a temporary directory
+  const string tdirName = timeStepDirName( dir_timestep, &baseDir == &m_checkpointsDir );
+
   //__________________________________
   // Create the directory for this time step, if necessary It is not
   // guaranteed that the rank holding m_writeMeta will call
@@ -1425,7 +1590,7 @@ DataArchiver::makeTimeStepDirs(       Dir                            & baseDir,
 
   //if(m_writeMeta) {
 
-  Dir tdir = baseDir.createSubdirPlus(tname.str());
+  Dir tdir = baseDir.createSubdirPlus(tdirName);
   
   // Create the directory for this level, if necessary
   for( int l = 0; l < numLevels; l++ ) {
@@ -1522,7 +1687,7 @@ DataArchiver::findNext_OutputCheckPointTimeStep( const bool restart,
     }
   }
 
-  if( m_isCheckpointTimeStep ) {
+  if( m_isCheckpointTimeStep && !m_isMemoryCheckpointTimeStep ) {
     // Checkpoint based on the simulaiton time.
     if( m_checkpointInterval > 0.0 ) {
       if( simTime >= m_nextCheckpointTime ) {
@@ -1665,7 +1830,8 @@ DataArchiver::recompute_OutputCheckPointTimeStep()
       m_isOutputTimeStep = false;
   }
   
-  if (m_isCheckpointTimeStep && m_checkpointInterval > 0.0) {
+  if (m_isCheckpointTimeStep && !m_isMemoryCheckpointTimeStep &&
+      m_checkpointInterval > 0.0) {
     if (simTime+delT < m_nextCheckpointTime) {
       m_isCheckpointTimeStep = false;    
       m_checkpointTimeStepDirs.pop_back();
@@ -1868,9 +2034,19 @@ DataArchiver::writeto_xml_files( const GridP& grid )
         }
       }
 
+      // A checkpoint written in the background is added once it is
+      // complete, see completeCheckpoint().
+      const bool deferred = ( dumpingCheckpoint && m_pendingCheckpoint &&
+                              m_pendingCheckpoint->timeStep == dir_timestep );
+      if( deferred ) {
+        m_pendingCheckpoint->addToIndex = true;
+        m_pendingCheckpoint->simTime    = simTime;
+        m_pendingCheckpoint->delT       = delT;
+      }
+
       //__________________________________
       // add timestep info - called after the sim time has been updated.
-      if( !found ) {
+      if( !found && !deferred ) {
         
         string timestepindex = tname.str() + "/timestep.xml";
         
@@ -1909,7 +2085,9 @@ DataArchiver::writeto_xml_files( const GridP& grid )
         metaElem->appendElement("nBits", (int)sizeof(unsigned long) * 8 );
         metaElem->appendElement("numProcs", d_myworld->nRanks());
 
-        string grid_path = baseDirs[i]->getName() + "/" + tname.str() + "/";
+        const string tdirName = timeStepDirName( dir_timestep, dumpingCheckpoint );
+
+        string grid_path = baseDirs[i]->getName() + "/" + tdirName + "/";
 
         // TimeStep information
         ProblemSpecP timeElem = rootElem->appendChild("Time");
@@ -1923,7 +2101,7 @@ DataArchiver::writeto_xml_files( const GridP& grid )
         // With AMR, we're not guaranteed that a rank has work on a
         // given level.  Quick check to see that, so we don't create a
         // node that points to no data.
-        string grim_path = baseDirs[i]->getName() + "/" + tname.str() + "/";
+        string grim_path = baseDirs[i]->getName() + "/" + tdirName + "/";
 
 #if XML_TEXTWRITER
 
@@ -1944,9 +2122,16 @@ DataArchiver::writeto_xml_files( const GridP& grid )
         outputProblemSpec( rootElem );
 
         // write out the timestep.xml file
-        string name = baseDirs[i]->getName() + "/" + tname.str() + "/timestep.xml";
+        string name = baseDirs[i]->getName() + "/" + tdirName + "/timestep.xml";
         rootElem->output( name.c_str() );
 
+        // Where a restart finds the data of an in-memory checkpoint.
+        if( dumpingCheckpoint && m_isMemoryCheckpointTimeStep ) {
+          string memoryName = baseDirs[i]->getName() + "/" + tdirName + "/memory";
+          ofstream memoryFile( memoryName.c_str() );
+          memoryFile << m_buddyCheckpoint->getRoot() << "\n";
+        }
+
         //__________________________________
         // output input.xml & input.xml.orig
 
@@ -2016,6 +2201,24 @@ DataArchiver::writeto_xml_files( const GridP& grid )
   (*m_runtimeStats)[XMLIOTime] += myTime;
   (*m_runtimeStats)[TotalIOTime ] += myTime;
 
+  // The checkpoint tasks have taken their snapshots, write them.
+  if( m_isCheckpointTimeStep && m_pendingCheckpoint &&
+      !m_isMemoryCheckpointTimeStep ) {
+    startCheckpointWriter();
+  }
+
+  // Copy the in-memory checkpoint to the partner ranks.
+  if( m_isCheckpointTimeStep && m_isMemoryCheckpointTimeStep ) {
+    Timers::Simple replicateTimer;
+    replicateTimer.start();
+
+    m_buddyCheckpoint->replicate( dir_timestep );
+
+    double replicateTime = replicateTimer().seconds();
+    (*m_runtimeStats)[ CheckpointIOTime ] += replicateTime;
+    (*m_runtimeStats)[ TotalIOTime ]      += replicateTime;
+  }
+
   if (dbg.active()) {
     dbg << "  end\n";
   }
@@ -2926,11 +3129,8 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   else /* if (type == CHECKPOINT || type == CHECKPOINT_GLOBAL) */ {
     dir = m_checkpointsDir;
   }
-  
-  ostringstream tname;
-  tname << "t" << setw(5) << setfill('0') << getTimeStepTopLevel();
 
-  Dir tdir = dir.getSubdir( tname.str() );
+  Dir tdir = dir.getSubdir( timeStepDirName( getTimeStepTopLevel(), type != OUTPUT ) );
   Dir ldir;
   
   string xmlFilename;
@@ -2964,6 +3164,12 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
     xmlFilename = ldir.getName() + "/" + pname.str() + ".xml";
     dataFilebase = pname.str() + ".data";
     dataFilename = ldir.getName() + "/" + dataFilebase;
+
+    // The data of an in-memory checkpoint goes to the node, the xml
+    // still refers to it by the name it gets back on a restore.
+    if( type == CHECKPOINT && m_isMemoryCheckpointTimeStep ) {
+      dataFilename = m_buddyCheckpoint->dataFile( getTimeStepTopLevel(), level->getIndex() );
+    }
   }
   else { // type == CHECKPOINT_GLOBAL
     xmlFilename =  tdir.getName() + "/global.xml";
@@ -2978,183 +3184,88 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
 
   //__________________________________
   // Output using standard output format
-  // Not only lock to prevent multiple threads from writing over the same
-  // file, but also lock because xerces (DOM..) has thread-safety issues.
-
   if( m_outputFileFormat == UDA || type == CHECKPOINT_GLOBAL ) {
-    m_outputLock.lock(); 
-    {  
-      // Make sure doc's constructor is called after the lock.
-      ProblemSpecP doc = ProblemSpec::createDocument( "Uintah_Output" );
-      // Find the end of the file
-      ASSERT( doc != nullptr );
-      ProblemSpecP n = doc->findBlock( "Variable" );
-      
-      long cur = 0;
-      while( n != nullptr ) {
-        ProblemSpecP endNode = n->findBlock( "end" );
 
-        ASSERT( endNode != nullptr );
+    SnapshotFile file;
+    file.xmlFilename         = xmlFilename;
+    file.dataFilename        = dataFilename;
+    file.dataFilebase        = dataFilebase;
+    file.isCheckpoint        = ( type != OUTPUT );
+    file.outputDoubleAsFloat = m_outputDoubleAsFloat && type != CHECKPOINT;
 
-        long end = atol( endNode->getNodeValue().c_str() );
+    // Written in the background, the data must be copied as the
+    // following time steps may modify it in the meantime.
+    const bool background = ( type != OUTPUT && m_pendingCheckpoint != nullptr &&
+                              !m_isMemoryCheckpointTimeStep );
 
-        if(end > cur) {
-          cur = end;
-        }
-        n = n->findNextBlock( "Variable" );
-      }
-      
-      //__________________________________
-      // Open the data file:
-      //
-      // Note: At least one time on a BGQ machine (Vulcan@LLNL), with
-      // 160K patches, a single checkpoint file failed to open, and it
-      // 'crashed' the simulation.  As the other processes on the node
-      // successfully opened their file, it is possible that a second
-      // open call would have succeeded.  (The original error no was
-      // 71.)  Therefore I am using a while loop and counting the
-      // 'tries'.
-      
-      int tries = 1;
-      int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
-      
-      const char* filename = dataFilename.c_str();
-      int fd  = open( filename, flags, 0666 );
-      
-      while( fd == -1 ) {
+    //__________________________________
+    // Loop over variables to save:
+    for( vector< SaveItem >::const_iterator saveIter = saveLabels.begin(); saveIter != saveLabels.end(); ++saveIter ) {
 
-        if( tries >= 50 ) {
-          ostringstream msg;
-          
-          msg << "DataArchiver::output(): Failed to open file '"
-              << dataFilename << "' (after 50 tries).";
-          throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
-        }
+      const VarLabel       * var       = saveIter->label;
+      const MaterialSubset * var_matls = saveIter->getMaterialSubset( level );
 
-        fd = open( filename, flags, 0666 );
-        tries++;
-      }
-      
-      if( tries > 1 ) {
-        proc0cout << "WARNING: There was a glitch in trying to open the "
-                  << "checkpoint file: " << dataFilename << ". "
-                  << "It took " << tries << " tries to successfully open it.";
+      if( var_matls == nullptr ) {
+        continue;
       }
 
       //__________________________________
-      // Loop over variables to save:
-      for( vector< SaveItem >::const_iterator saveIter = saveLabels.begin(); saveIter != saveLabels.end(); ++saveIter ) {
-
-        const VarLabel       * var       = saveIter->label;
-        const MaterialSubset * var_matls = saveIter->getMaterialSubset( level );
-        
-        if( var_matls == nullptr ) {
-          continue;
-        }
-
-        //__________________________________
-        //  debugging output
-        if( dbg.active() ) {
-          dbg << "    " << var->getName() << ", materials: ";
-          for( int m = 0; m < var_matls->size(); m++ ) {
-            if( m != 0 ) {
-              dbg << ", ";
-            }
-            dbg << var_matls->get( m );
+      //  debugging output
+      if( dbg.active() ) {
+        dbg << "    " << var->getName() << ", materials: ";
+        for( int m = 0; m < var_matls->size(); m++ ) {
+          if( m != 0 ) {
+            dbg << ", ";
           }
-          dbg << "\n";
+          dbg << var_matls->get( m );
         }
-        
-        //__________________________________
-        // Loop through patches and materials:
-        for( int p = 0; p < (type == CHECKPOINT_GLOBAL ? 1 : patches->size() ); ++p ) {
-          const Patch* patch;
-          int patchID;
-          
-          if( type == CHECKPOINT_GLOBAL ) {
-            // to consolidate into this function, force patch = 0
-            patch = nullptr;
-            patchID = -1;
-          }
-          else { // type == OUTPUT || type == CHECKPOINT
-            patch   = patches->get( p );
-            patchID = patch->getID();
-          }
-          
-          //__________________________________
-          // write info for this variable to current index file
-          for( int m = 0; m < var_matls->size(); m++ ) {
-            
-            int matlIndex = var_matls->get( m );
-            
-            // Variables may not exist when we get here due to
-            // something whacky with weird AMR stuff...
-            ProblemSpecP pdElem = doc->appendChild( "Variable" );
-            
-            pdElem->appendElement( "variable", var->getName() );
-            pdElem->appendElement( "index",    matlIndex );
-            pdElem->appendElement( "patch",    patchID );
-            pdElem->setAttribute(  "type",     TranslateVariableType( var->typeDescription()->getName().c_str(), type != OUTPUT ) );
-            
-            if( var->getBoundaryLayer() != IntVector(0,0,0) ) {
-              pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
-            }
-            // Pad appropriately
-            if( cur % PADSIZE != 0 ) {
-              long pad = PADSIZE-cur%PADSIZE;
-              char* zero = scinew char[pad];
-              memset(zero, 0, pad);
-              int err = (int)write(fd, zero, pad);
-              if (err != pad) {
-                cerr << "Error writing to file: " << filename
-                     << ", errno=" << errno << '\n';
-                SCI_THROW(ErrnoException("DataArchiver::output (write call)",
-                                         errno, __FILE__, __LINE__));
-              }
-              cur+=pad;
-              delete[] zero;
-            }
-            ASSERTEQ(cur%PADSIZE, 0);
-            pdElem->appendElement("start", cur);
-            
-            // output data to data file
-            OutputContext oc(fd, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
-            totalBytes += dw->emit(oc, var, matlIndex, patch);
+        dbg << "\n";
+      }
 
-            pdElem->appendElement("end", oc.cur);
-            pdElem->appendElement("filename", dataFilebase.c_str());
-            
-#if SCI_ASSERTION_LEVEL >= 1
-            struct stat st;
-            int s = fstat(fd, &st);
-            
-            if(s == -1) {
-              cerr << "fstat error - file: " << filename
-                   << ", errno=" << errno << '\n';
-              throw ErrnoException("DataArchiver::output (stat call)",
-                                   errno, __FILE__, __LINE__);
-            }
-            ASSERTEQ(oc.cur, st.st_size);
-#endif
-            cur = oc.cur;
-          }  // matls
-        }  // patches
-      }  // save items
-      
       //__________________________________
-      // close files and handles 
-      int s = close( fd );
-      if( s == -1 ) {
-        cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
-        throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
-      }
-      
-      doc->output( xmlFilename.c_str() );
-      //doc->releaseDocument();
+      // Loop through patches and materials:
+      for( int p = 0; p < (type == CHECKPOINT_GLOBAL ? 1 : patches->size() ); ++p ) {
+        const Patch* patch;
+        int patchID;
 
-    } // end output locked section
+        if( type == CHECKPOINT_GLOBAL ) {
+          // to consolidate into this function, force patch = 0
+          patch = nullptr;
+          patchID = -1;
+        }
+        else { // type == OUTPUT || type == CHECKPOINT
+          patch   = patches->get( p );
+          patchID = patch->getID();
+        }
 
-    m_outputLock.unlock(); 
+        for( int m = 0; m < var_matls->size(); m++ ) {
+          SnapshotVariable snapshot;
+          snapshot.label     = var;
+          snapshot.matlIndex = var_matls->get( m );
+          snapshot.patchID   = patchID;
+          snapshot.var       = dw->emitSnapshot( var, snapshot.matlIndex, patch,
+                                                 snapshot.low, snapshot.high,
+                                                 background );
+          file.vars.push_back( snapshot );
+        }  // matls
+      }  // patches
+    }  // save items
+
+    // Not only lock to prevent multiple threads from writing over the
+    // same file, but also lock because xerces (DOM..) has thread-safety
+    // issues.
+    m_outputLock.lock();
+    {
+      if( background ) {
+        // Written in the background, a recomputed time step replaces
+        // the snapshot taken before.
+        m_pendingCheckpoint->files[ dataFilename ] = std::move( file );
+      }
+      else {
+        totalBytes += writeSnapshotFile( file );
+      }
+    }
+    m_outputLock.unlock();
   } // end UDA or Global Var
 
 #if HAVE_PIDX
@@ -3237,6 +3348,153 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   }
 } // end outputVariables()
 
+//______________________________________________________________________
+//
+DataArchiver::SnapshotFile::~SnapshotFile()
+{
+  for( auto & snapshot : vars ) {
+    delete snapshot.var;
+  }
+}
+
+//______________________________________________________________________
+//  Write the variables of one data file and the xml file indexing them.
+size_t
+DataArchiver::writeSnapshotFile( const SnapshotFile & file )
+{
+  size_t totalBytes = 0;
+
+  const string & dataFilename = file.dataFilename;
+
+  // Make sure doc's constructor is called after the lock.
+  ProblemSpecP doc = ProblemSpec::createDocument( "Uintah_Output" );
+  // Find the end of the file
+  ASSERT( doc != nullptr );
+  ProblemSpecP n = doc->findBlock( "Variable" );
+
+  long cur = 0;
+  while( n != nullptr ) {
+    ProblemSpecP endNode = n->findBlock( "end" );
+
+    ASSERT( endNode != nullptr );
+
+    long end = atol( endNode->getNodeValue().c_str() );
+
+    if(end > cur) {
+      cur = end;
+    }
+    n = n->findNextBlock( "Variable" );
+  }
+
+  //__________________________________
+  // Open the data file:
+  //
+  // Note: At least one time on a BGQ machine (Vulcan@LLNL), with
+  // 160K patches, a single checkpoint file failed to open, and it
+  // 'crashed' the simulation.  As the other processes on the node
+  // successfully opened their file, it is possible that a second
+  // open call would have succeeded.  (The original error no was
+  // 71.)  Therefore I am using a while loop and counting the
+  // 'tries'.
+
+  int tries = 1;
+  int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
+
+  const char* filename = dataFilename.c_str();
+  int fd  = open( filename, flags, 0666 );
+
+  while( fd == -1 ) {
+
+    if( tries >= 50 ) {
+      ostringstream msg;
+
+      msg << "DataArchiver::output(): Failed to open file '"
+          << dataFilename << "' (after 50 tries).";
+      throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
+    }
+
+    fd = open( filename, flags, 0666 );
+    tries++;
+  }
+
+  if( tries > 1 ) {
+    proc0cout << "WARNING: There was a glitch in trying to open the "
+              << "checkpoint file: " << dataFilename << ". "
+              << "It took " << tries << " tries to successfully open it.";
+  }
+
+  //__________________________________
+  // write info for each variable to the index file
+  for( const SnapshotVariable & snapshot : file.vars ) {
+
+    const VarLabel * var = snapshot.label;
+
+    // Variables may not exist when we get here due to
+    // something whacky with weird AMR stuff...
+    ProblemSpecP pdElem = doc->appendChild( "Variable" );
+
+    pdElem->appendElement( "variable", var->getName() );
+    pdElem->appendElement( "index",    snapshot.matlIndex );
+    pdElem->appendElement( "patch",    snapshot.patchID );
+    pdElem->setAttribute(  "type",     TranslateVariableType( var->typeDescription()->getName().c_str(), file.isCheckpoint ) );
+
+    if( var->getBoundaryLayer() != IntVector(0,0,0) ) {
+      pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
+    }
+    // Pad appropriately
+    if( cur % PADSIZE != 0 ) {
+      long pad = PADSIZE-cur%PADSIZE;
+      char* zero = scinew char[pad];
+      memset(zero, 0, pad);
+      int err = (int)write(fd, zero, pad);
+      if (err != pad) {
+        cerr << "Error writing to file: " << filename
+             << ", errno=" << errno << '\n';
+        SCI_THROW(ErrnoException("DataArchiver::output (write call)",
+                                 errno, __FILE__, __LINE__));
+      }
+      cur+=pad;
+      delete[] zero;
+    }
+    ASSERTEQ(cur%PADSIZE, 0);
+    pdElem->appendElement("start", cur);
+
+    // output data to data file
+    OutputContext oc(fd, filename, cur, pdElem, file.outputDoubleAsFloat);
+    totalBytes += snapshot.var->emit( oc, snapshot.low, snapshot.high, var->getCompressionMode() );
+
+    pdElem->appendElement("end", oc.cur);
+    pdElem->appendElement("filename", file.dataFilebase.c_str());
+
+#if SCI_ASSERTION_LEVEL >= 1
+    struct stat st;
+    int s = fstat(fd, &st);
+
+    if(s == -1) {
+      cerr << "fstat error - file: " << filename
+           << ", errno=" << errno << '\n';
+      throw ErrnoException("DataArchiver::output (stat call)",
+                           errno, __FILE__, __LINE__);
+    }
+    ASSERTEQ(oc.cur, st.st_size);
+#endif
+    cur = oc.cur;
+  }
+
+  //__________________________________
+  // close files and handles
+  int s = close( fd );
+  if( s == -1 ) {
+    cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
+    throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+  }
+
+  doc->output( file.xmlFilename.c_str() );
+  //doc->releaseDocument();
+
+  return totalBytes;
+}
+
 //______________________________________________________________________
 //  output only the savedLabels of a specified type description in PIDX format.
 
@@ -4512,6 +4770,13 @@ DataArchiver::checkpointTimeStep( const GridP& grid,
     return;
   }
 
+  // On demand checkpoints are written right away.
+  completeCheckpoint( true );
+
+  const bool asyncCheckpoints = m_asyncCheckpoints;
+  m_asyncCheckpoints = false;
+  m_isMemoryCheckpointTimeStep = false;
+
   int proc = d_myworld->myRank();
 
   DataWarehouse* oldDW = sched->get_dw(0);
@@ -4544,6 +4809,185 @@ DataArchiver::checkpointTimeStep( const GridP& grid,
 
   m_isCheckpointTimeStep = false;
   m_checkpointPreviousTimeStep = false;
+  m_asyncCheckpoints = asyncCheckpoints;
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiver::finishCheckpoint()
+{
+  completeCheckpoint( true );
+}
+
+//______________________________________________________________________
+//  An in-memory checkpoint has a "memory" file naming the node local
+//  directory that holds its data files.
+bool
+DataArchiver::restoreMemoryCheckpoint( const Dir & restartFromDir, int timeStep )
+{
+  const string tdir = restartFromDir.getSubdir( "checkpoints" ).getName() + "/" +
+    timeStepDirName( timeStep, false );
+
+  ifstream memoryFile( ( tdir + "/memory" ).c_str() );
+  if( !memoryFile ) {
+    return true;
+  }
+
+  string root;
+  getline( memoryFile, root );
+
+  return BuddyCheckpoint::restore( d_myworld, root, timeStep, tdir );
+}
+
+//______________________________________________________________________
+//
+string
+DataArchiver::timeStepDirName( int timeStep, bool isCheckpoint ) const
+{
+  ostringstream tname;
+  tname << "t" << setw(5) << setfill('0') << timeStep;
+
+  if( isCheckpoint && m_pendingCheckpoint &&
+      m_pendingCheckpoint->timeStep == timeStep ) {
+    tname << ".partial";
+  }
+  return tname.str();
+}
+
+//______________________________________________________________________
+//  Write the snapshots of the pending checkpoint on a background
+//  thread.  It only does file I/O (no MPI).  Called once the
+//  checkpoint tasks have taken their snapshots.
+void
+DataArchiver::startCheckpointWriter()
+{
+  PendingCheckpoint * pending = m_pendingCheckpoint.get();
+
+  if( pending == nullptr || pending->started ) {
+    return;
+  }
+  pending->started = true;
+  pending->timer.start();
+
+  pending->writer = std::thread( [this, pending]() {
+    try {
+      for( auto & file : pending->files ) {
+        // The output tasks of the following time steps run meanwhile,
+        // see outputVariables() for why the lock is needed.
+        std::lock_guard<Uintah::MasterLock> lock( m_outputLock );
+        writeSnapshotFile( file.second );
+      }
+    }
+    catch( const Exception & e ) {
+      pending->error = e.message();
+    }
+    catch( const std::exception & e ) {
+      pending->error = e.what();
+    }
+    catch( ... ) {
+      pending->error = "unknown exception";
+    }
+    pending->done = true;
+  } );
+}
+
+//______________________________________________________________________
+//  Once every rank has written its part of the pending checkpoint,
+//  rename its directory and add it to checkpoints/index.xml.
+void
+DataArchiver::completeCheckpoint( bool wait )
+{
+  PendingCheckpoint * pending = m_pendingCheckpoint.get();
+
+  if( pending == nullptr ) {
+    return;
+  }
+
+  // Normally started by writeto_xml_files().  A checkpoint of an
+  // earlier time step or at the end of the run whose xml files were
+  // not written (e.g. regridded) is not added to the index.
+  if( !pending->started ) {
+    if( !wait && pending->timeStep == getTimeStepTopLevel() ) {
+      return;
+    }
+    startCheckpointWriter();
+  }
+
+  if( wait ) {
+    pending->writer.join();
+  }
+
+  int done    = pending->done ? 1 : 0;
+  int allDone = 0;
+  Uintah::MPI::Allreduce( &done, &allDone, 1, MPI_INT, MPI_MIN, d_myworld->getComm() );
+
+  if( !allDone ) {
+    return;
+  }
+
+  if( pending->writer.joinable() ) {
+    pending->writer.join();
+  }
+
+  int failed    = pending->error.empty() ? 0 : 1;
+  int anyFailed = 0;
+  Uintah::MPI::Allreduce( &failed, &anyFailed, 1, MPI_INT, MPI_MAX, d_myworld->getComm() );
+
+  if( anyFailed ) {
+    ostringstream msg;
+    msg << "DataArchiver: writing checkpoint " << pending->partialDir << " failed";
+    if( failed ) {
+      msg << ": " << pending->error;
+    }
+    else {
+      msg << " on another rank";
+    }
+    throw InternalError( msg.str(), __FILE__, __LINE__ );
+  }
+
+  if( m_writeMeta ) {
+    if( pending->addToIndex ) {
+      if( rename( pending->partialDir.c_str(), pending->finalDir.c_str() ) != 0 ) {
+        throw ErrnoException( "DataArchiver::completeCheckpoint(): renaming " + pending->partialDir,
+                              errno, __FILE__, __LINE__ );
+      }
+
+      ostringstream tname;
+      tname << "t" << setw(5) << setfill('0') << pending->timeStep;
+
+      string       iname    = m_checkpointsDir.getName() + "/index.xml";
+      ProblemSpecP indexDoc = loadDocument( iname );
+
+      ProblemSpecP ts = indexDoc->findBlock( "timesteps" );
+      if( ts == nullptr ) {
+        ts = indexDoc->appendChild( "timesteps" );
+      }
+
+      string timestepindex = tname.str() + "/timestep.xml";
+
+      ostringstream value, timeVal, deltVal;
+      value << pending->timeStep;
+      ProblemSpecP newElem = ts->appendElement( "timestep", value.str().c_str() );
+      newElem->setAttribute( "href",     timestepindex.c_str() );
+      timeVal << std::setprecision(17) << pending->simTime;
+      newElem->setAttribute( "time",     timeVal.str() );
+      deltVal << std::setprecision(17) << pending->delT;
+      newElem->setAttribute( "oldDelt",  deltVal.str() );
+
+      indexDoc->output( iname.c_str() );
+    }
+    else {
+      // The time step was not output after all (e.g. regridded).
+      Dir::removeDir( pending->partialDir.c_str() );
+    }
+  }
+
+  DOUT( d_myworld->myRank() == 0,
+        "Checkpoint " << pending->finalDir << " written in the background ("
+        << pending->timer().seconds() << " seconds)" );
+
+  m_pendingCheckpoint.reset();
 }
 
 //______________________________________________________________________
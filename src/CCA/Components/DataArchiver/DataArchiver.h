@@ -39,9 +39,18 @@
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/UintahParallelComponent.h>
 #include <Core/Util/Assert.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace Uintah {
 
+class BuddyCheckpoint;
 class DataWarehouse;
 class ApplicationInterface;
 class LoadBalancer;
@@ -244,6 +253,15 @@ class LoadBalancer;
                              SchedulerP& sched,
                              bool previous );
 
+    //! Waits for a checkpoint being written in the background and
+    //! publishes it.  Collective.
+    void finishCheckpoint();
+
+    //! Copies the data files of an in-memory checkpoint from the
+    //! nodes back into the uda.  Returns false if they are lost.
+    //! Collective.
+    bool restoreMemoryCheckpoint( const Dir & restartFromDir, int timeStep );
+
     void maybeLastTimeStep( bool val ) { m_maybeLastTimeStep = val; };
     bool maybeLastTimeStep() { return m_maybeLastTimeStep; };
      
@@ -368,6 +386,104 @@ class LoadBalancer;
 #endif
     int m_lastOutputOfTimeStepXML = -1; 
 
+    //__________________________________
+    //  Data files
+
+    //! One variable of a data file.  var is a copy of the
+    //! DataWarehouse variable, so it stays valid while the following
+    //! time steps run and after the DataWarehouse has been scrubbed.
+    struct SnapshotVariable {
+      const VarLabel * label;
+      int              matlIndex;
+      int              patchID;
+      IntVector        low;
+      IntVector        high;
+      Variable       * var;
+    };
+
+    //! The variables of one p#####.data or global.data file and its
+    //! xml index.
+    struct SnapshotFile {
+      std::string                     xmlFilename;
+      std::string                     dataFilename;
+      std::string                     dataFilebase;
+      bool                            isCheckpoint {false};
+      bool                            outputDoubleAsFloat {false};
+      std::vector< SnapshotVariable > vars;
+
+      SnapshotFile() = default;
+      SnapshotFile( SnapshotFile && ) = default;
+      SnapshotFile & operator=( SnapshotFile && ) = default;
+      ~SnapshotFile();
+
+      SnapshotFile( const SnapshotFile & ) = delete;
+      SnapshotFile & operator=( const SnapshotFile & ) = delete;
+    };
+
+    //! Writes a data file and its xml index, returns the bytes written.
+    size_t writeSnapshotFile( const SnapshotFile & file );
+
+    //__________________________________
+    //  Asynchronous checkpoints
+    //
+    //  With <checkpoint asynchronous="true"> the checkpoint tasks only
+    //  take snapshots of the variables, a background thread writes them
+    //  to a "t#####.partial" directory while the simulation continues.
+    //  Once every rank is done the directory is renamed to "t#####" and
+    //  the time step is added to checkpoints/index.xml, so a restart
+    //  never sees an incomplete checkpoint.
+
+    struct PendingCheckpoint {
+      int                                   timeStep {-1};
+      std::string                           partialDir;
+      std::string                           finalDir;
+      std::map< std::string, SnapshotFile > files;  // by data file name
+
+      // Set on the ranks writing meta data by writeto_xml_files()
+      bool                                  addToIndex {false};
+      double                                simTime {0};
+      double                                delT {0};
+
+      bool                                  started {false};
+      std::thread                           writer;
+      std::atomic<bool>                     done {false};
+      std::string                           error;
+      Timers::Simple                        timer;
+    };
+
+    //! Name of the time step directory, "t#####" or "t#####.partial"
+    //! for a checkpoint being written in the background.
+    std::string timeStepDirName( int timeStep, bool isCheckpoint ) const;
+
+    void startCheckpointWriter();
+
+    //! Publishes the pending checkpoint once all ranks wrote their
+    //! part, waits for them if wait is true.  Collective.
+    void completeCheckpoint( bool wait );
+
+    bool m_asyncCheckpoints {false};
+    std::unique_ptr< PendingCheckpoint > m_pendingCheckpoint;
+
+    //__________________________________
+    //  In-memory checkpoints
+    //
+    //  With <memoryCheckpoint timestepInterval="N"> the data files of
+    //  the checkpoints taken between the disk checkpoints are written
+    //  to a node local RAM file system and copied to a partner rank,
+    //  see BuddyCheckpoint.  The xml files stay in checkpoints/
+    //  together with a "memory" file that names the node local
+    //  directory.
+
+    int                                m_memoryCheckpointTimeStepInterval {0};
+    int                                m_memoryCheckpointCycle {2};
+    std::string                        m_memoryCheckpointDirectory {"/dev/shm"};
+    bool                               m_isMemoryCheckpointTimeStep {false};
+    std::list<int>                     m_memoryCheckpointTimeSteps;
+    std::unique_ptr< BuddyCheckpoint > m_buddyCheckpoint;
+
+    //! Helper for setCheckpointTimeStep.
+    void setMemoryCheckpointTimeStep();
+
     //! helper for finalizeTimeStep - schedules a task for each var's output
     void scheduleOutputTimeStep(       std::vector<SaveItem> & saveLabels,
                                  const GridP                 & grid, 
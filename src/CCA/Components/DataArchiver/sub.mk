@@ -31,7 +31,8 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 
 SRCDIR   := CCA/Components/DataArchiver
 
-SRCS     += $(SRCDIR)/DataArchiver.cc
+SRCS     += $(SRCDIR)/BuddyCheckpoint.cc \
+            $(SRCDIR)/DataArchiver.cc
 
 PSELIBS := \
 	CCA/Ports          \
@@ -46,6 +46,7 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Math/MiscMath.h>
 #include <Core/Util/DebugStream.h>
+#include <deque>
 #include <iomanip>
 #include <cstdio>
 
@@ -1094,40 +1095,29 @@ void AMRICE::coarsen(const ProcessorGroup*,
       new_dw->getModifiable(eng_adv,   lb->eng_advLabel,    indx, coarsePatch);
       new_dw->getModifiable(mom_adv,   lb->mom_advLabel,    indx, coarsePatch);  
       
-      // coarsen
-      bool computesAve = false;
-      fineToCoarseOperator<double>(mass_adv,   computesAve, 
-                         lb->mass_advLabel,   indx, new_dw, 
-                         coarsePatch, coarseLevel, fineLevel);      
-
-      fineToCoarseOperator<double>(sp_vol_adv, computesAve,
-                         lb->sp_vol_advLabel, indx, new_dw, 
-                         coarsePatch, coarseLevel, fineLevel);
+      // coarsen, all the variables of this matl in one batch
+      FineToCoarseBatch batch( new_dw, coarsePatch, coarseLevel, fineLevel );
 
-      fineToCoarseOperator<double>(eng_adv,   computesAve,   
-                         lb->eng_advLabel,    indx, new_dw, 
-                         coarsePatch, coarseLevel, fineLevel);
-       
-      fineToCoarseOperator<Vector>( mom_adv,  computesAve,   
-                         lb->mom_advLabel,    indx, new_dw, 
-                         coarsePatch, coarseLevel, fineLevel);
+      bool computesAve = false;
+      batch.add( mass_adv,   computesAve, lb->mass_advLabel,   indx );
+      batch.add( sp_vol_adv, computesAve, lb->sp_vol_advLabel, indx );
+      batch.add( eng_adv,    computesAve, lb->eng_advLabel,    indx );
+      batch.add( mom_adv,    computesAve, lb->mom_advLabel,    indx );
       
       //__________________________________
       // pressure
+      CCVariable<double> press_CC;
       if( indx == 0){
-          // pressure
-        CCVariable<double> press_CC;                  
         new_dw->getModifiable(press_CC, lb->press_CCLabel,  0,    coarsePatch);
         computesAve = true;
         
-        fineToCoarseOperator<double>(press_CC, computesAve,
-                           lb->press_CCLabel, 0,   new_dw, 
-                           coarsePatch, coarseLevel, fineLevel);
+        batch.add( press_CC, computesAve, lb->press_CCLabel, 0 );
       }                   
                          
                          
       //__________________________________
       // Model with transported variables.
+      std::deque< CCVariable<double> > q_CC_adv;   // stable addresses for the batch
       if(d_models.size()){
         for(vector<ModelInterface*>::iterator m_iter  = d_models.begin();
                                               m_iter != d_models.end(); m_iter++){
@@ -1140,18 +1130,17 @@ void AMRICE::coarsen(const ProcessorGroup*,
               TransportedVariable* tvar = *t_iter;
 
               if(tvar->matls->contains(indx)){
-                CCVariable<double> q_CC_adv;
-                new_dw->getModifiable(q_CC_adv, tvar->var_adv, indx, coarsePatch);
+                q_CC_adv.emplace_back();
+                new_dw->getModifiable(q_CC_adv.back(), tvar->var_adv, indx, coarsePatch);
                 computesAve = false;
             
-                fineToCoarseOperator<double>(q_CC_adv, computesAve, 
-                                             tvar->var_adv, indx, new_dw, 
-                                             coarsePatch, coarseLevel, fineLevel);
+                batch.add( q_CC_adv.back(), computesAve, tvar->var_adv, indx );
               }
             }
           }
         }
       } 
+      batch.execute();
     }
   }  // course patch loop 
 //  cout_dbg.setActive(dbg_onOff);  // reset on/off switch for cout_dbg (turn off for tsanitizer warnings)
@@ -633,23 +633,24 @@ void setBC(CCVariable<double>& press_CC,
       bool foundIterator = 
         getIteratorBCValueBCKind<double>( patch, face, child, kind, mat_id,
                                                bc_value, bound_ptr,bc_kind); 
+      const BCCellList& cells = patch->getBCDataArray(face)->getCellFaceList(mat_id, child);
       
       if(foundIterator && bc_kind != "LODI") {                                            
         //__________________________________
         // Dirichlet
         if(bc_kind == "Dirichlet"){
-           nCells += setDirichletBC_CC<double>( press_CC, bound_ptr, bc_value);
+           nCells += setDirichletBC_CC<double>( press_CC, cells, bc_value);
         }
         //__________________________________
         // Neumann
         else if(bc_kind == "Neumann"){
-           nCells += setNeumannBC_CC<double >( patch, face, press_CC, bound_ptr, bc_value, cell_dx);
+           nCells += setNeumannBC_CC<double >( patch, face, press_CC, cells, bc_value, cell_dx);
         } 
         //__________________________________
         //  Symmetry
         else if ( bc_kind == "symmetry" || bc_kind == "zeroNeumann" ) {
           bc_value = 0.0;
-          nCells += setNeumannBC_CC<double >( patch, face, press_CC, bound_ptr, bc_value, cell_dx);
+          nCells += setNeumannBC_CC<double >( patch, face, press_CC, cells, bc_value, cell_dx);
         }
                                           
         //__________________________________
@@ -771,23 +772,24 @@ void setBC(CCVariable<double>& var_CC,
       bool foundIterator = 
         getIteratorBCValueBCKind<double>( patch, face, child, desc, mat_id,
                                                bc_value, bound_ptr,bc_kind); 
+      const BCCellList& cells = patch->getBCDataArray(face)->getCellFaceList(mat_id, child);
                                                 
       if (foundIterator && bc_kind != "LODI") {
         //__________________________________
         // Dirichlet
         if(bc_kind == "Dirichlet"){
-           nCells += setDirichletBC_CC<double>( var_CC, bound_ptr, bc_value);
+           nCells += setDirichletBC_CC<double>( var_CC, cells, bc_value);
         }
         //__________________________________
         // Neumann
         else if(bc_kind == "Neumann"){
-           nCells += setNeumannBC_CC<double >( patch, face, var_CC, bound_ptr, bc_value, cell_dx);
+           nCells += setNeumannBC_CC<double >( patch, face, var_CC, cells, bc_value, cell_dx);
         }                                   
         //__________________________________
         //  Symmetry
         else if ( bc_kind == "symmetry" || bc_kind == "zeroNeumann" ) {
           bc_value = 0.0;
-          nCells += setNeumannBC_CC<double >( patch, face, var_CC, bound_ptr, bc_value, cell_dx);
+          nCells += setNeumannBC_CC<double >( patch, face, var_CC, cells, bc_value, cell_dx);
         }
         //__________________________________
         //  Custom Boundary Conditions
@@ -929,23 +931,24 @@ void setBC(CCVariable<Vector>& var_CC,
       bool foundIterator = 
           getIteratorBCValueBCKind<Vector>(patch, face, child, desc, mat_id,
                                             bc_value, bound_ptr ,bc_kind);
+      const BCCellList& cells = patch->getBCDataArray(face)->getCellFaceList(mat_id, child);
       
       if (foundIterator && bc_kind != "LODI") {
         
         //__________________________________
         // Dirichlet
         if(bc_kind == "Dirichlet"){
-           nCells += setDirichletBC_CC<Vector>( var_CC, bound_ptr, bc_value);
+           nCells += setDirichletBC_CC<Vector>( var_CC, cells, bc_value);
         }
         //__________________________________
         // Neumann
         else if(bc_kind == "Neumann"){
-           nCells += setNeumannBC_CC<Vector>( patch, face, var_CC, bound_ptr, bc_value, cell_dx);
+           nCells += setNeumannBC_CC<Vector>( patch, face, var_CC, cells, bc_value, cell_dx);
         }                                   
         //__________________________________
         //  Symmetry
         else if ( bc_kind == "symmetry" ) {
-          nCells += setSymmetryBC_CC( patch, face, var_CC, bound_ptr);
+          nCells += setSymmetryBC_CC( patch, face, var_CC, cells);
         }
         //__________________________________
         //  Custom Boundary Conditions
@@ -1049,24 +1052,25 @@ void setSpecificVolBC(CCVariable<double>& sp_vol_CC,
       bool foundIterator = 
         getIteratorBCValueBCKind<double>( patch, face, child, desc, mat_id,
                                           bc_value, bound_ptr,bc_kind); 
+      const BCCellList& cells = patch->getBCDataArray(face)->getCellFaceList(mat_id, child);
                                    
       if(foundIterator) {
 
         //__________________________________
         // Dirichlet
         if(bc_kind == "Dirichlet"){
-           nCells += setDirichletBC_CC<double>( sp_vol_CC, bound_ptr, bc_value);
+           nCells += setDirichletBC_CC<double>( sp_vol_CC, cells, bc_value);
         }
         //__________________________________
         // Neumann
         else if(bc_kind == "Neumann"){
-           nCells += setNeumannBC_CC<double >( patch, face, sp_vol_CC, bound_ptr, bc_value, cell_dx);
+           nCells += setNeumannBC_CC<double >( patch, face, sp_vol_CC, cells, bc_value, cell_dx);
         }                                   
         //__________________________________
         //  Symmetry
         else if ( bc_kind == "symmetry" || bc_kind == "zeroNeumann" ) {
           bc_value = 0.0;
-          nCells += setNeumannBC_CC<double >( patch, face, sp_vol_CC, bound_ptr, bc_value, cell_dx);
+          nCells += setNeumannBC_CC<double >( patch, face, sp_vol_CC, cells, bc_value, cell_dx);
         }
         //__________________________________
         //  Symmetry
@@ -1140,6 +1144,22 @@ void setSpecificVolBC(CCVariable<double>& sp_vol_CC,
    return nCells;
 }
 
+ int setSymmetryBC_CC( const Patch* patch,
+                       const Patch::FaceType face,
+                       CCVariable<Vector>& var_CC,
+                       const BCCellList& cells)
+{
+   CCVariable<Vector>* vars[1] = { &var_CC };
+   const int adj = -getBCStride( getBCLayout(var_CC), patch->faceDirection(face) );
+   int P_dir = patch->getFaceAxes(face)[0];  // principal direction
+
+   return applyBC_CC( vars, 1, cells,
+                      [adj, P_dir]( Vector* d, const int o, const int ) {
+                        d[o] = d[o + adj];
+                        d[o][P_dir] = -d[o][P_dir];
+                      } );
+}
+
 
 /* --------------------------------------------------------------------- 
  Function~  BC_bulletproofing--  
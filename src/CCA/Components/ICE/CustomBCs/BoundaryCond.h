@@ -158,6 +158,11 @@ namespace Uintah {
                        CCVariable<Vector>& var_CC,               
                        Iterator& bound_ptr);
 
+  int setSymmetryBC_CC( const Patch* patch,
+                       const Patch::FaceType face,
+                       CCVariable<Vector>& var_CC,
+                       const BCCellList& cells);
+
   template<class T>
   int setDirichletBC_FC( const Patch* patch,
                         const Patch::FaceType face,       
@@ -56,6 +56,7 @@
 #include <Core/Grid/MaterialManager.h>
 #include <Core/Grid/Task.h>
 #include <Core/Grid/Variables/CellIterator.h>
+#include <Core/Grid/Variables/RowRange.h>
 #include <Core/Grid/Variables/SoleVariable.h>
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Grid/BoundaryConditions/BCUtils.h>
@@ -3962,8 +3963,6 @@ void ICE::accumulateMomentumSourceSinks(const ProcessorGroup*,
 
     printTask(patches, patch, cout_doing, "Doing ICE::accumulateMomentumSourceSinks" );
       
-    IntVector right, left, top, bottom, front, back;
-
     delt_vartype delT; 
     old_dw->get(delT, lb->delTLabel, level);
  
@@ -4004,21 +4003,32 @@ void ICE::accumulateMomentumSourceSinks(const ProcessorGroup*,
       
       //__________________________________
       //  accumulate sources MPM and ICE matls
-      for(CellIterator iter = patch->getCellIterator(); !iter.done();iter++){
-        IntVector c = *iter;
-
-        right    = c + IntVector(1,0,0);    left     = c;
-        top      = c + IntVector(0,1,0);    bottom   = c;
-        front    = c + IntVector(0,0,1);    back     = c;
-          
-        double press_src_X = ( pressX_FC[right] - pressX_FC[left] )   * vol_frac[c];
-        double press_src_Y = ( pressY_FC[top]   - pressY_FC[bottom] ) * vol_frac[c]; 
-        double press_src_Z = ( pressZ_FC[front] - pressZ_FC[back] )   * vol_frac[c];
-        
-        mom_source[c].x( -press_src_X * areaX ); 
-        mom_source[c].y( -press_src_Y * areaY );    
-        mom_source[c].z( -press_src_Z * areaZ );
-      }
+      RowAccessor<const double> pressX( pressX_FC );
+      RowAccessor<const double> pressY( pressY_FC );
+      RowAccessor<const double> pressZ( pressZ_FC );
+      RowAccessor<const double> vf( vol_frac );
+      RowAccessor<Vector>       src( mom_source );
+
+      parallel_for_rows( RowRange( patch->getCellIterator() ),
+                         [&]( int j, int k, int ib, int ie ) {
+        const double* pX     = pressX.row( j,   k   );
+        const double* pY     = pressY.row( j,   k   );
+        const double* pY_top = pressY.row( j+1, k   );
+        const double* pZ     = pressZ.row( j,   k   );
+        const double* pZ_frt = pressZ.row( j,   k+1 );
+        const double* f      = vf.row( j, k );
+        Vector*       s      = src.row( j, k );
+
+        for( int i = ib; i < ie; i++ ) {
+          double press_src_X = ( pX[i+1]   - pX[i] ) * f[i];
+          double press_src_Y = ( pY_top[i] - pY[i] ) * f[i];
+          double press_src_Z = ( pZ_frt[i] - pZ[i] ) * f[i];
+
+          s[i] = Vector( -press_src_X * areaX,
+                         -press_src_Y * areaY,
+                         -press_src_Z * areaZ );
+        }
+      });
       
       //__________________________________
       //  Add user defined pressure gradient 
@@ -4046,25 +4056,37 @@ void ICE::accumulateMomentumSourceSinks(const ProcessorGroup*,
       }
       
       //__________________________________
-      //  ICE _matls: 
+      //  ICE _matls:  add the viscous and gravity sources, all matls:
+      //  scale by delT
+      const double dt = delT;
+
       if(ice_matl){
         constCCVariable<Vector> viscous_src;
         new_dw->get(viscous_src, lb->viscous_src_CCLabel, indx, patch,gn,0);
-      
-        for(CellIterator iter = patch->getCellIterator(); !iter.done();iter++){
-          IntVector c = *iter;
-          double mass = rho_CC[c] * vol;
 
-          mom_source[c] = (mom_source[c] + viscous_src[c] + mass * gravity );
-        }
-        
+        RowAccessor<const double> rho( rho_CC );
+        RowAccessor<const Vector> visc( viscous_src );
+
+        parallel_for_rows( RowRange( patch->getCellIterator() ),
+                           [&]( int j, int k, int ib, int ie ) {
+          const double* r = rho.row( j, k );
+          const Vector* v = visc.row( j, k );
+          Vector*       s = src.row( j, k );
+
+          for( int i = ib; i < ie; i++ ) {
+            double mass = r[i] * vol;
+            s[i] = ( s[i] + v[i] + mass * gravity ) * dt;
+          }
+        });
       }  //ice_matl
-      
-      //__________________________________
-      //  All Matls
-      for(CellIterator iter = patch->getCellIterator(); !iter.done();iter++){
-        IntVector c = *iter;
-        mom_source[c] *= delT; 
+      else {
+        parallel_for_rows( RowRange( patch->getCellIterator() ),
+                           [&]( int j, int k, int ib, int ie ) {
+          Vector* s = src.row( j, k );
+          for( int i = ib; i < ie; i++ ) {
+            s[i] *= dt;
+          }
+        });
       }
       
     }  // matls loop
@@ -4165,11 +4187,29 @@ void ICE::accumulateEnergySourceSinks(const ProcessorGroup*,
         //   Compute source from volume dilatation
         //   Exclude contribution from delP_MassX
         if( ice_matl->getIncludeFlowWork() ){
-          for(CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
-            IntVector c = *iter;
-            double A = TMV_CC[c] * vol_frac[c] * kappa[c] * press_CC[c];
-            int_eng_source[c] += A * delP_Dilatate[c] + heatCond_src[c];
-          }
+          RowAccessor<const double> TMV( TMV_CC );
+          RowAccessor<const double> vf( vol_frac );
+          RowAccessor<const double> kap( kappa );
+          RowAccessor<const double> press( press_CC );
+          RowAccessor<const double> delP( delP_Dilatate );
+          RowAccessor<const double> heat( heatCond_src );
+          RowAccessor<double>       src( int_eng_source );
+
+          parallel_for_rows( RowRange( patch->getCellIterator() ),
+                             [&]( int j, int k, int ib, int ie ) {
+            const double* t  = TMV.row( j, k );
+            const double* f  = vf.row( j, k );
+            const double* ka = kap.row( j, k );
+            const double* p  = press.row( j, k );
+            const double* dP = delP.row( j, k );
+            const double* h  = heat.row( j, k );
+            double*       s  = src.row( j, k );
+
+            for( int i = ib; i < ie; i++ ) {
+              double A = t[i] * f[i] * ka[i] * p[i];
+              s[i] += A * dP[i] + h[i];
+            }
+          });
         }
       }
     
@@ -4247,14 +4287,35 @@ void ICE::computeLagrangianValues(const ProcessorGroup*,
       //__________________________________
       //  NO mass exchange
       if(d_models.size() == 0) {
-        for(CellIterator iter = patch->getExtraCellIterator(); !iter.done(); 
-           iter++) {
-         IntVector c = *iter;
-          double mass = rho_CC[c] * vol;
-          mass_L[c] = mass;
-          mom_L[c] = vel_CC[c] * mass + mom_source[c];
-          int_eng_L[c] = mass*cv[c] * temp_CC[c] + int_eng_source[c];
-        }
+        RowAccessor<const double> rho( rho_CC );
+        RowAccessor<const double> cv_( cv );
+        RowAccessor<const double> temp( temp_CC );
+        RowAccessor<const double> eng_src( int_eng_source );
+        RowAccessor<const Vector> vel( vel_CC );
+        RowAccessor<const Vector> mom_src( mom_source );
+        RowAccessor<double>       massL( mass_L );
+        RowAccessor<Vector>       momL( mom_L );
+        RowAccessor<double>       engL( int_eng_L );
+
+        parallel_for_rows( RowRange( patch->getExtraCellIterator() ),
+                           [&]( int j, int k, int ib, int ie ) {
+          const double* r  = rho.row( j, k );
+          const double* c  = cv_.row( j, k );
+          const double* T  = temp.row( j, k );
+          const double* es = eng_src.row( j, k );
+          const Vector* v  = vel.row( j, k );
+          const Vector* ms = mom_src.row( j, k );
+          double*       mL = massL.row( j, k );
+          Vector*       pL = momL.row( j, k );
+          double*       eL = engL.row( j, k );
+
+          for( int i = ib; i < ie; i++ ) {
+            double mass = r[i] * vol;
+            mL[i] = mass;
+            pL[i] = v[i] * mass + ms[i];
+            eL[i] = mass*c[i] * T[i] + es[i];
+          }
+        });
       }
 
       //__________________________________
@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/MPM/Core/ImpMPMFlags.h>
+#include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Util/DebugStream.h>
 
 using namespace Uintah;
@@ -41,6 +42,8 @@ ImpMPMFlags::ImpMPMFlags(const ProcessorGroup* myworld) : MPMFlags(myworld)
   d_projectHeatSource = false;
 
   d_temp_solve = false;
+  d_solver_preconditioner = "jacobi";
+  d_solver_threads = 1;
   d_interpolateParticleTempToGridEveryStep = true;
 }
 
@@ -78,6 +81,13 @@ ImpMPMFlags::readMPMFlags(ProblemSpecP& ps, Output* dataArchive)
                               d_delT_increase_factor, 2);
   
   mpm_flag_ps->get("solver",d_solver_type);
+  mpm_flag_ps->getWithDefault("solver_preconditioner",
+                              d_solver_preconditioner, "jacobi");
+  mpm_flag_ps->getWithDefault("solver_threads", d_solver_threads, 1);
+  if (d_solver_threads < 1) {
+    throw ProblemSetupException("ERROR: <MPM><solver_threads> must be at least 1",
+                                __FILE__, __LINE__);
+  }
   mpm_flag_ps->get("temperature_solve",d_temp_solve);
   mpm_flag_ps->get("interpolateParticleTempToGridEveryStep",
                   d_interpolateParticleTempToGridEveryStep);
@@ -102,6 +112,8 @@ ImpMPMFlags::outputProblemSpec(ProblemSpecP& ps)
   ps->appendElement("delT_increase_factor",d_delT_increase_factor);
 
   ps->appendElement("solver",d_solver_type);
+  ps->appendElement("solver_preconditioner",d_solver_preconditioner);
+  ps->appendElement("solver_threads",d_solver_threads);
   ps->appendElement("temperature_solve",d_temp_solve);
   ps->appendElement("interpolateParticleTempToGridEveryStep",
                   d_interpolateParticleTempToGridEveryStep);
@@ -63,6 +63,8 @@ namespace Uintah {
     double d_delT_decrease_factor;
     double d_delT_increase_factor;
     std::string d_solver_type;
+    std::string d_solver_preconditioner;   // simple solver only
+    int d_solver_threads;                  // simple solver only
     bool d_temp_solve;
     bool d_interpolateParticleTempToGridEveryStep;
 
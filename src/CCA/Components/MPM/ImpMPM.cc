@@ -252,7 +252,8 @@ ImpMPM::problemSetup( const ProblemSpecP     & prob_spec,
     d_solver = scinew MPMPetscSolver();
   }
   else {
-    d_solver = scinew SimpleSolver();
+    d_solver = scinew SimpleSolver(flags->d_solver_preconditioner,
+                                   flags->d_solver_threads);
   }
 
   d_solver->initialize();
@@ -57,6 +57,7 @@
 #include <Core/Math/MinMax.h>
 #include <Core/Math/Gaussian.h>
 #include <Core/Math/Matrix3.h>
+#include <Core/Math/Matrix3Block.h>
 #include <Core/Math/SymmMatrix3.h>
 #include <Core/Math/FastMatrix.h>
 #include <Core/Math/TangentModulusTensor.h>
@@ -65,6 +66,7 @@
 #include <Core/Util/DebugStream.h>
 
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -95,6 +97,7 @@ ElasticPlasticHP::ElasticPlasticHP(ProblemSpecP& ps,MPMFlags* Mflag)
   ps->getWithDefault("initial_material_temperature",  d_initialMaterialTemperature, 294.0);
   ps->getWithDefault("check_TEPLA_failure_criterion", d_checkTeplaFailureCriterion, true);
   ps->getWithDefault("do_melting",                    d_doMelting,                  true);
+  ps->getWithDefault("use_batched_stress_update",     d_useBatchedUpdate,           false);
   
   // plasticity convergence Algorithm
   d_plasticConvergenceAlgo = "radialReturn";   // default
@@ -257,6 +260,7 @@ void ElasticPlasticHP::outputProblemSpec(ProblemSpecP& ps,bool output_cm_tag)
   cm_ps->appendElement("do_melting",                    d_doMelting);
   cm_ps->appendElement("plastic_convergence_algo",      d_plasticConvergenceAlgo);
   cm_ps->appendElement("compute_specific_heat",         d_computeSpecificHeat);
+  cm_ps->appendElement("use_batched_stress_update",     d_useBatchedUpdate);
 
   d_yield      ->outputProblemSpec(cm_ps);
   d_stable     ->outputProblemSpec(cm_ps);
@@ -698,11 +702,23 @@ ElasticPlasticHP::computeStressTensor(const PatchSubset* patches,
     // Copy localized data to new DW.  Will modify below.
     pLocalized_new.copyData(pLocalized);
 
+    // Evaluate the polar decompositions and the sub-models a block of
+    // particles at a time
+    std::vector<BatchedState> batched;
+    if (d_useBatchedUpdate) {
+      computeBatchedState(pset, matl, delT, pMass, pTemperature,
+                          pPlasticStrain, pPlasticStrainRate, pEnergy,
+                          pVolume_deformed, pStress, pDeformGrad,
+                          pDeformGrad_new, velGrad, batched);
+    }
+
     //______________________________________________________________________
     // Loop thru particles
     ParticleSubset::iterator iter = pset->begin(); 
     for( ; iter != pset->end(); iter++){
       particleIndex idx = *iter;      
+      const BatchedState* pre = d_useBatchedUpdate ?
+                                &batched[iter - pset->begin()] : nullptr;
       
       // Assign zero int. heating by default, modify with appropriate sources
       // This has units (in MKS) of K/s  (i.e. temperature/time)
@@ -741,7 +757,11 @@ ElasticPlasticHP::computeStressTensor(const PatchSubset* patches,
       tensorD = (tensorL + tensorL.Transpose())*0.5;
 
       // Compute polar decomposition of F (F = RU)
-      pDeformGrad[idx].polarDecompositionRMB(tensorU, tensorR);
+      if (pre) {
+        tensorR = pre->rotation;
+      } else {
+        pDeformGrad[idx].polarDecompositionRMB(tensorU, tensorR);
+      }
 
       // Rotate the total rate of deformation tensor back to the 
       // material configuration
@@ -793,17 +813,21 @@ ElasticPlasticHP::computeStressTensor(const PatchSubset* patches,
       state->energy              = pEnergy[idx];
       
       // Get or compute the specific heat
-      if (d_computeSpecificHeat) {
+      if (pre) {
+        state->specificHeat = pre->specificHeat;
+      } else if (d_computeSpecificHeat) {
         double C_p = d_Cp->computeSpecificHeat(state);
         state->specificHeat = C_p;
       }
     
       // Calculate the shear modulus and the melting temperature at the
       // start of the time step and update the plasticity state
-      double Tm_cur = d_melt->computeMeltingTemp(state);
+      double Tm_cur = pre ? pre->meltingTemp
+                          : d_melt->computeMeltingTemp(state);
       state->meltingTemp = Tm_cur ;
       
-      double mu_cur = d_shear->computeShearModulus(state);
+      double mu_cur = pre ? pre->shearModulus
+                          : d_shear->computeShearModulus(state);
       state->shearModulus = mu_cur ;
 
       // compute the local sound wave speed
@@ -833,8 +857,9 @@ ElasticPlasticHP::computeStressTensor(const PatchSubset* patches,
       double equivStress = sqrtThreeTwo*trialS.Norm();
 
       // Calculate flow stress
-      double flowStress = d_flow->computeFlowStress(state, delT, d_tol, 
-                                                    matl, idx);
+      double flowStress = pre ? pre->flowStress
+                              : d_flow->computeFlowStress(state, delT, d_tol, 
+                                                          matl, idx);
       state->yieldStress = flowStress;
 
       // Material has melted if flowStress <= 0.0
@@ -1132,6 +1157,149 @@ ElasticPlasticHP::computeStressTensor(const PatchSubset* patches,
 
 }
 
+//______________________________________________________________________
+//  Batched pre-pass for computeStressTensor.  Reproduces the kinematics
+//  and the PlasticityState set up of the particle loop for a block of
+//  particles, then calls the block versions of the sub-models.
+void
+ElasticPlasticHP::computeBatchedState(ParticleSubset* pset,
+                                      const MPMMaterial* matl,
+                                      const double delT,
+                                      constParticleVariable<double>& pMass,
+                                      constParticleVariable<double>& pTemperature,
+                                      constParticleVariable<double>& pPlasticStrain,
+                                      constParticleVariable<double>& pPlasticStrainRate,
+                                      constParticleVariable<double>& pEnergy,
+                                      constParticleVariable<double>& pVolume_deformed,
+                                      constParticleVariable<Matrix3>& pStress,
+                                      constParticleVariable<Matrix3>& pDeformGrad,
+                                      constParticleVariable<Matrix3>& pDeformGrad_new,
+                                      constParticleVariable<Matrix3>& velGrad,
+                                      std::vector<BatchedState>& batched)
+{
+  const int W = PlasticityStateBlock::width;
+
+  double bulk  = d_initialData.Bulk;
+  double shear = d_initialData.Shear;
+  double rho_0 = matl->getInitialDensity();
+  double Tm    = matl->getMeltTemperature();
+  double Cp    = matl->getSpecificHeat();
+  double sqrtTwoThird = sqrt(2.0/3.0);
+
+  int numParticles = pset->numParticles();
+  batched.resize(numParticles);
+
+  PlasticityStateBlock states;
+  Matrix3Block<W> F, U, R, L, D, S, tmp;
+  double J[W], normD[W], traceS[W];
+  double Tm_cur[W], mu_cur[W], flowStress[W];
+
+  for (int start = 0; start < numParticles; start += W) {
+    int n = std::min(W, numParticles - start);
+    const particleIndex* ids = pset->begin() + start;
+
+    states.size = n;
+    for (int lane = 0; lane < n; lane++) {
+      states.idx[lane] = ids[lane];
+    }
+
+    // Polar decomposition of F_n.  A lane the block iteration cannot
+    // handle goes through the scalar routine, which reports it.
+    F.gather(pDeformGrad, ids, n);
+    if (!polarDecompositionRMB(F, U, R)) {
+      for (int lane = 0; lane < n; lane++) {
+        Matrix3 tensorU, tensorR;
+        pDeformGrad[ids[lane]].polarDecompositionRMB(tensorU, tensorR);
+        R.set(lane, tensorR);
+      }
+    }
+
+    // Rate of deformation, zeroed for particles with a bad Jacobian
+    // exactly as in the particle loop
+    F.gather(pDeformGrad_new, ids, n);
+    determinant(F, J);
+    L.gather(velGrad, ids, n);
+    for (int lane = 0; lane < n; lane++) {
+      if (!(J[lane] > 0.) || J[lane] > 1.e5) {
+        L.set(lane, Matrix3(0.0));
+      }
+    }
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        for (int lane = 0; lane < W; lane++) {
+          D(i,j,lane) = (L(i,j,lane) + L(j,i,lane))*0.5;
+        }
+      }
+    }
+
+    // Rotate D and sigma back to the material configuration
+    multiply(D, R, tmp);
+    transposeMultiply(R, tmp, D);
+    norm(D, normD);
+
+    S.gather(pStress, ids, n);
+    multiply(S, R, tmp);
+    transposeMultiply(R, tmp, S);
+    trace(S, traceS);
+
+    for (int lane = 0; lane < n; lane++) {
+      particleIndex idx = ids[lane];
+      states.strainRate[lane]          = sqrtTwoThird*normD[lane];
+      states.plasticStrainRate[lane]   = pPlasticStrainRate[idx];
+      states.plasticStrain[lane]       = pPlasticStrain[idx]
+                                       + pPlasticStrainRate[idx]*delT;
+      states.pressure[lane]            = traceS[lane]/3.0;
+      states.temperature[lane]         = pTemperature[idx];
+      states.initialTemperature[lane]  = d_initialMaterialTemperature;
+      states.density[lane]             = rho_0/J[lane];
+      states.initialDensity[lane]      = rho_0;
+      states.volume[lane]              = pVolume_deformed[idx];
+      states.initialVolume[lane]       = pMass[idx]/rho_0;
+      states.bulkModulus[lane]         = bulk;
+      states.initialBulkModulus[lane]  = bulk;
+      states.shearModulus[lane]        = shear;
+      states.initialShearModulus[lane] = shear;
+      states.meltingTemp[lane]         = Tm;
+      states.initialMeltTemp[lane]     = Tm;
+      states.specificHeat[lane]        = Cp;
+      states.porosity[lane]            = 0.0;
+      states.energy[lane]              = pEnergy[idx];
+      states.yieldStress[lane]         = 0.0;
+      states.backStress[lane]          = Matrix3(0.0);
+    }
+
+    // There is no block specific heat model; evaluate it per particle
+    if (d_computeSpecificHeat) {
+      PlasticityState state;
+      for (int lane = 0; lane < n; lane++) {
+        states.get(lane, state);
+        states.specificHeat[lane] = d_Cp->computeSpecificHeat(&state);
+      }
+    }
+
+    d_melt->computeMeltingTempBlock(states, Tm_cur);
+    for (int lane = 0; lane < n; lane++) {
+      states.meltingTemp[lane] = Tm_cur[lane];
+    }
+
+    d_shear->computeShearModulusBlock(states, mu_cur);
+    for (int lane = 0; lane < n; lane++) {
+      states.shearModulus[lane] = mu_cur[lane];
+    }
+
+    d_flow->computeFlowStressBlock(states, delT, d_tol, matl, flowStress);
+
+    for (int lane = 0; lane < n; lane++) {
+      BatchedState& pre = batched[start + lane];
+      pre.rotation     = R.get(lane);
+      pre.specificHeat = states.specificHeat[lane];
+      pre.meltingTemp  = Tm_cur[lane];
+      pre.shearModulus = mu_cur[lane];
+      pre.flowStress   = flowStress[lane];
+    }
+  }
+}
+
 //______________________________________________________________________
 //
 bool ElasticPlasticHP::computePlasticStateBiswajit(PlasticityState* state, 
@@ -37,6 +37,7 @@
 #include "PlasticityModels/SpecificHeatModel.h"
 #include "PlasticityModels/DevStressModel.h"
 #include <cmath>
+#include <vector>
 #include <Core/Math/Matrix3.h>
 #include <Core/Math/TangentModulusTensor.h>
 #include <Core/ProblemSpec/ProblemSpecP.h>
@@ -135,6 +136,7 @@ namespace Uintah {
     bool   d_computeSpecificHeat;
     bool   d_checkTeplaFailureCriterion;
     bool   d_doMelting;
+    bool   d_useBatchedUpdate;
 
     std::string  d_plasticConvergenceAlgo;
 
@@ -274,6 +276,39 @@ namespace Uintah {
     virtual double getCompressibility();
 
   protected:
+
+    ////////////////////////////////////////////////////////////////////////
+    /*! \brief Per particle results of the batched pre-pass: the polar
+               rotation of F_n and the sub-model values at t_n+1 */
+    ////////////////////////////////////////////////////////////////////////
+    struct BatchedState {
+      Matrix3 rotation;
+      double  specificHeat;
+      double  meltingTemp;
+      double  shearModulus;
+      double  flowStress;
+    };
+
+    ////////////////////////////////////////////////////////////////////////
+    /*! \brief Evaluate the polar decomposition and the specific heat,
+               melting temperature, shear modulus and flow stress models
+               for blocks of PlasticityStateBlock::width particles.
+               batched[k] holds the result for the k'th particle of pset. */
+    ////////////////////////////////////////////////////////////////////////
+    void computeBatchedState(ParticleSubset* pset,
+                             const MPMMaterial* matl,
+                             const double delT,
+                             constParticleVariable<double>& pMass,
+                             constParticleVariable<double>& pTemperature,
+                             constParticleVariable<double>& pPlasticStrain,
+                             constParticleVariable<double>& pPlasticStrainRate,
+                             constParticleVariable<double>& pEnergy,
+                             constParticleVariable<double>& pVolume_deformed,
+                             constParticleVariable<Matrix3>& pStress,
+                             constParticleVariable<Matrix3>& pDeformGrad,
+                             constParticleVariable<Matrix3>& pDeformGrad_new,
+                             constParticleVariable<Matrix3>& velGrad,
+                             std::vector<BatchedState>& batched);
   
     ////////////////////////////////////////////////////////////////////////
     /*! \brief Compute Plastic State using Biswajit's approach */
@@ -59,3 +59,12 @@ ConstantMeltTemp::computeMeltingTemp(const PlasticityState* state)
   return state->initialMeltTemp;
 }
 
+void
+ConstantMeltTemp::computeMeltingTempBlock(const PlasticityStateBlock& states,
+                                          double* Tm)
+{
+  for (int lane = 0; lane < states.size; lane++) {
+    Tm[lane] = states.initialMeltTemp[lane];
+  }
+}
+
@@ -58,6 +58,10 @@ namespace Uintah {
 
     /*! Compute the melt temp */
     double computeMeltingTemp(const PlasticityState* state);
+
+    /*! Compute the melting temperature of a block of particles */
+    void computeMeltingTempBlock(const PlasticityStateBlock& states,
+                                 double* Tm);
   };
 } // End namespace Uintah
       
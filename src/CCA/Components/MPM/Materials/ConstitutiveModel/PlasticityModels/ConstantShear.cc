@@ -59,3 +59,12 @@ ConstantShear::computeShearModulus(const PlasticityState* state)
   return state->initialShearModulus;
 }
 
+void
+ConstantShear::computeShearModulusBlock(const PlasticityStateBlock& states,
+                                        double* mu)
+{
+  for (int lane = 0; lane < states.size; lane++) {
+    mu[lane] = states.initialShearModulus[lane];
+  }
+}
+
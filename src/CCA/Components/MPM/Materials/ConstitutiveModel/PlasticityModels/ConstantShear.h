@@ -58,6 +58,10 @@ namespace Uintah {
 
     /*! Compute the shear modulus */
     double computeShearModulus(const PlasticityState* state);
+
+    /*! Compute the shear modulus of a block of particles */
+    void computeShearModulusBlock(const PlasticityStateBlock& states,
+                                  double* mu);
   };
 } // End namespace Uintah
       
@@ -34,3 +34,18 @@ FlowModel::FlowModel()
 FlowModel::~FlowModel()
 {
 }
+
+void
+FlowModel::computeFlowStressBlock(const PlasticityStateBlock& states,
+                                  const double& delT,
+                                  const double& tolerance,
+                                  const MPMMaterial* matl,
+                                  double* flowStress)
+{
+  PlasticityState state;
+  for (int lane = 0; lane < states.size; lane++) {
+    states.get(lane, state);
+    flowStress[lane] = computeFlowStress(&state, delT, tolerance, matl,
+                                         states.idx[lane]);
+  }
+}
@@ -34,6 +34,7 @@
 #include <Core/Math/TangentModulusTensor.h>
 #include <CCA/Components/MPM/Materials/MPMMaterial.h>
 #include "PlasticityState.h"
+#include "PlasticityStateBlock.h"
 
 
 namespace Uintah {
@@ -115,6 +116,20 @@ namespace Uintah {
                                      const double& tolerance,
                                      const MPMMaterial* matl,
                                      const particleIndex idx) = 0;
+
+    //////////
+    /*! \brief Calculate the flow stress of each lane of a block of
+               particles.
+
+        The default evaluates computeFlowStress() lane by lane, which
+        is the reference result.  Models override it with a vectorized
+        version. */
+    //////////
+    virtual void computeFlowStressBlock(const PlasticityStateBlock& states,
+                                        const double& delT,
+                                        const double& tolerance,
+                                        const MPMMaterial* matl,
+                                        double* flowStress);
  
     //////////
     /*! \brief Calculate the plastic strain rate [epdot(tau,ep,T)] */
@@ -209,6 +209,18 @@ IsoHardeningFlow::computeFlowStress(const PlasticityState* state,
   return flowStress;
 }
 
+void
+IsoHardeningFlow::computeFlowStressBlock(const PlasticityStateBlock& states,
+                                         const double& ,
+                                         const double& ,
+                                         const MPMMaterial* ,
+                                         double* flowStress)
+{
+  for (int lane = 0; lane < states.size; lane++) {
+    flowStress[lane] = d_CM.sigma_0 + d_CM.K*states.plasticStrain[lane];
+  }
+}
+
 double 
 IsoHardeningFlow::computeEpdot(const PlasticityState* state,
                                   const double& ,
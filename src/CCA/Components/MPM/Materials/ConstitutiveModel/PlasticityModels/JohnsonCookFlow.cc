@@ -203,6 +203,44 @@ JohnsonCookFlow::computeFlowStress(const PlasticityState* state,
   return sigy;
 }
 
+void
+JohnsonCookFlow::computeFlowStressBlock(const PlasticityStateBlock& states,
+                                        const double& ,
+                                        const double& ,
+                                        const MPMMaterial* ,
+                                        double* flowStress)
+{
+  const int    n  = states.size;
+  const double Tr = d_CM.TRoom;
+  const double Tm = d_CM.TMelt;
+  const double m  = d_CM.m;
+
+  // Same expression as computeFlowStress with the branches written as
+  // selects so the lane loop vectorizes
+  for (int lane = 0; lane < n; lane++) {
+    double epdot = states.strainRate[lane]/d_CM.epdot_0;
+    double ep    = states.plasticStrain[lane];
+    double T     = states.temperature[lane];
+
+    double strainPart     = d_CM.A + d_CM.B*pow(ep,d_CM.n);
+    double strainRatePart = (epdot < 1.0) ? pow((1.0 + epdot),d_CM.C)
+                                          : 1.0 + d_CM.C*log(epdot);
+    double Tstar    = (T > Tm) ? 1.0 : ((T-Tr)/(Tm-Tr));
+    double tempPart = (Tstar < 0.0) ? (1.0 - Tstar) : (1.0-pow(Tstar,m));
+    flowStress[lane] = strainPart*strainRatePart*tempPart;
+  }
+
+  for (int lane = 0; lane < n; lane++) {
+    if (std::isnan(flowStress[lane])) {
+      cout << "**ERROR** JohnsonCook: sig_y == nan " 
+           << " Particle = " << states.idx[lane]
+           << " epdot = " << states.strainRate[lane]/d_CM.epdot_0
+           << " ep = " << states.plasticStrain[lane]
+           << " T = " << states.temperature[lane] << endl; 
+    }
+  }
+}
+
 double 
 JohnsonCookFlow::computeEpdot(const PlasticityState* state,
                                  const double& ,
@@ -150,6 +150,15 @@ namespace Uintah {
                                      const MPMMaterial* matl,
                                      const particleIndex idx);
 
+    ///////////////////////////////////////////////////////////////////////////
+    /*! \brief  compute the flow stress of a block of particles */
+    ///////////////////////////////////////////////////////////////////////////
+    virtual void computeFlowStressBlock(const PlasticityStateBlock& states,
+                                        const double& delT,
+                                        const double& tolerance,
+                                        const MPMMaterial* matl,
+                                        double* flowStress);
+
     //////////
     /*! \brief Calculate the plastic strain rate [epdot(tau,ep,T)] */
     //////////
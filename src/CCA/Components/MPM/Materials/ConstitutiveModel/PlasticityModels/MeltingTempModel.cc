@@ -34,4 +34,15 @@ MeltingTempModel::MeltingTempModel()
 MeltingTempModel::~MeltingTempModel()
 {
 }
+
+void
+MeltingTempModel::computeMeltingTempBlock(const PlasticityStateBlock& states,
+                                          double* Tm)
+{
+  PlasticityState state;
+  for (int lane = 0; lane < states.size; lane++) {
+    states.get(lane, state);
+    Tm[lane] = computeMeltingTemp(&state);
+  }
+}
          
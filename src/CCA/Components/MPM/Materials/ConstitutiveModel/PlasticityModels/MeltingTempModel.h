@@ -26,6 +26,7 @@
 #define __MELTING_TEMP_MODEL_H__
 
 #include "PlasticityState.h"
+#include "PlasticityStateBlock.h"
 #include <Core/ProblemSpec/ProblemSpecP.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 
@@ -61,6 +62,16 @@ namespace Uintah {
     /////////////////////////////////////////////////////////////////////////
     virtual double computeMeltingTemp(const PlasticityState* state) = 0;
 
+    /////////////////////////////////////////////////////////////////////////
+    /*! 
+      \brief Compute the melting temperature of each lane of a block of
+             particles.  The default evaluates the scalar model lane by
+             lane; models override it with a vectorized version.
+    */
+    /////////////////////////////////////////////////////////////////////////
+    virtual void computeMeltingTempBlock(const PlasticityStateBlock& states,
+                                         double* Tm);
+
   };
 } // End namespace Uintah
       
@@ -0,0 +1,131 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef __PLASTICITY_STATE_BLOCK_H__
+#define __PLASTICITY_STATE_BLOCK_H__
+
+#include "PlasticityState.h"
+#include <Core/Grid/Variables/ParticleSubset.h>
+
+namespace Uintah {
+
+  /////////////////////////////////////////////////////////////////////////////
+  /*!
+    \class PlasticityStateBlock
+    \brief The plasticity state of a block of particles stored as a
+           structure of arrays.
+
+    Used by the batched sub-model interfaces (e.g.
+    FlowModel::computeFlowStressBlock) so that a model can evaluate all
+    the lanes of a block in one call with loops the compiler vectorizes.
+    Only the first \c size lanes hold particles; idx[] gives their
+    particle indices for models that keep internal variables.
+  */
+  /////////////////////////////////////////////////////////////////////////////
+
+  class PlasticityStateBlock {
+
+  public:
+    static const int width = 8;
+
+    int           size {0};
+    particleIndex idx[width];
+
+    double yieldStress[width];
+    double strainRate[width];
+    double plasticStrainRate[width];
+    double plasticStrain[width];
+    double pressure[width];
+    double temperature[width];
+    double initialTemperature[width];
+    double density[width];
+    double initialDensity[width];
+    double volume[width];
+    double initialVolume[width];
+    double bulkModulus[width];
+    double initialBulkModulus[width];
+    double shearModulus[width];
+    double initialShearModulus[width];
+    double meltingTemp[width];
+    double initialMeltTemp[width];
+    double specificHeat[width];
+    double porosity[width];
+    double energy[width];
+    Matrix3 backStress[width];
+
+    inline void set(int lane, const PlasticityState& state)
+    {
+      yieldStress[lane]         = state.yieldStress;
+      strainRate[lane]          = state.strainRate;
+      plasticStrainRate[lane]   = state.plasticStrainRate;
+      plasticStrain[lane]       = state.plasticStrain;
+      pressure[lane]            = state.pressure;
+      temperature[lane]         = state.temperature;
+      initialTemperature[lane]  = state.initialTemperature;
+      density[lane]             = state.density;
+      initialDensity[lane]      = state.initialDensity;
+      volume[lane]              = state.volume;
+      initialVolume[lane]       = state.initialVolume;
+      bulkModulus[lane]         = state.bulkModulus;
+      initialBulkModulus[lane]  = state.initialBulkModulus;
+      shearModulus[lane]        = state.shearModulus;
+      initialShearModulus[lane] = state.initialShearModulus;
+      meltingTemp[lane]         = state.meltingTemp;
+      initialMeltTemp[lane]     = state.initialMeltTemp;
+      specificHeat[lane]        = state.specificHeat;
+      porosity[lane]            = state.porosity;
+      energy[lane]              = state.energy;
+      backStress[lane]          = state.backStress;
+    }
+
+    inline void get(int lane, PlasticityState& state) const
+    {
+      state.yieldStress         = yieldStress[lane];
+      state.strainRate          = strainRate[lane];
+      state.plasticStrainRate   = plasticStrainRate[lane];
+      state.plasticStrain       = plasticStrain[lane];
+      state.pressure            = pressure[lane];
+      state.temperature         = temperature[lane];
+      state.initialTemperature  = initialTemperature[lane];
+      state.density             = density[lane];
+      state.initialDensity      = initialDensity[lane];
+      state.volume              = volume[lane];
+      state.initialVolume       = initialVolume[lane];
+      state.bulkModulus         = bulkModulus[lane];
+      state.initialBulkModulus  = initialBulkModulus[lane];
+      state.shearModulus        = shearModulus[lane];
+      state.initialShearModulus = initialShearModulus[lane];
+      state.meltingTemp         = meltingTemp[lane];
+      state.initialMeltTemp     = initialMeltTemp[lane];
+      state.specificHeat        = specificHeat[lane];
+      state.porosity            = porosity[lane];
+      state.energy              = energy[lane];
+      state.backStress          = backStress[lane];
+    }
+  };
+
+} // End namespace Uintah
+
+#endif  // __PLASTICITY_STATE_BLOCK_H__
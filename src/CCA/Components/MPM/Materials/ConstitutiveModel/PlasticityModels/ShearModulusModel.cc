@@ -34,4 +34,15 @@ ShearModulusModel::ShearModulusModel()
 ShearModulusModel::~ShearModulusModel()
 {
 }
+
+void
+ShearModulusModel::computeShearModulusBlock(const PlasticityStateBlock& states,
+                                            double* mu)
+{
+  PlasticityState state;
+  for (int lane = 0; lane < states.size; lane++) {
+    states.get(lane, state);
+    mu[lane] = computeShearModulus(&state);
+  }
+}
          
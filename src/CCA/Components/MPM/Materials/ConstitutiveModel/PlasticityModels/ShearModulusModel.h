@@ -26,6 +26,7 @@
 #define __SHEAR_MODULUS_MODEL_H__
 
 #include "PlasticityState.h"
+#include "PlasticityStateBlock.h"
 #include <Core/ProblemSpec/ProblemSpecP.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 
@@ -59,6 +60,16 @@ namespace Uintah {
     */
     /////////////////////////////////////////////////////////////////////////
     virtual double computeShearModulus(const PlasticityState* state) = 0;
+
+    /////////////////////////////////////////////////////////////////////////
+    /*! 
+      \brief Compute the shear modulus of each lane of a block of
+             particles.  The default evaluates the scalar model lane by
+             lane; models override it with a vectorized version.
+    */
+    /////////////////////////////////////////////////////////////////////////
+    virtual void computeShearModulusBlock(const PlasticityStateBlock& states,
+                                          double* mu);
   };
 } // End namespace Uintah
       
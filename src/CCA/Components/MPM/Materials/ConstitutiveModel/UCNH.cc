@@ -37,6 +37,7 @@
 #include <Core/Grid/Variables/VarTypes.h>
 #include <CCA/Components/MPM/Core/MPMLabel.h>
 #include <Core/Math/Matrix3.h>
+#include <Core/Math/Matrix3Block.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <Core/Exceptions/ParameterNotFound.h>
 #include <Core/Exceptions/InvalidValue.h>
@@ -46,6 +47,7 @@
 #include <Core/Math/Weibull.h>
 #include <Core/Malloc/Allocator.h>
 
+#include <algorithm>
 #include <iostream>
 
 #include <unistd.h>
@@ -85,6 +87,7 @@ UCNH::UCNH(ProblemSpecP& ps, MPMFlags* Mflag, bool plas, bool dam)
   // Fix: Need to make it more general.  Add gravity turn-on option and
   //      read from file option etc.
   ps->getWithDefault("useInitialStress", d_useInitialStress, false);
+  ps->getWithDefault("use_batched_stress_update", d_useBatchedUpdate, false);
   d_init_pressure = 0.0;
   if (d_useInitialStress) {
     ps->getWithDefault("initial_pressure", d_init_pressure, 0.0);
@@ -161,6 +164,7 @@ void UCNH::outputProblemSpec(ProblemSpecP& ps, bool output_cm_tag)
     }
   }
   cm_ps->appendElement("useInitialStress",         d_useInitialStress);
+  cm_ps->appendElement("use_batched_stress_update", d_useBatchedUpdate);
 
   if (d_useInitialStress) {
     cm_ps->appendElement("initial_pressure", d_init_pressure);
@@ -550,6 +554,179 @@ void UCNH::computeStableTimeStep(const Patch* patch,
   double delT_new = WaveSpeed.minComponent();
   new_dw->put(delt_vartype(delT_new), lb->delTLabel, patch->getLevel());
 }
+//______________________________________________________________________
+//  Stress and bElBar update for one particle
+void UCNH::updateStress(const StressParams& params,
+                        const Matrix3& defGrad,
+                        const Matrix3& defGrad_new,
+                        const Matrix3& bElBar,
+                        const double flow,
+                        double& alpha,
+                        double& J,
+                        Matrix3& bElBar_new,
+                        Matrix3& stress)
+{
+  // Constants
+  double onethird = (1.0/3.0), sqtwthds = sqrt(2.0/3.0);
+  Matrix3 Identity; Identity.Identity();
+
+  double shear = params.shear;
+  double K     = params.K;
+
+  Matrix3 pDefGradInc = defGrad_new*defGrad.Inverse();
+  double Jinc = pDefGradInc.Determinant();
+
+  // 1) Get the volumetric part of the deformation
+  J = defGrad_new.Determinant();
+
+  // Get the volume preserving part of the deformation gradient increment
+  Matrix3 fBar = pDefGradInc/cbrt(Jinc);
+
+  // Compute the trial elastic part of the volume preserving
+  // part of the left Cauchy-Green deformation tensor
+  Matrix3 bElBarTrial = fBar*bElBar*fBar.Transpose();
+  if(!params.usePlasticity){
+    double cubeRootJ      = cbrt(J);
+    double Jtothetwothirds= cubeRootJ*cubeRootJ;
+    bElBarTrial           = defGrad_new*defGrad_new.Transpose()
+                             /Jtothetwothirds;
+  }
+  double IEl   = onethird*bElBarTrial.Trace();
+  double muBar = IEl*shear;
+
+  // tauDevTrial is equal to the shear modulus times dev(bElBar)
+  // Compute ||tauDevTrial||
+  Matrix3 tauDevTrial = (bElBarTrial - Identity*IEl)*shear;
+  double sTnorm       = tauDevTrial.Norm();
+
+  // Check for plastic loading
+  double fTrial = 0.0;
+  if(params.usePlasticity) {
+    fTrial = sTnorm - sqtwthds*(K*alpha + flow);
+  }
+
+  Matrix3 tauDev;
+  if (params.usePlasticity && (fTrial > 0.0) ) {
+    // plastic
+    // Compute increment of slip in the direction of flow
+    double delgamma = (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar)));
+    Matrix3 normal  = tauDevTrial/sTnorm;
+
+    // The actual shear stress
+    tauDev = tauDevTrial - normal*2.0*muBar*delgamma;
+
+    // Deal with history variables
+    alpha      = alpha + sqtwthds*delgamma;
+    bElBar_new = tauDev/shear + Identity*IEl;
+  } else {
+    // The actual shear stress
+    tauDev     = tauDevTrial;
+    bElBar_new = bElBarTrial;
+  }
+
+  // get the hydrostatic part of the stress
+  double p = 0.5*params.bulk*(J - 1.0/J);
+
+  // compute the total stress (volumetric + deviatoric)
+  stress = Identity*p + tauDev/J;
+}
+
+//______________________________________________________________________
+//  updateStress for a block of particles.  The plastic return is
+//  applied through a per lane scale factor so there is no branch in
+//  the lane loops.
+void UCNH::updateStressBlock(const StressParams& params,
+                             const Matrix3Block<blockWidth>& defGrad,
+                             const Matrix3Block<blockWidth>& defGrad_new,
+                             const Matrix3Block<blockWidth>& bElBar,
+                             const double* flow,
+                             double* alpha,
+                             double* J,
+                             Matrix3Block<blockWidth>& bElBar_new,
+                             Matrix3Block<blockWidth>& stress)
+{
+  const int W = blockWidth;
+  double onethird = (1.0/3.0), sqtwthds = sqrt(2.0/3.0);
+
+  double shear = params.shear;
+  double K     = params.K;
+
+  Matrix3Block<W> defGradInv, tmp, bElBarTrial;
+  double det[W], IEl[W], sTnorm[W], scale[W];
+  bool   plastic[W];
+
+  determinant(defGrad_new, J);
+
+  if (params.usePlasticity) {
+    // fBar = F_inc/cbrt(J_inc), bElBarTrial = fBar*bElBar*fBar^T
+    Matrix3Block<W> fBar;
+    inverse(defGrad, defGradInv, det);
+    multiply(defGrad_new, defGradInv, fBar);
+    determinant(fBar, det);
+    for (int k = 0; k < 9; k++) {
+      double* f = fBar.component(k);
+      for (int l = 0; l < W; l++) {
+        f[l] /= cbrt(det[l]);
+      }
+    }
+    multiply(fBar, bElBar, tmp);
+    multiplyTranspose(tmp, fBar, bElBarTrial);
+  } else {
+    // bElBarTrial = F*F^T/J^(2/3)
+    multiplyTranspose(defGrad_new, defGrad_new, bElBarTrial);
+    for (int l = 0; l < W; l++) {
+      double cubeRootJ = cbrt(J[l]);
+      det[l] = cubeRootJ*cubeRootJ;
+    }
+    for (int k = 0; k < 9; k++) {
+      double* b = bElBarTrial.component(k);
+      for (int l = 0; l < W; l++) {
+        b[l] /= det[l];
+      }
+    }
+  }
+
+  // tauDevTrial = shear*dev(bElBarTrial), kept in tmp
+  trace(bElBarTrial, IEl);
+  for (int l = 0; l < W; l++) {
+    IEl[l] *= onethird;
+  }
+  for (int k = 0; k < 9; k++) {
+    const double delta = (k % 4 == 0) ? 1.0 : 0.0;
+    const double* b = bElBarTrial.component(k);
+    double* t = tmp.component(k);
+    for (int l = 0; l < W; l++) {
+      t[l] = (b[l] - delta*IEl[l])*shear;
+    }
+  }
+  norm(tmp, sTnorm);
+
+  // Radial return: tauDev = scale*tauDevTrial
+  for (int l = 0; l < W; l++) {
+    double muBar    = IEl[l]*shear;
+    double fTrial   = sTnorm[l] - sqtwthds*(K*alpha[l] + flow[l]);
+    plastic[l]      = params.usePlasticity && (fTrial > 0.0);
+    double delgamma = plastic[l] ?
+                      (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar))) : 0.0;
+    scale[l]        = plastic[l] ? 1.0 - 2.0*muBar*delgamma/sTnorm[l] : 1.0;
+    alpha[l]       += sqtwthds*delgamma;
+  }
+
+  for (int k = 0; k < 9; k++) {
+    const double delta = (k % 4 == 0) ? 1.0 : 0.0;
+    const double* b = bElBarTrial.component(k);
+    const double* t = tmp.component(k);
+    double* bn = bElBar_new.component(k);
+    double* sg = stress.component(k);
+    for (int l = 0; l < W; l++) {
+      double tauDev = t[l]*scale[l];
+      double p      = 0.5*params.bulk*(J[l] - 1.0/J[l]);
+      bn[l] = plastic[l] ? tauDev/shear + delta*IEl[l] : b[l];
+      sg[l] = delta*p + tauDev/J[l];
+    }
+  }
+}
+
 //______________________________________________________________________
 //
 void UCNH::computeStressTensor(const PatchSubset* patches,
@@ -557,16 +734,16 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
                                 DataWarehouse* old_dw,
                                 DataWarehouse* new_dw)
 {
-  // Constants
-  double onethird = (1.0/3.0), sqtwthds = sqrt(2.0/3.0);
-  Matrix3 Identity; Identity.Identity();
-
   // Grab initial data
   double shear    = d_initialData.tauDev;
   double bulk     = d_initialData.Bulk;
   double rho_orig = matl->getInitialDensity();
-  double flow     = 0.0;
-  double K        = 0.0;
+
+  StressParams params;
+  params.bulk          = bulk;
+  params.shear         = shear;
+  params.K             = d_usePlasticity ? d_initialData.K : 0.0;
+  params.usePlasticity = d_usePlasticity;
 
   Ghost::GhostType  gan = Ghost::AroundNodes;
 
@@ -575,14 +752,11 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
     const Patch* patch = patches->get(pp);
 
     // Temporary and "get" variables
-    double delgamma = 0.0, fTrial = 0.0, IEl = 0.0, J = 0.0, Jinc = 0.0;
-    double muBar = 0.0, p = 0.0, sTnorm = 0.0, U = 0.0, W = 0.0;
+    double J = 0.0;
+    double U = 0.0, W = 0.0;
     double se=0.0;     // Strain energy placeholder
     double c_dil=0.0;  // Speed of sound
 
-    Matrix3 pBBar_new(0.0), bEB_new(0.0), bElBarTrial(0.0), pDefGradInc(0.0);
-    Matrix3 fBar(0.0), defGrad(0.0), normal(0.0);
-    Matrix3 tauDev(0.0), tauDevTrial(0.0);
     Vector WaveSpeed(1.e-12,1.e-12,1.e-12);
 
     // Get particle info and patch info
@@ -621,10 +795,6 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
 
       pPlasticStrain.copyData(pPlasticStrain_old);
       pYieldStress.copyData(pYieldStress_old);
-
-      // Copy initial data
-      flow  = d_initialData.FlowStress;
-      K     = d_initialData.K;
     }
 
     // Universal Gets
@@ -643,23 +813,65 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
     new_dw->allocateAndPut(pdTdt,       lb->pdTdtLabel,            pset);
     new_dw->allocateAndPut(p_q,         lb->p_qLabel_preReloc,     pset);
 
+    // Jacobian of the new deformation gradient of each particle in pset
+    int numParticles = pset->numParticles();
+    std::vector<double> pJ(numParticles);
+
+    if (d_useBatchedUpdate) {
+      const int BW = blockWidth;
+      Matrix3Block<BW> F, F_new, b, b_new, sig;
+      double flow[BW], alpha[BW], Jb[BW];
+
+      for (int start = 0; start < numParticles; start += BW) {
+        int n = std::min(BW, numParticles - start);
+        const particleIndex* ids = pset->begin() + start;
+
+        F.gather(pDefGrad,         ids, n);
+        F_new.gather(pDefGrad_new, ids, n);
+        b.gather(bElBar,           ids, n);
+        for (int l = 0; l < BW; l++) {
+          flow[l]  = (d_usePlasticity && l < n) ? pYieldStress[ids[l]]   : 0.0;
+          alpha[l] = (d_usePlasticity && l < n) ? pPlasticStrain[ids[l]] : 0.0;
+        }
+
+        updateStressBlock(params, F, F_new, b, flow, alpha, Jb, b_new, sig);
+
+        b_new.scatter(bElBar_new, ids, n);
+        sig.scatter(pStress, ids, n);
+        for (int l = 0; l < n; l++) {
+          pJ[start + l] = Jb[l];
+          if (d_usePlasticity) {
+            pPlasticStrain[ids[l]] = alpha[l];
+          }
+        }
+      }
+    }
+
     ParticleSubset::iterator iter = pset->begin();
     for(; iter != pset->end(); iter++){
       particleIndex idx = *iter;
       // Assign zero internal heating by default - modify if necessary.
       pdTdt[idx] = 0.0;
 
-      pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
-      Jinc    = pDefGradInc.Determinant();
-      defGrad = pDefGrad_new[idx];
+      // Compute the stress and bElBar
+      double& Jp = pJ[iter - pset->begin()];
+      if (!d_useBatchedUpdate) {
+        double flow  = d_usePlasticity ? pYieldStress[idx]   : 0.0;
+        double alpha = d_usePlasticity ? pPlasticStrain[idx] : 0.0;
+        updateStress(params, pDefGrad[idx], pDefGrad_new[idx], bElBar[idx],
+                     flow, alpha, Jp, bElBar_new[idx], pStress[idx]);
+        if (d_usePlasticity) {
+          pPlasticStrain[idx] = alpha;
+        }
+      }
 
-      // 1) Get the volumetric part of the deformation
-      // 2) Compute the deformed volume and new density
-      J               = defGrad.Determinant();
+      // Compute the deformed volume and new density
+      J               = Jp;
       double rho_cur  = rho_orig/J;
 
       // Check 1: Look at Jacobian
       if (!(J > 0.0)) {
+        Matrix3 pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
         cerr << "matl = "  << dwi              << endl;
         cerr << "F_old = " << pDefGrad[idx]     << endl;
         cerr << "F_inc = " << pDefGradInc       << endl;
@@ -675,57 +887,6 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
                             __FILE__, __LINE__);
       }
 
-      // Get the volume preserving part of the deformation gradient increment
-      fBar = pDefGradInc/cbrt(Jinc);
-
-      // Compute the trial elastic part of the volume preserving
-      // part of the left Cauchy-Green deformation tensor
-      bElBarTrial = fBar*bElBar[idx]*fBar.Transpose();
-      if(!d_usePlasticity){
-        double cubeRootJ      = cbrt(J);
-        double Jtothetwothirds= cubeRootJ*cubeRootJ;
-        bElBarTrial           = pDefGrad_new[idx]* pDefGrad_new[idx].Transpose()
-                                 /Jtothetwothirds;
-      }
-      IEl   = onethird*bElBarTrial.Trace();
-      muBar = IEl*shear;
-
-      // tauDevTrial is equal to the shear modulus times dev(bElBar)
-      // Compute ||tauDevTrial||
-      tauDevTrial = (bElBarTrial - Identity*IEl)*shear;
-      sTnorm      = tauDevTrial.Norm();
-
-      // Check for plastic loading
-      double alpha;
-      if(d_usePlasticity) {
-        flow = pYieldStress[idx];
-        alpha  = pPlasticStrain[idx];
-        fTrial = sTnorm - sqtwthds*(K*alpha + flow);
-      }
-      if (d_usePlasticity && (fTrial > 0.0) ) {
-        // plastic
-        // Compute increment of slip in the direction of flow
-        delgamma = (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar)));
-        normal   = tauDevTrial/sTnorm;
-
-        // The actual shear stress
-        tauDev = tauDevTrial - normal*2.0*muBar*delgamma;
-
-        // Deal with history variables
-        pPlasticStrain[idx] = alpha + sqtwthds*delgamma;
-        bElBar_new[idx]     = tauDev/shear + Identity*IEl;
-      } else {
-        // The actual shear stress
-        tauDev          = tauDevTrial;
-        bElBar_new[idx] = bElBarTrial;
-      }
-
-      // get the hydrostatic part of the stress
-      p = 0.5*bulk*(J - 1.0/J);
-
-      // compute the total stress (volumetric + deviatoric)
-      pStress[idx] = Identity*p + tauDev/J;
-
       //__________________________________
       // Compute the strain energy for non-localized particles
       // Note this calculation is lagging by a timestep.
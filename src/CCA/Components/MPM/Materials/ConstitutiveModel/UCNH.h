@@ -57,6 +57,7 @@ namespace Uintah {
 #include <CCA/Ports/DataWarehouseP.h>
 #include <Core/Disclosure/TypeDescription.h>
 #include <Core/Math/Matrix3.h>
+#include <Core/Math/Matrix3Block.h>
 #include <cmath>
 #include <vector>
 
@@ -125,6 +126,9 @@ namespace Uintah {
     bool d_useInitialStress;
     double d_init_pressure;  // Initial pressure
 
+    // Update blocks of particles with updateStressBlock
+    bool d_useBatchedUpdate;
+
     // Model factories
     //bool d_useEOSFactory;
     MPMEquationOfState* d_eos;
@@ -248,6 +252,44 @@ namespace Uintah {
 
     void createPlasticityLabels();
 
+  public:
+    //__________________________________
+    //  Explicit stress update kernels.  computeStressTensor uses
+    //  updateStress per particle (the reference) or, with
+    //  use_batched_stress_update, updateStressBlock on blocks of
+    //  blockWidth particles.  Both are static so the stress update
+    //  benchmark can drive them without a data warehouse.
+    struct StressParams {
+      double bulk;
+      double shear;
+      double K;               // hardening modulus
+      bool   usePlasticity;
+    };
+
+    static const int blockWidth = 8;
+
+    // flow and alpha are the yield stress and plastic strain (alpha is
+    // updated); J is det(F_new)
+    static void updateStress(const StressParams& params,
+                             const Matrix3& defGrad,
+                             const Matrix3& defGrad_new,
+                             const Matrix3& bElBar,
+                             const double flow,
+                             double& alpha,
+                             double& J,
+                             Matrix3& bElBar_new,
+                             Matrix3& stress);
+
+    static void updateStressBlock(const StressParams& params,
+                                  const Matrix3Block<blockWidth>& defGrad,
+                                  const Matrix3Block<blockWidth>& defGrad_new,
+                                  const Matrix3Block<blockWidth>& bElBar,
+                                  const double* flow,
+                                  double* alpha,
+                                  double* J,
+                                  Matrix3Block<blockWidth>& bElBar_new,
+                                  Matrix3Block<blockWidth>& stress);
+
   protected:
     // compute stress at each particle in the patch
     void computeStressTensorImplicit(const PatchSubset* patches,
@@ -45,10 +45,14 @@
 #include <Core/GeometryPiece/GeometryObject.h>
 #include <Core/GeometryPiece/GeometryPiece.h>
 #include <Core/GeometryPiece/SmoothGeomPiece.h>
+#include <Core/GeometryPiece/TriGeometryPiece.h>
 #include <Core/Grid/Box.h>
 #include <Core/Grid/Variables/CellIterator.h>
 #include <Core/Grid/Patch.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ThreadExecutor.h>
 
+#include <exception>
 #include <iostream>
 
 /*  This code is a bit tough to follow.  Here's the basic order of operations.
@@ -77,6 +81,9 @@ and then depending on how many points are prescribed in the <res> tag in the
 input file, loops over each of the candidate locations in that cell, and
 determines if that point is inside or outside of the cell.  Points that are
 inside the object are pushed back into the struct, as described above.  The
+cells are visited in blocks, which are spread over the -nthreads threads, and
+for TriGeometryPieces whole blocks away from the surface are classified with
+a single inside test.  The
 actual particle count comes from an operation in countAndCreateParticles
 to determine the size of the object_points entry in the ObjectVars struct.
 
@@ -625,42 +632,140 @@ void ParticleCreator::createPoints(const Patch* patch, GeometryObject* obj,
   if(hasFiner){
     fineLevel = (Level*) curLevel->getFinerLevel().get_rep();
   }
-  for(CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
-    Point lower = patch->nodePosition(*iter) + dcorner;
-    IntVector c = *iter;
-    
-    if(hasFiner){ // Don't create particles if a finer level exists here
-      const Point CC = patch->cellPosition(c);
-      bool includeExtraCells=false;
-      const Patch* patchExists = fineLevel->getPatchFromPoint(CC,
-                                                             includeExtraCells);
-      if(patchExists != 0){
-       continue;
+
+  // Triangulated surfaces are classified a block of cells at a time.  A
+  // block that the surface does not touch lies entirely inside or entirely
+  // outside of it, so one point decides for all of its candidates.  The
+  // points of the remaining blocks are traced as ray packets.
+  TriGeometryPiece* tgp = dynamic_cast<TriGeometryPiece*>(piece.get_rep());
+
+  const IntVector lowIdx  = patch->getCellLowIndex();
+  const IntVector highIdx = patch->getCellHighIndex();
+  const IntVector blockSize(4,4,4);   // cells per block
+
+  vector<IntVector> blocks;
+  for(int k = lowIdx.z(); k < highIdx.z(); k += blockSize.z()){
+    for(int j = lowIdx.y(); j < highIdx.y(); j += blockSize.y()){
+      for(int i = lowIdx.x(); i < highIdx.x(); i += blockSize.x()){
+        blocks.push_back(IntVector(i,j,k));
       }
     }
+  }
 
-    for(int ix=0;ix < ppc.x(); ix++){
-      for(int iy=0;iy < ppc.y(); iy++){
-        for(int iz=0;iz < ppc.z(); iz++){
-        
-          IntVector idx(ix, iy, iz);
-          Point p = lower + dxpp*idx;
-          if (!b2.contains(p)){
-            throw InternalError("Particle created outside of patch?",
-                                 __FILE__, __LINE__);
-          }
-          if (piece->inside(p,true)){ 
-            Vector p1(p(0),p(1),p(2));
-            p1=affineTrans_A*p1+affineTrans_b;
-            p(0)=p1[0];
-            p(1)=p1[1];
-            p(2)=p1[2];
-            vars.d_object_points[obj].push_back(p);
-          }
-        }  // z
-      }  // y
-    }  // x
-  }  // CellIterator
+  // Every block fills its own list of points, so no locking is needed, and
+  // records where the points of each of its cells end.  The points are
+  // gathered below in the patch's cell order and, within a cell, in the
+  // ix, iy, iz order.  The particle order and IDs are therefore the same as
+  // with a single loop over the cells, whatever the number of threads.
+  vector< vector<Point> > blockPoints(blocks.size());
+  vector< vector<int> >   blockCellEnd(blocks.size());
+
+  auto fillBlock = [&](int b) {
+    const IntVector blockLow  = blocks[b];
+    const IntVector blockHigh = Min(blockLow + blockSize, highIdx);
+
+    vector<Point> candidates;
+    vector<int>   cellStart;      // first candidate of each cell
+    Point cmin( 1e30, 1e30, 1e30);
+    Point cmax(-1e30,-1e30,-1e30);
+
+    for(CellIterator iter(blockLow, blockHigh); !iter.done(); iter++){
+      IntVector c = *iter;
+      Point lower = patch->nodePosition(c) + dcorner;
+      cellStart.push_back(candidates.size());
+
+      if(hasFiner){ // Don't create particles if a finer level exists here
+        const Point CC = patch->cellPosition(c);
+        bool includeExtraCells=false;
+        const Patch* patchExists = fineLevel->getPatchFromPoint(CC,
+                                                               includeExtraCells);
+        if(patchExists != 0){
+         continue;
+        }
+      }
+
+      for(int ix=0;ix < ppc.x(); ix++){
+        for(int iy=0;iy < ppc.y(); iy++){
+          for(int iz=0;iz < ppc.z(); iz++){
+
+            IntVector idx(ix, iy, iz);
+            Point p = lower + dxpp*idx;
+            if (!b2.contains(p)){
+              throw InternalError("Particle created outside of patch?",
+                                   __FILE__, __LINE__);
+            }
+            candidates.push_back(p);
+            cmin = Min(cmin, p);
+            cmax = Max(cmax, p);
+          }  // z
+        }  // y
+      }  // x
+    }  // CellIterator
+
+    const int n = candidates.size();
+    if(n == 0){
+      blockCellEnd[b].assign(cellStart.size(), 0);
+      return;
+    }
+    cellStart.push_back(n);
+
+    vector<bool> isInside(n);
+    if(tgp && !tgp->surfaceIntersects(Box(cmin, cmax))){
+      isInside.assign(n, piece->inside(candidates[0],true));
+    } else if(tgp){
+      tgp->inside(candidates, true, isInside);
+    } else {
+      for(int i = 0; i < n; i++){
+        isInside[i] = piece->inside(candidates[i],true);
+      }
+    }
+
+    vector<Point>& points = blockPoints[b];
+    vector<int>& cellEnd  = blockCellEnd[b];
+    for(size_t cell = 0; cell + 1 < cellStart.size(); cell++){
+      for(int i = cellStart[cell]; i < cellStart[cell+1]; i++){
+        if (isInside[i]){ 
+          Point p = candidates[i];
+          Vector p1(p(0),p(1),p(2));
+          p1=affineTrans_A*p1+affineTrans_b;
+          p(0)=p1[0];
+          p(1)=p1[1];
+          p(2)=p1[2];
+          points.push_back(p);
+        }
+      }
+      cellEnd.push_back(points.size());
+    }
+  };
+
+  //__________________________________
+  //  Spread the blocks over the task runner threads (-nthreads).  The
+  //  inside tests only read the geometry piece.
+  const int nBlocks  = blocks.size();
+  const int nThreads = std::max(1, Uintah::Parallel::getNumThreads());
+
+  ThreadExecutor::runTasks(nBlocks, fillBlock, nThreads);
+
+  //__________________________________
+  //  Gather the points cell by cell
+  const IntVector nBlocksDir = (highIdx - lowIdx + blockSize - IntVector(1,1,1))/blockSize;
+
+  vector<Point>& objectPoints = vars.d_object_points[obj];
+  for(CellIterator iter = patch->getCellIterator(); !iter.done(); iter++){
+    const IntVector rel = *iter - lowIdx;
+    const IntVector bi  = rel/blockSize;
+    const int b = (bi.z()*nBlocksDir.y() + bi.y())*nBlocksDir.x() + bi.x();
+
+    const IntVector blockLow  = blocks[b];
+    const IntVector blockExt  = Min(blockLow + blockSize, highIdx) - blockLow;
+    const IntVector local     = *iter - blockLow;
+    const int cell = (local.z()*blockExt.y() + local.y())*blockExt.x() + local.x();
+
+    const vector<int>& cellEnd = blockCellEnd[b];
+    const int first = (cell == 0) ? 0 : cellEnd[cell-1];
+    objectPoints.insert(objectPoints.end(), blockPoints[b].begin() + first,
+                                            blockPoints[b].begin() + cellEnd[cell]);
+  }
 
 /*
 //  This part is associated with CBDI_CompressiveCylinder.ups input file.
@@ -877,7 +982,7 @@ ParticleCreator::countAndCreateParticles(const Patch* patch,
     sgp->setCellSize(patch->dCell());
     if(fgp){
       fgp->setCpti(d_useCPTI);
-      fgp->readPoints(patch->getID());
+      fgp->readPoints(patch->getID(), patch->getExtraBox());
       numPts = fgp->returnPointCount();
     } else {
       // setParticleSpacing seems to only be used by GUVSphereShell
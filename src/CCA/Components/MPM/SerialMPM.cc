@@ -60,6 +60,7 @@
 #include <Core/Grid/Variables/ParticleVariable.h>
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Grid/Variables/PerPatchVars.h>
+#include <Core/Grid/Variables/RowRange.h>
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
@@ -2485,20 +2486,43 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
           }
         }
       } // End of particle loop
-      for(NodeIterator iter=patch->getExtraNodeIterator();
-                       !iter.done();iter++){
-        IntVector c = *iter;
 
-        gmassglobal[c]    += gmass[c];
-        gvolumeglobal[c]  += gvolume[c];
-        gvelglobal[c]     += gvelocity[c];
-        gvelocity[c]      /= gmass[c];
-        gtempglobal[c]    += gTemperature[c];
-        gTemperature[c]   /= gmass[c];
-//        gColor[c]         /= gmass[c];
-        gTemperatureNoBC[c] = gTemperature[c];
-        gSp_vol[c]        /= gmass[c];
-      }
+      RowAccessor<double> massG( gmassglobal );
+      RowAccessor<double> volG( gvolumeglobal );
+      RowAccessor<Vector> velG( gvelglobal );
+      RowAccessor<double> tempG( gtempglobal );
+      RowAccessor<double> mass( gmass );
+      RowAccessor<double> vol( gvolume );
+      RowAccessor<Vector> vel( gvelocity );
+      RowAccessor<double> temp( gTemperature );
+      RowAccessor<double> tempNoBC( gTemperatureNoBC );
+      RowAccessor<double> sp_vol( gSp_vol );
+
+      parallel_for_rows( RowRange( patch->getExtraNodeIterator() ),
+                         [&]( int j, int k, int ib, int ie ) {
+        double* mG  = massG.row( j, k );
+        double* vG  = volG.row( j, k );
+        Vector* uG  = velG.row( j, k );
+        double* tG  = tempG.row( j, k );
+        double* m   = mass.row( j, k );
+        double* v   = vol.row( j, k );
+        Vector* u   = vel.row( j, k );
+        double* t   = temp.row( j, k );
+        double* tNB = tempNoBC.row( j, k );
+        double* sv  = sp_vol.row( j, k );
+
+        for( int i = ib; i < ie; i++ ) {
+          mG[i]  += m[i];
+          vG[i]  += v[i];
+          uG[i]  += u[i];
+          u[i]   /= m[i];
+          tG[i]  += t[i];
+          t[i]   /= m[i];
+//          gColor[c]         /= gmass[c];
+          tNB[i]  = t[i];
+          sv[i]  /= m[i];
+        }
+      });
 
       if (flags->d_doScalarDiffusion) {
         for (NodeIterator iter=patch->getExtraNodeIterator();
@@ -3273,18 +3297,35 @@ void SerialMPM::computeAndIntegrateAcceleration(const ProcessorGroup*,
       acceleration.initialize(Vector(0.,0.,0.));
       double damp_coef = flags->d_artificialDampCoeff;
 
-      for(NodeIterator iter=patch->getExtraNodeIterator();
-                        !iter.done();iter++){
-        IntVector c = *iter;
-
-        Vector acc(0.,0.,0.);
-        if (mass[c] > flags->d_min_mass_for_acceleration){
-          acc  = (internalforce[c] + externalforce[c])/mass[c];
-          acc -= damp_coef*velocity[c];
+      const double dt       = delT;
+      const double min_mass = flags->d_min_mass_for_acceleration;
+
+      RowAccessor<const Vector> intF( internalforce );
+      RowAccessor<const Vector> extF( externalforce );
+      RowAccessor<const Vector> vel( velocity );
+      RowAccessor<const double> gmass( mass );
+      RowAccessor<Vector>       vel_star( velocity_star );
+      RowAccessor<Vector>       accel( acceleration );
+
+      parallel_for_rows( RowRange( patch->getExtraNodeIterator() ),
+                         [&]( int j, int k, int ib, int ie ) {
+        const Vector* fi = intF.row( j, k );
+        const Vector* fe = extF.row( j, k );
+        const Vector* v  = vel.row( j, k );
+        const double* m  = gmass.row( j, k );
+        Vector*       vs = vel_star.row( j, k );
+        Vector*       a  = accel.row( j, k );
+
+        for( int i = ib; i < ie; i++ ) {
+          Vector acc(0.,0.,0.);
+          if (m[i] > min_mass){
+            acc  = (fi[i] + fe[i])/m[i];
+            acc -= damp_coef*v[i];
+          }
+          a[i]  = acc +  gravity;
+          vs[i] = v[i] + a[i] * dt;
         }
-        acceleration[c]  = acc +  gravity;
-        velocity_star[c] = velocity[c] + acceleration[c] * delT;
-      }
+      });
 
       // Check the integrated nodal velocity and if the product of velocity
       // and timestep size is larger than half the cell size, restart the
@@ -3350,11 +3391,20 @@ void SerialMPM::setGridBoundaryConditions(const ProcessorGroup*,
 
       // Now recompute acceleration as the difference between the velocity
       // interpolated to the grid (no bcs applied) and the new velocity_star
-      for(NodeIterator iter=patch->getExtraNodeIterator();!iter.done();
-                                                                iter++){
-        IntVector c = *iter;
-        gacceleration[c] = (gvelocity_star[c] - gvelocity[c])/delT;
-      }
+      const double dt = delT;
+      RowAccessor<Vector>       accel( gacceleration );
+      RowAccessor<const Vector> vel_star( gvelocity_star );
+      RowAccessor<const Vector> vel( gvelocity );
+
+      parallel_for_rows( RowRange( patch->getExtraNodeIterator() ),
+                         [&]( int j, int k, int ib, int ie ) {
+        Vector*       a  = accel.row( j, k );
+        const Vector* vs = vel_star.row( j, k );
+        const Vector* v  = vel.row( j, k );
+        for( int i = ib; i < ie; i++ ) {
+          a[i] = (vs[i] - v[i])/dt;
+        }
+      });
     } // matl loop
   }  // patch loop
 }
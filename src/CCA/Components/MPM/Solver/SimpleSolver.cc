@@ -26,15 +26,19 @@
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Level.h>
+#include <Core/Exceptions/InternalError.h>
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
 using namespace Uintah;
 using namespace std;
 
-SimpleSolver::SimpleSolver()
+SimpleSolver::SimpleSolver( const std::string& preconditioner,
+                            int numThreads )
 {
-
+  d_preconditioner = parsePreconditioner( preconditioner );
+  d_numThreads     = std::max( 1, numThreads );
 }
 
 SimpleSolver::~SimpleSolver()
@@ -58,6 +62,7 @@ void SimpleSolver::createLocalToGlobalMapping(const ProcessorGroup* d_myworld,
   d_numNodes.resize(numProcessors, 0);
   d_startIndex.resize(numProcessors);
   d_totalNodes = 0;
+  d_DOFsPerNode = DOFsPerNode;
 
    for (int p = 0; p < perproc_patches->size(); p++) {
     d_startIndex[p] = d_totalNodes;
@@ -105,8 +110,8 @@ void SimpleSolver::createLocalToGlobalMapping(const ProcessorGroup* d_myworld,
       int petscglobalIndex = d_petscGlobalStart[neighbor];
       IntVector dnodes = phigh-plow;
       IntVector start = low-plow;
-      petscglobalIndex += start.z()*dnodes.x()*dnodes.y()*DOFsPerNode
-        +start.y()*dnodes.x()*(DOFsPerNode-1) + start.x();
+      petscglobalIndex += (start.z()*dnodes.x()*dnodes.y()
+                           + start.y()*dnodes.x() + start.x())*DOFsPerNode;
       for (int colZ = low.z(); colZ < high.z(); colZ ++) {
         int idx_slab = petscglobalIndex;
         petscglobalIndex += dnodes.x()*dnodes.y()*DOFsPerNode;
@@ -135,22 +140,27 @@ void SimpleSolver::solve(vector<double>& guess)
   printRHS();
 #endif
 
+  KK.endAssembly();
+
   double Qtot=0.;
   for (int i = 0; i < (int)Q.size(); i++){
     Qtot += fabs(Q[i]);
   }
   cout << "Qtot = " << Qtot << endl;
 
-  d_x.resize(Q.size());
+  d_x.assign(Q.size(), 0.0);
 
-  if (compare(Qtot,0.0)){
-    for (int i = 0; i < (int)Q.size(); i++){
-      d_x[i] = 0.0;
+  if (!compare(Qtot,0.0)){
+    PCGResult result = pcgSolve(KK, Q, d_x, d_preconditioner,
+                                1.e-8, 5000, d_numThreads);
+    if (result.converged) {
+      cout << "number of iterations is " << result.iterations << endl;
+      cout << "residual is " << result.residual << endl;
+    }
+    else {
+      cout << "No convergence, residual is " << result.residual
+           << " after " << result.iterations << " iterations" << endl;
     }
-  }
-  else{
-    int conflag = 0;
-    d_x = cgSolve(KK,Q,conflag);
   }
 #if 0
   for (int i=0;i< d_x.size();i++)
@@ -164,15 +174,22 @@ void SimpleSolver::createMatrix(const ProcessorGroup* d_myworld,
   int globalrows = (int)d_totalNodes;
   int globalcolumns = (int)d_totalNodes;
   
-  KK.setSize(globalrows,globalcolumns);
-  Q.resize(globalrows);
-  d_t.resize(globalrows);
-  d_flux.resize(globalrows);
+  if (globalrows != globalcolumns) {
+    throw InternalError("SimpleSolver: the matrix must be square", __FILE__, __LINE__);
+  }
+
+  // The sparsity pattern from the previous assembly is kept as long as
+  // the number of DOFs doesn't change.
+  KK.setSize(globalrows,d_DOFsPerNode);
+  KK.beginAssembly();
+  Q.assign(globalrows, 0.0);
+  d_t.assign(globalrows, 0.0);
+  d_flux.assign(globalrows, 0.0);
 }
 
 void SimpleSolver::destroyMatrix(bool recursion)
 {
-  KK.clear();
+  KK.clearValues();
   if (recursion == false) {
     d_DOF.clear();
     d_DOFFlux.clear();
@@ -185,7 +202,7 @@ void SimpleSolver::fillMatrix(int numi,int i[],int numj,
 {
    for(int ii=0;ii<numi;ii++){
      for(int jj=0;jj<numj;jj++){
-       KK[i[ii]][j[jj]] = KK[i[ii]][j[jj]] + value[ii*numi + jj];
+       KK.add(i[ii], j[jj], value[ii*numi + jj]);
      }
    }
 }
@@ -228,12 +245,12 @@ void SimpleSolver::assembleTemporaryVector()
 
 void SimpleSolver::applyBCSToRHS()
 {
+  KK.endAssembly();
+
+  vector<double> Kt(d_totalNodes);
+  KK.multiply(&d_t[0], &Kt[0], d_numThreads);
   for(int ii=0;ii<d_totalNodes;ii++){
-     double rowvecprod=0.;
-     for(int jj=0;jj<d_totalNodes;jj++){
-        rowvecprod+=KK[ii][jj]*d_t[jj];
-     }
-     Q[ii]=Q[ii]+rowvecprod;
+     Q[ii]=Q[ii]+Kt[ii];
   }
 }
 
@@ -245,43 +262,26 @@ void SimpleSolver::copyL2G(Array3<int>& mapping,const Patch* patch)
 
 void SimpleSolver::removeFixedDOFHeat()
 {
+  KK.endAssembly();
 
-  SparseMatrix<double,int> KKK(KK.Rows(),KK.Columns());
-  for (SparseMatrix<double,int>::iterator itr = KK.begin(); 
-       itr != KK.end(); itr++) {
-    int i = KK.Index1(itr);
-    int j = KK.Index2(itr);
-    set<int>::iterator find_itr_j = d_DOF.find(j);
-    set<int>::iterator find_itr_i = d_DOF.find(i);
-    
-    if (find_itr_j != d_DOF.end()) {
-      Q[j] = 0.;
-      if (i == j) {
-        KKK[i][j] = 1.;
-      }
-    }
-    else if (find_itr_i != d_DOF.end()) {
-      Q[i] = 0.;
-      if (i == j) {
-        KKK[i][j] = 1.;
-      }
-    }
-    else {
-      KKK[i][j] = KK[i][j];
-    }
+  // Replace the rows and columns of the fixed DOFs with the identity
+  vector<char> fixed(d_totalNodes, 0);
+  for (set<int>::iterator iter = d_DOF.begin(); iter != d_DOF.end(); 
+       iter++) {
+    fixed[*iter] = 1;
+    Q[*iter] = 0.;
   }
+  KK.eliminate(fixed);
+
   // Make sure the nodes that are outside of the material have values 
   // assigned and solved for.  The solutions will be 0.
   
   for (set<int>::iterator iter = d_DOFZero.begin(); iter != d_DOFZero.end();
        iter++) {
     int j = *iter;
-    KKK[j][j] = 1.;
+    KK.setDiagonal(j, 1.);
     Q[j] = 0.;
   }
-  KK.clear();
-  KK = KKK;
-  KKK.clear();
 
   for (set<int>::iterator iter = d_DOF.begin(); iter != d_DOF.end(); 
        iter++) {
@@ -301,47 +301,35 @@ void SimpleSolver::removeFixedDOFHeat()
 
 void SimpleSolver::removeFixedDOF()
 {
+  KK.endAssembly();
+
+  vector<char> fixed(d_totalNodes, 0);
   for (set<int>::iterator iter = d_DOF.begin(); iter != d_DOF.end(); 
        iter++) {
     // Take care of the right hand side
     Q[*iter] = 0;
+    fixed[*iter] = 1;
   }    
-  SparseMatrix<double,int> KKK(KK.Rows(),KK.Columns());
-  for (SparseMatrix<double,int>::iterator itr = KK.begin(); 
-       itr != KK.end(); itr++) {
-    int i = KK.Index1(itr);
-    int j = KK.Index2(itr);
-    set<int>::iterator find_itr_j = d_DOF.find(j);
-    set<int>::iterator find_itr_i = d_DOF.find(i);
-    
-    if (find_itr_j != d_DOF.end()) {
-      Q[j] = 0.;
-      if (i == j) {
-        KKK[i][j] = 1.;
-      }
-    }
-    else if (find_itr_i != d_DOF.end()) {
-      Q[i] = 0.;
-      if (i == j) {
-        KKK[i][j] = 1.;
-      }
-    }
-    else {
-      KKK[i][j] = KK[i][j];
+
+  // Nodes that are outside of the material have a zero diagonal, find
+  // them before the fixed DOFs get a unit diagonal.
+  vector<int> zeroDiag;
+  for (int j = 0; j < d_totalNodes; j++) {
+    if (compare(KK.diagonal(j),0.)) {
+      zeroDiag.push_back(j);
     }
   }
+
+  KK.eliminate(fixed);
+
   // Make sure the nodes that are outside of the material have values 
   // assigned and solved for.  The solutions will be 0.
   
-  for (int j = 0; j < d_totalNodes; j++) {
-    if (compare(KK[j][j],0.)) {
-      KKK[j][j] = 1.;
-      Q[j] = 0.;
-    }
+  for (unsigned int n = 0; n < zeroDiag.size(); n++) {
+    int j = zeroDiag[n];
+    KK.setDiagonal(j, 1.);
+    Q[j] = 0.;
   }
-  KK.clear();
-  KK = KKK;
-  KKK.clear();
 
 }
 
@@ -376,8 +364,8 @@ void SimpleSolver::printMatrix()
   for (int i = 0; i < d_totalNodes; i++) {
     cout << "row " << i << ":";
     for (int j = 0; j < d_totalNodes; j++) {
-      if (KK[i][j] != 0.)
-        cout << " (" << j << ", " << KK[i][j] << ") ";
+      if (KK.get(i,j) != 0.)
+        cout << " (" << j << ", " << KK.get(i,j) << ") ";
     }
     cout << endl;
   }
@@ -27,10 +27,12 @@
 
 #include <Core/Grid/Variables/ComputeSet.h>
 #include <Core/Grid/Variables/Array3.h>
-#include <Core/Math/Sparse.h>
+#include <Core/Math/BlockSparseMatrix.h>
 #include <CCA/Components/MPM/Solver/Solver.h>
+#include <cmath>
 #include <map>
 #include <set>
+#include <string>
 #include <vector>
 
 using std::map;
@@ -42,10 +44,18 @@ namespace Uintah {
   class ProcessorGroup;
   class Patch;
 
+  // Serial/threaded solver for the implicit MPM and implicit heat
+  // conduction systems.  The matrix is kept in block CSR storage with one
+  // DOFsPerNode x DOFsPerNode block per node pair; its sparsity pattern is
+  // built on the first assembly and reused by later assemblies of the same
+  // size.  The system is solved with preconditioned CG.
   class SimpleSolver : public Solver {
 
   public:
-    SimpleSolver();
+    // preconditioner is one of none, jacobi, block_jacobi or ic0,
+    // numThreads is the number of threads used by the Krylov solve.
+    SimpleSolver( const std::string& preconditioner = "jacobi",
+                  int numThreads = 1 );
     ~SimpleSolver();
 
     void initialize();
@@ -102,13 +112,17 @@ namespace Uintah {
     map<const Patch*, Array3<int> > d_petscLocalToGlobal;
     vector<int> d_numNodes,d_startIndex;
     int d_totalNodes;
-    
+    int d_DOFsPerNode {1};
+
+    Preconditioner d_preconditioner;
+    int d_numThreads;
+
     // Simple matrix and vectors
 
-    SparseMatrix<double,int> KK;
-    std::valarray<double> Q;
-    std::valarray<double> d_x;
-    std::valarray<double> d_t,d_flux;
+    BlockSparseMatrix KK;
+    vector<double> Q;
+    vector<double> d_x;
+    vector<double> d_t,d_flux;
 
     inline bool compare(double num1, double num2)
       {
@@ -0,0 +1,478 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
+
+#include <CCA/Ports/LoadBalancer.h>
+#include <CCA/Ports/Output.h>
+#include <CCA/Ports/Scheduler.h>
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Task.h>
+#include <Core/Parallel/ProcessorGroup.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/DOUT.hpp>
+
+#include <cstring>
+#include <map>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Uintah;
+
+namespace {
+  Dout dbg_OTF_AO("AnalysisOutput", "OnTheFlyAnalysis", "binary analysis output debug stream", false);
+
+  // instances per module name, used to make the file names unique
+  std::map<std::string, int> s_instances;
+
+  const int64_t BLOCK_HEADER_SIZE = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+  template<class T>
+  void append( std::vector<char> & buf, const T & val )
+  {
+    const char * p = reinterpret_cast<const char*>( &val );
+    buf.insert( buf.end(), p, p + sizeof(T) );
+  }
+
+  void pwriteAll( int fd, const char * buf, size_t size, off_t offset, const std::string & filename )
+  {
+    while( size > 0 ){
+      ssize_t n = ::pwrite( fd, buf, size, offset );
+      if( n <= 0 ){
+        throw InternalError( "AnalysisOutput: write failed on " + filename, __FILE__, __LINE__ );
+      }
+      buf    += n;
+      size   -= n;
+      offset += n;
+    }
+  }
+}
+
+const char     AnalysisOutput::MAGIC[8] = { 'U','A','N','L','Y','S','0','1' };
+const uint32_t AnalysisOutput::ENDIAN_TAG;
+const uint32_t AnalysisOutput::BLOCK_TAG;
+
+//______________________________________________________________________
+//
+AnalysisOutput::AnalysisOutput( const ProcessorGroup * myworld,
+                                const std::string    & moduleName )
+  : d_myworld( myworld )
+{
+  int n = s_instances[moduleName]++;
+
+  std::ostringstream name;
+  name << moduleName;
+  if( n > 0 ){
+    name << "_" << n;
+  }
+  d_moduleName = name.str();
+
+  d_columnNames.push_back( "series" );
+  d_columnTypes.push_back( INT64 );
+  d_columnNames.push_back( "time" );
+  d_columnTypes.push_back( DOUBLE );
+}
+
+//______________________________________________________________________
+//
+AnalysisOutput::~AnalysisOutput()
+{
+  if( d_writeThread.joinable() ){
+    d_writeThread.join();
+  }
+
+  if( !d_buffer.empty() ){
+    DOUT( true, "Rank-" << d_myworld->myRank() << " AnalysisOutput(" << d_moduleName << ") WARNING: "
+          << d_buffer.size()/numColumns() << " rows were never flushed" );
+  }
+
+  if( d_fd >= 0 ){
+    ::close( d_fd );
+  }
+
+  int finalized = 0;
+  MPI_Finalized( &finalized );
+  if( d_groupComm != MPI_COMM_NULL && !finalized ){
+    Uintah::MPI::Comm_free( &d_groupComm );
+  }
+}
+
+//______________________________________________________________________
+//
+bool AnalysisOutput::isRequested( const ProblemSpecP & module_spec )
+{
+  std::string format = "text";
+  ProblemSpecP ps = module_spec;
+  ps->get( "outputFormat", format );
+
+  if( format != "text" && format != "binary" ){
+    throw ProblemSetupException( "ERROR: AnalysisModule: <outputFormat> must be text or binary, not " + format,
+                                 __FILE__, __LINE__ );
+  }
+  return ( format == "binary" );
+}
+
+//______________________________________________________________________
+//
+void AnalysisOutput::problemSetup( const ProblemSpecP & module_spec )
+{
+  ProblemSpecP bin_ps = module_spec->findBlock( "binaryOutput" );
+
+  if( bin_ps ){
+    std::map<std::string,std::string> attribute;
+    bin_ps->getAttributes( attribute );
+
+    if( attribute.count( "flushInterval" ) ){
+      d_flushInterval = std::stoi( attribute["flushInterval"] );
+    }
+    if( attribute.count( "ranksPerWriter" ) ){
+      d_ranksPerWriter = std::stoi( attribute["ranksPerWriter"] );
+    }
+  }
+
+  if( d_flushInterval < 1 || d_ranksPerWriter < 1 ){
+    throw ProblemSetupException( "ERROR: AnalysisModule: <binaryOutput> flushInterval and ranksPerWriter must be > 0",
+                                 __FILE__, __LINE__ );
+  }
+}
+
+//______________________________________________________________________
+//
+void AnalysisOutput::addColumn( const std::string & name )
+{
+  if( d_isOpen ){
+    throw InternalError( "AnalysisOutput: addColumn called after the file was opened", __FILE__, __LINE__ );
+  }
+  d_columnNames.push_back( name );
+  d_columnTypes.push_back( DOUBLE );
+}
+
+//______________________________________________________________________
+//  The series id is stored bit for bit in the double buffer
+void AnalysisOutput::addRow( const int64_t  series,
+                             const double   time,
+                             const double * values )
+{
+  const int nValues = numColumns() - 2;
+
+  std::lock_guard<std::mutex> lock( d_bufferLock );
+
+  size_t n = d_buffer.size();
+  d_buffer.resize( n + nValues + 2 );
+
+  double * row = &d_buffer[n];
+  std::memcpy( &row[0], &series, sizeof(int64_t) );
+  row[1] = time;
+  std::copy( values, values + nValues, &row[2] );
+}
+
+//______________________________________________________________________
+//  Only the finest level schedules the flush so it executes once per timestep.
+void AnalysisOutput::scheduleFlush( Scheduler         * sched,
+                                    const LevelP      & level,
+                                    const MaterialSet * matls,
+                                    const VarLabel    * afterLabel,
+                                    Output            * output )
+{
+  if( level->getIndex() != level->getGrid()->numLevels() - 1 ){
+    return;
+  }
+
+  Task* t = scinew Task( "AnalysisOutput::flush(" + d_moduleName + ")",
+                         this, &AnalysisOutput::flushTask, output );
+
+  t->setType( Task::OncePerProc );
+
+  // the flush uses collectives, the schedulers run such tasks in the
+  // same order on all ranks
+  t->usesMPI( true );
+
+  // the rows are added by the task computing afterLabel
+  if( afterLabel ){
+    t->requires( Task::NewDW, afterLabel );
+  }
+
+  const PatchSet* perProcPatches = sched->getLoadBalancer()->getPerProcessorPatchSet( level );
+
+  sched->addTask( t, perProcPatches, matls );
+}
+
+//______________________________________________________________________
+//
+void AnalysisOutput::flushTask( const ProcessorGroup *,
+                                const PatchSubset    *,
+                                const MaterialSubset *,
+                                DataWarehouse        *,
+                                DataWarehouse        *,
+                                Output               * output )
+{
+  if( d_filename.empty() ){
+    d_filename = output->getOutputLocation() + "/" + d_moduleName + ".uab";
+  }
+
+  d_nCalls++;
+
+  bool doFlush = ( d_nCalls % d_flushInterval == 0 ) ||
+                 output->isOutputTimeStep()           ||
+                 output->isCheckpointTimeStep()       ||
+                 output->maybeLastTimeStep();
+  if( doFlush ){
+    flush();
+  }
+}
+
+//______________________________________________________________________
+//
+std::vector<char> AnalysisOutput::schemaHeader() const
+{
+  std::vector<char> header( MAGIC, MAGIC + 8 );
+
+  append( header, ENDIAN_TAG );
+  append( header, (uint32_t) d_columnNames.size() );
+
+  for( size_t i = 0; i < d_columnNames.size(); i++ ){
+    append( header, (uint32_t) d_columnTypes[i] );
+    append( header, (uint32_t) d_columnNames[i].size() );
+    header.insert( header.end(), d_columnNames[i].begin(), d_columnNames[i].end() );
+  }
+  return header;
+}
+
+//______________________________________________________________________
+//  Collective.  Rank 0 creates the file or, on a restart, checks the
+//  schema and drops a partially written trailing block.
+void AnalysisOutput::openFile()
+{
+  const int rank = d_myworld->myRank();
+
+  int64_t fileEnd = 0;
+
+  if( rank == 0 ){
+    std::vector<char> header = schemaHeader();
+    int64_t headerSize       = header.size();
+
+    int fd = ::open( d_filename.c_str(), O_RDWR | O_CREAT, 0644 );
+
+    if( fd < 0 ){
+      fileEnd = -1;
+    }
+    else {
+      struct stat st;
+      fstat( fd, &st );
+
+      if( st.st_size == 0 ){
+        pwriteAll( fd, header.data(), headerSize, 0, d_filename );
+        fileEnd = headerSize;
+      }
+      else {
+        std::vector<char> existing( headerSize );
+        if( st.st_size < headerSize ||
+            ::pread( fd, existing.data(), headerSize, 0 ) != headerSize ||
+            existing != header ){
+          fileEnd = -2;
+        }
+        else {
+          // walk the blocks
+          const int64_t rowBytes = sizeof(double) * numColumns();
+          fileEnd = headerSize;
+
+          while( fileEnd + BLOCK_HEADER_SIZE <= st.st_size ){
+            uint32_t tag[2];
+            uint64_t nRows;
+            ::pread( fd, tag,    sizeof(tag),   fileEnd );
+            ::pread( fd, &nRows, sizeof(nRows), fileEnd + sizeof(tag) );
+
+            int64_t blockEnd = fileEnd + BLOCK_HEADER_SIZE + nRows * rowBytes;
+            if( tag[0] != BLOCK_TAG || blockEnd > st.st_size ){
+              break;
+            }
+            fileEnd = blockEnd;
+          }
+
+          if( fileEnd != st.st_size ){
+            DOUT( true, "AnalysisOutput: truncating " << d_filename << " from " << st.st_size
+                  << " to " << fileEnd << " bytes (incomplete block)" );
+            if( ftruncate( fd, fileEnd ) != 0 ){
+              fileEnd = -1;
+            }
+          }
+        }
+      }
+      ::close( fd );
+    }
+  }
+
+  Uintah::MPI::Bcast( &fileEnd, 1, MPI_INT64_T, 0, d_myworld->getComm() );
+
+  if( fileEnd == -1 ){
+    throw InternalError( "AnalysisOutput: could not open " + d_filename, __FILE__, __LINE__ );
+  }
+  if( fileEnd == -2 ){
+    throw InternalError( "AnalysisOutput: " + d_filename + " exists and its columns differ from this run",
+                         __FILE__, __LINE__ );
+  }
+  d_fileEnd = fileEnd;
+
+  //__________________________________
+  //  one writer per group of ranks
+  Uintah::MPI::Comm_split( d_myworld->getComm(), rank / d_ranksPerWriter, rank, &d_groupComm );
+
+  int groupRank;
+  Uintah::MPI::Comm_rank( d_groupComm, &groupRank );
+  d_isWriter = ( groupRank == 0 );
+
+  if( d_isWriter ){
+    d_fd = ::open( d_filename.c_str(), O_WRONLY );
+    if( d_fd < 0 ){
+      throw InternalError( "AnalysisOutput: could not open " + d_filename, __FILE__, __LINE__ );
+    }
+  }
+
+  d_isOpen = true;
+
+  DOUT( dbg_OTF_AO, "Rank-" << rank << " AnalysisOutput: opened " << d_filename
+        << " writer: " << d_isWriter << " offset: " << d_fileEnd );
+}
+
+//______________________________________________________________________
+//
+void AnalysisOutput::flush()
+{
+  wait();
+
+  if( !d_isOpen ){
+    openFile();
+  }
+
+  std::vector<double> rows;
+  {
+    std::lock_guard<std::mutex> lock( d_bufferLock );
+    rows.swap( d_buffer );
+  }
+
+  //__________________________________
+  //  gather the rows on the writer of each group
+  int groupSize;
+  Uintah::MPI::Comm_size( d_groupComm, &groupSize );
+
+  int nLocal = rows.size();
+  std::vector<int> counts( groupSize, 0 );
+  std::vector<int> displs( groupSize, 0 );
+
+  Uintah::MPI::Gather( &nLocal, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, d_groupComm );
+
+  int nTotal = 0;
+  if( d_isWriter ){
+    for( int i = 0; i < groupSize; i++ ){
+      displs[i] = nTotal;
+      nTotal   += counts[i];
+    }
+  }
+
+  std::vector<double> gathered( nTotal );
+  Uintah::MPI::Gatherv( rows.data(), nLocal, MPI_DOUBLE,
+                        gathered.data(), counts.data(), displs.data(), MPI_DOUBLE, 0, d_groupComm );
+
+  //__________________________________
+  //  where each writer's block goes in the file
+  const int64_t nRows = nTotal / numColumns();
+  int64_t bytes       = 0;
+
+  if( nRows > 0 ){
+    bytes = BLOCK_HEADER_SIZE + nRows * numColumns() * sizeof(double);
+  }
+
+  int64_t offset     = 0;
+  int64_t totalBytes = 0;
+  Uintah::MPI::Exscan(    &bytes, &offset,     1, MPI_INT64_T, MPI_SUM, d_myworld->getComm() );
+  Uintah::MPI::Allreduce( &bytes, &totalBytes, 1, MPI_INT64_T, MPI_SUM, d_myworld->getComm() );
+
+  if( d_myworld->myRank() == 0 ){
+    offset = 0;             // MPI_Exscan leaves rank 0 undefined
+  }
+
+  if( bytes > 0 ){
+    d_writeThread = std::thread( &AnalysisOutput::writeBlock, this,
+                                 std::move( gathered ), nRows, d_fileEnd + offset );
+  }
+
+  DOUT( dbg_OTF_AO, "Rank-" << d_myworld->myRank() << " AnalysisOutput(" << d_moduleName << ") flush: "
+        << nRows << " rows, " << totalBytes << " bytes total" );
+
+  d_fileEnd += totalBytes;
+}
+
+//______________________________________________________________________
+//  Runs on the background thread: transpose the rows into columns and write
+void AnalysisOutput::writeBlock( std::vector<double> rows,
+                                 const int64_t       nRows,
+                                 const int64_t       offset )
+{
+  const int nCols = numColumns();
+
+  std::vector<char> block;
+  block.reserve( BLOCK_HEADER_SIZE + rows.size() * sizeof(double) );
+
+  append( block, BLOCK_TAG );
+  append( block, (uint32_t) 0 );
+  append( block, (uint64_t) nRows );
+
+  std::vector<double> column( nRows );
+  for( int c = 0; c < nCols; c++ ){
+    for( int64_t r = 0; r < nRows; r++ ){
+      column[r] = rows[r * nCols + c];
+    }
+    const char* p = reinterpret_cast<const char*>( column.data() );
+    block.insert( block.end(), p, p + nRows * sizeof(double) );
+  }
+
+  try {
+    pwriteAll( d_fd, block.data(), block.size(), offset, d_filename );
+  }
+  catch( ... ){
+    d_writeError = std::current_exception();
+  }
+}
+
+//______________________________________________________________________
+//
+void AnalysisOutput::wait()
+{
+  if( d_writeThread.joinable() ){
+    d_writeThread.join();
+  }
+
+  if( d_writeError ){
+    std::exception_ptr error = d_writeError;
+    d_writeError = nullptr;
+    std::rethrow_exception( error );
+  }
+}
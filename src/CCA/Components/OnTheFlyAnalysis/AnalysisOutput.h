@@ -0,0 +1,190 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef Packages_Uintah_CCA_Components_ontheflyAnalysis_AnalysisOutput_h
+#define Packages_Uintah_CCA_Components_ontheflyAnalysis_AnalysisOutput_h
+
+#include <Core/Grid/LevelP.h>
+#include <Core/Grid/Variables/ComputeSet.h>
+#include <Core/Parallel/UintahMPI.h>
+#include <Core/ProblemSpec/ProblemSpecP.h>
+
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Uintah {
+
+  class DataWarehouse;
+  class Output;
+  class ProcessorGroup;
+  class Scheduler;
+  class VarLabel;
+
+/**************************************
+
+CLASS
+   AnalysisOutput
+
+GENERAL INFORMATION
+
+   AnalysisOutput.h
+
+KEYWORDS
+   AnalysisModule, binary output
+
+DESCRIPTION
+   Buffered binary output backend shared by the on-the-fly analysis
+   modules.  Instead of every rank fprintf'ing into one text file per
+   probe, each rank appends rows to an in-memory buffer.  Every
+   <flushInterval> analysis timesteps (and on output, checkpoint and
+   the last timestep) the buffers are gathered to one writer rank per
+   group of <ranksPerWriter> ranks and appended to a single file per
+   module.  The file offsets are computed with an MPI_Exscan so the
+   writers never overlap; the write itself runs on a background thread.
+
+   Every row holds a series id (int64), the physical time and the
+   module defined columns (double).
+
+   File layout, native endian:
+
+     header:  char[8]  "UANLYS01"
+              uint32   endian tag 0x01020304
+              uint32   number of columns (series and time included)
+              per column:  uint32 type (0 = int64, 1 = double),
+                           uint32 name length, char name[]
+     block:   uint32   "BLK1" tag
+              uint32   0
+              uint64   number of rows
+              the rows stored column by column, 8 bytes per value
+
+   The reader tool is StandAlone/tools/extractors/analysisextract.
+
+   Input file usage, inside the <Module> spec:
+
+     <outputFormat>   binary </outputFormat>    <!-- default: text -->
+     <binaryOutput flushInterval="10" ranksPerWriter="32"/>
+
+   The file is <uda>/<module name>.uab; a second instance of the same
+   module gets the suffix _1, _2, ...
+****************************************/
+
+  class AnalysisOutput {
+  public:
+
+    enum ColumnType { INT64 = 0, DOUBLE = 1 };
+
+    static const char     MAGIC[8];
+    static const uint32_t ENDIAN_TAG  = 0x01020304;
+    static const uint32_t BLOCK_TAG   = 0x314B4C42;   // "BLK1"
+
+    AnalysisOutput( const ProcessorGroup * myworld,
+                    const std::string    & moduleName );
+
+    ~AnalysisOutput();
+
+    // returns true if the module spec asks for binary output
+    static bool isRequested( const ProblemSpecP & module_spec );
+
+    void problemSetup( const ProblemSpecP & module_spec );
+
+    // declare a double column, must be called before the first flush
+    void addColumn( const std::string & name );
+
+    int numColumns() const { return d_columnNames.size(); }
+
+    // thread safe, values holds numColumns() - 2 entries
+    void addRow( const int64_t  series,
+                 const double   time,
+                 const double * values );
+
+    void addRow( const int64_t               series,
+                 const double                time,
+                 const std::vector<double> & values )
+    {
+      addRow( series, time, values.data() );
+    }
+
+    // adds a OncePerProc task that flushes the buffers once per timestep.
+    // The task runs after the task computing "afterLabel"
+    void scheduleFlush( Scheduler         * sched,
+                        const LevelP      & level,
+                        const MaterialSet * matls,
+                        const VarLabel    * afterLabel,
+                        Output            * output );
+
+    // collective over d_myworld
+    void flush();
+
+    // wait for the background write to finish, rethrows its errors
+    void wait();
+
+  private:
+
+    void flushTask( const ProcessorGroup *,
+                    const PatchSubset    *,
+                    const MaterialSubset *,
+                    DataWarehouse        *,
+                    DataWarehouse        *,
+                    Output               * output );
+
+    void openFile();
+
+    std::vector<char> schemaHeader() const;
+
+    void writeBlock( std::vector<double> rows,
+                     const int64_t       nRows,
+                     const int64_t       offset );
+
+    const ProcessorGroup * d_myworld;
+    std::string            d_moduleName;
+    std::string            d_filename;
+
+    std::vector<std::string> d_columnNames;
+    std::vector<ColumnType>  d_columnTypes;
+
+    int d_flushInterval  {10};
+    int d_ranksPerWriter {32};
+    int d_nCalls         {0};
+
+    // rows waiting to be flushed, row major
+    std::mutex          d_bufferLock;
+    std::vector<double> d_buffer;
+
+    // writer state
+    MPI_Comm    d_groupComm  {MPI_COMM_NULL};
+    bool        d_isWriter   {false};
+    bool        d_isOpen     {false};
+    int         d_fd         {-1};
+    int64_t     d_fileEnd    {0};
+    std::thread d_writeThread;
+    std::exception_ptr d_writeError {nullptr};
+  };
+}
+
+#endif
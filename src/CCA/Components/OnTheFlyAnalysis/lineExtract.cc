@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/OnTheFlyAnalysis/lineExtract.h>
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
 #include <CCA/Components/OnTheFlyAnalysis/FileInfoVar.h>
 
 #include <Core/Grid/Variables/PerPatchVars.h>
@@ -82,6 +83,7 @@ lineExtract::~lineExtract()
   VarLabel::destroy(ps_lb->lastWriteTimeLabel);
   VarLabel::destroy(ps_lb->fileVarsStructLabel);
   delete ps_lb;
+  delete d_binaryOutput;
 
   // delete each line
   vector<line*>::iterator iter;
@@ -326,6 +328,53 @@ void lineExtract::problemSetup(const ProblemSpecP& ,
     l->stepSize = stepSize;
     d_lines.push_back(l);
   }
+
+  //__________________________________
+  //  Binary output: one file for all lines, the series is the line index.
+  //  The columns are in the same order as the text files.
+  if( AnalysisOutput::isRequested( m_module_spec ) ){
+    d_binaryOutput = scinew AnalysisOutput( d_myworld, "lineExtract" );
+    d_binaryOutput->problemSetup( m_module_spec );
+
+    d_binaryOutput->addColumn( "level" );
+    d_binaryOutput->addColumn( "X_CC" );
+    d_binaryOutput->addColumn( "Y_CC" );
+    d_binaryOutput->addColumn( "Z_CC" );
+
+    addColumns( TypeDescription::CCVariable, TypeDescription::int_type );
+
+    const TypeDescription::Type types[4] = { TypeDescription::CCVariable,   TypeDescription::SFCXVariable,
+                                             TypeDescription::SFCYVariable, TypeDescription::SFCZVariable };
+    for( int t = 0; t < 4; t++ ){
+      addColumns( types[t], TypeDescription::double_type );
+      addColumns( types[t], TypeDescription::Vector );
+    }
+  }
+}
+
+//______________________________________________________________________
+//  add the binary output columns of the variables of this type
+void lineExtract::addColumns( const TypeDescription::Type myType,
+                              const TypeDescription::Type mySubType )
+{
+  for (unsigned int i =0 ; i< d_varLabels.size(); i++) {
+    const Uintah::TypeDescription* td = d_varLabels[i]->typeDescription();
+
+    if( td->getType() != myType || td->getSubType()->getType() != mySubType ){
+      continue;
+    }
+
+    ostringstream name;
+    name << d_varLabels[i]->getName() << "_" << d_varMatl[i];
+
+    if( mySubType == TypeDescription::Vector ){
+      d_binaryOutput->addColumn( name.str() + ".x" );
+      d_binaryOutput->addColumn( name.str() + ".y" );
+      d_binaryOutput->addColumn( name.str() + ".z" );
+    } else {
+      d_binaryOutput->addColumn( name.str() );
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -426,6 +475,11 @@ void lineExtract::scheduleDoAnalysis(SchedulerP   & sched,
   t->computes(ps_lb->fileVarsStructLabel, d_zero_matl);
 
   sched->addTask(t, level->eachPatch(), d_matl_set);
+
+  if( d_binaryOutput ){
+    d_binaryOutput->scheduleFlush( sched.get_rep(), level, d_matl_set,
+                                   ps_lb->lastWriteTimeLabel, m_output );
+  }
 }
 
 //______________________________________________________________________
@@ -613,7 +667,7 @@ void lineExtract::doAnalysis(const ProcessorGroup * pg,
         string levelIndex = li.str();
         string path       = linePath + "/" + levelIndex;
 
-        if( d_isDirCreated.count(path) == 0){
+        if( !d_binaryOutput && d_isDirCreated.count(path) == 0){
           createDirectory(linePath, levelIndex);
           d_isDirCreated.insert(path);
         }
@@ -659,6 +713,27 @@ void lineExtract::doAnalysis(const ProcessorGroup * pg,
             continue;  // just in case - the point-to-cell logic might throw us off on patch boundaries...
 
           IntVector c = *iter;
+
+          //__________________________________
+          //  buffer the row, it's written by AnalysisOutput::flush
+          if( d_binaryOutput ){
+            Point here = patch->cellPosition(c);
+
+            vector<double> row = { (double) level->getIndex(), here.x(), here.y(), here.z() };
+
+            for (unsigned int i=0 ; i< CC_integer_data.size(); i++) {
+              row.push_back( CC_integer_data[i][c] );
+            }
+
+            append_Arrays( row, c, CC_double_data,   CC_Vector_data);
+            append_Arrays( row, c, SFCX_double_data, SFCX_Vector_data);
+            append_Arrays( row, c, SFCY_double_data, SFCY_Vector_data);
+            append_Arrays( row, c, SFCZ_double_data, SFCZ_Vector_data);
+
+            d_binaryOutput->addRow( l, tv.now, row );
+            continue;
+          }
+
           ostringstream fname;
           fname<<path<<"/i"<< c.x() << "_j" << c.y() << "_k"<< c.z();
           string filename = fname.str();
@@ -823,6 +898,25 @@ void lineExtract::fprintf_Arrays( FILE*& fp,
    }
 }
 
+//______________________________________________________________________
+//
+template< class D, class V >
+void lineExtract::append_Arrays( std::vector<double> & row,
+                                 const IntVector     & c,
+                                 const D             & doubleData,
+                                 const V             & VectorData)
+{
+   for (unsigned int i=0 ; i< doubleData.size(); i++) {
+     row.push_back( doubleData[i][c] );
+   }
+
+   for (unsigned int i=0 ; i< VectorData.size(); i++) {
+     row.push_back( VectorData[i][c].x() );
+     row.push_back( VectorData[i][c].y() );
+     row.push_back( VectorData[i][c].z() );
+   }
+}
+
 //______________________________________________________________________
 // create the directory structure   lineName/LevelIndex
 //
@@ -41,6 +41,7 @@
 
 namespace Uintah {
 
+  class AnalysisOutput;
 
   class lineExtract : public AnalysisModule {
   public:
@@ -101,6 +102,15 @@ namespace Uintah {
                          const D&  doubleData,
                          const V&  VectorData);
 
+    template< class D, class V >
+    void append_Arrays( std::vector<double> & row,
+                        const IntVector     & c,
+                        const D             & doubleData,
+                        const V             & VectorData);
+
+    void addColumns( const TypeDescription::Type myType,
+                     const TypeDescription::Type mySubType );
+
     // general labels
     class lineExtractLabel {
     public:
@@ -129,6 +139,8 @@ namespace Uintah {
     MaterialSet     * d_matl_set;
     MaterialSubset  * d_zero_matl;
     std::set<std::string> d_isDirCreated;
+
+    AnalysisOutput  * d_binaryOutput {nullptr};   // <outputFormat> binary
   };
 }
 
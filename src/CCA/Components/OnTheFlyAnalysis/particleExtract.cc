@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/OnTheFlyAnalysis/particleExtract.h>
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
 #include <CCA/Ports/Scheduler.h>
 #include <CCA/Ports/LoadBalancer.h>
 #include <Core/Exceptions/ProblemSetupException.h>
@@ -78,6 +79,7 @@ particleExtract::~particleExtract()
   VarLabel::destroy(ps_lb->filePointerLabel_preReloc);
   delete ps_lb;
   delete M_lb;
+  delete d_binaryOutput;
 }
 
 //______________________________________________________________________
@@ -170,7 +172,48 @@ void particleExtract::problemSetup(const ProblemSpecP& ,
   int matl = d_matl->getDWIndex();
   PState[matl].push_back(         ps_lb->filePointerLabel);
   PState_preReloc[matl].push_back(ps_lb->filePointerLabel_preReloc);
-  
+
+  //__________________________________
+  //  Binary output: one file for all particles, the series is the particle ID.
+  //  The columns are in the same order as the text files.
+  if( AnalysisOutput::isRequested( m_module_spec ) ){
+    d_binaryOutput = scinew AnalysisOutput( d_myworld, "particleExtract" );
+    d_binaryOutput->problemSetup( m_module_spec );
+
+    d_binaryOutput->addColumn( "X" );
+    d_binaryOutput->addColumn( "Y" );
+    d_binaryOutput->addColumn( "Z" );
+
+    const TypeDescription::Type types[4] = { TypeDescription::int_type, TypeDescription::double_type,
+                                             TypeDescription::Vector,   TypeDescription::Matrix3 };
+    for( int t = 0; t < 4; t++ ){
+      for (unsigned int i =0 ; i < d_varLabels.size(); i++) {
+        if( d_varLabels[i]->typeDescription()->getSubType()->getType() != types[t] ){
+          continue;
+        }
+        string name = d_varLabels[i]->getName();
+
+        if( types[t] == TypeDescription::Vector ){
+          d_binaryOutput->addColumn( name + ".x" );
+          d_binaryOutput->addColumn( name + ".y" );
+          d_binaryOutput->addColumn( name + ".z" );
+        }
+        else if( types[t] == TypeDescription::Matrix3 ){
+          for (int row = 0; row<3; row++){
+            for (int col = 0; col<3; col++){
+              ostringstream colName;
+              colName << name << "(" << row << "," << col << ")";
+              d_binaryOutput->addColumn( colName.str() );
+            }
+          }
+        }
+        else {
+          d_binaryOutput->addColumn( name );
+        }
+      }
+    }
+  }
+
   //__________________________________
   //  Warning
   proc0cout << "\n\n______________________________________________________________________" << endl;
@@ -358,6 +401,11 @@ void particleExtract::scheduleDoAnalysis(SchedulerP& sched,
   t->modifies( ps_lb->filePointerLabel );
   
   sched->addTask(t, level->eachPatch(), d_matl_set);
+
+  if( d_binaryOutput ){
+    d_binaryOutput->scheduleFlush( sched.get_rep(), level, d_matl_set,
+                                   ps_lb->lastWriteTimeLabel, m_output );
+  }
 }
 
 //______________________________________________________________________
@@ -483,7 +531,7 @@ particleExtract::doAnalysis( const ProcessorGroup * pg,
       string levelIndex = li.str();
       string path = pPath + "/" + levelIndex;
       
-      if( d_isDirCreated.count(path) == 0){
+      if( !d_binaryOutput && d_isDirCreated.count(path) == 0){
         createDirectory(pPath, levelIndex);
         d_isDirCreated.insert(path);
       }
@@ -495,7 +543,34 @@ particleExtract::doAnalysis( const ProcessorGroup * pg,
         particleIndex idx = *iter;
 
         if (pColor[idx] > d_colorThreshold){
-        
+
+          //__________________________________
+          //  buffer the row, it's written by AnalysisOutput::flush
+          if( d_binaryOutput ){
+            vector<double> row = { px[idx].x(), px[idx].y(), px[idx].z() };
+
+            for (unsigned int i=0 ; i <  integer_data.size(); i++) {
+              row.push_back( integer_data[i][idx] );
+            }
+            for (unsigned int i=0 ; i <  double_data.size(); i++) {
+              row.push_back( double_data[i][idx] );
+            }
+            for (unsigned int i=0 ; i <  Vector_data.size(); i++) {
+              row.push_back( Vector_data[i][idx].x() );
+              row.push_back( Vector_data[i][idx].y() );
+              row.push_back( Vector_data[i][idx].z() );
+            }
+            for (unsigned int i=0 ; i <  Matrix3_data.size(); i++) {
+              for (int r = 0; r<3; r++){
+                for (int c = 0; c<3; c++){
+                  row.push_back( Matrix3_data[i][idx](r,c) );
+                }
+              }
+            }
+            d_binaryOutput->addRow( pid[idx], tv.now, row );
+            continue;
+          }
+
           ostringstream fname;
           fname<<path<<"/"<<pid[idx];
           string filename = fname.str();
@@ -39,7 +39,7 @@
 #include <vector>
 
 namespace Uintah {
-  
+  class AnalysisOutput;
 
 /**************************************
 
@@ -144,7 +144,9 @@ WARNING
     const Material* d_matl;
     MaterialSet* d_matl_set;
     MaterialSubset* d_matl_subset;
-    std::set<std::string> d_isDirCreated;        
+    std::set<std::string> d_isDirCreated;
+
+    AnalysisOutput  * d_binaryOutput {nullptr};   // <outputFormat> binary        
   };
 }
 
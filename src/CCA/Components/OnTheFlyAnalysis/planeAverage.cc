@@ -121,6 +121,7 @@ planeAverage::~planeAverage()
   VarLabel::destroy(d_lb->fileVarsStructLabel);
 
   delete d_lb;
+  delete d_binaryOutput;
 }
 
 //______________________________________________________________________
@@ -318,6 +319,24 @@ void planeAverage::problemSetup(const ProblemSpecP&,
     }
     d_allLevels_planarVars.at(0) = planarVars;
   }
+
+  //__________________________________
+  //  Binary output: one file for all variables and levels.
+  //  The series is the index of the variable in the list of planar variables,
+  //  the ave.y, ave.z columns of doubles are zero.
+  if( d_writeOutput && AnalysisOutput::isRequested( m_module_spec ) ){
+    d_binaryOutput = scinew AnalysisOutput( d_myworld, d_className );
+    d_binaryOutput->problemSetup( m_module_spec );
+
+    d_binaryOutput->addColumn( "level" );
+    d_binaryOutput->addColumn( "X" );
+    d_binaryOutput->addColumn( "Y" );
+    d_binaryOutput->addColumn( "Z" );
+    d_binaryOutput->addColumn( "ave.x" );
+    d_binaryOutput->addColumn( "ave.y" );
+    d_binaryOutput->addColumn( "ave.z" );
+    d_binaryOutput->addColumn( "weight" );
+  }
 }
 
 //______________________________________________________________________
@@ -938,6 +957,11 @@ void planeAverage::sched_writeToFiles(SchedulerP   &    sched,
   if (zeroPatch && zeroPatch->removeReference()) {
     delete zeroPatch;
   }
+
+  if( d_binaryOutput ){
+    d_binaryOutput->scheduleFlush( sched.get_rep(), level, d_matl_set,
+                                   d_lb->lastCompTimeLabel, m_output );
+  }
 }
 
 //______________________________________________________________________
@@ -996,6 +1020,14 @@ void planeAverage::writeToFiles(const ProcessorGroup* pg,
 
       std::vector< std::shared_ptr< planarVarBase > > planarVars = d_allLevels_planarVars[L_indx];
 
+      // buffer the averages, they're written by AnalysisOutput::flush
+      if( d_binaryOutput ){
+        for (unsigned int i =0 ; i < planarVars.size(); i++) {
+          planarVars[i]->bufferAverage( d_binaryOutput, i, L_indx, tv.now );
+        }
+        planarVars.clear();
+      }
+
       for (unsigned int i =0 ; i < planarVars.size(); i++) {
         VarLabel* label = planarVars[i]->label;
         string labelName = label->getName();
@@ -26,6 +26,7 @@
 #ifndef Packages_Uintah_CCA_Components_ontheflyAnalysis_planeAverage_h
 #define Packages_Uintah_CCA_Components_ontheflyAnalysis_planeAverage_h
 #include <CCA/Components/OnTheFlyAnalysis/AnalysisModule.h>
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
 #include <CCA/Ports/DataWarehouse.h>
 #include <CCA/Ports/Output.h>
 #include <Core/Grid/MaterialManager.h>
@@ -237,6 +238,12 @@ ______________________________________________________________________*/
         virtual  void printAverage( FILE* & fp,
                                     const int levelIndex,
                                     const double simTime ) = 0;
+
+        // binary output columns:  level, X, Y, Z, ave.x, ave.y, ave.z, weight
+        virtual  void bufferAverage( AnalysisOutput * out,
+                                     const int64_t    series,
+                                     const int        levelIndex,
+                                     const double     simTime ) = 0;
     };
 
     //  It's simple and straight forward to use a double and vector class
@@ -356,6 +363,31 @@ ______________________________________________________________________*/
             }
           }
         }
+
+        //__________________________________
+        void bufferAverage( AnalysisOutput * out,
+                            const int64_t    series,
+                            const int        levelIndex,
+                            const double     simTime )
+        {
+          for ( unsigned i =0; i< sum.size(); i++ ){
+            double avg = sum[i];
+            double w   = 0.;
+
+            if( weightType == NCELLS ){
+              w   = nCells[i];
+              avg = sum[i]/nCells[i];
+            }
+            else if( weightType == MASS ){
+              w   = weight[i];
+              avg = sum[i]/weight[i];
+            }
+
+            double row[8] = { (double) levelIndex, CC_pos[i].x(), CC_pos[i].y(), CC_pos[i].z(),
+                              avg, 0., 0., w };
+            out->addRow( series, simTime, row );
+          }
+        }
         ~planarVar_double(){}
     };
 
@@ -500,6 +532,31 @@ ______________________________________________________________________*/
             }
           }
         }
+
+        //__________________________________
+        void bufferAverage( AnalysisOutput * out,
+                            const int64_t    series,
+                            const int        levelIndex,
+                            const double     simTime )
+        {
+          for ( unsigned i =0; i< sum.size(); i++ ){
+            Vector avg = sum[i];
+            double w   = 0.;
+
+            if( weightType == NCELLS ){
+              w   = nCells[i];
+              avg = sum[i]/Vector( nCells[i] );
+            }
+            else if( weightType == MASS ){
+              w   = weight[i];
+              avg = sum[i]/Vector( weight[i] );
+            }
+
+            double row[8] = { (double) levelIndex, CC_pos[i].x(), CC_pos[i].y(), CC_pos[i].z(),
+                              avg.x(), avg.y(), avg.z(), w };
+            out->addRow( series, simTime, row );
+          }
+        }
         ~planarVar_Vector(){}
     };
 
@@ -667,6 +724,8 @@ ______________________________________________________________________*/
     const Material*  d_matl;
     
     std::set<std::string> d_isDirCreated;
+
+    AnalysisOutput  * d_binaryOutput {nullptr};   // <outputFormat> binary
     MaterialSubset*       d_zero_matl;
 
     const int d_MAXLEVELS {5};               // HARDCODED
@@ -23,6 +23,7 @@
  */
 
 #include <CCA/Components/OnTheFlyAnalysis/planeExtract.h>
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
 #include <CCA/Ports/Scheduler.h>
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Exceptions/ProblemSetupException.h>
@@ -77,6 +78,7 @@ planeExtract::~planeExtract()
   VarLabel::destroy(d_lb->lastWriteTimeLabel);
   VarLabel::destroy(d_lb->fileVarsStructLabel);
   delete d_lb;
+  delete d_binaryOutput;
 
   // delete each plane
   vector<plane*>::iterator iter;
@@ -314,6 +316,34 @@ void planeExtract::problemSetup(const ProblemSpecP& ,
     p->planeType = planeType;
     d_planes.push_back(p);
   }
+
+  //__________________________________
+  //  Binary output: one file for all planes and variables.
+  //  The series is  plane index * number of variables + variable index,
+  //  the values of doubles and ints are in q0, of Vectors in q0-q2 and
+  //  of Stencil7 (n, s, e, w, t, b, p) in q0-q6.
+  if( AnalysisOutput::isRequested( m_module_spec ) ){
+    d_binaryOutput = scinew AnalysisOutput( d_myworld, "planeExtract" );
+    d_binaryOutput->problemSetup( m_module_spec );
+
+    d_binaryOutput->addColumn( "level" );
+    d_binaryOutput->addColumn( "X" );
+    d_binaryOutput->addColumn( "Y" );
+    d_binaryOutput->addColumn( "Z" );
+
+    for( int q = 0; q < 7; q++ ){
+      ostringstream name;
+      name << "q" << q;
+      d_binaryOutput->addColumn( name.str() );
+    }
+
+    for (unsigned int p =0 ; p < d_planes.size(); p++) {
+      for (unsigned int i =0 ; i < d_varLabels.size(); i++) {
+        proc0cout << "  planeExtract binary output series " << p * d_varLabels.size() + i << ":  "
+                  << d_planes[p]->name << "  " << d_varLabels[i]->getName() << "(" << d_varMatl[i] << ")\n";
+      }
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -398,6 +428,11 @@ void planeExtract::scheduleDoAnalysis(SchedulerP& sched,
 
   sched->addTask(t, level->eachPatch(), d_matl_set );
 
+  if( d_binaryOutput ){
+    d_binaryOutput->scheduleFlush( sched.get_rep(), level, d_matl_set,
+                                   d_lb->lastWriteTimeLabel, m_output );
+  }
+
 }
 
 //______________________________________________________________________
@@ -453,7 +488,7 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
         string levelIndex = li.str();
         string path = planePath + "/" + timestep + "/" + levelIndex;
 
-        if( d_isDirCreated.count(path) == 0 ){
+        if( !d_binaryOutput && d_isDirCreated.count(path) == 0 ){
           createDirectory( planePath, timestep, tv.now, levelIndex );
           d_isDirCreated.insert( path );
         }
@@ -512,8 +547,12 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
 
             //__________________________________
             //  Open the file pointer
-            FILE *fp;
-            createFile(filename, varLabel, matl, fp);
+            FILE *fp = nullptr;
+            const int64_t series = p * d_varLabels.size() + i;
+
+            if( !d_binaryOutput ){
+              createFile(filename, varLabel, matl, fp);
+            }
 
             //__________________________________
             //
@@ -534,19 +573,19 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
                 switch( subtype->getType( )) {
 
                   case Uintah::TypeDescription::double_type:
-                    writeDataD< constCCVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataD< constCCVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::Vector:
-                    writeDataV< constCCVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataV< constCCVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::int_type:
-                    writeDataI< constCCVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataI< constCCVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::Stencil7:
-                    writeDataS7< constCCVariable<Stencil7> >(new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataS7< constCCVariable<Stencil7> >(new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
                   default:
                     throw InternalError("planeExtract: (CCVariable) invalid data type", __FILE__, __LINE__);
@@ -563,15 +602,15 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
                 switch( subtype->getType( )) {
 
                   case Uintah::TypeDescription::double_type:
-                    writeDataD< constSFCXVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataD< constSFCXVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::Vector:
-                    writeDataV< constSFCXVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataV< constSFCXVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::int_type:
-                    writeDataI< constSFCXVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataI< constSFCXVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   default:
@@ -589,15 +628,15 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
                 switch( subtype->getType( )) {
 
                   case Uintah::TypeDescription::double_type:
-                    writeDataD< constSFCYVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataD< constSFCYVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::Vector:
-                    writeDataV< constSFCYVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataV< constSFCYVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::int_type:
-                    writeDataI< constSFCYVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataI< constSFCYVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   default:
@@ -615,15 +654,15 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
                 switch( subtype->getType( )) {
 
                   case Uintah::TypeDescription::double_type:
-                    writeDataD< constSFCZVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataD< constSFCZVariable<double> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::Vector:
-                    writeDataV< constSFCZVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataV< constSFCZVariable<Vector> >(   new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   case Uintah::TypeDescription::int_type:
-                    writeDataI< constSFCZVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp );
+                    writeDataI< constSFCZVariable<int> >(      new_dw, varLabel, matl, patch, offset, iterLim, fp, series, tv.now );
                     break;
 
                   default:
@@ -639,7 +678,9 @@ void planeExtract::doAnalysis(const ProcessorGroup* pg,
                 throw InternalError(warn.str(), __FILE__, __LINE__);
             }
 
-            fclose(fp);
+            if( fp ){
+              fclose(fp);
+            }
           }  // loop over variables
         }  // doWrite
       }  // loop over planes
@@ -771,7 +812,9 @@ void planeExtract::writeDataD( DataWarehouse*  new_dw,
                               const Patch*    patch,
                               const Vector&   offset,
                               CellIterator    iter,
-                              FILE*     fp )
+                              FILE*     fp,
+                              const int64_t   series,
+                              const double    now )
 {
   Tvar Q_var;
   new_dw->get(Q_var, varLabel, indx, patch, Ghost::None, 0);
@@ -781,6 +824,12 @@ void planeExtract::writeDataD( DataWarehouse*  new_dw,
     Point here = patch->cellPosition(c);
     here += offset;
 
+    if( d_binaryOutput ){
+      double q = Q_var[c];
+      bufferRow( patch, here, &q, 1, series, now );
+      continue;
+    }
+
     fprintf(fp,    "%16.15E %16.15E  %16.15E ",here.x(),here.y(),here.z());
     fprintf(fp, "    %16.15E\n",Q_var[c]);
   }
@@ -794,7 +843,9 @@ void planeExtract::writeDataV( DataWarehouse*  new_dw,
                                const Patch*    patch,
                                const Vector&   offset,
                                CellIterator    iter,
-                               FILE*     fp )
+                               FILE*     fp,
+                               const int64_t   series,
+                               const double    now )
 {
 
   Tvar Q_var;
@@ -805,6 +856,12 @@ void planeExtract::writeDataV( DataWarehouse*  new_dw,
     Point here = patch->cellPosition(c);
     here += offset;
 
+    if( d_binaryOutput ){
+      double q[3] = { Q_var[c].x(), Q_var[c].y(), Q_var[c].z() };
+      bufferRow( patch, here, q, 3, series, now );
+      continue;
+    }
+
     fprintf(fp,    "%16.15E %16.15E %16.15E ",here.x(), here.y(), here.z());
     fprintf(fp, "   %16.15E %16.15E %16.15E\n",Q_var[c].x(), Q_var[c].y(), Q_var[c].z() );
   }
@@ -817,7 +874,9 @@ void planeExtract::writeDataI( DataWarehouse*  new_dw,
                                const Patch*    patch,
                                const Vector&   offset,
                                CellIterator    iter,
-                               FILE*     fp )
+                               FILE*     fp,
+                               const int64_t   series,
+                               const double    now )
 {
   Tvar Q_var;
   new_dw->get(Q_var, varLabel, indx, patch, Ghost::None, 0);
@@ -827,6 +886,12 @@ void planeExtract::writeDataI( DataWarehouse*  new_dw,
     Point here = patch->cellPosition(c);
     here += offset;
 
+    if( d_binaryOutput ){
+      double q = Q_var[c];
+      bufferRow( patch, here, &q, 1, series, now );
+      continue;
+    }
+
     fprintf(fp,    "%16.15E %16.15E %16.15E ",here.x(), here.y(), here.z());
     fprintf(fp, "   %i \n",Q_var[c] );
   }
@@ -839,7 +904,9 @@ void planeExtract::writeDataS7( DataWarehouse*  new_dw,
                                const Patch*    patch,
                                const Vector&   offset,
                                CellIterator    iter,
-                               FILE*     fp )
+                               FILE*     fp,
+                               const int64_t   series,
+                               const double    now )
 {
   Tvar Q;
   new_dw->get(Q, varLabel, indx, patch, Ghost::None, 0);
@@ -849,12 +916,36 @@ void planeExtract::writeDataS7( DataWarehouse*  new_dw,
     Point here = patch->cellPosition(c);
     here += offset;
 
+    if( d_binaryOutput ){
+      double q[7] = { Q[c].n, Q[c].s, Q[c].e, Q[c].w, Q[c].t, Q[c].b, Q[c].p };
+      bufferRow( patch, here, q, 7, series, now );
+      continue;
+    }
+
     fprintf(fp,    "%16.15E %16.15E %16.15E ",here.x(), here.y(), here.z());
     fprintf(fp, "   %16.15E %16.15E %16.15E %16.15E %16.15E %16.15E %16.15E \n",
             Q[c].n, Q[c].s, Q[c].e, Q[c].w, Q[c].t, Q[c].b, Q[c].p );
   }
 }
 
+//______________________________________________________________________
+//  buffer the row, it's written by AnalysisOutput::flush.  Unused
+//  value columns are zero.
+void planeExtract::bufferRow( const Patch   * patch,
+                              const Point   & here,
+                              const double  * q,
+                              const int       nq,
+                              const int64_t   series,
+                              const double    now )
+{
+  double row[11] = { (double) patch->getLevel()->getIndex(), here.x(), here.y(), here.z(),
+                     0., 0., 0., 0., 0., 0., 0. };
+
+  std::copy( q, q + nq, &row[4] );
+
+  d_binaryOutput->addRow( series, now, row );
+}
+
 //______________________________________________________________________
 //
 CellIterator
@@ -40,6 +40,8 @@
 #include <vector>
 
 namespace Uintah {
+
+  class AnalysisOutput;
   
 
 /**************************************
@@ -132,7 +134,9 @@ WARNING
                      const Patch*    patch,
                      const Vector&   offset,
                      CellIterator    iter,
-                     FILE*     fp );
+                     FILE*     fp,
+                     const int64_t   series,
+                     const double    now );
                      
     template <class Tvar>     /* Vector */
     void writeDataV( DataWarehouse*  new_dw,
@@ -141,7 +145,9 @@ WARNING
                      const Patch*    patch,
                      const Vector&   offset,
                      CellIterator    iter,
-                     FILE*     fp );
+                     FILE*     fp,
+                     const int64_t   series,
+                     const double    now );
                      
     template <class Tvar>     /* integer */   
     void writeDataI( DataWarehouse*  new_dw,
@@ -150,7 +156,9 @@ WARNING
                      const Patch*    patch,
                      const Vector&   offset,
                      CellIterator    iter,
-                     FILE*     fp );
+                     FILE*     fp,
+                     const int64_t   series,
+                     const double    now );
                      
     template <class Tvar>     /* Stencil7 */
     void writeDataS7( DataWarehouse*  new_dw,
@@ -159,8 +167,17 @@ WARNING
                       const Patch*    patch,
                       const Vector&   offset,
                       CellIterator    iter,
-                      FILE*     fp );
+                      FILE*     fp,
+                     const int64_t   series,
+                     const double    now );
                       
+    void bufferRow( const Patch   * patch,
+                    const Point   & here,
+                    const double  * q,
+                    const int       nq,
+                    const int64_t   series,
+                    const double    now );
+
     CellIterator getIterator( const Uintah::TypeDescription* td, 
                               const Patch* patch,
                               const IntVector& start_idx,
@@ -195,6 +212,8 @@ WARNING
     
     std::vector<plane*>   d_planes;
     std::set<std::string> d_isDirCreated;
+
+    AnalysisOutput  * d_binaryOutput {nullptr};   // <outputFormat> binary
     
     MaterialSet     * d_matl_set;
     MaterialSubset  * d_zero_matl;  
@@ -37,6 +37,7 @@ SRCDIR := CCA/Components/OnTheFlyAnalysis
 SRCS += \
         $(SRCDIR)/AnalysisModuleFactory.cc \
         $(SRCDIR)/AnalysisModule.cc        \
+        $(SRCDIR)/AnalysisOutput.cc        \
         $(SRCDIR)/controlVolume.cc         \
         $(SRCDIR)/controlVolFluxes.cc      \
         $(SRCDIR)/FileInfoVar.cc           \
@@ -25,6 +25,7 @@
 #include <CCA/Components/PostProcessUda/PostProcessUda.h>
 #include <CCA/Components/PostProcessUda/ModuleFactory.h>
 #include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/ProblemSetupException.h>
 
 #include <Core/Grid/SimpleMaterial.h>
 #include <Core/Util/DOUT.hpp>
@@ -105,6 +106,28 @@ void PostProcessUda::problemSetup(const ProblemSpecP& prob_spec,
   d_dataArchive->queryTimesteps( d_udaTimesteps, d_udaTimes );
   d_dataArchive->turnOffXMLCaching();
 
+  //__________________________________
+  //  Read ahead: the data files of the next timesteps are read by a
+  //  background thread while the modules process the current timestep.
+  ProblemSpecP pp_ps = prob_spec->findBlock("PostProcess");
+  ProblemSpecP ra_ps = pp_ps ? pp_ps->findBlock("readAhead") : nullptr;
+
+  if( ra_ps ){
+    int    numTimesteps;
+    double maxMemory_MB;
+    ra_ps->getWithDefault( "numTimesteps", numTimesteps, 2 );
+    ra_ps->getWithDefault( "maxMemory_MB", maxMemory_MB, 1024 );
+
+    if( numTimesteps < 1 || maxMemory_MB <= 0 ){
+      throw ProblemSetupException("ERROR: PostProcessUda: <readAhead> numTimesteps must be >= 1 and maxMemory_MB > 0", __FILE__, __LINE__);
+    }
+
+    d_dataArchive->enableReadAhead( numTimesteps, (size_t)( maxMemory_MB * 1024 * 1024 ) );
+
+    proc0cout << "Reading ahead " << numTimesteps << " timesteps of the original uda, using at most "
+              << maxMemory_MB << " MB per rank\n";
+  }
+
   proc0cout << "Time information from the original uda\n";
   for (unsigned int t = 0; t< d_udaTimesteps.size(); t++ ){
     proc0cout << " *** timesteps " << d_udaTimesteps[t] << " times: " << d_udaTimes[t] << endl;
@@ -316,6 +339,7 @@ void PostProcessUda::readDataArchive(const ProcessorGroup* pg,
   // new dw
   proc0cout << "    NEW_DW  ";
   d_dataArchive->postProcess_ReadUda(pg, d_simTimestep, d_oldGrid, patches, new_dw, m_loadBalancer);
+  d_dataArchive->readAheadAdvance( d_simTimestep );
   d_simTimestep++;
 //  new_dw->print();
 
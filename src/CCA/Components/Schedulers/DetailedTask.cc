@@ -33,6 +33,7 @@
 #endif
 
 #include <Core/Containers/ConsecutiveRangeSet.h>
+#include <Core/Malloc/AllocatorOwners.h>
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
@@ -139,6 +140,9 @@ DetailedTask::doit( const ProcessorGroup                      * pg
     }
   }
 
+  // charge the memory allocated by the task to it (MALLOC_OWNERS)
+  AllocatorOwnerScope allocation_owner( AllocOwnerTask, m_task->getName() );
+
 #ifdef HAVE_CUDA
   // Determine if task will be executed on CPU or GPU
   if ( m_task->usesDevice() ) {
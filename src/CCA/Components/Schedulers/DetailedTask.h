@@ -52,6 +52,7 @@ namespace Uintah {
 class ProcessorGroup;
 class DependencyBatch;
 class DetailedTasks;
+struct ReductionGroup;
 
 
 //_____________________________________________________________________________
@@ -150,6 +151,9 @@ public:
 
   DetailedTasks* getTaskGroup() const { return m_task_group; }
 
+  // non-null when this reduction task is fused with its neighbors, see TaskGraph::createDetailedDependencies
+  ReductionGroup* getReductionGroup() const { return m_reduction_group; }
+
   std::map<DependencyBatch*, DependencyBatch*>& getRequires() { return m_reqs; }
   std::map<DependencyBatch*, DependencyBatch*>& getInternalRequires() { return m_internal_reqs; }
 
@@ -248,6 +252,7 @@ public:
 protected:
 
   friend class TaskGraph;
+  friend class DetailedTasks;
 
 
 private:
@@ -272,6 +277,7 @@ private:
   DependencyBatch                              * m_comp_head { nullptr };
   DependencyBatch                              * m_internal_comp_head { nullptr };
   DetailedTasks                                * m_task_group { nullptr };
+  ReductionGroup                               * m_reduction_group { nullptr };
 
   std::atomic<bool> m_initiated { false };
   std::atomic<bool> m_externally_ready { false };
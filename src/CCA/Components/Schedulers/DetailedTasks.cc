@@ -146,6 +146,10 @@ DetailedTasks::~DetailedTasks()
     delete m_tasks[i];
   }
 
+  for (size_t i = 0; i < m_reduction_groups.size(); i++) {
+    delete m_reduction_groups[i];
+  }
+
   delete m_send_old_data;
 }
 
@@ -999,6 +1003,25 @@ DetailedTasks::initTimestep()
   m_atomic_initial_ready_tasks_size.store(m_initial_ready_tasks.size(), std::memory_order_release);
   incrementDependencyGeneration();
   initializeBatches();
+
+  // an aborted timestep may have left a group partially initiated
+  for (size_t i = 0; i < m_reduction_groups.size(); i++) {
+    m_reduction_groups[i]->m_num_initiated = 0;
+  }
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::addReductionGroup( const std::vector<DetailedTask*> & tasks )
+{
+  ReductionGroup* group = scinew ReductionGroup;
+  group->m_tasks = tasks;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    ASSERT(tasks[i]->getTask()->getType() == Task::Reduction);
+    tasks[i]->m_reduction_group = group;
+  }
+  m_reduction_groups.push_back(group);
 }
 
 //_____________________________________________________________________________
@@ -98,6 +98,17 @@ public:
 };
 
 
+//_____________________________________________________________________________
+//
+// Reduction tasks that are adjacent in the (rank independent) sorted task order.
+// Their MPI reductions are packed into a single collective that is posted once
+// every member has been initiated, see MPIScheduler::initiateReduction().
+struct ReductionGroup {
+  std::vector<DetailedTask*> m_tasks;
+  int                        m_num_initiated { 0 };
+};
+
+
 //_____________________________________________________________________________
 //
 class DetailedTasks {
@@ -162,6 +173,13 @@ public:
 
   void computeLocalTasks();
 
+  void addReductionGroup( const std::vector<DetailedTask*> & tasks );
+
+  int numReductionGroups() const
+  {
+    return static_cast<int>(m_reduction_groups.size());
+  }
+
   int numLocalTasks() const
   {
     return static_cast<int>(m_local_tasks.size());
@@ -356,6 +374,7 @@ private:
   std::vector<DetailedTask*>      m_tasks;
 
   std::vector<DependencyBatch*>   m_dep_batches;
+  std::vector<ReductionGroup*>    m_reduction_groups;
   DetailedDep                   * m_init_req { nullptr };
 
   ParticleExchangeVar             m_particle_sends;
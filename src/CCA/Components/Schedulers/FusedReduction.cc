@@ -0,0 +1,351 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Schedulers/FusedReduction.h>
+#include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Grid/Variables/ReductionVariableBase.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+
+using namespace Uintah;
+
+namespace {
+
+enum FusedOp : int32_t {
+    OpSum = 0
+  , OpMin
+  , OpMax
+  , OpProd
+  , OpLand
+  , OpLor
+};
+
+enum FusedType : int32_t {
+    TypeChar = 0
+  , TypeInt
+  , TypeLong
+  , TypeLongLong
+  , TypeUnsignedLong
+  , TypeFloat
+  , TypeDouble
+};
+
+//______________________________________________________________________
+//
+bool
+fusedOp( MPI_Op op, int & fop )
+{
+  if      ( op == MPI_SUM )  { fop = OpSum;  }
+  else if ( op == MPI_MIN )  { fop = OpMin;  }
+  else if ( op == MPI_MAX )  { fop = OpMax;  }
+  else if ( op == MPI_PROD ) { fop = OpProd; }
+  else if ( op == MPI_LAND ) { fop = OpLand; }
+  else if ( op == MPI_LOR )  { fop = OpLor;  }
+  else {
+    return false;
+  }
+  return true;
+}
+
+//______________________________________________________________________
+//
+bool
+fusedType( MPI_Datatype type, int & ftype )
+{
+  if      ( type == MPI_CHAR )          { ftype = TypeChar;         }
+  else if ( type == MPI_INT )           { ftype = TypeInt;          }
+  else if ( type == MPI_LONG )          { ftype = TypeLong;         }
+  else if ( type == MPI_LONG_LONG )     { ftype = TypeLongLong;     }
+  else if ( type == MPI_UNSIGNED_LONG ) { ftype = TypeUnsignedLong; }
+  else if ( type == MPI_FLOAT )         { ftype = TypeFloat;        }
+  else if ( type == MPI_DOUBLE )        { ftype = TypeDouble;       }
+  else {
+    return false;
+  }
+  return true;
+}
+
+//______________________________________________________________________
+//
+size_t
+typeSize( int ftype )
+{
+  switch ( ftype ) {
+    case TypeChar         : return sizeof(char);
+    case TypeInt          : return sizeof(int);
+    case TypeLong         : return sizeof(long);
+    case TypeLongLong     : return sizeof(long long);
+    case TypeUnsignedLong : return sizeof(unsigned long);
+    case TypeFloat        : return sizeof(float);
+    case TypeDouble       : return sizeof(double);
+  }
+  return 0;
+}
+
+//______________________________________________________________________
+//  Header: number of segments followed by (op, type, count) per segment,
+//  padded so the data starts on an 8 byte boundary.
+size_t
+headerSize( int nsegments )
+{
+  size_t bytes = sizeof(int32_t) * (1 + 3 * nsegments);
+  return (bytes + 7) & ~static_cast<size_t>(7);
+}
+
+//______________________________________________________________________
+//  The buffers are byte streams, so values are moved with memcpy.
+template <typename T>
+void
+combine( int op, const char * in, char * inout, int count )
+{
+  for (int i = 0; i < count; ++i) {
+    T a, b;
+    std::memcpy(&a, in + i * sizeof(T), sizeof(T));
+    std::memcpy(&b, inout + i * sizeof(T), sizeof(T));
+    switch ( op ) {
+      case OpSum  : b = b + a;                  break;
+      case OpMin  : b = std::min(a, b);         break;
+      case OpMax  : b = std::max(a, b);         break;
+      case OpProd : b = b * a;                  break;
+      case OpLand : b = static_cast<T>(a && b); break;
+      case OpLor  : b = static_cast<T>(a || b); break;
+    }
+    std::memcpy(inout + i * sizeof(T), &b, sizeof(T));
+  }
+}
+
+//______________________________________________________________________
+//
+void
+combineBuffer( const char * in, char * inout )
+{
+  int32_t nsegments;
+  std::memcpy(&nsegments, in, sizeof(int32_t));
+
+  const char* data_in    = in + headerSize(nsegments);
+  char*       data_inout = inout + headerSize(nsegments);
+
+  for (int s = 0; s < nsegments; ++s) {
+    int32_t desc[3];
+    std::memcpy(desc, in + sizeof(int32_t) * (1 + 3 * s), sizeof(desc));
+    const int op    = desc[0];
+    const int type  = desc[1];
+    const int count = desc[2];
+
+    switch ( type ) {
+      case TypeChar         : combine<char>         (op, data_in, data_inout, count); break;
+      case TypeInt          : combine<int>          (op, data_in, data_inout, count); break;
+      case TypeLong         : combine<long>         (op, data_in, data_inout, count); break;
+      case TypeLongLong     : combine<long long>    (op, data_in, data_inout, count); break;
+      case TypeUnsignedLong : combine<unsigned long>(op, data_in, data_inout, count); break;
+      case TypeFloat        : combine<float>        (op, data_in, data_inout, count); break;
+      case TypeDouble       : combine<double>       (op, data_in, data_inout, count); break;
+    }
+    const size_t bytes = count * typeSize(type);
+    data_in    += bytes;
+    data_inout += bytes;
+  }
+}
+
+//______________________________________________________________________
+//
+void
+fusedReductionOp( void * invec, void * inoutvec, int * len, MPI_Datatype * datatype )
+{
+  int element_size;
+  MPI_Type_size(*datatype, &element_size);
+
+  for (int e = 0; e < *len; ++e) {
+    combineBuffer(static_cast<const char*>(invec) + e * element_size, static_cast<char*>(inoutvec) + e * element_size);
+  }
+}
+
+//______________________________________________________________________
+//
+MPI_Op
+getFusedReductionOp()
+{
+  static std::once_flag once;
+  static MPI_Op         op = MPI_OP_NULL;
+
+  std::call_once(once, []() { Uintah::MPI::Op_create(fusedReductionOp, 1, &op); });
+
+  return op;
+}
+
+} // namespace
+
+
+//______________________________________________________________________
+//
+FusedReduction::~FusedReduction()
+{
+  if (m_posted && !m_complete) {
+    wait();
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+FusedReduction::add(       OnDemandDataWarehouse * dw
+                   , const VarLabel              * label
+                   , const Level                 * level
+                   , const MaterialSubset        * matls
+                   )
+{
+  ASSERT(!m_posted);
+
+  Segment segment;
+  dw->getReductionVariables(label, level, matls, segment.m_vars);
+
+  MPI_Op       op       = MPI_OP_NULL;
+  MPI_Datatype datatype = MPI_DATATYPE_NULL;
+  segment.m_count = 0;
+
+  for (size_t m = 0; m < segment.m_vars.size(); ++m) {
+    int          count;
+    MPI_Op       var_op       = MPI_OP_NULL;
+    MPI_Datatype var_datatype = MPI_DATATYPE_NULL;
+    segment.m_vars[m]->getMPIInfo(count, var_datatype, var_op);
+    if (m == 0) {
+      op       = var_op;
+      datatype = var_datatype;
+    }
+    else if (op != var_op || datatype != var_datatype) {
+      return false;
+    }
+    segment.m_count += count;
+  }
+
+  if (!fusedOp(op, segment.m_op) || !fusedType(datatype, segment.m_type)) {
+    return false;
+  }
+
+  m_segments.push_back(segment);
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+FusedReduction::post( MPI_Comm comm )
+{
+  ASSERT(!m_posted);
+
+  const int nsegments = static_cast<int>(m_segments.size());
+
+  size_t bytes = headerSize(nsegments);
+  for (auto& segment : m_segments) {
+    bytes += segment.m_count * typeSize(segment.m_type);
+  }
+
+  m_send_buffer.assign(bytes, 0);
+  m_recv_buffer.resize(bytes);
+
+  int32_t n = nsegments;
+  std::memcpy(&m_send_buffer[0], &n, sizeof(int32_t));
+
+  int index = static_cast<int>(headerSize(nsegments));
+  for (int s = 0; s < nsegments; ++s) {
+    const Segment& segment = m_segments[s];
+    int32_t desc[3] = { segment.m_op, segment.m_type, segment.m_count };
+    std::memcpy(&m_send_buffer[sizeof(int32_t) * (1 + 3 * s)], desc, sizeof(desc));
+
+    for (auto var : segment.m_vars) {
+      var->getMPIData(m_send_buffer, index);
+    }
+  }
+  ASSERTEQ(index, static_cast<int>(bytes));
+
+  Uintah::MPI::Type_contiguous(static_cast<int>(bytes), MPI_BYTE, &m_datatype);
+  Uintah::MPI::Type_commit(&m_datatype);
+
+  m_posted = true;
+
+#if UINTAH_ENABLE_MPI3
+  int error = Uintah::MPI::Iallreduce(&m_send_buffer[0], &m_recv_buffer[0], 1, m_datatype, getFusedReductionOp(), comm, &m_request);
+#else
+  int error = Uintah::MPI::Allreduce(&m_send_buffer[0], &m_recv_buffer[0], 1, m_datatype, getFusedReductionOp(), comm);
+  m_complete = true;
+  Uintah::MPI::Type_free(&m_datatype);
+#endif
+
+  if (error) {
+    SCI_THROW(InternalError("FusedReduction: MPI error", __FILE__, __LINE__));
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+FusedReduction::test()
+{
+  ASSERT(m_posted);
+
+  if (!m_complete) {
+    int flag = 0;
+    Uintah::MPI::Test(&m_request, &flag, MPI_STATUS_IGNORE);
+    if (flag) {
+      m_complete = true;
+      Uintah::MPI::Type_free(&m_datatype);
+    }
+  }
+  return m_complete;
+}
+
+//______________________________________________________________________
+//
+void
+FusedReduction::wait()
+{
+  ASSERT(m_posted);
+
+  if (!m_complete) {
+    Uintah::MPI::Wait(&m_request, MPI_STATUS_IGNORE);
+    m_complete = true;
+    Uintah::MPI::Type_free(&m_datatype);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+FusedReduction::unpack()
+{
+  ASSERT(m_complete);
+
+  int index = static_cast<int>(headerSize(static_cast<int>(m_segments.size())));
+  for (auto& segment : m_segments) {
+    for (auto var : segment.m_vars) {
+      var->putMPIData(m_recv_buffer, index);
+    }
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CCA_COMPONENTS_SCHEDULERS_FUSEDREDUCTION_H
+#define CCA_COMPONENTS_SCHEDULERS_FUSEDREDUCTION_H
+
+#include <Core/Grid/Variables/ComputeSet.h>
+#include <Core/Parallel/UintahMPI.h>
+
+#include <sci_defs/mpi_defs.h>
+
+#include <vector>
+
+namespace Uintah {
+
+class Level;
+class OnDemandDataWarehouse;
+class ReductionVariableBase;
+class VarLabel;
+
+/**************************************
+
+CLASS
+   FusedReduction
+
+   Several reduction variables combined into a single MPI_Iallreduce.
+
+GENERAL INFORMATION
+
+   FusedReduction.h
+
+   University of Utah
+
+KEYWORDS
+   Reduction, MPI_Iallreduce
+
+DESCRIPTION
+   Each added reduction becomes a segment of one packed byte buffer. The
+   buffer starts with a header that records the operation, element type
+   and element count of every segment, so a single user-defined MPI_Op can
+   combine sums, minima, maxima and logical reductions in one collective.
+
+   Usage: add() every reduction, then post(), then test() or wait(),
+   and finally unpack() to put the reduced values back in the warehouses.
+   Every rank must add the same reductions in the same order.
+
+****************************************/
+
+class FusedReduction {
+
+  public:
+
+    FusedReduction() = default;
+
+    ~FusedReduction();
+
+    // Adds the reduction of 'label' over 'matls' (null for no materials).
+    // Returns false if a variable uses an MPI type or operation the fused
+    // combiner does not handle; the caller then has to reduce individually.
+    bool add(       OnDemandDataWarehouse * dw
+            , const VarLabel              * label
+            , const Level                 * level
+            , const MaterialSubset        * matls
+            );
+
+    // Packs the buffer and posts the collective. Without MPI-3 support
+    // (UINTAH_ENABLE_MPI3) this is a blocking MPI_Allreduce.
+    void post( MPI_Comm comm );
+
+    // True when the collective has completed.
+    bool test();
+
+    void wait();
+
+    // Copies the reduced values back into the reduction variables.
+    void unpack();
+
+    int numSegments() const { return static_cast<int>(m_segments.size()); }
+
+    int numBytes() const { return static_cast<int>(m_send_buffer.size()); }
+
+  private:
+
+    struct Segment {
+      std::vector<ReductionVariableBase*> m_vars;
+      int                                 m_op;
+      int                                 m_type;
+      int                                 m_count;
+    };
+
+    std::vector<Segment> m_segments;
+    std::vector<char>    m_send_buffer;
+    std::vector<char>    m_recv_buffer;
+    MPI_Datatype         m_datatype{ MPI_DATATYPE_NULL };
+    MPI_Request          m_request{ MPI_REQUEST_NULL };
+    bool                 m_posted{ false };
+    bool                 m_complete{ false };
+
+    // eliminate copy, assignment and move
+    FusedReduction( const FusedReduction & )            = delete;
+    FusedReduction& operator=( const FusedReduction & ) = delete;
+    FusedReduction( FusedReduction && )                 = delete;
+    FusedReduction& operator=( FusedReduction && )      = delete;
+};
+
+} // End namespace Uintah
+
+#endif // CCA_COMPONENTS_SCHEDULERS_FUSEDREDUCTION_H
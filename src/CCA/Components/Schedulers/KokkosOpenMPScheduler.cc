@@ -36,6 +36,7 @@
 #include <Core/Grid/Variables/SFCZVariable.h>
 #include <Core/Parallel/CommunicationList.hpp>
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/ThreadExecutor.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/Timers/Timers.hpp>
 
@@ -45,6 +46,7 @@
   #include <Kokkos_Core.hpp>
 #endif //UINTAH_ENABLE_KOKKOS
 
+#include <algorithm>
 #include <atomic>
 #include <cstring>
 #include <iomanip>
@@ -98,6 +100,12 @@ KokkosOpenMPScheduler::problemSetup( const ProblemSpecP     & prob_spec
   m_num_partitions        = Uintah::Parallel::getNumPartitions();
   m_threads_per_partition = Uintah::Parallel::getThreadsPerPartition();
 
+  // the OpenMP partitions own these cores, component level thread pools
+  // must not add threads on top of them (sub-schedulers share the parent's)
+  if (m_parent_scheduler == nullptr) {
+    ThreadExecutor::reserveThreads( std::max(m_num_partitions, 1) * std::max(m_threads_per_partition, 1) );
+  }
+
   // Default taskReadyQueueAlg
   std::string taskQueueAlg = "";
 
@@ -38,6 +38,7 @@
 #include <Core/Grid/Variables/ComputeSet.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/CommunicationList.hpp>
+#include <Core/Parallel/LoopTileExecutor.h>
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/Parallel/UintahMPI.h>
@@ -262,12 +263,121 @@ MPIScheduler::initiateReduction( DetailedTask* dtask )
   Timers::Simple timer;
 
   timer.start();
-  runReductionTask(dtask);
+  ReductionGroup* group = m_fuse_reductions ? dtask->getReductionGroup() : nullptr;
+  if (group) {
+    initiateFusedReduction(dtask, group);
+  }
+  else {
+    runReductionTask(dtask);
+  }
   timer.stop();
 
   m_mpi_info[TotalReduce] += timer().seconds();
 }
 
+//______________________________________________________________________
+//
+void
+MPIScheduler::initiateFusedReduction( DetailedTask   * dtask
+                                    , ReductionGroup * group
+                                    )
+{
+  {
+    std::lock_guard<Uintah::MasterLock> pending_guard(m_pending_reductions_lock);
+    if (++group->m_num_initiated < static_cast<int>(group->m_tasks.size())) {
+      DOUT(g_reductions, "Rank-" << d_myworld->myRank() << " Deferring Reduction Task: " << dtask->getName());
+      return;
+    }
+    group->m_num_initiated = 0;
+  }
+
+  std::unique_ptr<FusedReduction> reduction(scinew FusedReduction);
+
+  for (auto member : group->m_tasks) {
+    const Task::Dependency* mod = member->getTask()->getModifies();
+    ASSERT(!mod->m_next);
+
+    OnDemandDataWarehouse* dw = m_dws[mod->mapDataWarehouse()].get_rep();
+    if (!reduction->add(dw, mod->m_var, mod->m_reduction_level, mod->m_matls)) {
+      // a type the fused combiner can't handle - the same on every rank
+      for (auto task : group->m_tasks) {
+        runReductionTask(task);
+      }
+      return;
+    }
+  }
+
+  ASSERT(group->m_tasks.front()->getTask()->m_comm >= 0);
+  reduction->post(d_myworld->getGlobalComm(group->m_tasks.front()->getTask()->m_comm));
+
+  DOUT(g_reductions, "Rank-" << d_myworld->myRank() << " Posted fused reduction of " << reduction->numSegments()
+                             << " reduction tasks, " << reduction->numBytes() << " bytes");
+
+  if (m_overlap_reductions) {
+    std::lock_guard<Uintah::MasterLock> pending_guard(m_pending_reductions_lock);
+    m_pending_reductions.push_back(PendingReduction{std::move(reduction), group});
+    m_num_pending_reductions.fetch_add(1, std::memory_order_release);
+  }
+  else {
+    reduction->wait();
+    completeFusedReduction(*reduction, group);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MPIScheduler::completeFusedReduction( FusedReduction & reduction
+                                    , ReductionGroup * group
+                                    )
+{
+  reduction.unpack();
+  for (auto member : group->m_tasks) {
+    member->done(m_dws);
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+MPIScheduler::processFusedReductions( bool wait )
+{
+  if (m_num_pending_reductions.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+
+  Timers::Simple timer;
+  timer.start();
+
+  std::vector<PendingReduction> completed;
+  {
+    std::lock_guard<Uintah::MasterLock> pending_guard(m_pending_reductions_lock);
+    for (auto iter = m_pending_reductions.begin(); iter != m_pending_reductions.end();) {
+      if (wait) {
+        iter->m_reduction->wait();
+      }
+      if (iter->m_reduction->test()) {
+        completed.push_back(std::move(*iter));
+        iter = m_pending_reductions.erase(iter);
+        m_num_pending_reductions.fetch_sub(1, std::memory_order_release);
+      }
+      else {
+        ++iter;
+      }
+    }
+  }
+
+  // done() releases the dependents, so it is called outside the lock
+  for (auto& pending : completed) {
+    completeFusedReduction(*pending.m_reduction, pending.m_group);
+  }
+
+  timer.stop();
+  m_mpi_info[TotalReduce] += timer().seconds();
+
+  return !completed.empty();
+}
+
 //______________________________________________________________________
 //
 void
@@ -365,141 +475,167 @@ MPIScheduler::postMPISends( DetailedTask * dtask
   Timers::Simple send_timer;
   send_timer.start();
 
-  int      my_rank = d_myworld->myRank();
-  MPI_Comm my_comm = d_myworld->getComm();
-
-  DOUT(g_dbg, "Rank-" << my_rank << " postMPISends - task " << *dtask);
+  DOUT(g_dbg, "Rank-" << d_myworld->myRank() << " postMPISends - task " << *dtask);
 
   // Send data to dependents
+  std::vector<DependencyBatch*> batches;
   for (DependencyBatch* batch = dtask->getComputes(); batch != nullptr; batch = batch->m_comp_next) {
+    batches.push_back(batch);
+  }
+
+  // Each batch is packed and its send posted as a tile of its own, so idle
+  // scheduler threads pack the other batches while this thread works on
+  // one, and every send goes out as soon as its batch is packed.  Only
+  // with scheduler threads, i.e. when MPI runs with MPI_THREAD_MULTIPLE.
+  const int num_batches = batches.size();
+  if (num_batches > 1 && LoopTileExecutor::useThreads()) {
+    LoopTileExecutor::run(num_batches, [&](int i) {
+      postMPISend(batches[i], iteration);
+    });
+  }
+  else {
+    for (DependencyBatch* batch : batches) {
+      postMPISend(batch, iteration);
+    }
+  }
+
+  send_timer.stop();
 
-    // Prepare to send a message
+  {
+    std::lock_guard<Uintah::MasterLock> send_time_lock(g_send_time_mutex);
+    m_mpi_info[TotalSend] += send_timer().seconds();
+  }
+
+}  // end postMPISends();
+
+//______________________________________________________________________
+//
+void
+MPIScheduler::postMPISend( DependencyBatch * batch
+                         , int               iteration
+                         )
+{
+  int      my_rank = d_myworld->myRank();
+  MPI_Comm my_comm = d_myworld->getComm();
+
+  // Prepare to send a message
 #ifdef USE_PACKING
-    PackBufferInfo mpibuff;
+  PackBufferInfo mpibuff;
 #else
-    BufferInfo mpibuff;
+  BufferInfo mpibuff;
 #endif
 
-    // Create the MPI type
-    int to = batch->m_to_tasks.front()->getAssignedResourceIndex();
-    ASSERTRANGE(to, 0, d_myworld->nRanks());
+  // Create the MPI type
+  int to = batch->m_to_tasks.front()->getAssignedResourceIndex();
+  ASSERTRANGE(to, 0, d_myworld->nRanks());
 
-    for (DetailedDep* req = batch->m_head; req != nullptr; req = req->m_next) {
+  for (DetailedDep* req = batch->m_head; req != nullptr; req = req->m_next) {
 
-     if ((req->m_comm_condition == DetailedDep::FirstIteration && iteration > 0) || (req->m_comm_condition == DetailedDep::SubsequentIterations
-         && iteration == 0) || (m_no_copy_data_vars.count(req->m_req->m_var->getName()) > 0)) {
-       // See comment in DetailedDep about CommCondition
-       DOUT(g_dbg, "Rank-" << my_rank << "   Ignoring conditional send for " << *req);
-       continue;
-     }
+    if ((req->m_comm_condition == DetailedDep::FirstIteration && iteration > 0) || (req->m_comm_condition == DetailedDep::SubsequentIterations
+        && iteration == 0) || (m_no_copy_data_vars.count(req->m_req->m_var->getName()) > 0)) {
+      // See comment in DetailedDep about CommCondition
+      DOUT(g_dbg, "Rank-" << my_rank << "   Ignoring conditional send for " << *req);
+      continue;
+    }
 
-     // if we send/recv to an output task, don't send/recv if not an output timestep
+    // if we send/recv to an output task, don't send/recv if not an output timestep
 
-     // ARS NOTE: Outputing and Checkpointing may be done out of snyc
-     // now. I.e. turned on just before it happens rather than turned
-     // on before the task graph execution.  As such, one should also
-     // be checking:
-     
-     // m_application->activeReductionVariable( "outputInterval" );
-     // m_application->activeReductionVariable( "checkpointInterval" );
-      
-     // However, if active the code below would be called regardless
-     // if an output or checkpoint time step or not. Not sure that is
-     // desired but not sure of the effect of not calling it and doing
-     // an out of sync output or checkpoint.
-     if (req->m_to_tasks.front()->getTask()->getType() == Task::Output &&
-         !m_output->isOutputTimeStep() && !m_output->isCheckpointTimeStep()) {
-       DOUT(g_dbg, "Rank-" << my_rank << "   Ignoring non-output-timestep send for " << *req);
-       continue;
-     }
-
-      OnDemandDataWarehouse* dw = m_dws[req->m_req->mapDataWarehouse()].get_rep();
-
-      DOUT(g_dbg, "Rank-" << my_rank << " --> sending " << *req << ", ghost type: " << "\""
-               << Ghost::getGhostTypeName(req->m_req->m_gtype) << "\", " << "num req ghost "
-               << Ghost::getGhostTypeName(req->m_req->m_gtype) << ": " << req->m_req->m_num_ghost_cells
-               << ", Ghost::direction: " << Ghost::getGhostTypeDir(req->m_req->m_gtype)
-               << ", from dw " << dw->getID());
-
-      // the load balancer is used to determine where data was in the
-      // old DW on the prev timestep, so pass it in if the particle
-      // data is in the old DW
-      const VarLabel        * posLabel;
-      OnDemandDataWarehouse * posDW;
-
-      if( !m_reloc_new_pos_label && m_parent_scheduler ) {
-        posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::ParentOldDW)].get_rep();
-        posLabel = m_parent_scheduler->m_reloc_new_pos_label;
+    // ARS NOTE: Outputing and Checkpointing may be done out of snyc
+    // now. I.e. turned on just before it happens rather than turned
+    // on before the task graph execution.  As such, one should also
+    // be checking:
+
+    // m_application->activeReductionVariable( "outputInterval" );
+    // m_application->activeReductionVariable( "checkpointInterval" );
+
+    // However, if active the code below would be called regardless
+    // if an output or checkpoint time step or not. Not sure that is
+    // desired but not sure of the effect of not calling it and doing
+    // an out of sync output or checkpoint.
+    if (req->m_to_tasks.front()->getTask()->getType() == Task::Output &&
+        !m_output->isOutputTimeStep() && !m_output->isCheckpointTimeStep()) {
+      DOUT(g_dbg, "Rank-" << my_rank << "   Ignoring non-output-timestep send for " << *req);
+      continue;
+    }
+
+    OnDemandDataWarehouse* dw = m_dws[req->m_req->mapDataWarehouse()].get_rep();
+
+    DOUT(g_dbg, "Rank-" << my_rank << " --> sending " << *req << ", ghost type: " << "\""
+                << Ghost::getGhostTypeName(req->m_req->m_gtype) << "\", " << "num req ghost "
+                << Ghost::getGhostTypeName(req->m_req->m_gtype) << ": " << req->m_req->m_num_ghost_cells
+                << ", Ghost::direction: " << Ghost::getGhostTypeDir(req->m_req->m_gtype)
+                << ", from dw " << dw->getID());
+
+    // the load balancer is used to determine where data was in the
+    // old DW on the prev timestep, so pass it in if the particle
+    // data is in the old DW
+    const VarLabel        * posLabel;
+    OnDemandDataWarehouse * posDW;
+
+    if( !m_reloc_new_pos_label && m_parent_scheduler ) {
+      posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::ParentOldDW)].get_rep();
+      posLabel = m_parent_scheduler->m_reloc_new_pos_label;
+    }
+    else {
+      // on an output task (and only on one) we require particle
+      // variables from the NewDW
+      if (req->m_to_tasks.front()->getTask()->getType() == Task::Output) {
+        posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::NewDW)].get_rep();
       }
       else {
-        // on an output task (and only on one) we require particle
-        // variables from the NewDW
-        if (req->m_to_tasks.front()->getTask()->getType() == Task::Output) {
-          posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::NewDW)].get_rep();
-        }
-        else {
-          posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::OldDW)].get_rep();
-        }
-        posLabel = m_reloc_new_pos_label;
-      }
-
-      MPIScheduler* top = this;
-      while( top->m_parent_scheduler ) {
-        top = top->m_parent_scheduler;
+        posDW = m_dws[req->m_req->m_task->mapDataWarehouse(Task::OldDW)].get_rep();
       }
+      posLabel = m_reloc_new_pos_label;
+    }
 
-      dw->sendMPI( batch, posLabel, mpibuff, posDW, req, m_loadBalancer );
+    MPIScheduler* top = this;
+    while( top->m_parent_scheduler ) {
+      top = top->m_parent_scheduler;
     }
 
-    // Post the send
-    if (mpibuff.count() > 0) {
-      ASSERT(batch->m_message_tag > 0);
-      void* buf = nullptr;
-      int count;
-      MPI_Datatype datatype;
+    dw->sendMPI( batch, posLabel, mpibuff, posDW, req, m_loadBalancer );
+  }
+
+  // Post the send
+  if (mpibuff.count() > 0) {
+    ASSERT(batch->m_message_tag > 0);
+    void* buf = nullptr;
+    int count;
+    MPI_Datatype datatype;
 
 #ifdef USE_PACKING
-      mpibuff.get_type(buf, count, datatype, my_comm);
-      mpibuff.pack(my_comm, count);
+    mpibuff.get_type(buf, count, datatype, my_comm);
+    mpibuff.pack(my_comm, count);
 #else
-      mpibuff.get_type(buf, count, datatype);
+    mpibuff.get_type(buf, count, datatype);
 #endif
-      if (!buf) {
-        printf("postMPISends() - ERROR, the send MPI buffer is nullptr\n");
-        SCI_THROW( InternalError("The send MPI buffer is null", __FILE__, __LINE__) );
-      }
-      DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting send for message number " << batch->m_message_tag
-                              << " to   rank-" << to << ", length: " << count << " (bytes)");
-
-      m_num_messages++;
-      int typeSize;
-
-      Uintah::MPI::Type_size(datatype, &typeSize);
+    if (!buf) {
+      printf("postMPISends() - ERROR, the send MPI buffer is nullptr\n");
+      SCI_THROW( InternalError("The send MPI buffer is null", __FILE__, __LINE__) );
+    }
+    DOUT(g_mpi_dbg, "Rank-" << my_rank << " Posting send for message number " << batch->m_message_tag
+                            << " to   rank-" << to << ", length: " << count << " (bytes)");
 
-      {
-        std::lock_guard<Uintah::MasterLock> msg_vol_lock(g_msg_vol_mutex);
-        m_message_volume += count * typeSize;
-      }
+    m_num_messages++;
+    int typeSize;
 
-      //---------------------------------------------------------------------------
-      // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
-      //---------------------------------------------------------------------------
-      CommRequestPool::iterator comm_sends_iter = m_sends.emplace(new SendHandle(mpibuff.takeSendlist()));
-      Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
-      comm_sends_iter.clear();
-      //---------------------------------------------------------------------------
+    Uintah::MPI::Type_size(datatype, &typeSize);
 
+    {
+      std::lock_guard<Uintah::MasterLock> msg_vol_lock(g_msg_vol_mutex);
+      m_message_volume += count * typeSize;
     }
-  }  // end for (DependencyBatch* batch = task->getComputes())
 
-  send_timer.stop();
+    //---------------------------------------------------------------------------
+    // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
+    //---------------------------------------------------------------------------
+    CommRequestPool::iterator comm_sends_iter = m_sends.emplace(new SendHandle(mpibuff.takeSendlist()));
+    Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+    comm_sends_iter.clear();
+    //---------------------------------------------------------------------------
 
-  {
-    std::lock_guard<Uintah::MasterLock> send_time_lock(g_send_time_mutex);
-    m_mpi_info[TotalSend] += send_timer().seconds();
   }
-
-}  // end postMPISends();
+}  // end postMPISend();
 
 //______________________________________________________________________
 //
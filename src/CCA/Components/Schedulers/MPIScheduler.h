@@ -27,14 +27,19 @@
 
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 #include <CCA/Components/Schedulers/DetailedTask.h>
+#include <CCA/Components/Schedulers/FusedReduction.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouseP.h>
 #include <CCA/Ports/DataWarehouseP.h>
 
 #include <Core/Parallel/CommunicationList.hpp>
+#include <Core/Parallel/MasterLock.h>
 #include <Core/Util/InfoMapper.h>
 #include <Core/Util/Timers/Timers.hpp>
 
+#include <atomic>
 #include <fstream>
+#include <list>
+#include <memory>
 #include <vector>
 
 namespace Uintah {
@@ -82,6 +87,9 @@ class MPIScheduler : public SchedulerCommon {
 
             void postMPISends( DetailedTask* dtask, int iteration );
 
+            // pack one batch of a task's computes and post its send
+            void postMPISend( DependencyBatch* batch, int iteration );
+
             void postMPIRecvs( DetailedTask* dtask, bool only_old_recvs, int abort_point, int iteration );
 
             void runTask( DetailedTask* dtask, int iteration );
@@ -95,8 +103,14 @@ class MPIScheduler : public SchedulerCommon {
     }
 
     // Performs the reduction task. (In threaded, Unified scheduler, a single worker thread will execute this.)
+    // Reduction tasks of a ReductionGroup are deferred until the last one of the group is initiated,
+    // then the whole group is reduced with a single collective.
     virtual void initiateReduction( DetailedTask* dtask );
 
+    // Completes the fused reductions left in flight (m_overlap_reductions) whose collective
+    // has finished, or all of them if 'wait' is true. Returns true if any were completed.
+    bool processFusedReductions( bool wait );
+
     void computeNetRuntimeStats();
 
     // timing statistics for Uintah infrastructure overhead
@@ -143,9 +157,25 @@ class MPIScheduler : public SchedulerCommon {
     double                      m_message_volume{0.0};
 
     Timers::Simple              m_exec_timer;
+
+    // leave fused reductions in flight instead of waiting for them in initiateReduction()
+    bool                        m_overlap_reductions{false};
   
   private:
 
+    void initiateFusedReduction( DetailedTask * dtask, ReductionGroup * group );
+
+    void completeFusedReduction( FusedReduction & reduction, ReductionGroup * group );
+
+    struct PendingReduction {
+      std::unique_ptr<FusedReduction>   m_reduction;
+      ReductionGroup                  * m_group;
+    };
+
+    Uintah::MasterLock                  m_pending_reductions_lock{};
+    std::list<PendingReduction>         m_pending_reductions{};
+    std::atomic<int>                    m_num_pending_reductions{0};
+
     // eliminate copy, assignment and move
     MPIScheduler( const MPIScheduler & )            = delete;
     MPIScheduler& operator=( const MPIScheduler & ) = delete;
@@ -24,8 +24,10 @@
 
 #include <CCA/Components/Schedulers/MemoryLog.h>
 #include <Core/Grid/Patch.h>
+#include <Core/Malloc/AllocatorOwners.h>
 
 #include <iostream>
+#include <vector>
 
 namespace Uintah {
 
@@ -62,5 +64,25 @@ void logMemory(       std::ostream  & out
   total += size;
 }
 
+void logAllocatorOwners( std::ostream & out )
+{
+  if (!AllocatorTrackingOwners()) {
+    return;
+  }
+
+  const char* kinds[NumAllocOwnerKinds] = { "Variable", "Task" };
+  std::vector<AllocatorOwnerStats> stats;
+
+  for (int kind = 0; kind < NumAllocOwnerKinds; kind++) {
+    AllocatorGetOwnerStats(static_cast<AllocatorOwnerKind>(kind), stats);
+
+    char tab = '\t';
+    for (const auto& owner : stats) {
+      out << "Allocator:" << kinds[kind] << tab << owner.m_name << tab << "inuse " << owner.m_inuse
+          << tab << "highwater " << owner.m_highwater << tab << "nalloc " << owner.m_nalloc << '\n';
+    }
+  }
+}
+
 } // namespace Uintah
 
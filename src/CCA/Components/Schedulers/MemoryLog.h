@@ -36,6 +36,10 @@ namespace Uintah {
 		 const std::string& type, const Patch* patch,
 		 int material, const std::string& elems,
 		 unsigned long size, void* ptr, int dwid=-1);
+
+  // Per variable and per task memory high-water marks recorded by the
+  // allocator (SCI malloc with MALLOC_OWNERS set); writes nothing otherwise.
+  void logAllocatorOwners(std::ostream& out);
 }
 
 #endif
@@ -51,6 +51,7 @@
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Grid/Variables/PSPatchMatlGhost.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Malloc/AllocatorOwners.h>
 #include <Core/OS/ProcessInfo.h>
 #include <Core/Parallel/BufferInfo.h>
 #include <Core/Parallel/CrowdMonitor.hpp>
@@ -850,6 +851,8 @@ OnDemandDataWarehouse::recvMPI(       DependencyBatch       * batch
   int matlIndex = dep->m_matl;
   int my_rank = d_myworld->myRank();
 
+  AllocatorOwnerScope allocation_owner( AllocOwnerVariable, label->getName() );
+
   switch ( label->typeDescription()->getType() ) {
     case TypeDescription::ParticleVariable : {
       IntVector low = dep->m_low;
@@ -943,6 +946,39 @@ OnDemandDataWarehouse::recvMPI(       DependencyBatch       * batch
   }  // end switch( label->getType() );
 }  // end recvMPI()
 
+//______________________________________________________________________
+//
+void
+OnDemandDataWarehouse::getReductionVariables( const VarLabel                       * label
+                                            , const Level                          * level
+                                            , const MaterialSubset                 * matls
+                                            ,       std::vector<ReductionVariableBase*> & vars
+                                            )
+{
+  const int nmatls = matls ? matls->size() : 1;
+  vars.resize( nmatls );
+
+  for( int m = 0; m < nmatls; m++ ) {
+
+    int matlIndex = matls ? matls->get( m ) : -1;
+
+    ReductionVariableBase* var;
+
+    if( m_level_DB.exists( label, matlIndex, level ) ) {
+      var = dynamic_cast<ReductionVariableBase*>( m_level_DB.get( label, matlIndex, level ) );
+    }
+    else {
+      //  Create and initialize the variable if it doesn't exist
+      var = dynamic_cast<ReductionVariableBase*>( label->typeDescription()->createInstance() );
+      var->setBenignValue();
+
+      DOUT(g_mpi_dbg, "Rank-" << d_myworld->myRank() << " reduceMPI: initializing (" <<label->getName() <<")" );
+      m_level_DB.put( label, matlIndex, level, var, d_scheduler->copyTimestep(), true );
+    }
+    vars[m] = var;
+  }
+}
+
 //______________________________________________________________________
 //
 void
@@ -968,28 +1004,14 @@ OnDemandDataWarehouse::reduceMPI( const VarLabel       * label
   MPI_Op op = MPI_OP_NULL;
   MPI_Datatype datatype = MPI_DATATYPE_NULL;
 
-  for( int m = 0; m < nmatls; m++ ) {
-
-    int matlIndex = matls->get( m );
-
-    ReductionVariableBase* var;
-
-    if( m_level_DB.exists( label, matlIndex, level ) ) {
-      var = dynamic_cast<ReductionVariableBase*>( m_level_DB.get( label, matlIndex, level ) );
-    }
-    else {
-      //  Create and initialize the variable if it doesn't exist
-      var = dynamic_cast<ReductionVariableBase*>( label->typeDescription()->createInstance() );
-      var->setBenignValue();
-
-      DOUT(g_mpi_dbg, "Rank-" << d_myworld->myRank() << " reduceMPI: initializing (" <<label->getName() <<")" );
-      m_level_DB.put( label, matlIndex, level, var, d_scheduler->copyTimestep(), true );
-    }
+  std::vector<ReductionVariableBase*> vars;
+  getReductionVariables( label, level, matls, vars );
 
+  for( int m = 0; m < nmatls; m++ ) {
     int sendcount;
     MPI_Datatype senddatatype = MPI_DATATYPE_NULL;
     MPI_Op sendop = MPI_OP_NULL;
-    var->getMPIInfo( sendcount, senddatatype, sendop );
+    vars[m]->getMPIInfo( sendcount, senddatatype, sendop );
     if( m == 0 ) {
       op = sendop;
       datatype = senddatatype;
@@ -1739,6 +1761,8 @@ OnDemandDataWarehouse::allocateAndPut(       ParticleVariableBase & var
     SCI_THROW(InternalError("Particle variable already exists: " + label->getName(), __FILE__, __LINE__));
   }
 
+  AllocatorOwnerScope allocation_owner( AllocOwnerVariable, label->getName() );
+
   var.allocate(pset);
   put(var, label);
 }
@@ -1892,6 +1916,8 @@ OnDemandDataWarehouse::allocateAndPut(       GridVariableBase & var
   checkPutAccess(label, matlIndex, patch, false);
   Patch::VariableBasis basis = Patch::translateTypeToBasis(label->typeDescription()->getType(), false);
 
+  AllocatorOwnerScope allocation_owner( AllocOwnerVariable, label->getName() );
+
   IntVector lowIndex, highIndex;
   IntVector lowOffset, highOffset;
   Patch::getGhostOffsets(var.virtualGetTypeDescription()->getType(), gtype, numGhostCells, lowOffset, highOffset);
@@ -2571,8 +2597,76 @@ OnDemandDataWarehouse::emit(       OutputContext & oc
 {
   checkGetAccess(label, matlIndex, patch);
 
-  Variable* var = nullptr;
   IntVector l, h;
+  Variable* var = getEmitVariable(label, matlIndex, patch, l, h);
+
+  size_t bytes;
+  bytes = var->emit( oc, l, h, label->getCompressionMode() );
+  return bytes;
+}
+
+//______________________________________________________________________
+//
+Variable*
+OnDemandDataWarehouse::emitSnapshot( const VarLabel  * label
+                                   ,       int         matlIndex
+                                   , const Patch     * patch
+                                   ,       IntVector & low
+                                   ,       IntVector & high
+                                   ,       bool        copy
+                                   )
+{
+  checkGetAccess(label, matlIndex, patch);
+
+  Variable* var = getEmitVariable(label, matlIndex, patch, low, high);
+
+  // Grid and particle data can be modified in place later on, e.g. with
+  // getModifiable() on a variable of the next DataWarehouse that this
+  // one's data was transferred to.
+  if (copy) {
+    switch (label->typeDescription()->getType()) {
+      case TypeDescription::NCVariable :
+      case TypeDescription::CCVariable :
+      case TypeDescription::SFCXVariable :
+      case TypeDescription::SFCYVariable :
+      case TypeDescription::SFCZVariable : {
+        GridVariableBase* gv = dynamic_cast<GridVariableBase*>(var);
+        GridVariableBase* snapshot = gv->cloneType();
+        snapshot->allocate(low, high);
+        snapshot->copyPatch(gv, low, high);
+        return snapshot;
+      }
+      case TypeDescription::ParticleVariable : {
+        ParticleVariableBase* pv = dynamic_cast<ParticleVariableBase*>(var);
+        ParticleVariableBase* snapshot = pv->cloneType();
+        snapshot->allocate(pv->getParticleSubset());
+        snapshot->copyData(pv);
+        return snapshot;
+      }
+      default : {
+        // PerPatch, reduction and sole variables are replaced rather
+        // than modified in place
+      }
+    }
+  }
+
+  // Shares the (reference counted) data, so it survives scrubbing
+  Variable* snapshot = label->typeDescription()->createInstance();
+  snapshot->copyPointer(*var);
+  return snapshot;
+}
+
+//______________________________________________________________________
+//
+Variable*
+OnDemandDataWarehouse::getEmitVariable( const VarLabel  * label
+                                      ,       int         matlIndex
+                                      , const Patch     * patch
+                                      ,       IntVector & l
+                                      ,       IntVector & h
+                                      )
+{
+  Variable* var = nullptr;
   if (patch) {
     // Save with the boundary layer, otherwise restarting from the DataArchive won't work.
     patch->computeVariableExtents(label->typeDescription()->getType(), label->getBoundaryLayer(), Ghost::None, 0, l, h);
@@ -2628,9 +2722,7 @@ OnDemandDataWarehouse::emit(       OutputContext & oc
   if (var == nullptr) {
     SCI_THROW(UnknownVariable(label->getName(), getID(), patch, matlIndex, "on emit", __FILE__, __LINE__));
   }
-  size_t bytes;
-  bytes = var->emit( oc, l, h, label->getCompressionMode() );
-  return bytes;
+  return var;
 }
 
 #if HAVE_PIDX
@@ -494,6 +494,14 @@ public:
                      , const Patch         * patch
                      );
 
+  virtual Variable* emitSnapshot( const VarLabel  * label
+                                ,       int         matlIndex
+                                , const Patch     * patch
+                                ,       IntVector & low
+                                ,       IntVector & high
+                                ,       bool        copy
+                                );
+
 
 #if HAVE_PIDX
      void emitPIDX(       PIDXOutputContext & context
@@ -533,6 +541,14 @@ public:
                 ,       int              nComm
                 );
 
+  // The reduction variables of 'label' for each of 'matls' (-1 if matls is null),
+  // creating benign ones for those that were not computed on this rank.
+  void getReductionVariables( const VarLabel                       * label
+                            , const Level                          * level
+                            , const MaterialSubset                 * matls
+                            ,       std::vector<ReductionVariableBase*> & vars
+                            );
+
   // Scrub counter manipulator functions -- when the scrub count goes to zero, the data is deleted
   void setScrubCount( const VarLabel * label
                     ,       int        matlIndex
@@ -688,6 +704,14 @@ private:
                                               , RunningTaskInfo * info
                                               );
 
+  // The variable emit() writes and the extents it writes it with.
+  Variable* getEmitVariable( const VarLabel  * label
+                           ,       int         matlIndex
+                           , const Patch     * patch
+                           ,       IntVector & low
+                           ,       IntVector & high
+                           );
+
   void getGridVar(       GridVariableBase & var
                  , const VarLabel         * label
                  ,       int                matlIndex
@@ -48,6 +48,8 @@
 #include <Core/Grid/Variables/SFCYVariable.h>
 #include <Core/Grid/Variables/SFCZVariable.h>
 #include <Core/Malloc/Allocator.h>
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <Core/OS/ProcessInfo.h>
@@ -58,6 +60,7 @@
 #include <sci_defs/visit_defs.h>
 
 #include <cerrno>
+#include <climits>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -355,6 +358,14 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
 
   m_tracking_vars_print_location = PRINT_AFTER_EXEC;
 
+  // Smallest MPI message (bytes) sent through a derived datatype rather
+  // than packed, -1 (the default) packs everything.  A message sent
+  // directly is read from the variable until the send completes, so this
+  // is opt-in, see USE_PACKING in MPIScheduler.cc.
+  int  pack_threshold         = -1;
+  bool have_pack_threshold    = false;
+  bool measure_pack_threshold = false;
+
   ProblemSpecP params = prob_spec->findBlock("Scheduler");
   if (params) {
     params->getWithDefault("small_messages", m_use_small_messages, true);
@@ -366,6 +377,35 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
       proc0cout << "Using large, combined MPI messages\n";
     }
 
+    params->getWithDefault("fuse_reductions", m_fuse_reductions, true);
+
+    have_pack_threshold = params->get("pack_threshold", pack_threshold) != nullptr;
+    if (have_pack_threshold && pack_threshold < -1) {
+      throw ProblemSetupException("<Scheduler><pack_threshold> must be -1 (always pack) or a message size in bytes", __FILE__, __LINE__);
+    }
+
+    params->getWithDefault("measure_pack_threshold", measure_pack_threshold, false);
+    if (have_pack_threshold && measure_pack_threshold) {
+      throw ProblemSetupException("<Scheduler> takes either <pack_threshold> or <measure_pack_threshold>, not both", __FILE__, __LINE__);
+    }
+
+    // Threaded parallel_for/parallel_reduce over idle scheduler threads
+    ProblemSpecP loops = params->findBlock("ParallelLoops");
+    if (loops) {
+      bool enabled = true;
+      bool deterministic = false;
+      int  tile_size = LoopTileExecutor::getTileSize();
+      loops->getWithDefault("enabled", enabled, true);
+      loops->getWithDefault("deterministic_reductions", deterministic, false);
+      loops->getWithDefault("tile_size", tile_size, tile_size);
+      if (tile_size < 1) {
+        throw ProblemSetupException("<Scheduler><ParallelLoops><tile_size> must be positive", __FILE__, __LINE__);
+      }
+      LoopTileExecutor::setEnabled(enabled);
+      LoopTileExecutor::setDeterministicReductions(deterministic);
+      LoopTileExecutor::setTileSize(tile_size);
+    }
+
     ProblemSpecP track = params->findBlock("VarTracker");
     if (track) {
       track->require("start_time", m_tracking_start_time);
@@ -544,6 +584,22 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
     proc0cout << "Using large, combined MPI messages\n";
   }
 
+  // Every rank reaches this point, the measurement is collective
+  if (have_pack_threshold || measure_pack_threshold || !PackBufferInfo::packThresholdSet()) {
+    if (measure_pack_threshold) {
+      pack_threshold = PackBufferInfo::measurePackThreshold(d_myworld->getComm());
+    }
+    PackBufferInfo::setPackThreshold(pack_threshold);
+  }
+
+  if (PackBufferInfo::getPackThreshold() == INT_MAX) {
+    proc0cout << "Packing all MPI messages\n";
+  }
+  else {
+    proc0cout << "Packing MPI messages smaller than " << PackBufferInfo::getPackThreshold()
+              << " bytes, larger ones are sent with derived datatypes\n";
+  }
+
   m_no_scrub_vars.insert("refineFlag");
   m_no_scrub_vars.insert("refinePatchFlag");
 
@@ -1344,6 +1400,9 @@ SchedulerCommon::logMemoryUse()
   }
 
   *m_mem_logfile << "Total: " << total << '\n';
+
+  logAllocatorOwners(*m_mem_logfile);
+
   m_mem_logfile->flush();
 }
 
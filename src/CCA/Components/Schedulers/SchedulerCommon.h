@@ -342,6 +342,9 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     int                                 m_generation{0};
     int                                 m_dwmap[Task::TotalDWs];
 
+    // whether adjacent reduction tasks share a single MPI collective
+    bool                                m_fuse_reductions{true};
+
     ApplicationInterface * m_application  {nullptr};
     LoadBalancer         * m_loadBalancer {nullptr};
     Output               * m_output       {nullptr};
@@ -677,6 +677,16 @@ TaskGraph::createDetailedDependencies()
   int currphase      = 0;
   int curr_num_comms = 0;
 
+  // Reduction tasks that are adjacent in the sorted task order have no task between them
+  // on any rank, so their reductions can be combined into one collective.
+  std::vector<DetailedTask*> reduction_group;
+  auto close_reduction_group = [&]() {
+    if (reduction_group.size() > 1) {
+      m_detailed_tasks->addReductionGroup(reduction_group);
+    }
+    reduction_group.clear();
+  };
+
   for (auto i = 0; i < num_tasks; i++) {
     DetailedTask* dtask = m_detailed_tasks->getTask(i);
     dtask->m_task->m_phase = currphase;
@@ -687,11 +697,20 @@ TaskGraph::createDetailedDependencies()
       dtask->m_task->m_comm = curr_num_comms;
       curr_num_comms++;
       currphase++;
+
+      if (!reduction_group.empty() && reduction_group.back()->m_task->getSortedOrder() + 1 != dtask->m_task->getSortedOrder()) {
+        close_reduction_group();
+      }
+      reduction_group.push_back(dtask);
     }
-    else if (dtask->m_task->usesMPI()) {
-      currphase++;
+    else {
+      close_reduction_group();
+      if (dtask->m_task->usesMPI()) {
+        currphase++;
+      }
     }
   }
+  close_reduction_group();
 
   // Uintah::MPI::Comm_dup happens here
   m_proc_group->setGlobalComm(curr_num_comms);
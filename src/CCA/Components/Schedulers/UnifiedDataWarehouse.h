@@ -286,6 +286,11 @@ public:
   virtual size_t emit(OutputContext&, const VarLabel* label,
         int matlIndex, const Patch* patch) = 0;
 
+  virtual Variable* emitSnapshot(const VarLabel* label, int matlIndex,
+                                 const Patch* patch,
+                                 IntVector& low, IntVector& high,
+                                 bool copy) = 0;
+
 #if HAVE_PIDX
   virtual void emitPIDX(PIDXOutputContext&,
                         const VarLabel* label,
@@ -35,6 +35,8 @@
 #include <Core/Grid/Variables/SFCYVariable.h>
 #include <Core/Grid/Variables/SFCZVariable.h>
 #include <Core/Parallel/CommunicationList.hpp>
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Parallel/ThreadExecutor.h>
 #include <Core/Parallel/MasterLock.h>
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/Timers/Timers.hpp>
@@ -124,7 +126,6 @@ enum class ThreadState : int
 };
 
 UnifiedSchedulerWorker   * g_runners[MAX_THREADS]        = {};
-std::vector<std::thread>   g_threads                       {};
 volatile ThreadState       g_thread_states[MAX_THREADS]  = {};
 int                        g_cpu_affinities[MAX_THREADS] = {};
 int                        g_num_threads                 = 0;
@@ -132,31 +133,14 @@ int                        g_num_threads                 = 0;
 std::atomic<int> g_run_tasks{0};
 
 
-//______________________________________________________________________
-//
-void set_affinity( const int proc_unit )
-{
-#ifndef __APPLE__
-  //disable affinity on OSX since sched_setaffinity() is not available in OSX API
-  cpu_set_t mask;
-  unsigned int len = sizeof(mask);
-  CPU_ZERO(&mask);
-  CPU_SET(proc_unit, &mask);
-  sched_setaffinity(0, len, &mask);
-#endif
-}
-
-
 //______________________________________________________________________
 //
 void thread_driver( const int tid )
 {
-  // t_tid is a thread_local variable, unique to each std::thread spawned below
+  // t_tid is a thread_local variable, unique to each worker thread
+  // (ThreadExecutor::startWorkers has already pinned it to core tid)
   t_tid = tid;
 
-  // set each TaskWorker thread's affinity
-  set_affinity( g_cpu_affinities[tid] );
-
   try {
     // wait until main thread sets function and changes states
     g_thread_states[tid] = ThreadState::Inactive;
@@ -216,21 +200,17 @@ void init_threads( UnifiedScheduler * sched, int num_threads )
     g_cpu_affinities[i] = i;
   }
 
-  // set main thread's affinity and tid, core-0 and tid-0, respectively
-  set_affinity(g_cpu_affinities[0]);
+  // main thread is tid-0
   t_tid = 0;
 
-  // TaskRunner threads start at g_runners[1], and std::threads start at g_threads[1]
+  // TaskRunner threads start at g_runners[1]
   for (int i = 1; i < g_num_threads; ++i) {
     g_runners[i] = new UnifiedSchedulerWorker(sched, i, g_cpu_affinities[i]);
-    Impl::g_threads.push_back(std::thread(thread_driver, i));
   }
 
-  for (auto& t : Impl::g_threads) {
-    if (t.joinable()) {
-      t.detach();
-    }
-  }
+  // the process-wide executor owns and pins the worker threads, the main
+  // thread goes on core-0
+  ThreadExecutor::startWorkers(num_threads, thread_driver);
 
   thread_fence();
 }
@@ -246,6 +226,8 @@ UnifiedScheduler::UnifiedScheduler( const ProcessorGroup   * myworld
                                   )
   : MPIScheduler(myworld, parentScheduler)
 {
+  // idle threads complete fused reductions while other tasks run
+  m_overlap_reductions = true;
 
 #ifdef HAVE_CUDA
   //__________________________________
@@ -403,6 +385,11 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
         << plural + " for task execution (total task execution threads = "
         << num_threads + 1 << ").\n" << std::endl;
 
+    if (num_threads + 1 > ThreadExecutor::maxThreads()) {
+      std::cout << "WARNING: " << num_threads + 1 << " task execution threads exceed the "
+                << ThreadExecutor::maxThreads() << " cores available to each MPI process.\n" << std::endl;
+    }
+
 #ifdef HAVE_CUDA
     if ( !gpu_ids && Uintah::Parallel::usingDevice() ) {
       cudaError_t retVal;
@@ -446,6 +433,9 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
 
   SchedulerCommon::problemSetup(prob_spec, materialManager);
 
+  // The additional task execution threads pick up parallel loop tiles when idle
+  LoopTileExecutor::setNumHelpers(num_threads);
+
 #ifdef HAVE_CUDA
   // Now pick out the materials out of the file.  This is done with an assumption that there
   // will only be ICE or MPM problems, and no problem will have both ICE and MPM materials in it.
@@ -785,6 +775,9 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
   //------------------------------------------------------------------------------------------------
 
 
+  // fused reductions whose results no local task requires may still be in flight
+  MPIScheduler::processFusedReductions(true);
+
   //---------------------------------------------------------------------------
   // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
   //---------------------------------------------------------------------------
@@ -1192,9 +1185,12 @@ UnifiedScheduler::runTasks( int thread_id )
       /*
        * (1.6)
        *
-       * Otherwise there's nothing to do but process MPI recvs.
+       * Otherwise there's nothing to do but complete fused reductions and process MPI recvs.
        */
       if (!havework) {
+        if (MPIScheduler::processFusedReductions(false)) {
+          continue;
+        }
         if (m_recvs.size() != 0u) {
           havework = true;
           break;
@@ -1203,6 +1199,16 @@ UnifiedScheduler::runTasks( int thread_id )
       if (m_num_tasks_done == m_num_tasks) {
         break;
       }
+
+      /*
+       * (1.7)
+       *
+       * Nothing this thread can run, lend it to the parallel loops of the
+       * tasks running on the other threads.
+       */
+      if (!havework) {
+        LoopTileExecutor::help();
+      }
     } // end while (!havework)
     //g_scheduler_mutex.unlock();
 
@@ -444,6 +444,10 @@ AMRSimulationController::run()
     walltime = m_wall_timers.GetWallTime();
     
   } // end while main time loop (time is not up, etc)
+
+  // Make sure a checkpoint still being written in the background is
+  // complete before exiting.
+  m_output->finishCheckpoint();
   
   // m_ups->releaseDocument();
 
@@ -301,6 +301,9 @@ SimulationController::restartArchiveSetup( void )
       Parallel::exitAll(1);
     }
 
+    // By default the newest checkpoint that can be restored is used
+    const bool newest = ( m_restart_index < 0 );
+
     // Find the right checkpoint timestep to query the grid
     if( indices.size() == 0) {
       std::ostringstream message;
@@ -317,6 +320,21 @@ SimulationController::restartArchiveSetup( void )
       throw InternalError(message.str(), __FILE__, __LINE__);
     }
 
+    // The data of an in-memory checkpoint must be back in the uda
+    // before the restart reads it.  Its copies on the nodes may be gone
+    // (e.g. when relaunched on other nodes) while it is still listed in
+    // the index, the previous checkpoint is used then.
+    while( !m_output->restoreMemoryCheckpoint( restartFromDir, indices[m_restart_index] ) ) {
+      if( !newest || m_restart_index == 0 ) {
+        std::ostringstream message;
+        message << "The in-memory checkpoint of time step " << indices[m_restart_index]
+                << " can not be restored.";
+        throw InternalError(message.str(), __FILE__, __LINE__);
+      }
+      --m_restart_index;
+      proc0cout << "Restarting from the previous checkpoint, time step " << indices[m_restart_index] << "\n";
+    }
+
     m_restart_timestep = indices[m_restart_index];
 
     // Do this call before calling DataArchive::restartInitialize,
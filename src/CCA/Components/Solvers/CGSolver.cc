@@ -38,6 +38,7 @@
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Exceptions/ConvergenceFailure.h>
+#include <Core/Parallel/MasterLock.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
 #include <CCA/Ports/LoadBalancer.h>
@@ -46,7 +47,11 @@
 #include <Core/Math/MinMax.h>
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/Timers/Timers.hpp>
+#include <cmath>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <vector>
 
 using namespace std;
 using namespace Uintah;
@@ -56,163 +61,317 @@ using namespace Uintah;
 
 static DebugStream cout_doing("SOLVER_DOING_COUT", false);
 
-void Mult(Array3<double>& B, const Array3<Stencil7>& A,
-          const Array3<double>& X, CellIterator iter,
-          const IntVector& l, const IntVector& h1, long64& flops, long64& memrefs)
+//______________________________________________________________________
+//  Stencil7 kernels
+//
+//  The kernels walk the box [l,h) one x-row at a time through raw row
+//  pointers so the inner loops are free of index arithmetic and branches.
+//  The west/east terms of the first and last cell of a row are peeled off
+//  and a missing south/north/bottom/top neighbor row (a patch face without
+//  a neighboring patch) is replaced by a row of zeros.  The matrix is seen
+//  through seven coefficient row pointers and a stride, so the same code
+//  serves the Stencil7 array (stride 7) and the structure-of-arrays copy
+//  (stride 1).  The CG vector updates are fused into single sweeps.
+
+// Coefficient row pointers, Stencil7 order: w, e, s, n, b, t, p
+struct StencilRow {
+  const double* c[7];
+};
+
+//__________________________________
+//  Rows of a Stencil7 array
+struct Stencil7Rows {
+  static const int stride = 7;
+
+  Stencil7Rows(const Array3<Stencil7>& A, const IntVector& l) : A(A), lx(l.x()) {}
+
+  void row(int y, int z, StencilRow& r) const {
+    const Stencil7* a = &A[IntVector(lx, y, z)];
+    for(int c=0;c<7;c++){
+      r.c[c] = &(*a)[c];
+    }
+  }
+
+  const Array3<Stencil7>& A;
+  int lx;
+};
+
+//__________________________________
+//  Structure-of-arrays copy of a Stencil7 matrix over [l,h)
+struct Stencil7SoA {
+  static const int stride = 1;
+
+  void load(const Array3<Stencil7>& A, const IntVector& l, const IntVector& h) {
+    low  = l;
+    size = h-l;
+    const size_t n = size_t(size.x())*size.y()*size.z();
+    for(int c=0;c<7;c++){
+      coef[c].resize(n);
+    }
+    size_t i = 0;
+    for(int z=l.z();z<h.z();z++){
+      for(int y=l.y();y<h.y();y++){
+        const Stencil7* a = &A[IntVector(l.x(), y, z)];
+        for(int x=0;x<size.x();x++, i++){
+          for(int c=0;c<7;c++){
+            coef[c][i] = a[x][c];
+          }
+        }
+      }
+    }
+  }
+
+  void row(int y, int z, StencilRow& r) const {
+    const size_t i = (size_t(z-low.z())*size.y() + (y-low.y()))*size.x();
+    for(int c=0;c<7;c++){
+      r.c[c] = &coef[c][i];
+    }
+  }
+
+  IntVector           low;
+  IntVector           size;
+  std::vector<double> coef[7];
+};
+
+//__________________________________
+//  B = A*X over one row, returns the row's contribution to X.B
+template<int S>
+static inline double MultRow(double* B, const StencilRow& a, const double* X,
+                             const double* Xs, const double* Xn,
+                             const double* Xb, const double* Xt,
+                             int nx, bool west, bool east)
 {
-  if(cout_doing.active())
-    cout_doing << "CGSolver::Mult" << endl;
-
-  for(; !iter.done(); ++iter){
-    IntVector idx = *iter;
-    const Stencil7& AA = A[idx];
-    double result = AA.p*X[idx];
-    if(idx.x() > l.x())
-      result += AA.w*X[idx+IntVector(-1,0,0)];
-    if(idx.x() < h1.x())
-      result += AA.e*X[idx+IntVector(1,0,0)];
-    if(idx.y() > l.y())
-      result += AA.s*X[idx+IntVector(0,-1,0)];
-    if(idx.y() < h1.y())
-      result += AA.n*X[idx+IntVector(0,1,0)];
-    if(idx.z() > l.z())
-      result += AA.b*X[idx+IntVector(0,0,-1)];
-    if(idx.z() < h1.z())
-      result += AA.t*X[idx+IntVector(0,0,1)];
-    B[idx] = result;
+  const double* w = a.c[0];
+  const double* e = a.c[1];
+  const double* s = a.c[2];
+  const double* n = a.c[3];
+  const double* b = a.c[4];
+  const double* t = a.c[5];
+  const double* p = a.c[6];
+
+  auto edge = [&](int i) {
+    const int k = i*S;
+    double r = p[k]*X[i];
+    if(i > 0 || west)
+      r += w[k]*X[i-1];
+    if(i < nx-1 || east)
+      r += e[k]*X[i+1];
+    r += s[k]*Xs[i];
+    r += n[k]*Xn[i];
+    r += b[k]*Xb[i];
+    r += t[k]*Xt[i];
+    return r;
+  };
+
+  double dot = 0;
+  B[0] = edge(0);
+  dot += B[0]*X[0];
+
+  for(int i=1;i<nx-1;i++){
+    const int k = i*S;
+    double r = p[k]*X[i];
+    r += w[k]*X[i-1];
+    r += e[k]*X[i+1];
+    r += s[k]*Xs[i];
+    r += n[k]*Xn[i];
+    r += b[k]*Xb[i];
+    r += t[k]*Xt[i];
+    B[i] = r;
+    dot += r*X[i];
+  }
+
+  if(nx > 1){
+    B[nx-1] = edge(nx-1);
+    dot += B[nx-1]*X[nx-1];
   }
-  IntVector diff = iter.end()-iter.begin();
-  flops += 13*diff.x()*diff.y()*diff.z();
-  memrefs += 15L*diff.x()*diff.y()*diff.z()*8L;
+  return dot;
 }
 
-void Mult(Array3<double>& B, const Array3<Stencil7>& A,
-          const Array3<double>& X, CellIterator iter,
-          const IntVector& l, const IntVector& h1, long64& flops,
-          long64& memrefs, double& dotresult)
+//__________________________________
+//  B = A*X, returns X.B.  hasLow/hasHigh flag the faces with a
+//  neighboring patch, whose ghost values of X take part in the product.
+template<class Matrix>
+double StencilMult(Array3<double>& B, const Matrix& A, const Array3<double>& X,
+                   const IntVector& l, const IntVector& h,
+                   const bool hasLow[3], const bool hasHigh[3],
+                   long64& flops, long64& memrefs)
 {
   if(cout_doing.active())
-    cout_doing << "CGSolver::Mult" << endl;
-
-  double dot=0;
-  for(; !iter.done(); ++iter){
-    IntVector idx = *iter;
-    const Stencil7& AA = A[idx];
-    double result = AA.p*X[idx];
-    if(idx.x() > l.x())
-      result += AA.w*X[idx+IntVector(-1,0,0)];
-    if(idx.x() < h1.x())
-      result += AA.e*X[idx+IntVector(1,0,0)];
-    if(idx.y() > l.y())
-      result += AA.s*X[idx+IntVector(0,-1,0)];
-    if(idx.y() < h1.y())
-      result += AA.n*X[idx+IntVector(0,1,0)];
-    if(idx.z() > l.z())
-      result += AA.b*X[idx+IntVector(0,0,-1)];
-    if(idx.z() < h1.z())
-      result += AA.t*X[idx+IntVector(0,0,1)];
-    B[idx] = result;
-    dot+=result*X[idx];
+    cout_doing << "CGSolver::StencilMult" << endl;
+
+  const int nx = h.x()-l.x();
+  std::vector<double> zeros(nx, 0.0);
+  StencilRow a;
+  double dot = 0;
+
+  for(int z=l.z();z<h.z();z++){
+    for(int y=l.y();y<h.y();y++){
+      A.row(y, z, a);
+      const double* Xs = (y > l.y()   || hasLow[1])  ? &X[IntVector(l.x(), y-1, z)] : zeros.data();
+      const double* Xn = (y < h.y()-1 || hasHigh[1]) ? &X[IntVector(l.x(), y+1, z)] : zeros.data();
+      const double* Xb = (z > l.z()   || hasLow[2])  ? &X[IntVector(l.x(), y, z-1)] : zeros.data();
+      const double* Xt = (z < h.z()-1 || hasHigh[2]) ? &X[IntVector(l.x(), y, z+1)] : zeros.data();
+
+      dot += MultRow<Matrix::stride>(&B[IntVector(l.x(), y, z)], a, &X[IntVector(l.x(), y, z)],
+                                     Xs, Xn, Xb, Xt, nx, hasLow[0], hasHigh[0]);
+    }
   }
 
-  dotresult=dot;
-  IntVector diff = iter.end()-iter.begin();
+  IntVector diff = h-l;
   flops += 15*diff.x()*diff.y()*diff.z();
   memrefs += 16L*diff.x()*diff.y()*diff.z()*8L;
+  return dot;
 }
 
-static void Sub(Array3<double>& r, const Array3<double>& a,
-                const Array3<double>& b,
-                CellIterator iter, long64& flops, long64& memrefs)
+//__________________________________
+//  Running norm of the preconditioned residual
+template<CGSolverParams::Norm N>
+static inline void NormAdd(double& err, double v)
 {
-  if(cout_doing.active())
-    cout_doing << "CGSolver::Sub" << endl;
-  for(; !iter.done(); ++iter)
-    r[*iter] = a[*iter]-b[*iter];
-  IntVector diff = iter.end()-iter.begin();
-  flops += diff.x()*diff.y()*diff.z();
-  memrefs += diff.x()*diff.y()*diff.z()*3L*8L;
+  if(N == CGSolverParams::L1){
+    err += std::fabs(v);
+  } else if(N == CGSolverParams::LInfinity){
+    err = Max(err, std::fabs(v));
+  }
 }
 
-void Mult(Array3<double>& r, const Array3<double>& a,
-          const Array3<double>& b,
-          CellIterator iter, long64& flops, long64& memrefs)
+//__________________________________
+//  Start of the iteration, one sweep:
+//    R = B - R   (R holds A*X on entry if hasGuess, otherwise R = B)
+//    diag = 1/Ap,  D = diag*R,  d = R.D,  err = |R|
+template<CGSolverParams::Norm N, class Matrix>
+static void CGStart(Array3<double>& R, Array3<double>& D, Array3<double>& diag,
+                    const Array3<double>& B, const Matrix& A, bool hasGuess,
+                    const IntVector& l, const IntVector& h,
+                    double& dnew, double& err, long64& flops, long64& memrefs)
 {
-  if(cout_doing.active())
-    cout_doing << "CGSolver::Mult" << endl;
-  for(; !iter.done(); ++iter)
-    r[*iter] = a[*iter]*b[*iter];
-  IntVector diff = iter.end()-iter.begin();
-  flops += diff.x()*diff.y()*diff.z();
-  memrefs += diff.x()*diff.y()*diff.z()*3L*8L;
-}
-
+  const int S  = Matrix::stride;
+  const int nx = h.x()-l.x();
+  StencilRow a;
+  double dot = 0;
+  double e   = 0;
+
+  for(int z=l.z();z<h.z();z++){
+    for(int y=l.y();y<h.y();y++){
+      const IntVector idx(l.x(), y, z);
+      A.row(y, z, a);
+      const double* p  = a.c[6];
+      const double* Bp = &B[idx];
+      double* Rp = &R[idx];
+      double* Dp = &D[idx];
+      double* dp = &diag[idx];
+
+      for(int i=0;i<nx;i++){
+        const double r  = hasGuess ? Bp[i]-Rp[i] : Bp[i];
+        const double di = 1./p[i*S];
+        const double d  = r*di;
+        Rp[i] = r;
+        dp[i] = di;
+        Dp[i] = d;
+        dot += r*d;
+        NormAdd<N>(e, r);
+      }
+    }
+  }
+  dnew = dot;
+  err  = e;
 
-static void InverseDiagonal(Array3<double>& r, const Array3<Stencil7>& A,
-                            CellIterator iter, long64& flops, long64& memrefs)
-{
-  if(cout_doing.active())
-    cout_doing << "CGSolver::InverseDiagonal" << endl;
-  for(; !iter.done(); ++iter)
-    r[*iter] = 1./A[*iter].p;
-  IntVector diff = iter.end()-iter.begin();
-  flops += diff.x()*diff.y()*diff.z();
-  memrefs += 2L*diff.x()*diff.y()*diff.z()*8L;
+  IntVector diff = h-l;
+  flops += 6*diff.x()*diff.y()*diff.z();
+  memrefs += 6L*diff.x()*diff.y()*diff.z()*8L;
 }
 
-static double L1(const Array3<double>& a, CellIterator iter, long64& flops,
-                 long64& memrefs)
+//__________________________________
+//  CGStart for the norm selected at run time
+template<class Matrix>
+static void CGStart(CGSolverParams::Norm norm,
+                    Array3<double>& R, Array3<double>& D, Array3<double>& diag,
+                    const Array3<double>& B, const Matrix& A, bool hasGuess,
+                    const IntVector& l, const IntVector& h,
+                    double& dnew, double& err, long64& flops, long64& memrefs)
 {
-  if(cout_doing.active())
-    cout_doing << "CGSolver::L1" << endl;
-  double sum=0;
-  for(; !iter.done(); ++iter)
-    sum += Abs(a[*iter]);
-  IntVector diff = iter.end()-iter.begin();
-  flops += 2*diff.x()*diff.y()*diff.z();
-  memrefs += diff.x()*diff.y()*diff.z()*8L;
-  return sum;
+  switch(norm){
+  case CGSolverParams::L1:
+    CGStart<CGSolverParams::L1>(R, D, diag, B, A, hasGuess, l, h, dnew, err, flops, memrefs);
+    break;
+  case CGSolverParams::L2:
+    CGStart<CGSolverParams::L2>(R, D, diag, B, A, hasGuess, l, h, dnew, err, flops, memrefs);
+    break;
+  case CGSolverParams::LInfinity:
+    CGStart<CGSolverParams::LInfinity>(R, D, diag, B, A, hasGuess, l, h, dnew, err, flops, memrefs);
+    break;
+  }
 }
 
-double LInf(const Array3<double>& a, CellIterator iter, long64& flops,
-            long64& memrefs)
+//__________________________________
+//  CG update, one sweep:
+//    X = a*D + X,  R = -a*Q + R,  Q = diag*R,  d = Q.R,  err = |Q|
+template<CGSolverParams::Norm N>
+static void CGUpdate(Array3<double>& Xnew, Array3<double>& Rnew, Array3<double>& Q,
+                     const Array3<double>& X, const Array3<double>& R,
+                     const Array3<double>& D, const Array3<double>& diag, double a,
+                     const IntVector& l, const IntVector& h,
+                     double& dnew, double& err, long64& flops, long64& memrefs)
 {
   if(cout_doing.active())
-    cout_doing << "CGSolver::Linf" << endl;
-  double max=0;
-  for(; !iter.done(); ++iter)
-    max = Max(max, Abs(a[*iter]));
-  IntVector diff = iter.end()-iter.begin();
-  flops += 2*diff.x()*diff.y()*diff.z();
-  memrefs += diff.x()*diff.y()*diff.z()*8L;
-  return max;
-}
+    cout_doing << "CGSolver::CGUpdate" << endl;
+
+  const int nx = h.x()-l.x();
+  double dot = 0;
+  double e   = 0;
+
+  for(int z=l.z();z<h.z();z++){
+    for(int y=l.y();y<h.y();y++){
+      const IntVector idx(l.x(), y, z);
+      const double* Xp = &X[idx];
+      const double* Rp = &R[idx];
+      const double* Dp = &D[idx];
+      const double* dp = &diag[idx];
+      double* Xn = &Xnew[idx];
+      double* Rn = &Rnew[idx];
+      double* Qp = &Q[idx];
+
+      for(int i=0;i<nx;i++){
+        const double r = -a*Qp[i] + Rp[i];
+        const double q = r*dp[i];
+        Xn[i] = a*Dp[i] + Xp[i];
+        Rn[i] = r;
+        Qp[i] = q;
+        dot += q*r;
+        NormAdd<N>(e, q);
+      }
+    }
+  }
+  dnew = dot;
+  err  = e;
 
-double Dot(const Array3<double>& a, const Array3<double>& b,
-           CellIterator iter, long64& flops, long64& memrefs)
-{
-  if(cout_doing.active())
-    cout_doing << "CGSolver::Dot" << endl;
-  double sum=0;
-  for(; !iter.done(); ++iter)
-    sum += a[*iter]*b[*iter];
-  IntVector diff = iter.end()-iter.begin();
-  flops += 2*diff.x()*diff.y()*diff.z();
-  memrefs += diff.x()*diff.y()*diff.z()*2L*8L;
-  return sum;
+  IntVector diff = h-l;
+  flops += 9*diff.x()*diff.y()*diff.z();
+  memrefs += 8L*diff.x()*diff.y()*diff.z()*8L;
 }
 
+//__________________________________
+//  r = s*a + b
 void ScMult_Add(Array3<double>& r, double s,
                 const Array3<double>& a, const Array3<double>& b,
-                CellIterator iter, long64& flops, long64& memrefs)
+                const IntVector& l, const IntVector& h, long64& flops, long64& memrefs)
 {
   if(cout_doing.active())
     cout_doing << "CGSolver::ScMult_Add" << endl;
 
-  for(; !iter.done(); ++iter){
-    r[*iter] = s*a[*iter]+b[*iter];
+  const int nx = h.x()-l.x();
+  for(int z=l.z();z<h.z();z++){
+    for(int y=l.y();y<h.y();y++){
+      const IntVector idx(l.x(), y, z);
+      const double* ap = &a[idx];
+      const double* bp = &b[idx];
+      double* rp = &r[idx];
+      for(int i=0;i<nx;i++){
+        rp[i] = s*ap[i]+bp[i];
+      }
+    }
   }
-  IntVector diff = iter.end()-iter.begin();
+  IntVector diff = h-l;
   flops += 2*diff.x()*diff.y()*diff.z();
   memrefs += diff.x()*diff.y()*diff.z()*3L*8L;
 }
@@ -331,9 +490,6 @@ public:
         typename GridVarType::double_type Q;
         new_dw->allocateAndPut(Q, Q_label, matl, patch);
 
-        typename GridVarType::matrix_type A;
-        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
-
         typename GridVarType::const_double_type D;
         old_dw->get(D, D_label, matl, patch, Around, 1);
 
@@ -352,25 +508,21 @@ public:
           h = patch->getHighIndex(basis);
         }
 
-        CellIterator iter(l, h);
-
-        IntVector ll(l);
-        IntVector hh(h);
-        ll -= IntVector(patch->getBCType(Patch::xminus) == Patch::Neighbor?1:0,
-            patch->getBCType(Patch::yminus) == Patch::Neighbor?1:0,
-            patch->getBCType(Patch::zminus) == Patch::Neighbor?1:0);
-
-        hh += IntVector(patch->getBCType(Patch::xplus) == Patch::Neighbor?1:0,
-            patch->getBCType(Patch::yplus) == Patch::Neighbor?1:0,
-            patch->getBCType(Patch::zplus) == Patch::Neighbor?1:0);
-        hh -= IntVector(1,1,1);
+        bool hasLow[3], hasHigh[3];
+        getNeighborFaces(patch, hasLow, hasHigh);
 
         // Q = A*D
         long64 flops = 0;
         long64 memrefs = 0;
         // Must be qualified with :: for the IBM xlC compiler.
         double aden;
-        ::Mult(Q, A, D, iter, ll, hh, flops, memrefs, aden);
+        if(params->layout == CGSolverParams::SoA){
+          aden = ::StencilMult(Q, soaMatrix(patch, matl), D, l, h, hasLow, hasHigh, flops, memrefs);
+        } else {
+          typename GridVarType::matrix_type A;
+          A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+          aden = ::StencilMult(Q, Stencil7Rows(A, l), D, l, h, hasLow, hasHigh, flops, memrefs);
+        }
         new_dw->put(sum_vartype(aden), aden_label);
 
         new_dw->put(sumlong_vartype(flops), flop_label);
@@ -406,7 +558,6 @@ public:
           l = patch->getLowIndex(basis);
           h = patch->getHighIndex(basis);
         }
-        CellIterator iter(l, h);
 
         // Step 2 - requires d(old), aden(new) D(old), X(old) R(old)  computes X, R, Q, d
         typename GridVarType::const_double_type D;
@@ -434,34 +585,22 @@ public:
         long64 memrefs = 0;
         double a=d/aden;
 
-        // X = a*D+X
-        ::ScMult_Add(Xnew, a, D, X, iter, flops, memrefs);
-        // R = -a*Q+R
-        ::ScMult_Add(Rnew, -a, Q, R, iter, flops, memrefs);
-
-        // Simple Preconditioning...
-        ::Mult(Q, Rnew, diagonal, iter, flops, memrefs);
-
-        // Calculate coefficient bk and direction vectors p and pp
-        double dnew = ::Dot(Q, Rnew, iter, flops, memrefs);
-
-        // Calculate error term
+        // X = a*D+X, R = -a*Q+R, Q = diagonal*R (simple preconditioning)
+        // and the coefficient bk and error term, all in one sweep
+        double dnew;
+        double err;
 
         switch(params->norm){
         case CGSolverParams::L1:
-          {
-            double err = ::L1(Q, iter, flops, memrefs);
-            new_dw->put(sum_vartype(err), err_label);
-          }
+          ::CGUpdate<CGSolverParams::L1>(Xnew, Rnew, Q, X, R, D, diagonal, a, l, h, dnew, err, flops, memrefs);
+          new_dw->put(sum_vartype(err), err_label);
           break;
         case CGSolverParams::L2:
-          // Nothing...
+          ::CGUpdate<CGSolverParams::L2>(Xnew, Rnew, Q, X, R, D, diagonal, a, l, h, dnew, err, flops, memrefs);
           break;
         case CGSolverParams::LInfinity:
-          {
-            double err = ::LInf(Q, iter, flops, memrefs);
-            new_dw->put(max_vartype(err), err_label);
-          }
+          ::CGUpdate<CGSolverParams::LInfinity>(Xnew, Rnew, Q, X, R, D, diagonal, a, l, h, dnew, err, flops, memrefs);
+          new_dw->put(max_vartype(err), err_label);
           break;
         }
         new_dw->put(sum_vartype(dnew), d_label);
@@ -499,7 +638,6 @@ public:
           l = patch->getLowIndex(basis);
           h = patch->getHighIndex(basis);
         }
-        CellIterator iter(l, h);
 
         sum_vartype dnew, dold;
         old_dw->get(dold, d_label);
@@ -518,7 +656,7 @@ public:
         new_dw->allocateAndPut(Dnew, D_label, matl, patch, Ghost::None, 0);
         long64 flops = 0;
         long64 memrefs = 0;
-        ::ScMult_Add(Dnew, b, D, Q, iter, flops, memrefs);
+        ::ScMult_Add(Dnew, b, D, Q, l, h, flops, memrefs);
         new_dw->put(sumlong_vartype(flops), flop_label);
         new_dw->put(sumlong_vartype(memrefs), memref_label);
       }
@@ -555,8 +693,6 @@ public:
           l = patch->getLowIndex(basis);
           h = patch->getHighIndex(basis);
         }
-        CellIterator iter(l, h);
-
         typename GridVarType::double_type R, Xnew, diagonal;
         new_dw->allocateAndPut(R, R_label, matl, patch);
         new_dw->allocateAndPut(Xnew, X_label, matl, patch);
@@ -566,66 +702,67 @@ public:
         b_dw->get(B, B_label, matl, patch, Ghost::None, 0);
         A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
 
+        // structure-of-arrays copy of A, used by every iteration of this solve
+        const Stencil7SoA* Asoa = nullptr;
+        if(params->layout == CGSolverParams::SoA){
+          Stencil7SoA soa;
+          soa.load(A, l, h);
+
+          std::lock_guard<Uintah::MasterLock> soa_lock_guard(m_soa_lock);
+          Stencil7SoA& stored = m_soa[std::make_pair(patch->getID(), matl)];
+          stored = std::move(soa);
+          Asoa = &stored;
+        }
+
+        bool hasLow[3], hasHigh[3];
+        getNeighborFaces(patch, hasLow, hasHigh);
+
         long64 flops = 0;
         long64 memrefs = 0;
+        double dnew = 0;
+        double err  = 0;
+
+        typename GridVarType::double_type D;
+        new_dw->allocateAndPut(D, D_label, matl, patch);
+
+        // R = B - A*X, D = R/Ap, d = R.D and the error term in one sweep
+        // Must be qualified with :: for the IBM xlC compiler.
         if(guess_label){
           typename GridVarType::const_double_type X;
           guess_dw->get(X, guess_label, matl, patch, Around, 1);
 
           // R = A*X
-          IntVector ll(l);
-          IntVector hh(h);
-          ll -= IntVector(patch->getBCType(Patch::xminus) == Patch::Neighbor?1:0,
-                          patch->getBCType(Patch::yminus) == Patch::Neighbor?1:0,
-                          patch->getBCType(Patch::zminus) == Patch::Neighbor?1:0);
-
-          hh += IntVector(patch->getBCType(Patch::xplus) == Patch::Neighbor?1:0,
-                          patch->getBCType(Patch::yplus) == Patch::Neighbor?1:0,
-                          patch->getBCType(Patch::zplus) == Patch::Neighbor?1:0);
-          hh -= IntVector(1,1,1);
-
-          ::Mult(R, A, X, iter, ll, hh, flops, memrefs);
-
-          // R = B-R
-          ::Sub(R, B, R, iter, flops, memrefs);
-          Xnew.copy(X, iter.begin(), iter.end());
+          if(Asoa){
+            ::StencilMult(R, *Asoa, X, l, h, hasLow, hasHigh, flops, memrefs);
+          } else {
+            ::StencilMult(R, Stencil7Rows(A, l), X, l, h, hasLow, hasHigh, flops, memrefs);
+          }
+          Xnew.copy(X, l, h);
         } else {
-          R.copy(B);
           Xnew.initialize(0);
         }
 
-        // D = R/Ap
-        typename GridVarType::double_type D;
-        new_dw->allocateAndPut(D, D_label, matl, patch);
-
-        ::InverseDiagonal(diagonal, A, iter, flops, memrefs);
-        ::Mult(D, R, diagonal, iter, flops, memrefs);
+        if(Asoa){
+          ::CGStart(params->norm, R, D, diagonal, B, *Asoa, guess_label != nullptr, l, h, dnew, err, flops, memrefs);
+        } else {
+          ::CGStart(params->norm, R, D, diagonal, B, Stencil7Rows(A, l), guess_label != nullptr, l, h, dnew, err, flops, memrefs);
+        }
 
-        double dnew = ::Dot(R, D, iter, flops, memrefs);
         new_dw->put(sum_vartype(dnew), d_label);
         new_dw->put( sum_vartype(params->tolerance), tolerance_label );
 
-
         // Calculate error term
         double residualNormalization = params->getResidualNormalizationFactor();
 
         switch(params->norm){
         case CGSolverParams::L1:
-          {
-            double err = ::L1(R, iter, flops, memrefs);
-            err /= residualNormalization;
-            new_dw->put(sum_vartype(err), err_label);
-          }
+          new_dw->put(sum_vartype(err/residualNormalization), err_label);
           break;
         case CGSolverParams::L2:
           // Nothing...
           break;
         case CGSolverParams::LInfinity:
-          {
-            double err = ::LInf(R, iter, flops, memrefs);
-            err /= residualNormalization;
-            new_dw->put(max_vartype(err), err_label);
-          }
+          new_dw->put(max_vartype(err/residualNormalization), err_label);
           break;
         }
 
@@ -748,7 +885,9 @@ public:
       if(cout_doing.active())
         cout_doing << "CGSolver::schedule Step 1" << endl;
       task = scinew Task("CGSolver:step1", this, &CGStencil7<GridVarType>::step1);
-      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+      if(params->layout == CGSolverParams::AoS){
+        task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+      }
       task->requires(Task::OldDW,       D_label, Around, 1);
       task->computes(aden_label);
       task->computes(Q_label);
@@ -875,6 +1014,9 @@ public:
       new_dw->transferFrom(subsched->get_dw(3), X_label, patches, matls);
     }
 
+    // the structure-of-arrays copies of A are rebuilt by the next solve
+    m_soa.clear();
+
     // Restore the scrubbing mode
     old_dw->setScrubbing(old_dw_scrubmode);
     new_dw->setScrubbing(new_dw_scrubmode);
@@ -905,6 +1047,24 @@ public:
     }
   }
 //______________________________________________________________________
+//  Faces of the patch that have a neighboring patch
+  void getNeighborFaces(const Patch* patch, bool hasLow[3], bool hasHigh[3])
+  {
+    hasLow[0]  = patch->getBCType(Patch::xminus) == Patch::Neighbor;
+    hasLow[1]  = patch->getBCType(Patch::yminus) == Patch::Neighbor;
+    hasLow[2]  = patch->getBCType(Patch::zminus) == Patch::Neighbor;
+    hasHigh[0] = patch->getBCType(Patch::xplus)  == Patch::Neighbor;
+    hasHigh[1] = patch->getBCType(Patch::yplus)  == Patch::Neighbor;
+    hasHigh[2] = patch->getBCType(Patch::zplus)  == Patch::Neighbor;
+  }
+
+  const Stencil7SoA& soaMatrix(const Patch* patch, int matl)
+  {
+    std::lock_guard<Uintah::MasterLock> soa_lock_guard(m_soa_lock);
+    return m_soa.at(std::make_pair(patch->getID(), matl));
+  }
+
+//______________________________________________________________________
 //
 private:
   Scheduler* sched;
@@ -933,6 +1093,10 @@ private:
 
   const CGSolverParams* params;
   bool modifies_x;
+
+  // structure-of-arrays copies of A, keyed on (patch ID, matl)
+  std::map<std::pair<int,int>, Stencil7SoA> m_soa;
+  Uintah::MasterLock                         m_soa_lock;
 };
 
 //______________________________________________________________________
@@ -977,6 +1141,16 @@ void CGSolver::readParameters(ProblemSpecP& params_ps,
           throw ProblemSetupException("Unknown norm type: "+norm, __FILE__, __LINE__);
         }
       }
+      string layout;
+      if(param_ps->get("matrix_layout", layout)){
+        if(layout == "AoS" || layout == "aos") {
+          m_params->layout = CGSolverParams::AoS;
+        } else if(layout == "SoA" || layout == "soa") {
+          m_params->layout = CGSolverParams::SoA;
+        } else {
+          throw ProblemSetupException("Unknown matrix layout: "+layout, __FILE__, __LINE__);
+        }
+      }
       string criteria;
       if(param_ps->get("criteria", criteria)){
         if(criteria == "Absolute" || criteria == "absolute") {
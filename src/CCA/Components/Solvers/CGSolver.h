@@ -49,12 +49,21 @@ namespace Uintah {
     };
     
     Criteria criteria;
+
+    // Storage of the matrix during the iteration: the Stencil7 array of the
+    // data warehouse, or a structure-of-arrays copy made once per solve.
+    enum MatrixLayout {
+      AoS, SoA
+    };
+
+    MatrixLayout layout;
     
     CGSolverParams()
       : tolerance(1.e-8)
       , initial_tolerance(1.e-15)
       , norm(L2)
       , criteria(Relative)
+      , layout(AoS)
     {}
     
     ~CGSolverParams() {}
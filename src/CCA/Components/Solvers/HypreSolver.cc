@@ -150,28 +150,244 @@ namespace Uintah {
     }
 
     //---------------------------------------------------------------------------------------------
-    //   Create and populate a Hypre struct vector,
-    HYPRE_StructVector
-    createPopulateHypreVector(   const timeStep_vartype   timeStep
-                               , const bool               recompute
-                               , const bool               do_setup
-                               , const ProcessorGroup   * pg
-                               , const HYPRE_StructGrid & grid
-                               , const PatchSubset      * patches
-                               , const int                matl
-                               , const VarLabel         * Q_label
-                               , DataWarehouse          * Q_dw
-                               , HYPRE_StructVector     * HQ)
+    //  Pack the extents of the patches this rank hands to the hypre grid.  The hypre
+    //  objects of a level are rebuilt when this list changes on any rank.
+    std::vector<int> getPatchLayout( const PatchSubset * patches )
+    {
+      std::vector<int> layout;
+      layout.reserve( 6*patches->size() );
+
+      for(int p=0;p<patches->size();p++){
+        IntVector lo;
+        IntVector hi;
+        getPatchExtents( patches->get(p), lo, hi );
+
+        for(int d=0;d<3;d++){
+          layout.push_back( lo[d] );
+          layout.push_back( hi[d] );
+        }
+      }
+      return layout;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //   Create the hypre grid, stencil, matrix and vectors for the local patches
+    void createHypreObjects( const ProcessorGroup      * pg
+                           , const PatchSubset         * patches
+                           ,       hypre_level_context & ctx )
     {
       //__________________________________
-      // Create the vector
-      if( do_setup ){
-        HYPRE_StructVectorDestroy( *HQ );
+      // Setup grid
+      HYPRE_StructGridCreate(pg->getComm(), 3, &ctx.grid);
+
+      for(int p=0;p<patches->size();p++){
+        const Patch* patch = patches->get(p);
+
+        IntVector lo;
+        IntVector hi;
+        getPatchExtents( patch, lo, hi );
+        hi -= IntVector(1,1,1);
+
+        HYPRE_StructGridSetExtents(ctx.grid, lo.get_pointer(), hi.get_pointer());
+      }
+
+      // Periodic boundaries
+      const Level* level = getLevel(patches);
+      IntVector periodic_vector = level->getPeriodicBoundaries();
+
+      IntVector low, high;
+      level->findCellIndexRange(low, high);
+      IntVector range = high-low;
+
+      int periodic[3];
+      periodic[0] = periodic_vector.x() * range.x();
+      periodic[1] = periodic_vector.y() * range.y();
+      periodic[2] = periodic_vector.z() * range.z();
+      HYPRE_StructGridSetPeriodic(ctx.grid, periodic);
+
+      // Assemble the grid
+      HYPRE_StructGridAssemble(ctx.grid);
+
+      //__________________________________
+      // Create the stencil
+      if( m_params->getSymmetric()){
+
+        HYPRE_StructStencilCreate(3, 4, &ctx.stencil);
+        int offsets[4][3] = {{0,0,0},
+          {-1,0,0},
+          {0,-1,0},
+          {0,0,-1}};
+        for(int i=0;i<4;i++) {
+          HYPRE_StructStencilSetElement(ctx.stencil, i, offsets[i]);
+        }
+
+      } else {
+
+        HYPRE_StructStencilCreate(3, 7, &ctx.stencil);
+        int offsets[7][3] = {{0,0,0},
+          {1,0,0}, {-1,0,0},
+          {0,1,0}, {0,-1,0},
+          {0,0,1}, {0,0,-1}};
+
+        for(int i=0;i<7;i++){
+          HYPRE_StructStencilSetElement(ctx.stencil, i, offsets[i]);
+        }
+      }
+
+      //__________________________________
+      // Create the matrix
+      HYPRE_StructMatrixCreate( pg->getComm(), ctx.grid, ctx.stencil, &ctx.HA );
+      HYPRE_StructMatrixSetSymmetric( ctx.HA, m_params->getSymmetric() );
+      int ghost[] = {1,1,1,1,1,1};
+      HYPRE_StructMatrixSetNumGhost( ctx.HA, ghost );
+      HYPRE_StructMatrixInitialize( ctx.HA );
+
+      //__________________________________
+      // Create the RHS and solution vectors
+      HYPRE_StructVectorCreate( pg->getComm(), ctx.grid, &ctx.HB );
+      HYPRE_StructVectorInitialize( ctx.HB );
+
+      HYPRE_StructVectorCreate( pg->getComm(), ctx.grid, &ctx.HX );
+      HYPRE_StructVectorInitialize( ctx.HX );
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //   Copy the coefficients of A into the existing hypre matrix
+    void setMatrixCoefficients( const PatchSubset        * patches
+                              , const int                  matl
+                              ,       DataWarehouse      * A_dw
+                              ,       HYPRE_StructMatrix   HA )
+    {
+      for(int p=0;p<patches->size();p++) {
+        const Patch* patch = patches->get(p);
+        printTask( patches, patch, cout_doing, "HypreSolver:solve: Set Matrix coefficients" );
+
+        //__________________________________
+        // Get A matrix from the DW
+        typename GridVarType::symmetric_matrix_type AStencil4;
+        typename GridVarType::matrix_type A;
+
+        if ( m_params->getUseStencil4() ){
+          A_dw->get( AStencil4, m_A_label, matl, patch, Ghost::None, 0);
+        } else {
+          A_dw->get( A, m_A_label, matl, patch, Ghost::None, 0);
+        }
+
+        IntVector l;
+        IntVector h;
+        getPatchExtents( patch, l, h );
+
+        //__________________________________
+        // Feed it to Hypre
+        if( m_params->getSymmetric()){
+
+          double* values = scinew double[(h.x()-l.x())*4];
+          int stencil_indices[] = {0,1,2,3};
+
+          // use stencil4 as coefficient matrix. NOTE: This should be templated
+          // on the stencil type. This workaround is to get things moving
+          // until we convince component developers to move to stencil4. You must
+          // set m_params->setUseStencil4(true) when you setup your linear solver
+          // if you want to use stencil4. You must also provide a matrix of type
+          // stencil4 otherwise this will crash.
+          if ( m_params->getUseStencil4()) {
+
+            for(int z=l.z();z<h.z();z++){
+              for(int y=l.y();y<h.y();y++){
+
+                const Stencil4* AA = &AStencil4[IntVector(l.x(), y, z)];
+                double* p = values;
+
+                for(int x=l.x();x<h.x();x++){
+                  *p++ = AA->p;
+                  *p++ = AA->w;
+                  *p++ = AA->s;
+                  *p++ = AA->b;
+                  AA++;
+                }
+                IntVector ll(l.x(), y, z);
+                IntVector hh(h.x()-1, y, z);
+                HYPRE_StructMatrixSetBoxValues(HA,
+                                               ll.get_pointer(), hh.get_pointer(),
+                                               4, stencil_indices, values);
+
+              } // y loop
+            }  // z loop
+
+          } else { // use stencil7
+
+            for(int z=l.z();z<h.z();z++){
+              for(int y=l.y();y<h.y();y++){
+
+                const Stencil7* AA = &A[IntVector(l.x(), y, z)];
+                double* p = values;
+
+                for(int x=l.x();x<h.x();x++){
+                  *p++ = AA->p;
+                  *p++ = AA->w;
+                  *p++ = AA->s;
+                  *p++ = AA->b;
+                  AA++;
+                }
+                IntVector ll(l.x(), y, z);
+                IntVector hh(h.x()-1, y, z);
+                HYPRE_StructMatrixSetBoxValues(HA,
+                                               ll.get_pointer(), hh.get_pointer(),
+                                               4, stencil_indices, values);
+
+              } // y loop
+            }  // z loop
+          }
+          delete[] values;
+        } else {
+          double* values = scinew double[(h.x()-l.x())*7];
+          int stencil_indices[] = {0,1,2,3,4,5,6};
+
+          for(int z=l.z();z<h.z();z++){
+            for(int y=l.y();y<h.y();y++){
+
+              const Stencil7* AA = &A[IntVector(l.x(), y, z)];
+              double* p = values;
+
+              for(int x=l.x();x<h.x();x++){
+                *p++ = AA->p;
+                *p++ = AA->e;
+                *p++ = AA->w;
+                *p++ = AA->n;
+                *p++ = AA->s;
+                *p++ = AA->t;
+                *p++ = AA->b;
+                AA++;
+              }
+
+              IntVector ll(l.x(), y, z);
+              IntVector hh(h.x()-1, y, z);
+              HYPRE_StructMatrixSetBoxValues(HA,
+                                             ll.get_pointer(), hh.get_pointer(),
+                                             7, stencil_indices,
+                                             values);
+            }  // y loop
+          } // z loop
+          delete[] values;
+        }
       }
 
-      if (timeStep == 1 || recompute || do_setup ) {
-        HYPRE_StructVectorCreate( pg->getComm(), grid, HQ );
-        HYPRE_StructVectorInitialize( *HQ );
+      // exchange the ghost coefficients of the updated matrix
+      HYPRE_StructMatrixAssemble(HA);
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //   Populate an existing Hypre struct vector.  Without a label the vector is zeroed.
+    void
+    populateHypreVector( const PatchSubset      * patches
+                       , const int                matl
+                       , const VarLabel         * Q_label
+                       , DataWarehouse          * Q_dw
+                       , HYPRE_StructVector       HQ)
+    {
+      if( !Q_label ){
+        HYPRE_StructVectorSetConstantValues( HQ, 0.0 );
+        return;
       }
 
       for(int p=0;p<patches->size();p++){
@@ -179,42 +395,34 @@ namespace Uintah {
 
         //__________________________________
         // Get Q
-        if( Q_label ){
-          ostringstream msg;
-          msg<< "HypreSolver:createPopulateHypreVector ("<< Q_label->getName() <<")\n";
-          printTask( patches, patch, cout_doing, msg.str() );
+        ostringstream msg;
+        msg<< "HypreSolver:populateHypreVector ("<< Q_label->getName() <<")\n";
+        printTask( patches, patch, cout_doing, msg.str() );
 
-          typename GridVarType::const_double_type Q;
-          Q_dw->get( Q, Q_label, matl, patch, Ghost::None, 0);
+        typename GridVarType::const_double_type Q;
+        Q_dw->get( Q, Q_label, matl, patch, Ghost::None, 0);
 
-          // find box range
-          IntVector lo;
-          IntVector hi;
-          getPatchExtents( patch, lo, hi );
+        // find box range
+        IntVector lo;
+        IntVector hi;
+        getPatchExtents( patch, lo, hi );
 
-          //__________________________________
-          // Feed Q variable to Hypre
-          for(int z=lo.z(); z<hi.z(); z++){
-            for(int y=lo.y(); y<hi.y(); y++){
+        //__________________________________
+        // Feed Q variable to Hypre
+        for(int z=lo.z(); z<hi.z(); z++){
+          for(int y=lo.y(); y<hi.y(); y++){
 
-              IntVector l(lo.x(), y, z);
-              IntVector h(hi.x()-1, y, z);
+            IntVector l(lo.x(), y, z);
+            IntVector h(hi.x()-1, y, z);
 
-              const double* values = &Q[l];
+            const double* values = &Q[l];
 
-              HYPRE_StructVectorSetBoxValues( *HQ,
-                                             l.get_pointer(), h.get_pointer(),
-                                             const_cast<double*>(values));
-            }
+            HYPRE_StructVectorSetBoxValues( HQ,
+                                           l.get_pointer(), h.get_pointer(),
+                                           const_cast<double*>(values));
           }
-        }  // label exist?
+        }
       }  // patch loop
-
-      if (timeStep == 1 || recompute || do_setup){
-        HYPRE_StructVectorAssemble( *HQ );
-      }
-
-      return *HQ;
     }
 
     //---------------------------------------------------------------------------------------------
@@ -271,12 +479,15 @@ namespace Uintah {
       }
 
       //________________________________________________________
-      // Matrix setup frequency - this will destroy and recreate a new Hypre matrix at the specified setupFrequency
+      // Setup frequency - this will redo the solver and preconditioner setup at the specified
+      // setupFrequency.  The hypre grid, matrix and vectors are kept between timesteps and
+      // are only recreated when the patch layout changes.  If precondReuseSteps > 0 it
+      // replaces setupFrequency.
       //
       int suFreq = m_params->getSetupFrequency();
-      bool do_setup = false;
+      bool setupDue = false;
       if (suFreq != 0){
-        do_setup = (timeStep % suFreq == 0);
+        setupDue = (timeStep % suFreq == 0);
       }
 
       //________________________________________________________
@@ -288,13 +499,8 @@ namespace Uintah {
         updateCoefs = (timeStep % updateCoefFreq == 0);
       }
 
-      // if it the first pass through ignore the flags
-      if(timeStep == 1 || recompute){
-        updateCoefs = false;
-        do_setup    = false;
-      }
-
-      //std::cout << "      HypreSolve  timestep: " << timeStep << " recompute: " << recompute << " m_firstPassThrough: " << m_firstPassThrough <<  " m_isFirstSolve: " << m_isFirstSolve <<" do_setup: " << do_setup << " updateCoefs: " << updateCoefs << std::endl;
+      const int    reuseSteps   = m_params->precondReuseSteps;
+      const double refreshRatio = m_params->precondRefreshRatio;
 
       DataWarehouse* A_dw     = new_dw->getOtherDataWarehouse( m_which_A_dw );
       DataWarehouse* b_dw     = new_dw->getOtherDataWarehouse( m_which_b_dw );
@@ -308,220 +514,51 @@ namespace Uintah {
       for(int m = 0;m<matls->size();m++){
         int matl = matls->get(m);
 
-        hypre_BeginTiming(m_tMatVecSetup);
-        //__________________________________
-        // Setup grid
-        HYPRE_StructGrid grid;
-        if (timeStep == 1 || do_setup || recompute) {
-          HYPRE_StructGridCreate(pg->getComm(), 3, &grid);
+        hypre_level_context & ctx = hypre_solver_s->contexts[ std::make_pair( m_level->getIndex(), matl ) ];
 
-          for(int p=0;p<patches->size();p++){
-            const Patch* patch = patches->get(p);
-
-            IntVector lo;
-            IntVector hi;
-            getPatchExtents( patch, lo, hi );
-            hi -= IntVector(1,1,1);
-
-            HYPRE_StructGridSetExtents(grid, lo.get_pointer(), hi.get_pointer());
-          }
-
-          // Periodic boundaries
-          const Level* level = getLevel(patches);
-          IntVector periodic_vector = level->getPeriodicBoundaries();
-
-          IntVector low, high;
-          level->findCellIndexRange(low, high);
-          IntVector range = high-low;
-
-          int periodic[3];
-          periodic[0] = periodic_vector.x() * range.x();
-          periodic[1] = periodic_vector.y() * range.y();
-          periodic[2] = periodic_vector.z() * range.z();
-          HYPRE_StructGridSetPeriodic(grid, periodic);
-
-          // Assemble the grid
-          HYPRE_StructGridAssemble(grid);
-        }
+        hypre_BeginTiming(m_tMatVecSetup);
 
         //__________________________________
-        // Create the stencil
-        HYPRE_StructStencil stencil;
-        if ( timeStep == 1 || do_setup || recompute) {
-          if( m_params->getSymmetric()){
-
-            HYPRE_StructStencilCreate(3, 4, &stencil);
-            int offsets[4][3] = {{0,0,0},
-              {-1,0,0},
-              {0,-1,0},
-              {0,0,-1}};
-            for(int i=0;i<4;i++) {
-              HYPRE_StructStencilSetElement(stencil, i, offsets[i]);
-            }
-
-          } else {
+        // (Re)create the hypre objects if this is the first solve, a recompute
+        // or if the patch layout changed on any rank (regrid).
+        std::vector<int> layout = getPatchLayout( patches );
 
-            HYPRE_StructStencilCreate(3, 7, &stencil);
-            int offsets[7][3] = {{0,0,0},
-              {1,0,0}, {-1,0,0},
-              {0,1,0}, {0,-1,0},
-              {0,0,1}, {0,0,-1}};
+        int rebuild = ( recompute || ctx.grid == nullptr || layout != ctx.layout );
+        Uintah::MPI::Allreduce( MPI_IN_PLACE, &rebuild, 1, MPI_INT, MPI_MAX, pg->getComm() );
 
-            for(int i=0;i<7;i++){
-              HYPRE_StructStencilSetElement(stencil, i, offsets[i]);
-            }
-          }
+        if( rebuild ){
+          hypre_solver_s->destroy( ctx );
+          createHypreObjects( pg, patches, ctx );
+          ctx.layout = layout;
         }
 
         //__________________________________
-        // Create the matrix
-        HYPRE_StructMatrix* HA = hypre_solver_s->HA_p;
+        // New coefficients go into the existing matrix
+        const bool newCoefs = ( rebuild || updateCoefs );
 
-        if( do_setup ){
-          HYPRE_StructMatrixDestroy( *HA );
-        }
-
-        if (timeStep == 1 || recompute || do_setup) {
-          HYPRE_StructMatrixCreate( pg->getComm(), grid, stencil, HA );
-          HYPRE_StructMatrixSetSymmetric( *HA, m_params->getSymmetric() );
-          int ghost[] = {1,1,1,1,1,1};
-          HYPRE_StructMatrixSetNumGhost( *HA, ghost );
-          HYPRE_StructMatrixInitialize( *HA );
+        if( newCoefs ){
+          setMatrixCoefficients( patches, matl, A_dw, ctx.HA );
         }
 
-        // setup the coefficient matrix ONLY on the first timeStep, if
-        // we are doing a recompute, or if we set setupFrequency != 0,
-        // or if UpdateCoefFrequency != 0
-        if (timeStep == 1 || recompute || do_setup || updateCoefs) {
-          for(int p=0;p<patches->size();p++) {
-            const Patch* patch = patches->get(p);
-            printTask( patches, patch, cout_doing, "HypreSolver:solve: Create Matrix" );
-
-            //__________________________________
-            // Get A matrix from the DW
-            typename GridVarType::symmetric_matrix_type AStencil4;
-            typename GridVarType::matrix_type A;
-
-            if ( m_params->getUseStencil4() ){
-              A_dw->get( AStencil4, m_A_label, matl, patch, Ghost::None, 0);
-            } else {
-              A_dw->get( A, m_A_label, matl, patch, Ghost::None, 0);
-            }
+        //__________________________________
+        // RHS and initial guess
+        populateHypreVector( patches, matl, m_b_label,     b_dw,     ctx.HB );
+        populateHypreVector( patches, matl, m_guess_label, guess_dw, ctx.HX );
 
-            IntVector l;
-            IntVector h;
-            getPatchExtents( patch, l, h );
-
-            //__________________________________
-            // Feed it to Hypre
-            if( m_params->getSymmetric()){
-
-              double* values = scinew double[(h.x()-l.x())*4];
-              int stencil_indices[] = {0,1,2,3};
-
-              // use stencil4 as coefficient matrix. NOTE: This should be templated
-              // on the stencil type. This workaround is to get things moving
-              // until we convince component developers to move to stencil4. You must
-              // set m_params->setUseStencil4(true) when you setup your linear solver
-              // if you want to use stencil4. You must also provide a matrix of type
-              // stencil4 otherwise this will crash.
-              if ( m_params->getUseStencil4()) {
-
-                for(int z=l.z();z<h.z();z++){
-                  for(int y=l.y();y<h.y();y++){
-
-                    const Stencil4* AA = &AStencil4[IntVector(l.x(), y, z)];
-                    double* p = values;
-
-                    for(int x=l.x();x<h.x();x++){
-                      *p++ = AA->p;
-                      *p++ = AA->w;
-                      *p++ = AA->s;
-                      *p++ = AA->b;
-                      AA++;
-                    }
-                    IntVector ll(l.x(), y, z);
-                    IntVector hh(h.x()-1, y, z);
-                    HYPRE_StructMatrixSetBoxValues(*HA,
-                                                   ll.get_pointer(), hh.get_pointer(),
-                                                   4, stencil_indices, values);
-
-                  } // y loop
-                }  // z loop
-
-              } else { // use stencil7
-
-                for(int z=l.z();z<h.z();z++){
-                  for(int y=l.y();y<h.y();y++){
-
-                    const Stencil7* AA = &A[IntVector(l.x(), y, z)];
-                    double* p = values;
-
-                    for(int x=l.x();x<h.x();x++){
-                      *p++ = AA->p;
-                      *p++ = AA->w;
-                      *p++ = AA->s;
-                      *p++ = AA->b;
-                      AA++;
-                    }
-                    IntVector ll(l.x(), y, z);
-                    IntVector hh(h.x()-1, y, z);
-                    HYPRE_StructMatrixSetBoxValues(*HA,
-                                                   ll.get_pointer(), hh.get_pointer(),
-                                                   4, stencil_indices, values);
-
-                  } // y loop
-                }  // z loop
-              }
-              delete[] values;
-            } else {
-              double* values = scinew double[(h.x()-l.x())*7];
-              int stencil_indices[] = {0,1,2,3,4,5,6};
-
-              for(int z=l.z();z<h.z();z++){
-                for(int y=l.y();y<h.y();y++){
-
-                  const Stencil7* AA = &A[IntVector(l.x(), y, z)];
-                  double* p = values;
-
-                  for(int x=l.x();x<h.x();x++){
-                    *p++ = AA->p;
-                    *p++ = AA->e;
-                    *p++ = AA->w;
-                    *p++ = AA->n;
-                    *p++ = AA->s;
-                    *p++ = AA->t;
-                    *p++ = AA->b;
-                    AA++;
-                  }
-
-                  IntVector ll(l.x(), y, z);
-                  IntVector hh(h.x()-1, y, z);
-                  HYPRE_StructMatrixSetBoxValues(*HA,
-                                                 ll.get_pointer(), hh.get_pointer(),
-                                                 7, stencil_indices,
-                                                 values);
-                }  // y loop
-              } // z loop
-              delete[] values;
-            }
-          }
-          if (timeStep == 1 || recompute || do_setup){
-            HYPRE_StructMatrixAssemble(*HA);
-          }
+        if( rebuild ){
+          HYPRE_StructVectorAssemble( ctx.HB );
+          HYPRE_StructVectorAssemble( ctx.HX );
         }
 
-        //__________________________________
-        // Create the RHS
-        HYPRE_StructVector HB;
-        HB = createPopulateHypreVector(  timeStep, recompute, do_setup, pg, grid, patches, matl, m_b_label, b_dw, hypre_solver_s->HB_p);
+        hypre_EndTiming( m_tMatVecSetup );
 
         //__________________________________
-        // Create the solution vector
-        HYPRE_StructVector HX;
-        HX = createPopulateHypreVector(  timeStep, recompute, do_setup, pg, grid, patches, matl, m_guess_label, guess_dw, hypre_solver_s->HX_p);
+        // Redo the solver/preconditioner setup?
+        bool do_setup = ( rebuild || !ctx.isSetup || ctx.refreshSetup );
 
-        hypre_EndTiming( m_tMatVecSetup );
+        if( !do_setup ){
+          do_setup = ( reuseSteps > 0 ) ? ( ctx.stepsSinceSetup >= reuseSteps ) : setupDue;
+        }
 
         //__________________________________
         Timers::Simple solve_timer;
@@ -532,216 +569,39 @@ namespace Uintah {
         int num_iterations;
         double final_res_norm;
 
-        //______________________________________________________________________
-        // Solve the system
-        switch( hypre_solver_s->solver_type ){
-        //__________________________________
-        // use symmetric SMG
-        case smg: {
-          HYPRE_StructSolver * solver  = hypre_solver_s->solver_p;
-
-          if ( do_setup ){
-            HYPRE_StructSMGDestroy( *solver );
-          }
-
-          if (timeStep == 1 || recompute || do_setup) {
-
-            HYPRE_StructSMGCreate         (pg->getComm(), solver);
-            HYPRE_StructSMGSetMemoryUse   (*solver,  0);
-            HYPRE_StructSMGSetMaxIter     (*solver,  m_params->maxiterations);
-            HYPRE_StructSMGSetTol         (*solver,  m_params->tolerance);
-            HYPRE_StructSMGSetRelChange   (*solver,  0);
-            HYPRE_StructSMGSetNumPreRelax (*solver,  m_params->npre);
-            HYPRE_StructSMGSetNumPostRelax(*solver,  m_params->npost);
-            HYPRE_StructSMGSetLogging     (*solver,  m_params->logging);
-
-            HYPRE_StructSMGSetup (*solver,  *HA, HB, HX);
-          }
-
-          HYPRE_StructSMGSolve(*solver, *HA, HB, HX);
-
-          HYPRE_StructSMGGetNumIterations( *solver, &num_iterations );
-          HYPRE_StructSMGGetFinalRelativeResidualNorm( *solver, &final_res_norm );
-          break;
-        }
-        //______________________________________________________________________
-        //
-        case pfmg:{
-
-          HYPRE_StructSolver* solver =  hypre_solver_s->solver_p;
-
-          if ( do_setup ){
-            HYPRE_StructPFMGDestroy( *solver );
-          }
-
-          if ( timeStep == 1 || recompute || do_setup ) {
-
-            HYPRE_StructPFMGCreate        ( pg->getComm(), solver );
-            HYPRE_StructPFMGSetMaxIter    (*solver,   m_params->maxiterations);
-            HYPRE_StructPFMGSetTol        (*solver,   m_params->tolerance);
-            HYPRE_StructPFMGSetRelChange  (*solver,   0);
-
-            /* weighted Jacobi = 1; red-black GS = 2 */
-            HYPRE_StructPFMGSetRelaxType   (*solver,  m_params->relax_type);
-            HYPRE_StructPFMGSetNumPreRelax (*solver,  m_params->npre);
-            HYPRE_StructPFMGSetNumPostRelax(*solver,  m_params->npost);
-            HYPRE_StructPFMGSetSkipRelax   (*solver,  m_params->skip);
-            HYPRE_StructPFMGSetLogging     (*solver,  m_params->logging);
-
-            HYPRE_StructPFMGSetup          (*solver,  *HA, HB,  HX);
-          }
-
-          HYPRE_StructPFMGSolve(*solver, *HA, HB, HX);
-
-          HYPRE_StructPFMGGetNumIterations(*solver, &num_iterations);
-          HYPRE_StructPFMGGetFinalRelativeResidualNorm(*solver,
-                                                       &final_res_norm);
-          break;
-        }
-        //______________________________________________________________________
-        //
-        case sparsemsg:{
-
-          HYPRE_StructSolver* solver = hypre_solver_s->solver_p;
-          if ( do_setup ){
-            HYPRE_StructSparseMSGDestroy(*solver);
-          }
-
-          if ( timeStep == 1 || recompute || do_setup ) {
-
-            HYPRE_StructSparseMSGCreate      (pg->getComm(), solver);
-            HYPRE_StructSparseMSGSetMaxIter  (*solver, m_params->maxiterations);
-            HYPRE_StructSparseMSGSetJump     (*solver, m_params->jump);
-            HYPRE_StructSparseMSGSetTol      (*solver, m_params->tolerance);
-            HYPRE_StructSparseMSGSetRelChange(*solver, 0);
-
-            /* weighted Jacobi = 1; red-black GS = 2 */
-            HYPRE_StructSparseMSGSetRelaxType   (*solver,  m_params->relax_type);
-            HYPRE_StructSparseMSGSetNumPreRelax (*solver,  m_params->npre);
-            HYPRE_StructSparseMSGSetNumPostRelax(*solver,  m_params->npost);
-            HYPRE_StructSparseMSGSetLogging     (*solver,  m_params->logging);
-
-            HYPRE_StructSparseMSGSetup(*solver, *HA, HB,  HX);
-          }
-
-          HYPRE_StructSparseMSGSolve(*solver, *HA, HB, HX);
-
-          HYPRE_StructSparseMSGGetNumIterations(*solver, &num_iterations);
-          HYPRE_StructSparseMSGGetFinalRelativeResidualNorm(*solver,
-                                                            &final_res_norm);
-          break;
-        }
-        //______________________________________________________________________
-        //
-        case pcg: {
-
-          HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
-          HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
-
-          if( do_setup ){
-            destroyPrecond( hypre_solver_s, *precond_solver );
-            HYPRE_StructPCGDestroy(*solver);
-          }
-
-          if (timeStep == 1 || recompute || do_setup) {
-            HYPRE_StructPCGCreate(pg->getComm(),solver);
-
-            HYPRE_PtrToStructSolverFcn precond;
-            HYPRE_PtrToStructSolverFcn precond_setup;
-
-            setupPrecond( pg, precond, precond_setup, hypre_solver_s, *precond_solver );
-            HYPRE_StructPCGSetPrecond( *solver, precond, precond_setup, *precond_solver );
-
-            HYPRE_StructPCGSetMaxIter   (*solver, m_params->maxiterations);
-            HYPRE_StructPCGSetTol       (*solver, m_params->tolerance);
-            HYPRE_StructPCGSetTwoNorm   (*solver,  1);
-            HYPRE_StructPCGSetRelChange (*solver,  0);
-            HYPRE_StructPCGSetLogging   (*solver,  m_params->logging);
-
-            HYPRE_StructPCGSetup        (*solver, *HA,HB, HX);
-          }
-
-          HYPRE_StructPCGSolve(*solver, *HA, HB, HX);
-
-          HYPRE_StructPCGGetNumIterations(*solver, &num_iterations);
-          HYPRE_StructPCGGetFinalRelativeResidualNorm(*solver,&final_res_norm);
-          break;
+        if( do_setup ){
+          setupSolver( pg, hypre_solver_s, ctx );
         }
 
-        //______________________________________________________________________
-        //
-        case hybrid: {
-
-          HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
-          HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
-
-          if ( do_setup ){
-            destroyPrecond( hypre_solver_s, *precond_solver );
-            HYPRE_StructHybridDestroy( *solver );
-          }
-
-          if ( timeStep == 1 || recompute || do_setup ) {
-            HYPRE_StructHybridCreate(pg->getComm(), solver);
+        solveSystem( hypre_solver_s, ctx, num_iterations, final_res_norm );
+        ctx.stepsSinceSetup++;
 
-            HYPRE_PtrToStructSolverFcn precond;
-            HYPRE_PtrToStructSolverFcn precond_setup;
-
-            setupPrecond( pg, precond, precond_setup, hypre_solver_s, *precond_solver );
-            HYPRE_StructHybridSetPrecond( *solver, precond, precond_setup, *precond_solver );
-
-            HYPRE_StructHybridSetDSCGMaxIter    (*solver, 100);
-            HYPRE_StructHybridSetPCGMaxIter     (*solver, m_params->maxiterations);
-            HYPRE_StructHybridSetTol            (*solver, m_params->tolerance);
-            HYPRE_StructHybridSetConvergenceTol (*solver, 0.90);
-            HYPRE_StructHybridSetTwoNorm        (*solver, 1);
-            HYPRE_StructHybridSetRelChange      (*solver, 0);
-            HYPRE_StructHybridSetLogging        (*solver, m_params->logging);
+        //__________________________________
+        // A solve with a reused setup that failed to converge is repeated
+        // with a fresh setup before declaring a convergence failure.
+        bool converged = ( final_res_norm <= m_params->tolerance && std::isfinite(final_res_norm) );
 
-            HYPRE_StructHybridSetup             (*solver, *HA, HB, HX);
-          }
+        if( !do_setup && !converged ){
+          proc0cout << "  HypreSolver: reused setup failed to converge ("
+                    << num_iterations << " iterations, residual = " << final_res_norm
+                    << "), redoing the setup.\n";
 
-          HYPRE_StructHybridSolve(*solver, *HA, HB, HX);
+          populateHypreVector( patches, matl, m_guess_label, guess_dw, ctx.HX );
 
-          HYPRE_StructHybridGetNumIterations( *solver,&num_iterations );
-          HYPRE_StructHybridGetFinalRelativeResidualNorm( *solver, &final_res_norm );
-          break;
+          setupSolver( pg, hypre_solver_s, ctx );
+          solveSystem( hypre_solver_s, ctx, num_iterations, final_res_norm );
+          ctx.stepsSinceSetup++;
+          do_setup = true;
         }
-        //______________________________________________________________________
-        //
-        case gmres: {
-
-          HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
-          HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
-
-          if ( do_setup ){
-            destroyPrecond( hypre_solver_s, *precond_solver );
-            HYPRE_StructGMRESDestroy(*solver);
-          }
-          if (timeStep == 1 || recompute || do_setup ) {
-            HYPRE_StructGMRESCreate(pg->getComm(),solver);
 
-            HYPRE_PtrToStructSolverFcn precond;
-            HYPRE_PtrToStructSolverFcn precond_setup;
-
-            setupPrecond( pg, precond, precond_setup, hypre_solver_s, *precond_solver );
-            HYPRE_StructGMRESSetPrecond  (*solver, precond, precond_setup, *precond_solver );
-
-            HYPRE_StructGMRESSetMaxIter  (*solver, m_params->maxiterations);
-            HYPRE_StructGMRESSetTol      (*solver, m_params->tolerance);
-            HYPRE_GMRESSetRelChange      ( (HYPRE_Solver)solver, 0);
-            HYPRE_StructGMRESSetLogging  (*solver, m_params->logging);
-
-            HYPRE_StructGMRESSetup       (*solver,*HA,HB,HX);
-          }
-
-          HYPRE_StructGMRESSolve(*solver,*HA,HB,HX);
-
-          HYPRE_StructGMRESGetNumIterations(*solver, &num_iterations);
-          HYPRE_StructGMRESGetFinalRelativeResidualNorm(*solver, &final_res_norm);
-          break;
+        //__________________________________
+        // Ask for a fresh setup when the iteration count grows
+        // past refreshRatio x the count right after the setup.
+        if( ctx.setupIterations < 0 ){
+          ctx.setupIterations = num_iterations;
         }
-        default:
-          throw InternalError("Unknown solver type: "+ m_params->solvertype, __FILE__, __LINE__);
+        else if( refreshRatio > 0 && num_iterations > refreshRatio * std::max( ctx.setupIterations, 1 ) ){
+          ctx.refreshSetup = true;
         }
 
         //______________________________________________________________________
@@ -751,9 +611,9 @@ namespace Uintah {
         //   Debugging
         vector<string> fname;
         m_params->getOutputFileName(fname);
-        HYPRE_StructMatrixPrint( fname[0].c_str(), *HA, 0 );
-        HYPRE_StructVectorPrint( fname[1].c_str(), *HB, 0 );
-        HYPRE_StructVectorPrint( fname[2].c_str(), HX, 0 );
+        HYPRE_StructMatrixPrint( fname[0].c_str(), ctx.HA, 0 );
+        HYPRE_StructVectorPrint( fname[1].c_str(), ctx.HB, 0 );
+        HYPRE_StructVectorPrint( fname[2].c_str(), ctx.HX, 0 );
 #endif
 
         printTask( patches, patches->get(0), cout_doing, "HypreSolver:solve: testConvergence" );
@@ -771,8 +631,6 @@ namespace Uintah {
           IntVector h;
           getPatchExtents( patch, l, h );
 
-          CellIterator iter(l, h);
-
           typename GridVarType::double_type Xnew;
           if( m_modifies_X ){
             new_dw->getModifiable(Xnew, m_X_label, matl, patch);
@@ -788,7 +646,7 @@ namespace Uintah {
               IntVector ll(l.x(), y, z);
               IntVector hh(h.x()-1, y, z);
 
-              HYPRE_StructVectorGetBoxValues(HX,
+              HYPRE_StructVectorGetBoxValues(ctx.HX,
                   ll.get_pointer(), hh.get_pointer(),
                   values);
             }
@@ -799,11 +657,6 @@ namespace Uintah {
          m_firstPassThrough  = false;
          hypre_solver_s->isRecomputeTimeStep  = false;
 
-        if ( timeStep == 1 || do_setup || recompute ) {
-          HYPRE_StructStencilDestroy(stencil);
-          HYPRE_StructGridDestroy(grid);
-        }
-
         hypre_EndTiming (m_tHypreAll);
 
         hypre_PrintTiming   ("Hypre Timings:", pg->getComm());
@@ -830,6 +683,10 @@ namespace Uintah {
             cout << "mean: " <<  m_movingAverage << " s, ";
           }
 
+          if( !do_setup ){
+            cout << "setup reused for " << ctx.stepsSinceSetup << " solves, ";
+          }
+
           cout << num_iterations << " iterations, residual = "
                << final_res_norm << ")." << std::endl;
         }
@@ -856,6 +713,205 @@ namespace Uintah {
       }
     }
 
+    //---------------------------------------------------------------------------------------------
+    //  (Re)create the solver and preconditioner and run their setup on the current matrix
+    void
+    setupSolver( const ProcessorGroup             * pg
+               , struct hypre_solver_struct       * hypre_solver_s
+               ,        hypre_level_context       & ctx
+               )
+    {
+      hypre_solver_s->destroySolver( ctx );
+
+      HYPRE_StructSolver & solver = ctx.solver;
+      HYPRE_StructMatrix   HA     = ctx.HA;
+      HYPRE_StructVector   HB     = ctx.HB;
+      HYPRE_StructVector   HX     = ctx.HX;
+
+      switch( hypre_solver_s->solver_type ){
+      //__________________________________
+      // use symmetric SMG
+      case smg: {
+        HYPRE_StructSMGCreate         (pg->getComm(), &solver);
+        HYPRE_StructSMGSetMemoryUse   (solver,  0);
+        HYPRE_StructSMGSetMaxIter     (solver,  m_params->maxiterations);
+        HYPRE_StructSMGSetTol         (solver,  m_params->tolerance);
+        HYPRE_StructSMGSetRelChange   (solver,  0);
+        HYPRE_StructSMGSetNumPreRelax (solver,  m_params->npre);
+        HYPRE_StructSMGSetNumPostRelax(solver,  m_params->npost);
+        HYPRE_StructSMGSetLogging     (solver,  m_params->logging);
+
+        HYPRE_StructSMGSetup (solver,  HA, HB, HX);
+        break;
+      }
+      //______________________________________________________________________
+      //
+      case pfmg:{
+        HYPRE_StructPFMGCreate        ( pg->getComm(), &solver );
+        HYPRE_StructPFMGSetMaxIter    (solver,   m_params->maxiterations);
+        HYPRE_StructPFMGSetTol        (solver,   m_params->tolerance);
+        HYPRE_StructPFMGSetRelChange  (solver,   0);
+
+        /* weighted Jacobi = 1; red-black GS = 2 */
+        HYPRE_StructPFMGSetRelaxType   (solver,  m_params->relax_type);
+        HYPRE_StructPFMGSetNumPreRelax (solver,  m_params->npre);
+        HYPRE_StructPFMGSetNumPostRelax(solver,  m_params->npost);
+        HYPRE_StructPFMGSetSkipRelax   (solver,  m_params->skip);
+        HYPRE_StructPFMGSetLogging     (solver,  m_params->logging);
+
+        HYPRE_StructPFMGSetup          (solver,  HA, HB,  HX);
+        break;
+      }
+      //______________________________________________________________________
+      //
+      case sparsemsg:{
+        HYPRE_StructSparseMSGCreate      (pg->getComm(), &solver);
+        HYPRE_StructSparseMSGSetMaxIter  (solver, m_params->maxiterations);
+        HYPRE_StructSparseMSGSetJump     (solver, m_params->jump);
+        HYPRE_StructSparseMSGSetTol      (solver, m_params->tolerance);
+        HYPRE_StructSparseMSGSetRelChange(solver, 0);
+
+        /* weighted Jacobi = 1; red-black GS = 2 */
+        HYPRE_StructSparseMSGSetRelaxType   (solver,  m_params->relax_type);
+        HYPRE_StructSparseMSGSetNumPreRelax (solver,  m_params->npre);
+        HYPRE_StructSparseMSGSetNumPostRelax(solver,  m_params->npost);
+        HYPRE_StructSparseMSGSetLogging     (solver,  m_params->logging);
+
+        HYPRE_StructSparseMSGSetup(solver, HA, HB,  HX);
+        break;
+      }
+      //______________________________________________________________________
+      //
+      case pcg: {
+        HYPRE_StructPCGCreate(pg->getComm(), &solver);
+
+        HYPRE_PtrToStructSolverFcn precond;
+        HYPRE_PtrToStructSolverFcn precond_setup;
+
+        setupPrecond( pg, precond, precond_setup, hypre_solver_s, ctx.precond_solver );
+        HYPRE_StructPCGSetPrecond( solver, precond, precond_setup, ctx.precond_solver );
+
+        HYPRE_StructPCGSetMaxIter   (solver, m_params->maxiterations);
+        HYPRE_StructPCGSetTol       (solver, m_params->tolerance);
+        HYPRE_StructPCGSetTwoNorm   (solver,  1);
+        HYPRE_StructPCGSetRelChange (solver,  0);
+        HYPRE_StructPCGSetLogging   (solver,  m_params->logging);
+
+        HYPRE_StructPCGSetup        (solver, HA, HB, HX);
+        break;
+      }
+      //______________________________________________________________________
+      //
+      case hybrid: {
+        HYPRE_StructHybridCreate(pg->getComm(), &solver);
+
+        HYPRE_PtrToStructSolverFcn precond;
+        HYPRE_PtrToStructSolverFcn precond_setup;
+
+        setupPrecond( pg, precond, precond_setup, hypre_solver_s, ctx.precond_solver );
+        HYPRE_StructHybridSetPrecond( solver, precond, precond_setup, ctx.precond_solver );
+
+        HYPRE_StructHybridSetDSCGMaxIter    (solver, 100);
+        HYPRE_StructHybridSetPCGMaxIter     (solver, m_params->maxiterations);
+        HYPRE_StructHybridSetTol            (solver, m_params->tolerance);
+        HYPRE_StructHybridSetConvergenceTol (solver, 0.90);
+        HYPRE_StructHybridSetTwoNorm        (solver, 1);
+        HYPRE_StructHybridSetRelChange      (solver, 0);
+        HYPRE_StructHybridSetLogging        (solver, m_params->logging);
+
+        HYPRE_StructHybridSetup             (solver, HA, HB, HX);
+        break;
+      }
+      //______________________________________________________________________
+      //
+      case gmres: {
+        HYPRE_StructGMRESCreate(pg->getComm(), &solver);
+
+        HYPRE_PtrToStructSolverFcn precond;
+        HYPRE_PtrToStructSolverFcn precond_setup;
+
+        setupPrecond( pg, precond, precond_setup, hypre_solver_s, ctx.precond_solver );
+        HYPRE_StructGMRESSetPrecond  (solver, precond, precond_setup, ctx.precond_solver );
+
+        HYPRE_StructGMRESSetMaxIter  (solver, m_params->maxiterations);
+        HYPRE_StructGMRESSetTol      (solver, m_params->tolerance);
+        HYPRE_GMRESSetRelChange      ( (HYPRE_Solver)solver, 0);
+        HYPRE_StructGMRESSetLogging  (solver, m_params->logging);
+
+        HYPRE_StructGMRESSetup       (solver, HA, HB, HX);
+        break;
+      }
+      default:
+        throw InternalError("Unknown solver type: "+ m_params->solvertype, __FILE__, __LINE__);
+      }
+
+      ctx.isSetup         = true;
+      ctx.refreshSetup    = false;
+      ctx.stepsSinceSetup = 0;
+      ctx.setupIterations = -1;
+    }
+
+    //---------------------------------------------------------------------------------------------
+    //  Solve with the current setup.  The matrix values may be newer than the setup.
+    void
+    solveSystem( struct hypre_solver_struct * hypre_solver_s
+               ,        hypre_level_context & ctx
+               ,        int                 & num_iterations
+               ,        double              & final_res_norm
+               )
+    {
+      HYPRE_StructSolver solver = ctx.solver;
+
+      switch( hypre_solver_s->solver_type ){
+      case smg: {
+        HYPRE_StructSMGSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructSMGGetNumIterations( solver, &num_iterations );
+        HYPRE_StructSMGGetFinalRelativeResidualNorm( solver, &final_res_norm );
+        break;
+      }
+      case pfmg:{
+        HYPRE_StructPFMGSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructPFMGGetNumIterations(solver, &num_iterations);
+        HYPRE_StructPFMGGetFinalRelativeResidualNorm(solver,
+                                                     &final_res_norm);
+        break;
+      }
+      case sparsemsg:{
+        HYPRE_StructSparseMSGSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructSparseMSGGetNumIterations(solver, &num_iterations);
+        HYPRE_StructSparseMSGGetFinalRelativeResidualNorm(solver,
+                                                          &final_res_norm);
+        break;
+      }
+      case pcg: {
+        HYPRE_StructPCGSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructPCGGetNumIterations(solver, &num_iterations);
+        HYPRE_StructPCGGetFinalRelativeResidualNorm(solver,&final_res_norm);
+        break;
+      }
+      case hybrid: {
+        HYPRE_StructHybridSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructHybridGetNumIterations( solver,&num_iterations );
+        HYPRE_StructHybridGetFinalRelativeResidualNorm( solver, &final_res_norm );
+        break;
+      }
+      case gmres: {
+        HYPRE_StructGMRESSolve(solver, ctx.HA, ctx.HB, ctx.HX);
+
+        HYPRE_StructGMRESGetNumIterations(solver, &num_iterations);
+        HYPRE_StructGMRESGetFinalRelativeResidualNorm(solver, &final_res_norm);
+        break;
+      }
+      default:
+        throw InternalError("Unknown solver type: "+ m_params->solvertype, __FILE__, __LINE__);
+      }
+    }
+
     //---------------------------------------------------------------------------------------------
     void
     setupPrecond( const ProcessorGroup              * pg
@@ -958,40 +1014,6 @@ namespace Uintah {
     }
 
     //---------------------------------------------------------------------------------------------
-    void
-    destroyPrecond( struct hypre_solver_struct * hypre_solver_s
-                   ,       HYPRE_StructSolver  & precond_solver )
-    {
-
-      switch( hypre_solver_s->precond_solver_type ){
-
-      case smg:{
-        HYPRE_StructSMGDestroy( precond_solver );
-        break;
-      }
-      case pfmg:{
-        HYPRE_StructPFMGDestroy( precond_solver );
-        break;
-      }
-      case sparsemsg:{
-        HYPRE_StructSparseMSGDestroy( precond_solver );
-        break;
-      }
-      case jacobi:{
-        HYPRE_StructJacobiDestroy( precond_solver );
-        break;
-      }
-      case diagonal:{
-        // do nothing
-        break;
-      }
-      default:
-        // This should have been caught in readParameters...
-        throw InternalError("Unknown preconditionertype: "+ m_params->precondtype, __FILE__, __LINE__);
-      }
-    }
-
-    //---------------------------------------------------------------------------------------------
 
   private:
 
@@ -1086,6 +1108,8 @@ namespace Uintah {
         param_ps->getWithDefault ("updateCoefFrequency",  coefFreq,             1);
         param_ps->getWithDefault ("solveFrequency",  m_params->solveFrequency, 1);
         param_ps->getWithDefault ("relax_type",      m_params->relax_type,     1);
+        param_ps->getWithDefault ("precondReuseSteps",   m_params->precondReuseSteps,   0);
+        param_ps->getWithDefault ("precondRefreshRatio", m_params->precondRefreshRatio, 1.5);
 
         // change to lowercase
         m_params->solvertype  = string_tolower( str_solver );
@@ -1106,6 +1130,11 @@ namespace Uintah {
         // 1 : Weighted Jacobi (default)
         // 2 : Red/Black Gauss-Seidel (symmetric: RB pre-relaxation, BR post-relaxation)
         // 3 : Red/Black Gauss-Seidel (nonsymmetric: RB pre- and post-relaxation)
+        //
+        // precondReuseSteps:   keep the solver/preconditioner setup for up to this many
+        //                      solves while the coefficients change (0 = setupFrequency decides)
+        // precondRefreshRatio: redo the setup once a solve needs more than this multiple
+        //                      of the iterations measured right after the setup (<= 0 disables)
 
         found=true;
       }
@@ -1124,6 +1153,8 @@ namespace Uintah {
       m_params->setUpdateCoefFrequency(1);
       m_params->solveFrequency = 1;
       m_params->relax_type = 1;
+      m_params->precondReuseSteps   = 0;
+      m_params->precondRefreshRatio = 1.5;
     }
   }
 
@@ -1175,11 +1206,6 @@ namespace Uintah {
     SoleVariable<hypre_solver_structP> hypre_solverP;
     hypre_solver_struct* hypre_struct = scinew hypre_solver_struct;
 
-    hypre_struct->solver_p         = scinew HYPRE_StructSolver( nullptr );
-    hypre_struct->precond_solver_p = scinew HYPRE_StructSolver( nullptr );
-    hypre_struct->HA_p             = scinew HYPRE_StructMatrix( nullptr );
-    hypre_struct->HX_p             = scinew HYPRE_StructVector( nullptr );
-    hypre_struct->HB_p             = scinew HYPRE_StructVector( nullptr );
     hypre_struct->solver_type         = stringToSolverType( m_params->solvertype );
     hypre_struct->precond_solver_type = stringToSolverType( m_params->precondtype );
 
@@ -37,6 +37,8 @@
 #include <HYPRE_krylov.h>
 
 #include <iostream>
+#include <map>
+#include <vector>
 
 /**
  *  @class  HypreSolver2
@@ -72,6 +74,8 @@ namespace Uintah {
     int         logging;            // Log Hypre solver (using Hypre options)
     int         solveFrequency;     // Frequency for solving the linear system. timestep % solveFrequency
     int         relax_type;         // relaxation type
+    int         precondReuseSteps;   // Reuse the solver/preconditioner setup for up to this many solves (0 = use setupFrequency)
+    double      precondRefreshRatio; // Redo the setup once the iteration count exceeds this multiple of the count right after setup
     
     // SMG parameters
     int    npre;               // # pre relaxations for Hypre SMG solver
@@ -97,6 +101,70 @@ namespace Uintah {
     diagonal
   };
 
+  //______________________________________________________________________
+  //  Destroy a hypre struct solver of the given type
+  inline void destroyHypreSolver( const SolverType           type
+                                ,       HYPRE_StructSolver & solver )
+  {
+    if( !solver ){
+      return;
+    }
+
+    switch ( type ) {
+    case smg:
+      HYPRE_StructSMGDestroy( solver );
+      break;
+    case pfmg:
+      HYPRE_StructPFMGDestroy( solver );
+      break;
+    case sparsemsg:
+      HYPRE_StructSparseMSGDestroy( solver );
+      break;
+    case pcg:
+      HYPRE_StructPCGDestroy( solver );
+      break;
+    case hybrid:
+      HYPRE_StructHybridDestroy( solver );
+      break;
+    case gmres:
+      HYPRE_StructGMRESDestroy( solver );
+      break;
+    case jacobi:
+      HYPRE_StructJacobiDestroy( solver );
+      break;
+    case diagonal:
+      // nothing was created
+      break;
+    default:
+      // FYI: This should never happen as the solver type is validated when the struct is initialized.
+      std::cout << " ERROR: destroyHypreSolver() has bad solver type: " << type << "\n";
+      Parallel::exitAll( 1 );
+    }
+    solver = nullptr;
+  }
+
+  //______________________________________________________________________
+  //  The hypre objects of one (level, material) system.  They persist from
+  //  one timestep to the next and are only rebuilt when the patch layout
+  //  they were created for changes, i.e. after a regrid.  New coefficients
+  //  are written into the existing matrix.
+  struct hypre_level_context {
+
+    HYPRE_StructGrid    grid           = nullptr;
+    HYPRE_StructStencil stencil        = nullptr;
+    HYPRE_StructMatrix  HA             = nullptr;
+    HYPRE_StructVector  HB             = nullptr;
+    HYPRE_StructVector  HX             = nullptr;
+    HYPRE_StructSolver  solver         = nullptr;
+    HYPRE_StructSolver  precond_solver = nullptr;
+
+    std::vector<int>    layout;                   // extents of the local patches the grid was built from
+    bool                isSetup         = false;  // solver and preconditioner have been set up
+    bool                refreshSetup    = false;  // the last solve asked for a fresh setup
+    int                 stepsSinceSetup = 0;      // solves performed with the current setup
+    int                 setupIterations = -1;     // iterations of the first solve after the setup
+  };
+
   //______________________________________________________________________
   //
   struct hypre_solver_struct : public RefCounted {
@@ -104,13 +172,9 @@ namespace Uintah {
     SolverType           solver_type;
     SolverType           precond_solver_type;
     bool                 isRecomputeTimeStep;
-    
-    //  *_p = pointer
-    HYPRE_StructSolver * solver_p = nullptr;
-    HYPRE_StructSolver * precond_solver_p;
-    HYPRE_StructMatrix * HA_p;
-    HYPRE_StructVector * HB_p;
-    HYPRE_StructVector * HX_p;
+
+    // one context per (level index, material)
+    std::map< std::pair<int,int>, hypre_level_context > contexts;
 
     //__________________________________
     //
@@ -118,97 +182,58 @@ namespace Uintah {
       isRecomputeTimeStep  = false;
       solver_type          = smg;
       precond_solver_type  = diagonal;
-      solver_p             = 0;
-      precond_solver_p     = 0;
-      HA_p = 0;
-      HB_p = 0;
-      HX_p = 0;
     };
     //__________________________________
     //
     void print()
     {
-      std::cout << "  Solver  type: " << solver_type << " solver: " << &solver_p <<  " " << *solver_p << "\n";
-                
-      std::cout << "  Precond type: " << precond_solver_type << " solver: " << &precond_solver_p << " " << *solver_p << "\n";
+      std::cout << "  Solver  type: " << solver_type << " Precond type: " << precond_solver_type << "\n";
+
+      for( auto & c : contexts ){
+        std::cout << "  level: " << c.first.first << " matl: " << c.first.second
+                  << " solver: " << c.second.solver << " precond: " << c.second.precond_solver
+                  << " solves since setup: " << c.second.stepsSinceSetup << "\n";
+      }
     };
-    
+
     //__________________________________
-    //
-    virtual ~hypre_solver_struct() {
+    //  Destroy the solver and preconditioner, keep the matrix and vectors
+    void destroySolver( hypre_level_context & ctx )
+    {
+      destroyHypreSolver( solver_type,         ctx.solver );
+      destroyHypreSolver( precond_solver_type, ctx.precond_solver );
+      ctx.isSetup = false;
+    };
 
-      if (*solver_p) {
-        switch (solver_type) {
-        case smg:
-          HYPRE_StructSMGDestroy(*solver_p);
-          break;
-        case pfmg:
-          HYPRE_StructPFMGDestroy(*solver_p);
-          break;
-        case sparsemsg:
-          HYPRE_StructSparseMSGDestroy(*solver_p);
-          break;
-        case pcg:
-          HYPRE_StructPCGDestroy(*solver_p);
-          break;
-        case gmres:
-          HYPRE_StructGMRESDestroy(*solver_p);
-          break;
-        case jacobi:
-          HYPRE_StructJacobiDestroy(*solver_p);
-          break;
-        default:
-          // FYI: This should never happen as the solver type is validated when the struct is initialized.
-          std::cout << " ERROR: ~hypre_solver_struct() has bad solver type: " << solver_type << "\n";
-          Parallel::exitAll( 1 );
-        }
-        delete solver_p;
-        solver_p = 0;
-      }
+    //__________________________________
+    //  Destroy everything in the context
+    void destroy( hypre_level_context & ctx )
+    {
+      destroySolver( ctx );
 
-      if (*precond_solver_p) {
-        switch (precond_solver_type) {
-        case smg:
-          HYPRE_StructSMGDestroy(*precond_solver_p);
-          break;
-        case pfmg:
-          HYPRE_StructPFMGDestroy(*precond_solver_p);
-          break;
-        case sparsemsg:
-          HYPRE_StructSparseMSGDestroy(*precond_solver_p);
-          break;
-        case pcg:
-          HYPRE_StructPCGDestroy(*precond_solver_p);
-          break;
-        case gmres:
-          HYPRE_StructGMRESDestroy(*precond_solver_p);
-          break;
-        case jacobi:
-          HYPRE_StructJacobiDestroy(*precond_solver_p);
-          break;
-        default:
-          // FYI: This should never happen as the solver type is validated when the struct is initialized.
-          std::cout << " ERROR: ~hypre_solver_struct() has bad precond solver type: " << precond_solver_type << "\n";
-          Parallel::exitAll( 1 );
-        }
-        delete precond_solver_p;
-        precond_solver_p = 0;
+      if (ctx.HA) {
+        HYPRE_StructMatrixDestroy( ctx.HA );
       }
-
-      if (HA_p) {
-        HYPRE_StructMatrixDestroy( *HA_p );
-        delete HA_p;  
-        HA_p = 0;
+      if (ctx.HB) {
+        HYPRE_StructVectorDestroy( ctx.HB );
       }
-      if (HB_p){
-        HYPRE_StructVectorDestroy( *HB_p );
-        delete HB_p;  
-        HB_p = 0;
+      if (ctx.HX) {
+        HYPRE_StructVectorDestroy( ctx.HX );
       }
-      if (HX_p) {
-        HYPRE_StructVectorDestroy( *HX_p );
-        delete HX_p;  
-        HX_p = 0;
+      if (ctx.stencil) {
+        HYPRE_StructStencilDestroy( ctx.stencil );
+      }
+      if (ctx.grid) {
+        HYPRE_StructGridDestroy( ctx.grid );
+      }
+      ctx = hypre_level_context();
+    };
+
+    //__________________________________
+    //
+    virtual ~hypre_solver_struct() {
+      for( auto & c : contexts ){
+        destroy( c.second );
       }
     };
   };
@@ -0,0 +1,595 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Solvers/MGHierarchy.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Uintah;
+
+namespace {
+
+  // neighbor offsets in Stencil7/Patch face order: -x +x -y +y -z +z
+  const int faceOffset[6][3] = { {-1,0,0}, {1,0,0}, {0,-1,0}, {0,1,0}, {0,0,-1}, {0,0,1} };
+
+  inline int faceDir( int face ) { return face/2; }
+
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::coarseningRatios( const IntVector        & size,
+                               const Options          & options,
+                                     std::vector<IntVector> & ratios )
+{
+  ratios.clear();
+  IntVector n = size;
+  const int nmin = std::max(1, options.coarseSize);
+
+  for (int level = 1; level < options.maxLevels; level++) {
+    IntVector ratio(1,1,1);
+    for (int d = 0; d < 3; d++) {
+      if (n[d] > nmin) {
+        ratio[d] = 2;
+      }
+    }
+    if (ratio == IntVector(1,1,1)) {
+      break;
+    }
+    ratios.push_back(ratio);
+    for (int d = 0; d < 3; d++) {
+      n[d] = (n[d] + ratio[d] - 1)/ratio[d];
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::Level::allocate( const IntVector & n )
+{
+  size = n;
+  sy   = n.x() + 2;
+  sz   = sy*(n.y() + 2);
+  const size_t npad = size_t(sz)*(n.z() + 2);
+
+  A.assign(npad, Stencil7(0.0));
+  invDiag.assign(npad, 0.0);
+  x.assign(npad, 0.0);
+  r.assign(npad, 0.0);
+  tmp.assign(npad, 0.0);
+  dir.clear();
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::setup( const std::vector<Stencil7> & A,
+                    const IntVector             & size,
+                    const Options               & options )
+{
+  m_options = options;
+
+  std::vector<IntVector> ratios;
+  coarseningRatios(size, options, ratios);
+
+  m_levels.resize(ratios.size() + 1);
+
+  // finest level, couplings that leave the box are dropped
+  m_A = A;
+  Level & L0 = m_levels[0];
+  L0.allocate(size);
+  const int nx = size.x(), ny = size.y(), nz = size.z();
+  for (int k = 0; k < nz; k++) {
+    for (int j = 0; j < ny; j++) {
+      for (int i = 0; i < nx; i++) {
+        Stencil7 & a = L0.A[L0.index(i,j,k)];
+        a = A[i + nx*(j + ny*k)];
+        if (i == 0)    a.w = 0.0;
+        if (i == nx-1) a.e = 0.0;
+        if (j == 0)    a.s = 0.0;
+        if (j == ny-1) a.n = 0.0;
+        if (k == 0)    a.b = 0.0;
+        if (k == nz-1) a.t = 0.0;
+      }
+    }
+  }
+
+  for (size_t l = 0; l < ratios.size(); l++) {
+    m_levels[l].ratio = ratios[l];
+    IntVector n;
+    for (int d = 0; d < 3; d++) {
+      n[d] = (m_levels[l].size[d] + ratios[l][d] - 1)/ratios[l][d];
+    }
+    m_levels[l+1].allocate(n);
+    coarsen(m_levels[l], m_levels[l+1]);
+  }
+  m_levels.back().ratio = IntVector(1,1,1);
+
+  for (Level & L : m_levels) {
+    for (size_t c = 0; c < L.A.size(); c++) {
+      L.invDiag[c] = (L.A[c].p != 0.0) ? 1.0/L.A[c].p : 0.0;
+    }
+    if (m_options.smoother == Chebyshev) {
+      L.dir.assign(L.x.size(), 0.0);
+      estimateLambdaMax(L);
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::coarsen( const Level & fine, Level & coarse ) const
+{
+  const IntVector & n = fine.size;
+  const IntVector & ratio = fine.ratio;
+  const bool galerkin = (m_options.coarsening == Galerkin);
+
+  std::vector<double> excess;
+  if (!galerkin) {
+    excess.assign(coarse.A.size(), 0.0);
+  }
+
+  for (int k = 0; k < n.z(); k++) {
+    for (int j = 0; j < n.y(); j++) {
+      for (int i = 0; i < n.x(); i++) {
+        const Stencil7 & a = fine.A[fine.index(i,j,k)];
+        const int I = coarse.index(i/ratio.x(), j/ratio.y(), k/ratio.z());
+        Stencil7 & ac = coarse.A[I];
+
+        double ex = a.p;
+        if (galerkin) {
+          ac.p += a.p;
+        }
+
+        for (int f = 0; f < 6; f++) {
+          if (a[f] == 0.0) {
+            continue;
+          }
+          const int ii = i + faceOffset[f][0];
+          const int jj = j + faceOffset[f][1];
+          const int kk = k + faceOffset[f][2];
+          const bool inside = (ii/ratio.x() == i/ratio.x() &&
+                               jj/ratio.y() == j/ratio.y() &&
+                               kk/ratio.z() == k/ratio.z());
+          ex += a[f];
+          if (inside) {
+            if (galerkin) {
+              ac.p += a[f];
+            }
+          }
+          else if (galerkin) {
+            ac[f] += a[f];
+          }
+          else {
+            ac[f] += a[f]/ratio[faceDir(f)];
+          }
+        }
+
+        if (!galerkin) {
+          excess[I] += ex;
+        }
+      }
+    }
+  }
+
+  if (!galerkin) {
+    for (size_t c = 0; c < coarse.A.size(); c++) {
+      Stencil7 & ac = coarse.A[c];
+      ac.p = excess[c] - (ac.w + ac.e + ac.s + ac.n + ac.b + ac.t);
+    }
+  }
+}
+
+//______________________________________________________________________
+//  tmp = r - A x
+void
+MGHierarchy::computeResidual( Level & L ) const
+{
+  const int sy = L.sy, sz = L.sz;
+  for (int k = 0; k < L.size.z(); k++) {
+    for (int j = 0; j < L.size.y(); j++) {
+      int c = L.index(0,j,k);
+      for (int i = 0; i < L.size.x(); i++, c++) {
+        const Stencil7 & a = L.A[c];
+        const double * x = &L.x[c];
+        L.tmp[c] = L.r[c] - (a.p*x[0] + a.w*x[-1]  + a.e*x[1]
+                                      + a.s*x[-sy] + a.n*x[sy]
+                                      + a.b*x[-sz] + a.t*x[sz]);
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::relax( Level & L, int sweeps, bool reverse ) const
+{
+  const int sy = L.sy, sz = L.sz;
+
+  if (m_options.smoother == RedBlackGS) {
+    for (int s = 0; s < sweeps; s++) {
+      for (int color = 0; color < 2; color++) {
+        const int parity = reverse ? 1 - color : color;
+        for (int k = 0; k < L.size.z(); k++) {
+          for (int j = 0; j < L.size.y(); j++) {
+            const int i0 = (parity + j + k) & 1;
+            int c = L.index(i0,j,k);
+            for (int i = i0; i < L.size.x(); i += 2, c += 2) {
+              const Stencil7 & a = L.A[c];
+              double * x = &L.x[c];
+              x[0] = (L.r[c] - (a.w*x[-1]  + a.e*x[1]
+                              + a.s*x[-sy] + a.n*x[sy]
+                              + a.b*x[-sz] + a.t*x[sz])) * L.invDiag[c];
+            }
+          }
+        }
+      }
+    }
+    return;
+  }
+
+  // Chebyshev iteration on D^-1 A for the eigenvalues in
+  // [ratio*lambdaMax, lambdaMax]
+  const double upper = 1.1*L.lambdaMax;
+  const double lower = m_options.chebyshevRatio*upper;
+  const double theta = 0.5*(upper + lower);
+  const double delta = 0.5*(upper - lower);
+  const double sigma = theta/delta;
+  double rho = 1.0/sigma;
+
+  for (int s = 0; s < sweeps; s++) {
+    computeResidual(L);
+    if (s == 0) {
+      for (size_t c = 0; c < L.x.size(); c++) {
+        L.dir[c] = L.invDiag[c]*L.tmp[c]/theta;
+        L.x[c]  += L.dir[c];
+      }
+    }
+    else {
+      const double rho_new = 1.0/(2.0*sigma - rho);
+      const double c1 = rho_new*rho;
+      const double c2 = 2.0*rho_new/delta;
+      for (size_t c = 0; c < L.x.size(); c++) {
+        L.dir[c] = c1*L.dir[c] + c2*L.invDiag[c]*L.tmp[c];
+        L.x[c]  += L.dir[c];
+      }
+      rho = rho_new;
+    }
+  }
+}
+
+//______________________________________________________________________
+//  Power iteration for the largest eigenvalue of D^-1 A
+void
+MGHierarchy::estimateLambdaMax( Level & L ) const
+{
+  std::fill(L.r.begin(), L.r.end(), 0.0);
+  for (int k = 0; k < L.size.z(); k++) {
+    for (int j = 0; j < L.size.y(); j++) {
+      for (int i = 0; i < L.size.x(); i++) {
+        const unsigned int h = (unsigned int)(L.index(i,j,k)) * 2654435761u;
+        L.x[L.index(i,j,k)] = 0.5 + (h % 1000)/1000.0;
+      }
+    }
+  }
+
+  double lambda = 1.0;
+  for (int it = 0; it < 15; it++) {
+    computeResidual(L);       // tmp = -A x
+    double xx = 0.0, yy = 0.0;
+    for (size_t c = 0; c < L.x.size(); c++) {
+      const double y = -L.invDiag[c]*L.tmp[c];
+      xx += L.x[c]*L.x[c];
+      yy += y*y;
+      L.tmp[c] = y;
+    }
+    if (yy == 0.0 || xx == 0.0) {
+      break;
+    }
+    lambda = std::sqrt(yy/xx);
+    const double scale = 1.0/std::sqrt(yy);
+    for (size_t c = 0; c < L.x.size(); c++) {
+      L.x[c] = L.tmp[c]*scale;
+    }
+  }
+  L.lambdaMax = lambda;
+
+  std::fill(L.x.begin(), L.x.end(), 0.0);
+  std::fill(L.tmp.begin(), L.tmp.end(), 0.0);
+}
+
+//______________________________________________________________________
+//  Copy a box vector (x-fastest, no padding) in or out of a level
+void
+MGHierarchy::load( Level & L, std::vector<double> Level::* field, const std::vector<double> & v ) const
+{
+  std::vector<double> & f = L.*field;
+  const int nx = L.size.x(), ny = L.size.y();
+  for (int k = 0; k < L.size.z(); k++) {
+    for (int j = 0; j < ny; j++) {
+      const int c = L.index(0,j,k);
+      const double * vv = &v[nx*(j + ny*k)];
+      for (int i = 0; i < nx; i++) {
+        f[c+i] = vv[i];
+      }
+    }
+  }
+}
+
+void
+MGHierarchy::store( const Level & L, std::vector<double> & v ) const
+{
+  const int nx = L.size.x(), ny = L.size.y();
+  v.resize(L.numCells());
+  for (int k = 0; k < L.size.z(); k++) {
+    for (int j = 0; j < ny; j++) {
+      const int c = L.index(0,j,k);
+      double * vv = &v[nx*(j + ny*k)];
+      for (int i = 0; i < nx; i++) {
+        vv[i] = L.x[c+i];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::vcycle( const std::vector<double> & r, std::vector<double> & x )
+{
+  const int nlevels = static_cast<int>(m_levels.size());
+  load(m_levels[0], &Level::r, r);
+  load(m_levels[0], &Level::x, x);
+
+  for (int l = 0; l < nlevels - 1; l++) {
+    Level & L = m_levels[l];
+    Level & C = m_levels[l+1];
+    relax(L, m_options.preSweeps, false);
+    computeResidual(L);
+
+    std::fill(C.r.begin(), C.r.end(), 0.0);
+    for (int k = 0; k < L.size.z(); k++) {
+      for (int j = 0; j < L.size.y(); j++) {
+        for (int i = 0; i < L.size.x(); i++) {
+          C.r[C.index(i/L.ratio.x(), j/L.ratio.y(), k/L.ratio.z())] += L.tmp[L.index(i,j,k)];
+        }
+      }
+    }
+    std::fill(C.x.begin(), C.x.end(), 0.0);
+  }
+
+  // The coarsest level has a handful of cells, solve it with symmetric
+  // sweeps so that the cycle stays a symmetric preconditioner.
+  const int coarseSweeps = (nlevels > 1) ? 10 : 1;
+  relax(m_levels.back(), coarseSweeps*m_options.preSweeps,  false);
+  relax(m_levels.back(), coarseSweeps*m_options.postSweeps, true);
+
+  for (int l = nlevels - 2; l >= 0; l--) {
+    Level & L = m_levels[l];
+    const Level & C = m_levels[l+1];
+    for (int k = 0; k < L.size.z(); k++) {
+      for (int j = 0; j < L.size.y(); j++) {
+        for (int i = 0; i < L.size.x(); i++) {
+          L.x[L.index(i,j,k)] += C.x[C.index(i/L.ratio.x(), j/L.ratio.y(), k/L.ratio.z())];
+        }
+      }
+    }
+    relax(L, m_options.postSweeps, true);
+  }
+
+  store(m_levels[0], x);
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::smooth( const std::vector<double> & r,
+                           std::vector<double> & x,
+                           int                   sweeps,
+                           bool                  reverse,
+                     const bool                  hasGhost[6],
+                     const GhostMap            & ghost )
+{
+  Level & L0 = m_levels[0];
+  load(L0, &Level::r, r);
+  load(L0, &Level::x, x);
+
+  // Fold the (fixed) neighbor values into the right hand side of the
+  // boundary cells
+  const int nx = L0.size.x(), ny = L0.size.y();
+  for (int face = 0; face < 6; face++) {
+    if (!hasGhost[face]) {
+      continue;
+    }
+    const int d  = face/2;
+    const int d1 = (d == 0) ? 1 : 0;
+    const int d2 = (d == 2) ? 1 : 2;
+    const int n1 = L0.size[d1], n2 = L0.size[d2];
+    for (int b = 0; b < n2; b++) {
+      for (int a = 0; a < n1; a++) {
+        IntVector c;
+        c[d]  = (face % 2 == 0) ? 0 : L0.size[d] - 1;
+        c[d1] = a;
+        c[d2] = b;
+        const Stencil7 & s = m_A[c.x() + nx*(c.y() + ny*c.z())];
+        L0.r[L0.index(c.x(), c.y(), c.z())] -= s[face]*ghost(face, a, b);
+      }
+    }
+  }
+
+  relax(L0, sweeps, reverse);
+  store(L0, x);
+}
+
+//______________________________________________________________________
+//
+IntVector
+MGHierarchy::aggregateRatio( const IntVector & size,
+                             const Options   & options,
+                                   int         levels )
+{
+  std::vector<IntVector> ratios;
+  coarseningRatios(size, options, ratios);
+
+  IntVector F(1,1,1);
+  for (int l = 0; l < levels && l < static_cast<int>(ratios.size()); l++) {
+    F = F*ratios[l];
+  }
+  return F;
+}
+
+//______________________________________________________________________
+//
+IntVector
+MGHierarchy::aggregateSize( const IntVector & size, const IntVector & F )
+{
+  return IntVector( (size.x() + F.x() - 1)/F.x(),
+                    (size.y() + F.y() - 1)/F.y(),
+                    (size.z() + F.z() - 1)/F.z() );
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::restrictSum( const std::vector<double> & fine,
+                          const IntVector           & size,
+                          const IntVector           & F,
+                                std::vector<double> & coarse )
+{
+  const IntVector Nc = aggregateSize(size, F);
+  coarse.assign(long64(Nc.x())*Nc.y()*Nc.z(), 0.0);
+
+  long64 n = 0;
+  for (int k = 0; k < size.z(); k++) {
+    for (int j = 0; j < size.y(); j++) {
+      double * row = &coarse[Nc.x()*(j/F.y() + long64(Nc.y())*(k/F.z()))];
+      for (int i = 0; i < size.x(); i++) {
+        row[i/F.x()] += fine[n++];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::prolongAdd( const std::vector<double> & coarse,
+                         const IntVector           & size,
+                         const IntVector           & F,
+                               std::vector<double> & fine )
+{
+  const IntVector Nc = aggregateSize(size, F);
+
+  long64 n = 0;
+  for (int k = 0; k < size.z(); k++) {
+    for (int j = 0; j < size.y(); j++) {
+      const double * row = &coarse[Nc.x()*(j/F.y() + long64(Nc.y())*(k/F.z()))];
+      for (int i = 0; i < size.x(); i++) {
+        fine[n++] += row[i/F.x()];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MGHierarchy::coarseRows( const std::vector<Stencil7>  & A,
+                         const IntVector              & size,
+                         const IntVector              & F,
+                         const bool                     coupled[6],
+                               Coarsening               coarsening,
+                               long64                   ncoarse,
+                         const AggregateMap           & aggregateIndex,
+                               std::map<long64, double> & entries )
+{
+  const bool galerkin = (coarsening == Galerkin);
+
+  // for the rediscretization, the diagonal of an aggregate is the sum
+  // of its rows less the off diagonal entries
+  std::map<long64, double> excess, offsum;
+
+  const int nx = size.x(), ny = size.y(), nz = size.z();
+  for (int k = 0; k < nz; k++) {
+    for (int j = 0; j < ny; j++) {
+      for (int i = 0; i < nx; i++) {
+        const Stencil7 & a = A[i + nx*(j + ny*k)];
+        long64    I;
+        IntVector Fi;
+        aggregateIndex(IntVector(i,j,k), I, Fi);
+        double ex = a.p;
+
+        if (galerkin) {
+          entries[I*ncoarse + I] += a.p;
+        }
+
+        for (int f = 0; f < 6; f++) {
+          if (a[f] == 0.0) {
+            continue;
+          }
+          const IntVector nb(i + faceOffset[f][0], j + faceOffset[f][1], k + faceOffset[f][2]);
+          const bool inside = (nb.x() >= 0 && nb.y() >= 0 && nb.z() >= 0 &&
+                               nb.x() < nx && nb.y() < ny && nb.z() < nz);
+          long64    J;
+          IntVector Fn;
+          if ((!inside && !coupled[f]) || !aggregateIndex(nb, J, Fn)) {
+            continue;
+          }
+
+          ex += a[f];
+          if (J == I) {
+            if (galerkin) {
+              entries[I*ncoarse + I] += a[f];
+            }
+          }
+          else if (galerkin) {
+            entries[I*ncoarse + J] += a[f];
+          }
+          else {
+            const int d = faceDir(f);
+            const double v = a[f]/std::max(F[d], Fn[d]);
+            entries[I*ncoarse + J] += v;
+            offsum[I] += v;
+          }
+        }
+
+        if (!galerkin) {
+          excess[I] += ex;
+        }
+      }
+    }
+  }
+
+  if (!galerkin) {
+    for (const auto & e : excess) {
+      entries[e.first*ncoarse + e.first] += e.second - offsum[e.first];
+    }
+  }
+}
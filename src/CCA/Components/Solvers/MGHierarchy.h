@@ -0,0 +1,190 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef Packages_Uintah_CCA_Components_Solvers_MGHierarchy_h
+#define Packages_Uintah_CCA_Components_Solvers_MGHierarchy_h
+
+#include <Core/Disclosure/TypeUtils.h>
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/Stencil7.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace Uintah {
+
+  //______________________________________________________________________
+  //
+  //  Geometric multigrid hierarchy of a box of cells.
+  //
+  //  A Stencil7 operator on a box is coarsened by agglomerating 2 cells per
+  //  direction (directions that are already small are not coarsened) with
+  //  piecewise constant prolongation and summed restriction.  The coarse
+  //  operators are either the Galerkin product R A P, or rediscretized:
+  //  each face coupling is scaled by the inverse of the coarsening ratio
+  //  normal to it, the same scaling a constant coefficient Laplacian gets
+  //  when it is discretized on the coarse grid.  Couplings that leave the
+  //  box are dropped.
+  //
+  //  MGSolver uses it in two places:
+  //    - per patch, with a single level, for the patch level smoothing.
+  //      The neighbor values exchanged by the task graph are passed to
+  //      smooth() so that no couplings are dropped.
+  //    - on the rank that the coarse problem is agglomerated onto, as the
+  //      full hierarchy of the coarse box.
+  //  The static functions build the coarse problem from the patches: the
+  //  patch residual is restricted onto aggregates of F cells, and
+  //  coarseRows() gives the rows of the aggregated operator.
+  //
+  //  All arrays are stored with one layer of zero padding so that the
+  //  stencil kernels don't need boundary tests.
+  //
+
+  class MGHierarchy {
+
+  public:
+
+    enum Smoother   { RedBlackGS, Chebyshev };
+    enum Coarsening { Galerkin, Rediscretize };
+
+    struct Options {
+      Smoother   smoother       {RedBlackGS};
+      Coarsening coarsening     {Galerkin};
+      int        preSweeps      {2};
+      int        postSweeps     {2};
+      int        maxLevels      {20};
+      int        coarseSize     {2};      // stop coarsening a direction at this many cells
+      double     chebyshevRatio {0.3};    // smallest eigenvalue targeted, relative to the largest
+    };
+
+    // Per level coarsening ratios (1 or 2 in each direction) of a box of
+    // the given size.  Depends on the size and the options only.
+    static void coarseningRatios( const IntVector        & size,
+                                  const Options          & options,
+                                  std::vector<IntVector> & ratios );
+
+    // Build the hierarchy of the operator A, given in x-fastest order for
+    // the cells of a box of the given size.
+    void setup( const std::vector<Stencil7> & A,
+                const IntVector             & size,
+                const Options               & options );
+
+    int numLevels() const { return static_cast<int>(m_levels.size()); }
+
+    // One V-cycle for A x = r, x is updated.  Vectors are x-fastest over
+    // the box cells.
+    void vcycle( const std::vector<double> & r, std::vector<double> & x );
+
+    // Smoothing sweeps of the finest level.  'ghost(face, i, j)' gives the
+    // value of the neighbor across 'face' of the boundary cell (i,j) of
+    // that face (x-fastest over the other two directions).  The couplings
+    // through faces without ghost values are dropped.
+    using GhostMap = std::function<double( int face, int i, int j )>;
+
+    void smooth( const std::vector<double> & r,
+                       std::vector<double> & x,
+                       int                   sweeps,
+                       bool                  reverse,
+                 const bool                  hasGhost[6],
+                 const GhostMap            & ghost );
+
+    //__________________________________
+    //  Aggregation of a patch onto the coarse problem
+
+    // Aggregate size after 'levels' coarsenings of a patch of the given size
+    static IntVector aggregateRatio( const IntVector & size,
+                                     const Options   & options,
+                                           int         levels );
+
+    static IntVector aggregateSize( const IntVector & size, const IntVector & F );
+
+    // coarse[aggregate] = sum of 'fine' over the aggregate
+    static void restrictSum( const std::vector<double> & fine,
+                             const IntVector           & size,
+                             const IntVector           & F,
+                                   std::vector<double> & coarse );
+
+    // fine[cell] += coarse[aggregate of the cell]
+    static void prolongAdd( const std::vector<double> & coarse,
+                            const IntVector           & size,
+                            const IntVector           & F,
+                                  std::vector<double> & fine );
+
+    //  Rows of the aggregated operator for the aggregates of a patch,
+    //  added to 'entries' (key row*ncoarse+col).
+    //
+    //  A, size, F       patch part of the operator and its aggregate size
+    //  coupled[face]    couplings through this face are kept (neighbor patch)
+    //  aggregateIndex   maps a cell (relative to the patch low index, inside
+    //                   or outside of the patch) to the global index of its
+    //                   aggregate and the aggregate size of its patch, or
+    //                   returns false.
+    using AggregateMap = std::function<bool( const IntVector & cell, long64 & index, IntVector & ratio )>;
+
+    static void coarseRows( const std::vector<Stencil7>  & A,
+                            const IntVector              & size,
+                            const IntVector              & F,
+                            const bool                     coupled[6],
+                                  Coarsening               coarsening,
+                                  long64                   ncoarse,
+                            const AggregateMap           & aggregateIndex,
+                            std::map<long64, double>     & entries );
+
+  private:
+
+    struct Level {
+      IntVector size;
+      IntVector ratio;                // to the next coarser level
+      int       sy {0};               // padded strides
+      int       sz {0};
+      double    lambdaMax {1.0};      // of D^-1 A, for Chebyshev
+      std::vector<Stencil7> A;        // padded, outward couplings zeroed
+      std::vector<double>   invDiag;
+      std::vector<double>   x;
+      std::vector<double>   r;
+      std::vector<double>   tmp;
+      std::vector<double>   dir;
+
+      long64 numCells() const { return long64(size.x()) * size.y() * size.z(); }
+      int index( int i, int j, int k ) const { return (i+1) + sy*(j+1) + sz*(k+1); }
+      void allocate( const IntVector & n );
+    };
+
+    void coarsen( const Level & fine, Level & coarse ) const;
+    void computeResidual( Level & L ) const;             // tmp = r - A x
+    void relax( Level & L, int sweeps, bool reverse ) const;
+    void estimateLambdaMax( Level & L ) const;
+    void load( Level & L, std::vector<double> Level::* field, const std::vector<double> & v ) const;
+    void store( const Level & L, std::vector<double> & v ) const;
+
+    Options               m_options;
+    std::vector<Level>    m_levels;
+    std::vector<Stencil7> m_A;          // finest level, including the outward couplings
+  };
+
+} // end namespace Uintah
+
+#endif // Packages_Uintah_CCA_Components_Solvers_MGHierarchy_h
@@ -0,0 +1,1305 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Solvers/MGSolver.h>
+#include <CCA/Ports/LoadBalancer.h>
+#include <CCA/Ports/Scheduler.h>
+#include <Core/Exceptions/ConvergenceFailure.h>
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/PerPatch.h>
+#include <Core/Grid/Variables/Stencil7.h>
+#include <Core/Grid/Variables/VarLabel.h>
+#include <Core/Grid/Variables/VarTypes.h>
+#include <Core/Math/BlockSparseMatrix.h>
+#include <Core/Math/MinMax.h>
+#include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/UintahMPI.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/DebugStream.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <cmath>
+
+using namespace std;
+using namespace Uintah;
+
+//__________________________________
+//  To turn on normal output
+//  setenv SCI_DEBUG "SOLVER_DOING_COUT:+"
+
+static DebugStream cout_doing("SOLVER_DOING_COUT", false);
+
+namespace {
+
+  const IntVector faceOffset[6] = { IntVector(-1,0,0), IntVector(1,0,0),
+                                    IntVector(0,-1,0), IntVector(0,1,0),
+                                    IntVector(0,0,-1), IntVector(0,0,1) };
+
+  inline bool hasNeighbor( const Patch * patch, int face )
+  {
+    return patch->getBCType(Patch::FaceType(face)) == Patch::Neighbor;
+  }
+
+  //__________________________________
+  //  (A x)[idx].  Couplings to cells outside of [ll, hh] are not used,
+  //  the bounds include the ghost layer across faces with a neighbor patch.
+  inline double apply( const Stencil7       & a,
+                       const constCCVariable<double> & x,
+                       const IntVector      & idx,
+                       const IntVector      & ll,
+                       const IntVector      & hh )
+  {
+    double result = a.p*x[idx];
+    if (idx.x() > ll.x()) result += a.w*x[idx + IntVector(-1, 0, 0)];
+    if (idx.x() < hh.x()) result += a.e*x[idx + IntVector( 1, 0, 0)];
+    if (idx.y() > ll.y()) result += a.s*x[idx + IntVector( 0,-1, 0)];
+    if (idx.y() < hh.y()) result += a.n*x[idx + IntVector( 0, 1, 0)];
+    if (idx.z() > ll.z()) result += a.b*x[idx + IntVector( 0, 0,-1)];
+    if (idx.z() < hh.z()) result += a.t*x[idx + IntVector( 0, 0, 1)];
+    return result;
+  }
+
+  inline void stencilBounds( const Patch * patch, IntVector & ll, IntVector & hh )
+  {
+    ll = patch->getCellLowIndex();
+    hh = patch->getCellHighIndex() - IntVector(1,1,1);
+    for (int d = 0; d < 3; d++) {
+      if (hasNeighbor(patch, 2*d))   ll[d]--;
+      if (hasNeighbor(patch, 2*d+1)) hh[d]++;
+    }
+  }
+
+  //__________________________________
+  //  Patch cells <-> x-fastest vectors
+  template<class Var>
+  void toVector( const Var & v, const Patch * patch, vector<double> & out )
+  {
+    const IntVector l = patch->getCellLowIndex();
+    const IntVector h = patch->getCellHighIndex();
+    out.resize(long64(h.x() - l.x())*(h.y() - l.y())*(h.z() - l.z()));
+    long64 n = 0;
+    for (int k = l.z(); k < h.z(); k++) {
+      for (int j = l.y(); j < h.y(); j++) {
+        for (int i = l.x(); i < h.x(); i++) {
+          out[n++] = v[IntVector(i,j,k)];
+        }
+      }
+    }
+  }
+
+  void fromVector( const vector<double> & in, const Patch * patch, CCVariable<double> & v )
+  {
+    const IntVector l = patch->getCellLowIndex();
+    const IntVector h = patch->getCellHighIndex();
+    long64 n = 0;
+    for (int k = l.z(); k < h.z(); k++) {
+      for (int j = l.y(); j < h.y(); j++) {
+        for (int i = l.x(); i < h.x(); i++) {
+          v[IntVector(i,j,k)] = in[n++];
+        }
+      }
+    }
+  }
+
+  //__________________________________
+  //  Gather 'send' of every rank onto rank 0, counts[rank] and
+  //  displs[rank] are set on rank 0.
+  template<class T>
+  void gatherToRoot( const ProcessorGroup * pg,
+                     const vector<T>      & send,
+                           vector<T>      & recv,
+                           vector<int>    & counts,
+                           vector<int>    & displs,
+                           MPI_Datatype     type )
+  {
+    int n = static_cast<int>(send.size());
+    counts.assign(pg->nRanks(), 0);
+    displs.assign(pg->nRanks(), 0);
+    Uintah::MPI::Gather(&n, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, pg->getComm());
+
+    int total = 0;
+    if (pg->myRank() == 0) {
+      for (int r = 0; r < pg->nRanks(); r++) {
+        displs[r] = total;
+        total    += counts[r];
+      }
+    }
+    recv.resize(total);
+    Uintah::MPI::Gatherv(const_cast<T*>(send.data()), n, type,
+                         recv.data(), counts.data(), displs.data(), type, 0, pg->getComm());
+  }
+
+} // end anonymous namespace
+
+namespace Uintah {
+
+//______________________________________________________________________
+//
+class MGStencil7 : public RefCounted {
+public:
+  MGStencil7(Scheduler* sched, const ProcessorGroup* world, const Level* level,
+             const MaterialSet* matlset, const PatchSet* perProcPatches,
+             const VarLabel* A, Task::WhichDW which_A_dw,
+             const VarLabel* x, bool modifies_x,
+             const VarLabel* b, Task::WhichDW which_b_dw,
+             const VarLabel* guess, Task::WhichDW which_guess_dw,
+             const MGSolverParams* params)
+    : sched(sched), world(world), level(level), matlset(matlset),
+      perProcPatches(perProcPatches),
+      A_label(A), X_label(x), B_label(b), guess_label(guess),
+      params(params), modifies_x(modifies_x)
+  {
+    parent_which_A_dw     = parentDW(which_A_dw,     "A matrix");
+    parent_which_b_dw     = parentDW(which_b_dw,     "b rhs");
+    parent_which_guess_dw = parentDW(which_guess_dw, "initial guess");
+
+    const TypeDescription* cc = CCVariable<double>::getTypeDescription();
+    R_label    = VarLabel::create(A->getName()+" R",     cc);
+    D_label    = VarLabel::create(A->getName()+" D",     cc);
+    Q_label    = VarLabel::create(A->getName()+" Q",     cc);
+    Z_label    = VarLabel::create(A->getName()+" Z",     cc);
+    X0_label   = VarLabel::create(A->getName()+" MG x0", cc);
+    X1_label   = VarLabel::create(A->getName()+" MG x1", cc);
+    d_label    = VarLabel::create(A->getName()+" d",     sum_vartype::getTypeDescription());
+    aden_label = VarLabel::create(A->getName()+" aden",  sum_vartype::getTypeDescription());
+    restricted_label  = VarLabel::create(A->getName()+" MG restricted",   PerPatch<int>::getTypeDescription());
+    coarseSetup_label = VarLabel::create(A->getName()+" MG coarse setup", PerPatch<int>::getTypeDescription());
+
+    if (params->norm == MGSolverParams::LInfinity) {
+      err_label = VarLabel::create(A->getName()+" err", max_vartype::getTypeDescription());
+    }
+    else {
+      err_label = VarLabel::create(A->getName()+" err", sum_vartype::getTypeDescription());
+    }
+
+    m_patchOptions = params->options;
+    m_patchOptions.maxLevels = 1;
+
+    numberAggregates();
+  }
+
+  virtual ~MGStencil7() {
+    VarLabel::destroy(R_label);
+    VarLabel::destroy(D_label);
+    VarLabel::destroy(Q_label);
+    VarLabel::destroy(Z_label);
+    VarLabel::destroy(X0_label);
+    VarLabel::destroy(X1_label);
+    VarLabel::destroy(d_label);
+    VarLabel::destroy(aden_label);
+    VarLabel::destroy(err_label);
+    VarLabel::destroy(restricted_label);
+    VarLabel::destroy(coarseSetup_label);
+  }
+
+//______________________________________________________________________
+//  Global numbering of the aggregates.  If the patches tile the level's
+//  box with the same aggregate size, and their aggregates line up, the
+//  aggregates are numbered x-fastest over the coarse box so that rank 0
+//  can run multigrid on it.  Otherwise they are numbered patch by patch.
+  void numberAggregates()
+  {
+    level->findInteriorCellIndexRange(m_levelLow, m_levelHigh);
+
+    m_ncoarse = 0;
+    m_isBox   = true;
+    long64 volume = 0;
+    IntVector F0(0,0,0);
+
+    for (Level::const_patch_iterator iter = level->patchesBegin(); iter != level->patchesEnd(); ++iter) {
+      const Patch* patch = *iter;
+      const IntVector low  = patch->getCellLowIndex();
+      const IntVector high = patch->getCellHighIndex();
+      const IntVector size = high - low;
+      const IntVector F  = MGHierarchy::aggregateRatio(size, params->options, params->aggregationLevels);
+      const IntVector nc = MGHierarchy::aggregateSize(size, F);
+
+      m_F[patch->getID()]      = F;
+      m_offset[patch->getID()] = m_ncoarse;
+      m_ncoarse += long64(nc.x())*nc.y()*nc.z();
+      volume    += long64(size.x())*size.y()*size.z();
+
+      if (F0 == IntVector(0,0,0)) {
+        F0 = F;
+      }
+      for (int d = 0; d < 3; d++) {
+        if (F[d] != F0[d] || (low[d] - m_levelLow[d]) % F[d] != 0 ||
+            (size[d] % F[d] != 0 && high[d] != m_levelHigh[d])) {
+          m_isBox = false;
+        }
+      }
+    }
+
+    const IntVector range = m_levelHigh - m_levelLow;
+    if (volume != long64(range.x())*range.y()*range.z()) {
+      m_isBox = false;
+    }
+
+    if (m_isBox) {
+      m_boxF    = F0;
+      m_boxSize = MGHierarchy::aggregateSize(range, F0);
+      m_ncoarse = long64(m_boxSize.x())*m_boxSize.y()*m_boxSize.z();
+    }
+  }
+
+  //__________________________________
+  //  Global index of the aggregate of 'cell' (relative to the patch low
+  //  index, inside of the patch or of a neighbor)
+  bool aggregateIndex( const Patch * patch, const IntVector & cell, long64 & index, IntVector & F ) const
+  {
+    const IntVector c = cell + patch->getCellLowIndex();
+
+    if (m_isBox) {
+      for (int d = 0; d < 3; d++) {
+        if (c[d] < m_levelLow[d] || c[d] >= m_levelHigh[d]) {
+          return false;
+        }
+      }
+      F = m_boxF;
+      const IntVector a = (c - m_levelLow)/m_boxF;
+      index = a.x() + long64(m_boxSize.x())*(a.y() + long64(m_boxSize.y())*a.z());
+      return true;
+    }
+
+    const Patch* owner = patch;
+    if (!patch->containsCell(c)) {
+      owner = level->getPatchFromIndex(c, false);
+      if (!owner) {
+        return false;
+      }
+    }
+    F = m_F.at(owner->getID());
+    const IntVector size = owner->getCellHighIndex() - owner->getCellLowIndex();
+    const IntVector nc   = MGHierarchy::aggregateSize(size, F);
+    const IntVector a    = (c - owner->getCellLowIndex())/F;
+    index = m_offset.at(owner->getID()) + a.x() + long64(nc.x())*(a.y() + long64(nc.y())*a.z());
+    return true;
+  }
+
+  //__________________________________
+  //  Norm of the residual used for the convergence test
+  double residualError( const CCVariable<double> & R, const Patch * patch ) const
+  {
+    double err = 0.0;
+    for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+      const double r = R[*iter];
+      switch (params->norm) {
+      case MGSolverParams::L1:        err += std::fabs(r);        break;
+      case MGSolverParams::L2:        err += r*r;                 break;
+      case MGSolverParams::LInfinity: err  = Max(err, std::fabs(r)); break;
+      }
+    }
+    double norm = params->getResidualNormalizationFactor();
+    if (params->norm == MGSolverParams::L2) {
+      norm *= norm;
+    }
+    return err/norm;
+  }
+
+  void putError( DataWarehouse * new_dw, double err ) const
+  {
+    if (params->norm == MGSolverParams::LInfinity) {
+      new_dw->put(max_vartype(err), err_label);
+    }
+    else {
+      new_dw->put(sum_vartype(err), err_label);
+    }
+  }
+
+  double getError( DataWarehouse * dw ) const
+  {
+    if (params->norm == MGSolverParams::LInfinity) {
+      max_vartype err;
+      dw->get(err, err_label);
+      return err;
+    }
+    sum_vartype err;
+    dw->get(err, err_label);
+    return err;
+  }
+
+  //__________________________________
+  //  Pre-smoothing from a zero guess: X0 = S R.  The neighbors are zero too.
+  void preSmooth( DataWarehouse * new_dw, const Patch * patch, int matl,
+                  const CCVariable<double> & R )
+  {
+    PatchData& pd = m_patchData.at(make_pair(patch->getID(), matl));
+
+    vector<double> r, x;
+    toVector(R, patch, r);
+    x.assign(r.size(), 0.0);
+    const bool noGhost[6] = {false, false, false, false, false, false};
+    pd.smoother.smooth(r, x, params->options.preSweeps, false, noGhost, nullptr);
+
+    CCVariable<double> X0;
+    new_dw->allocateAndPut(X0, X0_label, matl, patch);
+    X0.initialize(0.0);
+    fromVector(x, patch, X0);
+  }
+
+//______________________________________________________________________
+//  R = B - A X, builds the patch smoother and this patch's rows of the
+//  aggregated operator, and pre-smooths.
+  void setup(const ProcessorGroup *,
+             const PatchSubset    * patches,
+             const MaterialSubset * matls,
+             DataWarehouse        *,
+             DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw     = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    DataWarehouse* b_dw     = new_dw->getOtherDataWarehouse(parent_which_b_dw);
+    DataWarehouse* guess_dw = new_dw->getOtherDataWarehouse(parent_which_guess_dw);
+
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "MGSolver::setup on patch " << patch->getID()<< endl;
+
+      IntVector ll, hh;
+      stencilBounds(patch, ll, hh);
+      const IntVector size = patch->getCellHighIndex() - patch->getCellLowIndex();
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        CCVariable<double> R, Xnew;
+        new_dw->allocateAndPut(R,    R_label, matl, patch);
+        new_dw->allocateAndPut(Xnew, X_label, matl, patch);
+        R.initialize(0.0);
+        Xnew.initialize(0.0);
+
+        constCCVariable<double>   B;
+        constCCVariable<Stencil7> A;
+        b_dw->get(B, B_label, matl, patch, Ghost::None, 0);
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+
+        if(guess_label){
+          constCCVariable<double> X;
+          guess_dw->get(X, guess_label, matl, patch, Ghost::AroundCells, 1);
+          for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+            const IntVector c = *iter;
+            R[c]    = B[c] - apply(A[c], X, c, ll, hh);
+            Xnew[c] = X[c];
+          }
+        } else {
+          for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+            R[*iter] = B[*iter];
+          }
+        }
+        putError(new_dw, residualError(R, patch));
+
+        //__________________________________
+        //  Patch smoother and coarse rows
+        PatchData& pd = m_patchData.at(make_pair(patch->getID(), matl));
+
+        vector<Stencil7> Ap;
+        Ap.reserve(long64(size.x())*size.y()*size.z());
+        for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+          Ap.push_back(A[*iter]);
+        }
+        pd.smoother.setup(Ap, size, m_patchOptions);
+        pd.F = m_F.at(patch->getID());
+
+        bool coupled[6];
+        for (int f = 0; f < 6; f++) {
+          coupled[f] = hasNeighbor(patch, f);
+        }
+        auto index = [&](const IntVector& c, long64& I, IntVector& F) {
+          return aggregateIndex(patch, c, I, F);
+        };
+        pd.rows.clear();
+        MGHierarchy::coarseRows(Ap, size, pd.F, coupled, params->options.coarsening,
+                                m_ncoarse, index, pd.rows);
+
+        const IntVector nc = MGHierarchy::aggregateSize(size, pd.F);
+        pd.aggregates.clear();
+        for (int k = 0; k < nc.z(); k++) {
+          for (int j = 0; j < nc.y(); j++) {
+            for (int i = 0; i < nc.x(); i++) {
+              long64    I;
+              IntVector F;
+              aggregateIndex(patch, IntVector(i,j,k)*pd.F, I, F);
+              pd.aggregates.push_back(I);
+            }
+          }
+        }
+
+        preSmooth(new_dw, patch, matl, R);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Gather the aggregated operator onto rank 0.  OncePerProc.
+  void coarseSetup(const ProcessorGroup * pg,
+                   const PatchSubset    * patches,
+                   const MaterialSubset * matls,
+                   DataWarehouse        *,
+                   DataWarehouse        * new_dw)
+  {
+    if(cout_doing.active())
+      cout_doing << "MGSolver::coarseSetup" << endl;
+
+    for(int m = 0;m<matls->size();m++){
+      int matl = matls->get(m);
+      CoarseProblem& cp = m_coarse.at(matl);
+
+      vector<long64> index, rows, cols;
+      vector<double> values;
+      for(int p=0;p<patches->size();p++){
+        const PatchData& pd = m_patchData.at(make_pair(patches->get(p)->getID(), matl));
+        index.insert(index.end(), pd.aggregates.begin(), pd.aggregates.end());
+        for (const auto& e : pd.rows) {
+          rows.push_back(e.first / m_ncoarse);
+          cols.push_back(e.first % m_ncoarse);
+          values.push_back(e.second);
+        }
+      }
+
+      vector<long64> allRows, allCols;
+      vector<double> allValues;
+      vector<int>    counts, displs;
+      gatherToRoot(pg, index,  cp.index, cp.counts, cp.displs, MPI_LONG_LONG);
+      gatherToRoot(pg, rows,   allRows,   counts, displs, MPI_LONG_LONG);
+      gatherToRoot(pg, cols,   allCols,   counts, displs, MPI_LONG_LONG);
+      gatherToRoot(pg, values, allValues, counts, displs, MPI_DOUBLE);
+
+      if (pg->myRank() == 0) {
+        if (m_isBox) {
+          const long64 sy = m_boxSize.x();
+          const long64 sz = sy*m_boxSize.y();
+          vector<Stencil7> Ac(m_ncoarse, Stencil7(0.0));
+          for (size_t n = 0; n < allValues.size(); n++) {
+            Stencil7& a = Ac[allRows[n]];
+            const long64 offset = allCols[n] - allRows[n];
+            if      (offset ==   0) a.p += allValues[n];
+            else if (offset ==  -1) a.w += allValues[n];
+            else if (offset ==   1) a.e += allValues[n];
+            else if (offset == -sy) a.s += allValues[n];
+            else if (offset ==  sy) a.n += allValues[n];
+            else if (offset == -sz) a.b += allValues[n];
+            else if (offset ==  sz) a.t += allValues[n];
+            else {
+              throw InternalError("MGSolver: aggregated operator is not a 7 point stencil", __FILE__, __LINE__);
+            }
+          }
+          cp.mg.setup(Ac, m_boxSize, params->options);
+        }
+        else {
+          cp.A.setSize(m_ncoarse, 1);
+          cp.A.beginAssembly();
+          for (size_t n = 0; n < allValues.size(); n++) {
+            cp.A.add(allRows[n], allCols[n], allValues[n]);
+          }
+          cp.A.endAssembly();
+        }
+      }
+
+      PerPatch<int> done(0);
+      for(int p=0;p<patches->size();p++){
+        new_dw->put(done, coarseSetup_label, matl, patches->get(p));
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Restrict the residual of the pre-smoothed correction onto the aggregates
+  void restrictResidual(const ProcessorGroup *,
+                        const PatchSubset    * patches,
+                        const MaterialSubset * matls,
+                        DataWarehouse        *,
+                        DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      IntVector ll, hh;
+      stencilBounds(patch, ll, hh);
+      const IntVector size = patch->getCellHighIndex() - patch->getCellLowIndex();
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        PatchData& pd = m_patchData.at(make_pair(patch->getID(), matl));
+
+        constCCVariable<Stencil7> A;
+        constCCVariable<double>   R, X0;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+        new_dw->get(R,  R_label,  matl, patch, Ghost::None, 0);
+        new_dw->get(X0, X0_label, matl, patch, Ghost::AroundCells, 1);
+
+        vector<double> residual;
+        residual.reserve(long64(size.x())*size.y()*size.z());
+        for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+          const IntVector c = *iter;
+          residual.push_back(R[c] - apply(A[c], X0, c, ll, hh));
+        }
+        MGHierarchy::restrictSum(residual, size, pd.F, pd.rc);
+
+        PerPatch<int> done(0);
+        new_dw->put(done, restricted_label, matl, patch);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Gather the restricted residual onto rank 0, solve the aggregated
+//  problem there and scatter the correction back:  X1 = X0 + P e.
+//  OncePerProc.
+  void coarseSolve(const ProcessorGroup * pg,
+                   const PatchSubset    * patches,
+                   const MaterialSubset * matls,
+                   DataWarehouse        *,
+                   DataWarehouse        * new_dw,
+                   bool                   /* first */)
+  {
+    if(cout_doing.active())
+      cout_doing << "MGSolver::coarseSolve" << endl;
+
+    for(int m = 0;m<matls->size();m++){
+      int matl = matls->get(m);
+      CoarseProblem& cp = m_coarse.at(matl);
+
+      vector<double> rc;
+      for(int p=0;p<patches->size();p++){
+        const PatchData& pd = m_patchData.at(make_pair(patches->get(p)->getID(), matl));
+        rc.insert(rc.end(), pd.rc.begin(), pd.rc.end());
+      }
+
+      const int n = static_cast<int>(rc.size());
+      vector<double> all, allCorrection;
+      if (pg->myRank() == 0) {
+        all.resize(cp.index.size());
+        allCorrection.resize(cp.index.size());
+      }
+      Uintah::MPI::Gatherv(rc.data(), n, MPI_DOUBLE, all.data(), cp.counts.data(),
+                           cp.displs.data(), MPI_DOUBLE, 0, pg->getComm());
+
+      if (pg->myRank() == 0) {
+        vector<double> r(m_ncoarse, 0.0), e(m_ncoarse, 0.0);
+        for (size_t q = 0; q < all.size(); q++) {
+          r[cp.index[q]] = all[q];
+        }
+
+        if (m_isBox) {
+          for (int c = 0; c < params->coarseCycles; c++) {
+            cp.mg.vcycle(r, e);
+          }
+        }
+        else {
+          double l1 = 0.0;
+          for (const double v : r) {
+            l1 += std::fabs(v);
+          }
+          pcgSolve(cp.A, r, e, Preconditioner::IC0, 1.e-10*l1 + 1.e-300, 5000);
+        }
+
+        for (size_t q = 0; q < all.size(); q++) {
+          allCorrection[q] = e[cp.index[q]];
+        }
+      }
+
+      vector<double> ec(n);
+      Uintah::MPI::Scatterv(allCorrection.data(), cp.counts.data(), cp.displs.data(), MPI_DOUBLE,
+                            ec.data(), n, MPI_DOUBLE, 0, pg->getComm());
+
+      //__________________________________
+      //  X1 = X0 + P e
+      size_t offset = 0;
+      for(int p=0;p<patches->size();p++){
+        const Patch* patch = patches->get(p);
+        const PatchData& pd = m_patchData.at(make_pair(patch->getID(), matl));
+        const IntVector size = patch->getCellHighIndex() - patch->getCellLowIndex();
+
+        vector<double> coarse(ec.begin() + offset, ec.begin() + offset + pd.rc.size());
+        offset += pd.rc.size();
+
+        constCCVariable<double> X0;
+        new_dw->get(X0, X0_label, matl, patch, Ghost::None, 0);
+        vector<double> x;
+        toVector(X0, patch, x);
+        MGHierarchy::prolongAdd(coarse, size, pd.F, x);
+
+        CCVariable<double> X1;
+        new_dw->allocateAndPut(X1, X1_label, matl, patch);
+        X1.initialize(0.0);
+        fromVector(x, patch, X1);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Post-smoothing with the neighbor values of X1:  Z, d = R.Z
+//  The first application also sets the search direction D = Z.
+  void postSmooth(const ProcessorGroup *,
+                  const PatchSubset    * patches,
+                  const MaterialSubset * matls,
+                  DataWarehouse        *,
+                  DataWarehouse        * new_dw,
+                  bool                   first)
+  {
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      const IntVector low  = patch->getCellLowIndex();
+      const IntVector high = patch->getCellHighIndex();
+
+      bool hasGhost[6];
+      for (int f = 0; f < 6; f++) {
+        hasGhost[f] = hasNeighbor(patch, f);
+      }
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        PatchData& pd = m_patchData.at(make_pair(patch->getID(), matl));
+
+        constCCVariable<double> R, X1;
+        new_dw->get(R,  R_label,  matl, patch, Ghost::None, 0);
+        new_dw->get(X1, X1_label, matl, patch, Ghost::AroundCells, 1);
+
+        // neighbor value across 'face' of the boundary cell (a,b) of that face
+        auto ghost = [&](int face, int a, int b) {
+          const int d  = face/2;
+          const int d1 = (d == 0) ? 1 : 0;
+          const int d2 = (d == 2) ? 1 : 2;
+          IntVector c;
+          c[d]  = (face % 2 == 0) ? low[d] - 1 : high[d];
+          c[d1] = low[d1] + a;
+          c[d2] = low[d2] + b;
+          return X1[c];
+        };
+
+        vector<double> r, x;
+        toVector(R,  patch, r);
+        toVector(X1, patch, x);
+        pd.smoother.smooth(r, x, params->options.postSweeps, true, hasGhost, ghost);
+
+        CCVariable<double> Z;
+        new_dw->allocateAndPut(Z, Z_label, matl, patch);
+        Z.initialize(0.0);
+        fromVector(x, patch, Z);
+
+        double dnew = 0.0;
+        for (size_t c = 0; c < x.size(); c++) {
+          dnew += r[c]*x[c];
+        }
+        new_dw->put(sum_vartype(dnew), d_label);
+
+        if (first) {
+          CCVariable<double> D;
+          new_dw->allocateAndPut(D, D_label, matl, patch);
+          D.copyData(Z);
+        }
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  Q = A D, aden = D.Q
+  void step1(const ProcessorGroup*, const PatchSubset* patches,
+             const MaterialSubset* matls,
+             DataWarehouse* old_dw, DataWarehouse* new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      IntVector ll, hh;
+      stencilBounds(patch, ll, hh);
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        CCVariable<double> Q;
+        new_dw->allocateAndPut(Q, Q_label, matl, patch);
+        Q.initialize(0.0);
+
+        constCCVariable<Stencil7> A;
+        constCCVariable<double>   D;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+        old_dw->get(D, D_label, matl, patch, Ghost::AroundCells, 1);
+
+        double aden = 0.0;
+        for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+          const IntVector c = *iter;
+          Q[c]  = apply(A[c], D, c, ll, hh);
+          aden += D[c]*Q[c];
+        }
+        new_dw->put(sum_vartype(aden), aden_label);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  X += a D, R -= a Q, the error and the pre-smoothing of R
+  void step2(const ProcessorGroup   *,
+             const PatchSubset      * patches,
+             const MaterialSubset   * matls,
+             DataWarehouse          * old_dw,
+             DataWarehouse          * new_dw)
+  {
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "MGSolver::step2 on patch" << patch->getID()<<endl;
+
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        constCCVariable<double> D, X, R, Q;
+        old_dw->get(D, D_label, matl, patch, Ghost::None, 0);
+        old_dw->get(X, X_label, matl, patch, Ghost::None, 0);
+        old_dw->get(R, R_label, matl, patch, Ghost::None, 0);
+        new_dw->get(Q, Q_label, matl, patch, Ghost::None, 0);
+
+        CCVariable<double> Xnew, Rnew;
+        new_dw->allocateAndPut(Xnew, X_label, matl, patch);
+        new_dw->allocateAndPut(Rnew, R_label, matl, patch);
+        Xnew.copyData(X);
+        Rnew.copyData(R);
+
+        sum_vartype aden, d;
+        new_dw->get(aden, aden_label);
+        old_dw->get(d, d_label);
+        const double a = d/aden;
+
+        for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+          const IntVector c = *iter;
+          Xnew[c] = X[c] + a*D[c];
+          Rnew[c] = R[c] - a*Q[c];
+        }
+        putError(new_dw, residualError(Rnew, patch));
+
+        preSmooth(new_dw, patch, matl, Rnew);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  D = Z + b D
+  void step3(const ProcessorGroup *,
+             const PatchSubset    * patches,
+             const MaterialSubset * matls,
+             DataWarehouse        * old_dw,
+             DataWarehouse        * new_dw)
+  {
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+
+        sum_vartype dnew, dold;
+        old_dw->get(dold, d_label);
+        new_dw->get(dnew, d_label);
+        const double b = dnew/dold;
+
+        constCCVariable<double> Z, D;
+        new_dw->get(Z, Z_label, matl, patch, Ghost::None, 0);
+        old_dw->get(D, D_label, matl, patch, Ghost::None, 0);
+
+        CCVariable<double> Dnew;
+        new_dw->allocateAndPut(Dnew, D_label, matl, patch);
+        Dnew.copyData(D);
+        for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+          const IntVector c = *iter;
+          Dnew[c] = Z[c] + b*D[c];
+        }
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  The preconditioner tasks.  The coarse solve is the only task that
+//  communicates outside of the task graph; it requires every reduction
+//  computed before it so that its collectives and the reductions run
+//  in the same order on all ranks.
+  void schedulePreconditioner( SchedulerP & subsched, bool first )
+  {
+    Task* task = scinew Task("MGSolver:restrict", this, &MGStencil7::restrictResidual);
+    task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+    task->requires(Task::NewDW, R_label,  Ghost::None, 0);
+    task->requires(Task::NewDW, X0_label, Ghost::AroundCells, 1);
+    task->computes(restricted_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+
+    task = scinew Task("MGSolver:coarseSolve", this, &MGStencil7::coarseSolve, first);
+    task->setType(Task::OncePerProc);
+    task->requires(Task::NewDW, restricted_label, Ghost::None, 0);
+    task->requires(Task::NewDW, X0_label,         Ghost::None, 0);
+    task->requires(Task::NewDW, err_label);
+    if (first) {
+      task->requires(Task::NewDW, coarseSetup_label, Ghost::None, 0);
+    }
+    else {
+      task->requires(Task::NewDW, aden_label);
+    }
+    task->computes(X1_label);
+    subsched->addTask(task, perProcPatches, matlset);
+
+    task = scinew Task("MGSolver:postSmooth", this, &MGStencil7::postSmooth, first);
+    task->requires(Task::NewDW, R_label,  Ghost::None, 0);
+    task->requires(Task::NewDW, X1_label, Ghost::AroundCells, 1);
+    task->computes(Z_label);
+    task->computes(d_label);
+    if (first) {
+      task->computes(D_label);
+    }
+    subsched->addTask(task, level->eachPatch(), matlset);
+  }
+
+  //______________________________________________________________________
+  void solve(const ProcessorGroup * pg,
+             const PatchSubset    * patches,
+             const MaterialSubset * matls,
+             DataWarehouse        * old_dw,
+             DataWarehouse        * new_dw,
+             Handle<MGStencil7>)
+  {
+    if(cout_doing.active())
+      cout_doing << "MGSolver::solve" << endl;
+
+    Timers::Simple timer;
+    timer.start();
+
+    // the tasks only look up their own entries, create them all up front
+    m_patchData.clear();
+    m_coarse.clear();
+    for(int m = 0;m<matls->size();m++){
+      m_coarse[matls->get(m)];
+      for(int p=0;p<patches->size();p++){
+        m_patchData[make_pair(patches->get(p)->getID(), matls->get(m))];
+      }
+    }
+
+    SchedulerP subsched = sched->createSubScheduler();
+    DataWarehouse::ScrubMode old_dw_scrubmode = old_dw->setScrubbing(DataWarehouse::ScrubNone);
+    DataWarehouse::ScrubMode new_dw_scrubmode = new_dw->setScrubbing(DataWarehouse::ScrubNone);
+    subsched->initialize(3, 1);
+    subsched->setParentDWs(old_dw, new_dw);
+    subsched->clearMappings();
+    subsched->mapDataWarehouse(Task::ParentOldDW, 0);
+    subsched->mapDataWarehouse(Task::ParentNewDW, 1);
+    subsched->mapDataWarehouse(Task::OldDW, 2);
+    subsched->mapDataWarehouse(Task::NewDW, 3);
+
+    GridP grid = level->getGrid();
+    int niter=0;
+
+    subsched->advanceDataWarehouse(grid);
+
+    //__________________________________
+    // Schedule the setup and the first application of the preconditioner
+    if(cout_doing.active())
+      cout_doing << "MGSolver::schedule setup" << endl;
+    Task* task = scinew Task("MGSolver:setup", this, &MGStencil7::setup);
+    task->requires(parent_which_b_dw, B_label, Ghost::None, 0);
+    task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+    if(guess_label){
+      task->requires(parent_which_guess_dw, guess_label, Ghost::AroundCells, 1);
+    }
+    task->computes(R_label);
+    task->computes(X_label);
+    task->computes(X0_label);
+    task->computes(err_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+
+    task = scinew Task("MGSolver:coarseSetup", this, &MGStencil7::coarseSetup);
+    task->setType(Task::OncePerProc);
+    task->requires(Task::NewDW, err_label);
+    task->requires(Task::NewDW, X0_label, Ghost::None, 0);
+    task->computes(coarseSetup_label);
+    subsched->addTask(task, perProcPatches, matlset);
+
+    schedulePreconditioner(subsched, true);
+
+    subsched->compile();
+
+    DataWarehouse* subNewDW = subsched->get_dw(3);
+    subNewDW->setScrubbing(DataWarehouse::ScrubNone);
+    subsched->execute();
+
+    double e = getError(subNewDW);
+    const double err0 = e;
+
+    //__________________________________
+    if(!(e < params->initial_tolerance)) {
+      subsched->initialize(3, 1);
+      subsched->setParentDWs(old_dw, new_dw);
+      subsched->clearMappings();
+      subsched->mapDataWarehouse(Task::ParentOldDW, 0);
+      subsched->mapDataWarehouse(Task::ParentNewDW, 1);
+      subsched->mapDataWarehouse(Task::OldDW, 2);
+      subsched->mapDataWarehouse(Task::NewDW, 3);
+
+      task = scinew Task("MGSolver:step1", this, &MGStencil7::step1);
+      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+      task->requires(Task::OldDW,       D_label, Ghost::AroundCells, 1);
+      task->computes(aden_label);
+      task->computes(Q_label);
+      subsched->addTask(task, level->eachPatch(), matlset);
+
+      task = scinew Task("MGSolver:step2", this, &MGStencil7::step2);
+      task->requires(Task::OldDW, d_label);
+      task->requires(Task::NewDW, aden_label);
+      task->requires(Task::OldDW, D_label, Ghost::None, 0);
+      task->requires(Task::OldDW, X_label, Ghost::None, 0);
+      task->requires(Task::OldDW, R_label, Ghost::None, 0);
+      task->requires(Task::NewDW, Q_label, Ghost::None, 0);
+      task->computes(X_label);
+      task->computes(R_label);
+      task->computes(X0_label);
+      task->computes(err_label);
+      subsched->addTask(task, level->eachPatch(), matlset);
+
+      schedulePreconditioner(subsched, false);
+
+      task = scinew Task("MGSolver:step3", this, &MGStencil7::step3);
+      task->requires(Task::OldDW, D_label, Ghost::None, 0);
+      task->requires(Task::NewDW, Z_label, Ghost::None, 0);
+      task->requires(Task::NewDW, d_label);
+      task->requires(Task::OldDW, d_label);
+      task->computes(D_label);
+      subsched->addTask(task, level->eachPatch(), matlset);
+      subsched->compile();
+
+      //__________________________________
+      //  Main iteration
+      while(niter < params->maxiterations && !(e < params->tolerance)){
+        niter++;
+        subsched->advanceDataWarehouse(grid);
+        DataWarehouse* subOldDW = subsched->get_dw(2);
+        DataWarehouse* subNewDW = subsched->get_dw(3);
+
+        subOldDW->setScrubbing(DataWarehouse::ScrubComplete);
+        subNewDW->setScrubbing(DataWarehouse::ScrubNonPermanent);
+
+        subsched->execute();
+
+        e = getError(subNewDW);
+        if(params->criteria == MGSolverParams::Relative){
+          e/=err0;
+        }
+      }
+    }
+
+    //__________________________________
+    //  Pull the solution out of subsched new DW and put it into our X
+    if(modifies_x){
+      for(int p=0;p<patches->size();p++){
+        const Patch* patch = patches->get(p);
+        for(int m = 0;m<matls->size();m++){
+          int matl = matls->get(m);
+          CCVariable<double>      Xnew;
+          constCCVariable<double> X;
+          new_dw->getModifiable(Xnew, X_label, matl, patch);
+          subsched->get_dw(3)->get(X, X_label, matl, patch, Ghost::None, 0);
+          Xnew.copy(X, patch->getCellLowIndex(), patch->getCellHighIndex());
+        }
+      }
+    } else {
+      new_dw->transferFrom(subsched->get_dw(3), X_label, patches, matls);
+    }
+
+    // Restore the scrubbing mode
+    old_dw->setScrubbing(old_dw_scrubmode);
+    new_dw->setScrubbing(new_dw_scrubmode);
+
+    m_patchData.clear();
+    m_coarse.clear();
+
+    double dt = timer().seconds();
+
+    if(niter < params->maxiterations) {
+      proc0cout << "Solve of " << X_label->getName()
+                << " on level " << level->getIndex()
+                << " completed in "
+                << dt << " seconds ("
+                << niter << " iterations, "
+                << e << " residual, "
+                << (m_isBox ? "multigrid" : "IC0-PCG") << " coarse solve of "
+                << m_ncoarse << " aggregates)\n";
+    } else if(params->getRecomputeTimeStepOnFailure()) {
+      proc0cout << "MGSolver not converging, requesting smaller time step\n";
+      proc0cout << "    niters:   " << niter << "\n"
+                << "    residual: " << e << endl;
+
+      new_dw->put( bool_or_vartype(true), VarLabel::find(abortTimeStep_name));
+      new_dw->put( bool_or_vartype(true), VarLabel::find(recomputeTimeStep_name));
+    }
+    else {
+      throw ConvergenceFailure("MGSolve variable: "+X_label->getName(),
+                               niter, e, params->tolerance,__FILE__,__LINE__);
+    }
+  }
+
+//______________________________________________________________________
+//
+private:
+
+  static Task::WhichDW parentDW( Task::WhichDW dw, const string & what )
+  {
+    switch(dw){
+    case Task::OldDW:
+      return Task::ParentOldDW;
+    case Task::NewDW:
+      return Task::ParentNewDW;
+    default:
+      throw ProblemSetupException("Unknown data warehouse for "+what, __FILE__, __LINE__);
+    }
+  }
+
+  struct PatchData {
+    MGHierarchy              smoother;     // patch level only
+    IntVector                F;            // aggregate size
+    std::map<long64, double> rows;         // this patch's rows of the aggregated operator
+    vector<long64>           aggregates;   // global index of the patch's aggregates
+    vector<double>           rc;           // restricted residual
+  };
+
+  struct CoarseProblem {                   // the members are used on rank 0
+    vector<int>       counts;              // aggregates per rank
+    vector<int>       displs;
+    vector<long64>    index;               // global index of the gathered aggregates
+    MGHierarchy       mg;                  // box numbering
+    BlockSparseMatrix A;                   // otherwise
+  };
+
+  Scheduler* sched;
+  const ProcessorGroup* world;
+  const Level* level;
+  const MaterialSet* matlset;
+  const PatchSet* perProcPatches;
+  const VarLabel* A_label;
+  Task::WhichDW parent_which_A_dw;
+  const VarLabel* X_label;
+  const VarLabel* B_label;
+  Task::WhichDW parent_which_b_dw;
+  const VarLabel* guess_label;
+  Task::WhichDW parent_which_guess_dw;
+
+  const VarLabel* R_label;
+  const VarLabel* D_label;
+  const VarLabel* Q_label;
+  const VarLabel* Z_label;
+  const VarLabel* X0_label;
+  const VarLabel* X1_label;
+  const VarLabel* d_label;
+  const VarLabel* aden_label;
+  const VarLabel* err_label;
+  const VarLabel* restricted_label;
+  const VarLabel* coarseSetup_label;
+
+  const MGSolverParams* params;
+  bool modifies_x;
+
+  MGHierarchy::Options m_patchOptions;
+
+  IntVector m_levelLow, m_levelHigh;
+  bool      m_isBox {false};
+  IntVector m_boxF;
+  IntVector m_boxSize;
+  long64    m_ncoarse {0};
+  std::map<int, IntVector> m_F;            // aggregate size of each patch
+  std::map<int, long64>    m_offset;       // first aggregate of each patch (patch numbering)
+
+  std::map<std::pair<int,int>, PatchData> m_patchData;   // (patch ID, matl)
+  std::map<int, CoarseProblem>            m_coarse;      // matl
+};
+
+//______________________________________________________________________
+//
+//______________________________________________________________________
+//
+MGSolver::MGSolver(const ProcessorGroup* myworld)
+  : SolverCommon(myworld)
+{
+  m_params = scinew MGSolverParams();
+}
+
+MGSolver::~MGSolver()
+{
+  delete m_params;
+}
+
+//______________________________________________________________________
+//
+void MGSolver::readParameters(ProblemSpecP& params_ps,
+                              const string& varname)
+{
+  if(params_ps){
+    for(ProblemSpecP param_ps = params_ps->findBlock("Parameters"); param_ps != nullptr; param_ps = param_ps->findNextBlock("Parameters")) {
+      string variable;
+      if(param_ps->getAttribute("variable", variable) && variable != varname) {
+        continue;
+      }
+      param_ps->get("initial_tolerance",           m_params->initial_tolerance);
+      param_ps->get("tolerance",                   m_params->tolerance);
+      param_ps->get("maxiterations",               m_params->maxiterations);
+
+      string norm;
+      if(param_ps->get("norm", norm)){
+        if(norm == "L1" || norm == "l1") {
+          m_params->norm = MGSolverParams::L1;
+        } else if(norm == "L2" || norm == "l2") {
+          m_params->norm = MGSolverParams::L2;
+        } else if(norm == "LInfinity" || norm == "linfinity") {
+          m_params->norm = MGSolverParams::LInfinity;
+        } else {
+          throw ProblemSetupException("Unknown norm type: "+norm, __FILE__, __LINE__);
+        }
+      }
+      string criteria;
+      if(param_ps->get("criteria", criteria)){
+        if(criteria == "Absolute" || criteria == "absolute") {
+          m_params->criteria = MGSolverParams::Absolute;
+        } else if(criteria == "Relative" || criteria == "relative") {
+          m_params->criteria = MGSolverParams::Relative;
+        } else {
+          throw ProblemSetupException("Unknown criteria: "+criteria, __FILE__, __LINE__);
+        }
+      }
+
+      //__________________________________
+      //  multigrid
+      MGHierarchy::Options& options = m_params->options;
+      string smoother;
+      if(param_ps->get("smoother", smoother)){
+        if(smoother == "rbgs" || smoother == "RedBlackGS") {
+          options.smoother = MGHierarchy::RedBlackGS;
+        } else if(smoother == "chebyshev" || smoother == "Chebyshev") {
+          options.smoother = MGHierarchy::Chebyshev;
+        } else {
+          throw ProblemSetupException("Unknown MGSolver smoother: "+smoother+" (rbgs, chebyshev)", __FILE__, __LINE__);
+        }
+      }
+      string coarsening;
+      if(param_ps->get("coarsening", coarsening)){
+        if(coarsening == "galerkin" || coarsening == "Galerkin") {
+          options.coarsening = MGHierarchy::Galerkin;
+        } else if(coarsening == "rediscretize" || coarsening == "Rediscretize") {
+          options.coarsening = MGHierarchy::Rediscretize;
+        } else {
+          throw ProblemSetupException("Unknown MGSolver coarsening: "+coarsening+" (galerkin, rediscretize)", __FILE__, __LINE__);
+        }
+      }
+      param_ps->get("npre",                options.preSweeps);
+      param_ps->get("npost",               options.postSweeps);
+      param_ps->get("max_levels",          options.maxLevels);
+      param_ps->get("coarse_size",         options.coarseSize);
+      param_ps->get("chebyshev_ratio",     options.chebyshevRatio);
+      param_ps->get("aggregation_levels",  m_params->aggregationLevels);
+      param_ps->get("coarse_cycles",       m_params->coarseCycles);
+    }
+  }
+
+  MGHierarchy::Options& options = m_params->options;
+  if(options.preSweeps < 0 || options.postSweeps < 0 || options.preSweeps + options.postSweeps == 0){
+    throw ProblemSetupException("MGSolver: npre and npost must be >= 0 and not both 0", __FILE__, __LINE__);
+  }
+  if(options.preSweeps != options.postSweeps){
+    // the V-cycle is only a symmetric preconditioner with as many pre- as post-sweeps
+    proc0cout << "WARNING: MGSolver npre (" << options.preSweeps << ") != npost ("
+              << options.postSweeps << "), the preconditioner is not symmetric\n";
+  }
+  if(options.maxLevels < 1 || options.coarseSize < 1 || m_params->aggregationLevels < 0 ||
+     m_params->coarseCycles < 1){
+    throw ProblemSetupException("MGSolver: max_levels, coarse_size and coarse_cycles must be >= 1, aggregation_levels >= 0", __FILE__, __LINE__);
+  }
+  if(options.chebyshevRatio <= 0.0 || options.chebyshevRatio >= 1.0){
+    throw ProblemSetupException("MGSolver: chebyshev_ratio must be in (0,1)", __FILE__, __LINE__);
+  }
+
+  if(m_params->norm == MGSolverParams::L2){
+    m_params->tolerance *= m_params->tolerance;
+  }
+}
+
+//______________________________________________________________________
+//
+void MGSolver::scheduleSolve(const LevelP       & level,
+                             SchedulerP         & sched,
+                             const MaterialSet  * matls,
+                             const VarLabel     * A,
+                             Task::WhichDW        which_A_dw,
+                             const VarLabel     * x,
+                             bool                 modifies_x,
+                             const VarLabel     * b,
+                             Task::WhichDW        which_b_dw,
+                             const VarLabel     * guess,
+                             Task::WhichDW        which_guess_dw,
+                             bool                 isFirstSolve)
+{
+  TypeDescription::Type domtype = A->typeDescription()->getType();
+  ASSERTEQ(domtype, x->typeDescription()->getType());
+  ASSERTEQ(domtype, b->typeDescription()->getType());
+
+  if(domtype != TypeDescription::CCVariable){
+    throw ProblemSetupException("MGSolver only solves cell centered systems, use the CGSolver or hypre for "+x->getName(), __FILE__, __LINE__);
+  }
+  if(m_params->getSolveOnExtraCells()){
+    throw ProblemSetupException("MGSolver does not solve on the extra cells", __FILE__, __LINE__);
+  }
+
+  LoadBalancer * lb = sched->getLoadBalancer();
+  const PatchSet * perproc_patches = lb->getPerProcessorPatchSet( level );
+
+  // The extra handle arg ensures that the stencil7 object will get freed
+  // when the task gets freed.
+  MGStencil7* that = scinew MGStencil7(sched.get_rep(), d_myworld, level.get_rep(), matls, perproc_patches,
+                                       A, which_A_dw, x, modifies_x, b, which_b_dw, guess, which_guess_dw, m_params);
+  Handle<MGStencil7> handle = that;
+  Task* task = scinew Task("MGSolver::Matrix solve(CC)", that, &MGStencil7::solve, handle);
+
+  task->requires(which_A_dw, A, Ghost::None, 0);
+  if(guess){
+    task->requires(which_guess_dw, guess, Ghost::AroundCells, 1);
+  }
+  if(modifies_x) {
+    task->modifies(x);
+  }
+  else{
+    task->computes(x);
+  }
+
+  task->requires(which_b_dw, b, Ghost::None, 0);
+  task->hasSubScheduler();
+
+  if(m_params->getRecomputeTimeStepOnFailure()) {
+    task->computes( VarLabel::find(abortTimeStep_name) );
+    task->computes( VarLabel::find(recomputeTimeStep_name) );
+  }
+
+  sched->addTask(task, perproc_patches, matls);
+}
+
+string
+MGSolver::getName() {
+  return "MGSolver";
+}
+
+} // end namespace Uintah
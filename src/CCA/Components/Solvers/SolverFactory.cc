@@ -27,6 +27,7 @@
 #include <CCA/Components/Solvers/AMR/AMRSolver.h>
 #include <CCA/Components/Solvers/SolverFactory.h>
 #include <CCA/Components/Solvers/CGSolver.h>
+#include <CCA/Components/Solvers/MGSolver.h>
 
 #ifdef HAVE_HYPRE
 #  include <CCA/Components/Solvers/HypreSolver.h>
@@ -59,6 +60,9 @@ SolverInterface* SolverFactory::create(       ProblemSpecP   & ps,
   if( solverName == "CGSolver" ) {
     solver = scinew CGSolver(world);
   }
+  else if( solverName == "MGSolver" || solverName == "multigrid" ) {
+    solver = scinew MGSolver(world);
+  }
   else if (solverName == "HypreSolver" || solverName == "hypre") {
 #if HAVE_HYPRE
     solver = scinew HypreSolver2(world);
@@ -80,7 +84,7 @@ SolverInterface* SolverFactory::create(       ProblemSpecP   & ps,
   else {
     std::ostringstream msg;
     msg << "\nERROR<Solver>: Unknown solver (" << solverName
-        << ") Valid Solvers: CGSolver, HypreSolver, AMRSolver, hypreamr \n";
+        << ") Valid Solvers: CGSolver, MGSolver, HypreSolver, AMRSolver, hypreamr \n";
     throw ProblemSetupException( msg.str(), __FILE__, __LINE__ );
   }
 
@@ -35,6 +35,8 @@ SRCDIR := CCA/Components/Solvers
 SRCS += \
 	$(SRCDIR)/SolverCommon.cc  \
 	$(SRCDIR)/CGSolver.cc      \
+	$(SRCDIR)/MGHierarchy.cc   \
+	$(SRCDIR)/MGSolver.cc      \
 	$(SRCDIR)/SolverFactory.cc
 
 PSELIBS := \
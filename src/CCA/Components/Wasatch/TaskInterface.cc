@@ -23,8 +23,6 @@
  */
 
 #include <boost/foreach.hpp>
-#include <boost/thread/mutex.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
 
 //-- SpatialOps library includes --//
 #include <spatialops/OperatorDatabase.h>
@@ -125,6 +123,14 @@ namespace WasatchCore{
       SpatialOps::OperatorDatabase* operators;
       Uintah::Task* task;
       TreePtr tree;
+      Expr::FieldManagerList* fml; ///< fields bound to this patch's tree
+      bool operatorsBound;         ///< operators are bound once for the life of the task graph
+
+      // expressions that need Uintah variables bound before each execution,
+      // looked up once at schedule time rather than on every execution.
+      Pressure* pressure;
+      std::vector<PoissonExpression*> poisson;
+      std::vector<DORadSolver*> radiation;
     };
     typedef std::map< int, Info > PatchTreeTaskMap;
     Uintah::SchedulerP& scheduler_;
@@ -132,7 +138,6 @@ namespace WasatchCore{
     const Uintah::MaterialSet* const materials_;
 
     const std::string taskName_;        ///< the name of the task
-    Expr::FieldManagerList* const fml_; ///< the FieldManagerList for this TaskInterface
 
     bool hasPressureExpression_, hasBeenScheduled_;
     PatchTreeTaskMap patchTreeMap_;
@@ -196,24 +201,8 @@ namespace WasatchCore{
 
 # endif
 
-    /**
-     *  \class ExecMutex
-     *  \brief Scoped lock.
-     */
-    class ExecMutex
-    {
-#   ifdef ENABLE_THREADS
-      const boost::mutex::scoped_lock lock;
-      inline boost::mutex& get_mutex() const{ static boost::mutex m; return m; }
-    public:
-      ExecMutex() : lock( get_mutex() ) {}
-      ~ExecMutex() {}
-#   else
-    public:
-      ExecMutex(){}
-      ~ExecMutex(){}
-#   endif
-    };
+    /** \brief caches the expressions in \c info that bind Uintah variables at execution. */
+    void resolve_uintah_exprs( Info& info ) const;
 
   public:
 
@@ -246,7 +235,7 @@ namespace WasatchCore{
     void schedule( Expr::TagSet newDWFields, const int rkStage );
 
     PatchTreeTaskMap& get_patch_tree_map() {return patchTreeMap_;}
-    Expr::FieldManagerList& get_fml(){return *fml_;}
+    Expr::FieldManagerList& get_fml( const int patchID );
 
   };
 
@@ -264,8 +253,7 @@ namespace WasatchCore{
     : scheduler_( sched ),
       patches_( patches ),
       materials_( materials ),
-      taskName_( taskName ),
-      fml_( scinew Expr::FieldManagerList(taskName) )
+      taskName_( taskName )
   {
     assert( treeMap.size() > 0 );
     hasPressureExpression_ = false;
@@ -277,6 +265,11 @@ namespace WasatchCore{
       const int patchID = vt.first;
       TreePtr tree = vt.second;
 
+      // Each patch gets its own FieldManagerList so that the trees on
+      // different patches never share field bindings and may execute
+      // concurrently on different scheduler threads.
+      Expr::FieldManagerList* const fml = scinew Expr::FieldManagerList( taskName );
+
 #     ifdef HAVE_CUDA
       const bool isHomogeneous = tree->is_homogeneous_gpu();
       bool gpuTurnedOff = !isHomogeneous;
@@ -286,7 +279,7 @@ namespace WasatchCore{
         tree->turn_off_gpu_runnable();
         gpuTurnedOff = true;
         // Get the best device available
-        tree->set_device_index( GPULoadBalancer::get_device_index(), *fml_ );
+        tree->set_device_index( GPULoadBalancer::get_device_index(), *fml );
       }
 
       // Flag the task as Uintah GPU::Task, if it is homogeneous GPU graph
@@ -300,7 +293,7 @@ namespace WasatchCore{
           hasPressureExpression_ = true;
         }
       }
-      tree->register_fields( *fml_ );
+      tree->register_fields( *fml );
 
       BOOST_FOREACH( const std::string& iof, ioFieldSet ){
 
@@ -309,30 +302,30 @@ namespace WasatchCore{
         const Expr::Tag fieldStateNP1 ( iof, Expr::STATE_NP1  );
         if( tree->has_field(fieldStateN) ){
           if( tree->has_expression(tree->get_id(fieldStateN)) ){
-            tree->set_expr_is_persistent( fieldStateN, *fml_ );
+            tree->set_expr_is_persistent( fieldStateN, *fml );
           }
         }
         if( tree->has_field(fieldStateNONE) ){
           if( tree->has_expression(tree->get_id(fieldStateNONE)) ){
-            tree->set_expr_is_persistent( fieldStateNONE, *fml_ );
+            tree->set_expr_is_persistent( fieldStateNONE, *fml );
           }
         }
         if( tree->has_field(fieldStateNP1) ){
           if( tree->has_expression(tree->get_id(fieldStateNP1)) ){
-            tree->set_expr_is_persistent( fieldStateNP1, *fml_ );
+            tree->set_expr_is_persistent( fieldStateNP1, *fml );
           }
         }
 
         // the error norm computed by the dual time integrator needs to be also persistent
         const Expr::Tag normTag = Expr::Tag(iof + "_err_norm", Expr::STATE_NONE);
         if (tree->has_field(normTag) ) {
-          tree->set_expr_is_persistent(normTag, *fml_);
+          tree->set_expr_is_persistent(normTag, *fml);
         }
 
       } // loop over persistent fields
 
       // force Uintah to manage all fields:
-      if( lockAllFields ) tree->lock_fields(*fml_);
+      if( lockAllFields ) tree->lock_fields(*fml);
 
 #     ifdef HAVE_CUDA
       // For Heterogeneous case only
@@ -348,6 +341,9 @@ namespace WasatchCore{
       info.operators = ipim->second.operators;
       info.task = tsk;
       info.tree = tree;
+      info.fml = fml;
+      info.operatorsBound = false;
+      info.pressure = nullptr;
       patchTreeMap_[patchID] = info;
     } // loop over trees
 
@@ -357,13 +353,25 @@ namespace WasatchCore{
 
   TreeTaskExecute::~TreeTaskExecute()
   {
-    delete fml_;
+    BOOST_FOREACH( PatchTreeTaskMap::value_type& vt, patchTreeMap_ ){
+      delete vt.second.fml;
+    }
     // Tasks are deleted by the scheduler that they are assigned to.
     // This means that we don't need to delete the task created here.
   }
 
   //------------------------------------------------------------------
 
+  Expr::FieldManagerList&
+  TreeTaskExecute::get_fml( const int patchID )
+  {
+    PatchTreeTaskMap::iterator iptm = patchTreeMap_.find(patchID);
+    ASSERT( iptm != patchTreeMap_.end() );
+    return *iptm->second.fml;
+  }
+
+  //------------------------------------------------------------------
+
   /**
    *  \ingroup WasatchGraph
    *  \brief adds requisite fields to the given task.
@@ -374,6 +382,9 @@ namespace WasatchCore{
    *  \param materials - the materials to associate with this task
    *  \param newDWFields - any fields specified in this TagSet will be taken from the new DataWarehouse instead of the old DataWarehouse.
    *  \param rkStage - the current Runge-Kutta stage
+   *  \param advertise - if false, only the field modes on \c fml are set
+   *         and nothing is declared on the task.  This is used for the
+   *         per-patch FieldManagerLists after the first one.
    *
    *  This function analyzes the ExpressionTree to identify what
    *  fields are required for this task, and then advertises them to
@@ -386,7 +397,8 @@ namespace WasatchCore{
                       const Uintah::PatchSubset* const patches,
                       const Uintah::MaterialSubset* const materials,
                       const Expr::TagSet& newDWFields,
-                      const int rkStage )
+                      const int rkStage,
+                      const bool advertise = true )
   {
     // this is done once when the task is scheduled.  The purpose of
     // this method is to collect the fields from the ExpressionTree
@@ -497,6 +509,8 @@ namespace WasatchCore{
          */
         const Uintah::Task::WhichDW dw = ( fieldInfo.useOldDataWarehouse ) ? ( (fieldTag.context() == Expr::STATE_DYNAMIC) ? Uintah::Task::OldDW : ( hasDualTime ? Uintah::Task::ParentOldDW : Uintah::Task::OldDW) )  : Uintah::Task::NewDW;
 //        const Uintah::Task::WhichDW dw = ( fieldInfo.useOldDataWarehouse ) ? Uintah::Task::ParentOldDW : Uintah::Task::NewDW;
+        if( !advertise ) continue;
+
         switch( fieldInfo.mode ){
 
         case Expr::COMPUTES:
@@ -576,7 +590,14 @@ namespace WasatchCore{
       }
     }
 
-    add_fields_to_task( *task, *tree, *fml_, pss, mss, newDWFields, rkStage );
+    add_fields_to_task( *task, *tree, *iptm->second.fml, pss, mss, newDWFields, rkStage );
+
+    // the remaining patches carry identical trees; their field managers
+    // need the same modes but must not declare anything on the task again.
+    for( PatchTreeTaskMap::iterator i=patchTreeMap_.begin(); i!=patchTreeMap_.end(); ++i ){
+      if( i == iptm ) continue;
+      add_fields_to_task( *task, *i->second.tree, *i->second.fml, pss, mss, newDWFields, rkStage, false );
+    }
 
     //---------------------------------------------------------------------------------------------------------------------------
     // Added for temporal scheduling support when using RMCRT - APH 05/30/17
@@ -629,11 +650,42 @@ namespace WasatchCore{
     // and insert a Uintah task immediately after.
     ReductionHelper::self().schedule_tasks(Uintah::getLevelP(pss), scheduler_, materials_, tree, patchID, rkStage);
 
+    BOOST_FOREACH( PatchTreeTaskMap::value_type& vt, patchTreeMap_ ){
+      resolve_uintah_exprs( vt.second );
+    }
+
     hasBeenScheduled_ = true;
   }
 
   //------------------------------------------------------------------
 
+  void
+  TreeTaskExecute::resolve_uintah_exprs( Info& info ) const
+  {
+    const TreePtr tree = info.tree;
+
+    info.pressure = nullptr;
+    if( hasPressureExpression_ && Wasatch::flow_treatment() != WasatchCore::COMPRESSIBLE && Wasatch::need_pressure_solve() ){
+      info.pressure = dynamic_cast<Pressure*>( tree->get_expression( TagNames::self().pressure ) );
+    }
+
+    info.poisson.clear();
+    BOOST_FOREACH( const Expr::Tag& ptag, PoissonExpression::poissonTagList ){
+      if( tree->computes_field( ptag ) ){
+        info.poisson.push_back( dynamic_cast<PoissonExpression*>( tree->get_expression( ptag ) ) );
+      }
+    }
+
+    info.radiation.clear();
+    BOOST_FOREACH( const Expr::Tag& tag, DORadSolver::intensityTags ){
+      if( tree->computes_field( tag ) ){
+        info.radiation.push_back( dynamic_cast<DORadSolver*>( tree->get_expression(tag) ) );
+      }
+    }
+  }
+
+  //------------------------------------------------------------------
+
   void
   TreeTaskExecute::execute( Uintah::DetailedTask* dtask,
                             Uintah::Task::CallBackEvent event,
@@ -651,14 +703,11 @@ namespace WasatchCore{
     //
     // execute on each patch
     //
-    // NOTE: in principle this patch loop could be done in parallel
-    //       IFF the expression tree was generated for each patch.
-    //       Otherwise we would have binding clashes between different
-    //       threads.
+    // NOTE: each patch owns its tree and FieldManagerList, so detailed
+    //       tasks for different patches may run this concurrently on
+    //       different scheduler threads without clashing bindings.
     //
 
-    ExecMutex lock; // thread-safe
-
     const bool isGPUTask = (event == Uintah::Task::GPU);
 
     // preventing postGPU / preGPU callbacks to execute the tree again
@@ -668,7 +717,9 @@ namespace WasatchCore{
       const int patchID = patch->getID();
       PatchTreeTaskMap::iterator iptm = patchTreeMap_.find(patchID);
       ASSERT( iptm != patchTreeMap_.end() );
-      const TreePtr tree = iptm->second.tree;
+      Info& info = iptm->second;
+      const TreePtr tree = info.tree;
+      Expr::FieldManagerList& fml = *info.fml;
 
 #     ifdef HAVE_CUDA
       if( isGPUTask ){ // homogeneous GPU task
@@ -679,11 +730,15 @@ namespace WasatchCore{
 
         // set the device index passed from Uintah to the Expression tree
         // Currently it is not yet fixed as the callback is not providing deviceID
-        tree->set_device_index( deviceID, *fml_);
+        tree->set_device_index( deviceID, fml );
       }
 #     endif
 
-      const SpatialOps::OperatorDatabase& opdb = *iptm->second.operators;
+      // operators live as long as the patch, so they only need binding once.
+      if( !info.operatorsBound ){
+        tree->bind_operators( *info.operators );
+        info.operatorsBound = true;
+      }
 
       for( int im=0; im<materials->size(); ++im ){
 
@@ -694,7 +749,7 @@ namespace WasatchCore{
                     << "' for patch " << patch->getID()
                     << " and material " << material
                     << endl;
-          if( dbg_tasks_on ) fml_->dump_fields(std::cout);
+          if( dbg_tasks_on ) fml.dump_fields(std::cout);
 
 
           Uintah::ParticleSubset* const pset = newDW->haveParticleSubset(material, patch) ?
@@ -702,18 +757,14 @@ namespace WasatchCore{
               ( oldDW ? (oldDW->haveParticleSubset(material, patch) ? oldDW->getParticleSubset(material, patch) : nullptr ) : nullptr );
 
           AllocInfo ainfo( oldDW, newDW, material, patch, pset, pg, isGPUTask );
-          fml_->allocate_fields( ainfo );
+          fml.allocate_fields( ainfo );
 
-          if( hasPressureExpression_ && Wasatch::flow_treatment() != WasatchCore::COMPRESSIBLE && Wasatch::need_pressure_solve() ){
-            Pressure* pexpr = dynamic_cast<Pressure*>( tree->get_expression( TagNames::self().pressure ) );
-            pexpr->bind_uintah_vars( newDW, patch, material, rkStage );
+          if( info.pressure ){
+            info.pressure->bind_uintah_vars( newDW, patch, material, rkStage );
           }
 
-          BOOST_FOREACH( const Expr::Tag& ptag, PoissonExpression::poissonTagList ){
-            if( tree->computes_field( ptag ) ){
-              PoissonExpression* pexpr = dynamic_cast<PoissonExpression*>( tree->get_expression( ptag ) );
-              pexpr->bind_uintah_vars( newDW, patch, material, rkStage );
-            }
+          BOOST_FOREACH( PoissonExpression* pexpr, info.poisson ){
+            pexpr->bind_uintah_vars( newDW, patch, material, rkStage );
           }
 
           // In case we want to copy coordinates instead of recomputing them, uncomment the following lines
@@ -731,18 +782,14 @@ namespace WasatchCore{
           //              else if( coordFieldT == "ZVOL" ) oldVar.add_variable<ZVolField>( ADVANCE_SOLUTION, coordTag, true );
           //            }
 
-          BOOST_FOREACH( const Expr::Tag& tag, DORadSolver::intensityTags ){
-            if( tree->computes_field( tag ) ){
-              DORadSolver* rad = dynamic_cast<DORadSolver*>( tree->get_expression(tag) );
-              rad->bind_uintah_vars( newDW, patch, material, rkStage );
-            }
+          BOOST_FOREACH( DORadSolver* rad, info.radiation ){
+            rad->bind_uintah_vars( newDW, patch, material, rkStage );
           }
 
-          tree->bind_fields( *fml_ );
-          tree->bind_operators( opdb );
+          tree->bind_fields( fml );
           tree->execute_tree();
           dbg_tasks << "Wasatch: done executing graph '" << taskName_ << "'" << endl;
-          fml_->deallocate_fields();
+          fml.deallocate_fields();
         }
         catch( std::exception& e ){
           proc0cout << e.what() << endl;
@@ -889,7 +936,7 @@ namespace WasatchCore{
       execList_.push_back( tskExec );
       for( int ip=0; ip<localPatches->size(); ++ip ){
         const int patchID = localPatches->get(ip)->getID();
-        dualTimePatchMap[patchID].first->set_fml(tskExec->get_fml());
+        dualTimePatchMap[patchID].first->set_fml(tskExec->get_fml(patchID));
       }
     }
   }
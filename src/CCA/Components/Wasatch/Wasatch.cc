@@ -39,6 +39,7 @@
 #include <Core/Grid/Task.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/ThreadExecutor.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/Grid/Patch.h>
@@ -370,6 +371,23 @@ namespace WasatchCore{
 
   //--------------------------------------------------------------------
 
+  /**
+   * \brief Limit the ExprLib/SpatialOps thread count requested in the input
+   *        to the cores left for each scheduler thread, so that the Wasatch
+   *        pools and the scheduler threads together don't oversubscribe the
+   *        node.
+   */
+  int clamp_thread_count( const int requested, const std::string& name )
+  {
+    const int available = Uintah::ThreadExecutor::threadsPerTask();
+    if( requested <= available ) return requested;
+    proc0cout << "NOTE: Wasatch " << name << " of " << requested
+              << " reduced to " << available << " to stay within the cores of this MPI process" << std::endl;
+    return available;
+  }
+
+  //--------------------------------------------------------------------
+
   
   void Wasatch::preGridProblemSetup(const Uintah::ProblemSpecP& uintahSpec,
                                     Uintah::GridP& grid)
@@ -417,6 +435,7 @@ namespace WasatchCore{
 #    ifdef ENABLE_THREADS
       int spatialOpsThreads=0;
       wasatchSpec_->get( "FieldParallelThreadCount", spatialOpsThreads );
+      spatialOpsThreads = clamp_thread_count( spatialOpsThreads, "FieldParallelThreadCount" );
       SpatialOps::set_hard_thread_count(NTHREADS);
       SpatialOps::set_soft_thread_count( spatialOpsThreads );
       proc0cout << "-> Wasatch is running with " << SpatialOps::get_soft_thread_count()
@@ -430,6 +449,7 @@ namespace WasatchCore{
 #    ifdef ENABLE_THREADS
       int exprLibThreads=0;
       wasatchSpec_->get( "TaskParallelThreadCount", exprLibThreads );
+      exprLibThreads = clamp_thread_count( exprLibThreads, "TaskParallelThreadCount" );
       Expr::set_hard_thread_count( NTHREADS );
       Expr::set_soft_thread_count( exprLibThreads );
       proc0cout << "-> Wasatch is running with " << Expr::get_soft_thread_count()
@@ -267,6 +267,16 @@ public:
   virtual size_t emit(OutputContext&, const VarLabel* label,
                     int matlIndex, const Patch* patch) = 0;
 
+  // A new variable holding the data emit() would write, and the extents
+  // it would write.  The data stays valid after this DataWarehouse is
+  // scrubbed or deleted, the caller deletes the variable.  The variable
+  // shares the data unless copy is set, in which case it also stays
+  // unchanged when tasks modify the data in place later on.
+  virtual Variable* emitSnapshot(const VarLabel* label, int matlIndex,
+                                 const Patch* patch,
+                                 IntVector& low, IntVector& high,
+                                 bool copy) = 0;
+
 #if HAVE_PIDX
   virtual void emitPIDX(PIDXOutputContext&, 
                         const VarLabel* label, 
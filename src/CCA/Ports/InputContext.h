@@ -60,11 +60,20 @@ namespace Uintah {
 	 : fd(fd), filename(filename), cur(cur)
       {
       }
+
+      // Read from a copy of the file already in memory, buffer[0] holds
+      // the byte at file offset bufferStart.
+      InputContext(const char* buffer, long bufferStart, const char* filename, long cur)
+	 : fd(-1), filename(filename), cur(cur), buffer(buffer), bufferStart(bufferStart)
+      {
+      }
       ~InputContext() {}
 
       int fd;
       const char* filename;
       long cur;
+      const char* buffer {nullptr};
+      long bufferStart {0};
    private:
       InputContext(const InputContext&);
       InputContext& operator=(const InputContext&);
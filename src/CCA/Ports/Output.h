@@ -203,6 +203,16 @@ WARNING
                                      SchedulerP& sched,
                                      bool previous ) = 0;
 
+    //! Called at the end of the run so a checkpoint still being
+    //! written in the background is completed.
+    virtual void finishCheckpoint() = 0;
+
+    //! Called when restarting before the checkpoint data is read so
+    //! the data files of an in-memory checkpoint are put back.
+    //! Returns false if they are lost on the nodes.
+    virtual bool restoreMemoryCheckpoint( const Dir & restartFromDir,
+                                          int         timeStep ) = 0;
+
     virtual void maybeLastTimeStep( bool val ) = 0;
     virtual bool maybeLastTimeStep() = 0;
 
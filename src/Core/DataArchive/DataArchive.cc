@@ -35,6 +35,7 @@
 #endif
 
 #include <Core/Containers/OffsetArray1.h>
+#include <Core/DataArchive/DataArchiveReadAhead.h>
 #include <Core/Exceptions/ErrnoException.h>
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Exceptions/ProblemSetupException.h>
@@ -128,6 +129,8 @@ DataArchive::DataArchive( const string & filebase,
 //
 DataArchive::~DataArchive()
 {
+  delete d_readAhead;
+
   // The d_createdVarLabels member variable, is used to keep track of
   // the VarLabels (for each of the data fields found in the data
   // archive we are reading data out of) for which a varLabel does not
@@ -1072,6 +1075,7 @@ DataArchive::query(       Variable     & var,
 
   VarData & varinfo = timedata.d_varInfo[ name ];
   string    data_filename;
+  string    relative_filename;        // data_filename relative to the timestep directory
   int       patchid;
   VarType   varType = BLANK;
 
@@ -1099,15 +1103,17 @@ DataArchive::query(       Variable     & var,
 
     ostringstream ostr;
     // append l#/datafilename to the directory
-    ostr << timedata.d_ts_directory << "l" << patch->getLevel()->getIndex() << "/" << patchinfo.datafilename;
-    data_filename = ostr.str();
+    ostr << "l" << patch->getLevel()->getIndex() << "/" << patchinfo.datafilename;
+    relative_filename = ostr.str();
+    data_filename = timedata.d_ts_directory + relative_filename;
   }
   else {
     varType = GLOBAL_VAR;
     // reference reduction and sole var in the file 'global.data' with
     // a null patch
     patchid = -1;
-    data_filename = timedata.d_ts_directory + timedata.d_globaldata;
+    relative_filename = timedata.d_globaldata;
+    data_filename = timedata.d_ts_directory + relative_filename;
   }
 
   // On a call from restartInitialize, we already have the information from the dfi,
@@ -1179,37 +1185,53 @@ DataArchive::query(       Variable     & var,
   //__________________________________
   // open data file Standard Uda Format
   if( d_fileFormat == UDA || varType == GLOBAL_VAR) {
-    int fd = open( data_filename.c_str(), O_RDONLY );
 
-    if(fd == -1) {
-      cerr << "Error opening file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (open call)", errno, __FILE__, __LINE__);
+    // Use the copy of the file made by the read ahead thread if there is one
+    std::shared_ptr<const std::string> prefetched;
+    if( d_readAhead ) {
+      prefetched = d_readAhead->lookup( timeIndex, relative_filename );
     }
 
-    off_t ls = lseek( fd, dfi->start, SEEK_SET );
+    if( prefetched && dfi->end <= (long) prefetched->size() ) {
+      InputContext ic( prefetched->data(), 0, data_filename.c_str(), dfi->start );
+
+      var.read( ic, dfi->end, timedata.d_swapBytes, timedata.d_nBytes, varinfo.compression );
 
-    if( ls == -1 ) {
-      cerr << "Error lseek - file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (lseek call)", errno, __FILE__, __LINE__);
+      ASSERTEQ( dfi->end, ic.cur );
     }
+    else {
+      int fd = open( data_filename.c_str(), O_RDONLY );
+
+      if(fd == -1) {
+        cerr << "Error opening file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (open call)", errno, __FILE__, __LINE__);
+      }
+
+      off_t ls = lseek( fd, dfi->start, SEEK_SET );
+
+      if( ls == -1 ) {
+        cerr << "Error lseek - file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (lseek call)", errno, __FILE__, __LINE__);
+      }
 
-    // read in the variable
-    InputContext ic( fd, data_filename.c_str(), dfi->start );
+      // read in the variable
+      InputContext ic( fd, data_filename.c_str(), dfi->start );
 
-    Timers::Simple read_timer;
-    timer.start();
+      Timers::Simple read_timer;
+      timer.start();
 
-    var.read( ic, dfi->end, timedata.d_swapBytes, timedata.d_nBytes, varinfo.compression );
+      var.read( ic, dfi->end, timedata.d_swapBytes, timedata.d_nBytes, varinfo.compression );
 
-    dbg << "DataArchive::query: time to read raw data: "
-        << read_timer().seconds() << " seconds\n";
+      dbg << "DataArchive::query: time to read raw data: "
+          << read_timer().seconds() << " seconds\n";
 
-    ASSERTEQ( dfi->end, ic.cur );
+      ASSERTEQ( dfi->end, ic.cur );
 
-    int result = close( fd );
-    if( result == -1 ) {
-      cerr << "Error closing file: " << data_filename.c_str() << ", errno=" << errno << '\n';
-      throw ErrnoException("DataArchive::query (close call)", errno, __FILE__, __LINE__);
+      int result = close( fd );
+      if( result == -1 ) {
+        cerr << "Error closing file: " << data_filename.c_str() << ", errno=" << errno << '\n';
+        throw ErrnoException("DataArchive::query (close call)", errno, __FILE__, __LINE__);
+      }
     }
   }
 
@@ -1870,6 +1892,38 @@ DataArchive::postProcess_ReadUda( const ProcessorGroup   * pg,
 
 } // end postProcess_ReadUda()
 
+//______________________________________________________________________
+//
+void
+DataArchive::enableReadAhead( const int    depth,
+                              const size_t maxBytes )
+{
+  if( d_readAhead || depth <= 0 ) {
+    return;
+  }
+
+  vector<int>    timesteps;
+  vector<double> times;
+  queryTimesteps( timesteps, times );
+
+  vector<string> directories( d_timeData.size() );
+  for( unsigned int i = 0; i < d_timeData.size(); i++ ) {
+    directories[i] = d_timeData[i].d_ts_directory;
+  }
+
+  d_readAhead = scinew DataArchiveReadAhead( directories, depth, maxBytes );
+}
+
+//______________________________________________________________________
+//
+void
+DataArchive::readAheadAdvance( const int timeIndex )
+{
+  if( d_readAhead ) {
+    d_readAhead->advance( timeIndex );
+  }
+}
+
 //______________________________________________________________________
 //
 bool
@@ -61,6 +61,7 @@ namespace Uintah {
 class VarLabel;
 class DataWarehouse;
 class LoadBalancer;
+class DataArchiveReadAhead;
 
 /**************************************
 
@@ -145,6 +146,17 @@ public:
                             DataWarehouse        * dw,
                             LoadBalancer         * lb ); 
 
+  //__________________________________
+  //  Prefetch the data files of the next 'depth' timesteps in a background
+  //  thread while the current timestep is processed, holding at most maxBytes.
+  //  Intended for reading the archive one timestep after the other
+  //  (postProcessUda).  See DataArchiveReadAhead.h
+  void enableReadAhead( const int    depth,
+                        const size_t maxBytes );
+
+  // Timestep timeIndex has been read, release it and prefetch the following ones.
+  void readAheadAdvance( const int timeIndex );
+
   // GROUP:  Information Access
   //////////
   // However, we need a means of determining the names of existing
@@ -485,6 +497,8 @@ private:
   int d_numProcessors;
 
   Uintah::MasterLock d_lock;
+
+  DataArchiveReadAhead * d_readAhead{nullptr};
     
   std::string d_particlePositionName;
 
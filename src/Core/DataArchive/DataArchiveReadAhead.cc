@@ -0,0 +1,267 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/DataArchive/DataArchiveReadAhead.h>
+
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Uintah;
+
+//______________________________________________________________________
+//
+DataArchiveReadAhead::DataArchiveReadAhead( const std::vector<std::string> & ts_directories,
+                                            const int                        depth,
+                                            const size_t                     maxBytes ) :
+  d_ts_directories( ts_directories ),
+  d_depth( depth ),
+  d_maxBytes( maxBytes )
+{
+  d_thread = std::thread( &DataArchiveReadAhead::run, this );
+}
+
+//______________________________________________________________________
+//
+DataArchiveReadAhead::~DataArchiveReadAhead()
+{
+  {
+    std::lock_guard<std::mutex> lock( d_mutex );
+    d_stop = true;
+  }
+  d_cv.notify_all();
+  d_thread.join();
+}
+
+//______________________________________________________________________
+//
+std::shared_ptr<const std::string>
+DataArchiveReadAhead::lookup( const int           timeIndex,
+                              const std::string & relativeName )
+{
+  std::unique_lock<std::mutex> lock( d_mutex );
+
+  d_filesRead[timeIndex].insert( relativeName );
+
+  const FileKey key( timeIndex, relativeName );
+
+  // Wait for a read that is under way or queued.  Don't wait if the thread
+  // is stalled on the memory limit, the buffers are only released by advance().
+  d_cv.wait( lock, [&]{ return d_inFlight.count( key ) == 0 &&
+                               ( d_queued.count( key ) == 0 || stalled() ); } );
+
+  auto iter = d_buffers.find( key );
+  if( iter != d_buffers.end() ) {
+    d_hits++;
+    return iter->second;
+  }
+
+  // the caller reads it from disk, don't bother prefetching it
+  if( d_queued.erase( key ) ) {
+    d_cv.notify_all();
+  }
+  d_misses++;
+  return nullptr;
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiveReadAhead::advance( const int timeIndex )
+{
+  {
+    std::lock_guard<std::mutex> lock( d_mutex );
+
+    d_consumed = timeIndex;
+
+    // release everything at or before this timestep
+    for( auto iter = d_buffers.begin(); iter != d_buffers.end(); ) {
+      if( iter->first.first <= timeIndex ) {
+        d_bytes -= iter->second->size();
+        iter = d_buffers.erase( iter );
+      }
+      else {
+        ++iter;
+      }
+    }
+
+    for( auto iter = d_queued.begin(); iter != d_queued.end(); ) {
+      if( iter->first <= timeIndex ) {
+        iter = d_queued.erase( iter );
+      }
+      else {
+        ++iter;
+      }
+    }
+
+    // The files this rank read in this timestep are the ones it will read next
+    auto files = d_filesRead.find( timeIndex );
+    if( files != d_filesRead.end() && !files->second.empty() ) {
+      d_fileSet = files->second;
+    }
+    d_filesRead.erase( d_filesRead.begin(), d_filesRead.upper_bound( timeIndex ) );
+
+    const int last = std::min( timeIndex + d_depth, (int) d_ts_directories.size() - 1 );
+
+    for( int t = timeIndex + 1; t <= last; t++ ) {
+      for( const std::string & name : d_fileSet ) {
+        const FileKey key( t, name );
+
+        if( d_buffers.count( key ) || d_inFlight.count( key ) || d_queued.count( key ) ) {
+          continue;
+        }
+        d_queued.insert( key );
+        d_queue.push_back( key );
+      }
+    }
+  }
+  d_cv.notify_all();
+}
+
+//______________________________________________________________________
+//  True if the thread cannot continue until advance() releases buffers.
+//  Called with d_mutex locked.
+bool
+DataArchiveReadAhead::stalled() const
+{
+  return d_waitingForRoom && d_queued.count( d_waitingKey ) &&
+         d_bytes > 0 && d_bytes + d_waitingSize > d_maxBytes;
+}
+
+//______________________________________________________________________
+//  Body of the prefetch thread.  Files are read in the order they were
+//  queued, i.e. the nearest timestep first.
+void
+DataArchiveReadAhead::run()
+{
+  std::unique_lock<std::mutex> lock( d_mutex );
+
+  while( true ) {
+
+    d_cv.wait( lock, [&]{ return d_stop || !d_queue.empty(); } );
+
+    if( d_stop ) {
+      break;
+    }
+
+    const FileKey key = d_queue.front();
+    d_queue.pop_front();
+
+    // dropped by advance() or already read from disk by lookup()
+    if( d_queued.count( key ) == 0 ) {
+      continue;
+    }
+
+    const std::string filename = d_ts_directories[key.first] + key.second;
+
+    lock.unlock();
+    bool ok = readFile( filename, key );
+    lock.lock();
+
+    if( !ok ) {
+      d_queued.erase( key );
+      d_cv.notify_all();
+    }
+  }
+}
+
+//______________________________________________________________________
+//  Called with d_mutex unlocked.  Returns false if the file was not
+//  buffered; query() will then read it, and report any error, itself.
+bool
+DataArchiveReadAhead::readFile( const std::string & filename,
+                                const FileKey     & key )
+{
+  int fd = open( filename.c_str(), O_RDONLY );
+  if( fd == -1 ) {
+    return false;
+  }
+
+  struct stat st;
+  if( fstat( fd, &st ) == -1 ) {
+    close( fd );
+    return false;
+  }
+  const size_t size = st.st_size;
+
+  //__________________________________
+  //  Wait until the buffer has room.  A file larger than the whole buffer
+  //  is read once nothing else is held.
+  {
+    std::unique_lock<std::mutex> lock( d_mutex );
+
+    auto ready = [&]{ return d_stop || d_queued.count( key ) == 0 ||
+                             d_bytes == 0 || d_bytes + size <= d_maxBytes; };
+
+    if( !ready() ) {
+      d_waitingForRoom = true;
+      d_waitingKey     = key;
+      d_waitingSize    = size;
+      d_cv.notify_all();
+      d_cv.wait( lock, ready );
+      d_waitingForRoom = false;
+    }
+
+    if( d_stop || d_queued.count( key ) == 0 ) {
+      close( fd );
+      return false;
+    }
+    d_queued.erase( key );
+    d_inFlight.insert( key );
+    d_bytes += size;
+  }
+
+  std::shared_ptr<std::string> buffer = std::make_shared<std::string>();
+  buffer->resize( size );
+
+  size_t nread = 0;
+  while( nread < size ) {
+    ssize_t s = ::read( fd, &(*buffer)[nread], size - nread );
+    if( s <= 0 ) {
+      break;
+    }
+    nread += s;
+  }
+  close( fd );
+
+  //__________________________________
+  {
+    std::lock_guard<std::mutex> lock( d_mutex );
+
+    d_inFlight.erase( key );
+
+    if( nread == size && !d_stop && key.first > d_consumed ) {
+      d_buffers[key] = buffer;
+    }
+    else {
+      d_bytes -= size;
+    }
+  }
+  d_cv.notify_all();
+
+  return true;
+}
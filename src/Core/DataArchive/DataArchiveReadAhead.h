@@ -0,0 +1,142 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_DATAARCHIVE_DATAARCHIVEREADAHEAD_H
+#define CORE_DATAARCHIVE_DATAARCHIVEREADAHEAD_H
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   DataArchiveReadAhead
+
+   Prefetches the raw data files of upcoming timesteps of an uda.
+
+GENERAL INFORMATION
+
+   DataArchiveReadAhead.h
+
+   Department of Mechanical Engineering
+   University of Utah
+
+DESCRIPTION
+   Used by the DataArchive when the archive is read sequentially one
+   timestep after another (postProcessUda).  Every data file that is read
+   for timestep n is recorded.  Once timestep n has been consumed the same
+   files (l#/p#####.data, global.data) in timesteps n+1 ... n+depth are read
+   into memory by a background thread, so the disk is busy while the tasks
+   of timestep n execute.  DataArchive::query() decodes variables straight
+   out of these buffers and falls back to reading the disk for anything
+   that was not prefetched.
+
+   The memory held by the buffers is bounded by maxBytes.  The thread never
+   touches the DataArchive's TimeData, the xml cache of the archive is not
+   affected.
+
+WARNING
+   Only data files are prefetched, the timestep and patch xml files are
+   still parsed on demand.
+****************************************/
+
+class DataArchiveReadAhead {
+
+public:
+
+  DataArchiveReadAhead( const std::vector<std::string> & ts_directories,
+                        const int                        depth,
+                        const size_t                     maxBytes );
+
+  ~DataArchiveReadAhead();
+
+  //__________________________________
+  //  Returns the contents of the file ts_directories[timeIndex] + relativeName
+  //  if it has been prefetched, nullptr otherwise.  If the file is queued or
+  //  being read this waits for the read to finish.  Every call is recorded so
+  //  that the file is prefetched in the following timesteps.
+  std::shared_ptr<const std::string> lookup( const int           timeIndex,
+                                             const std::string & relativeName );
+
+  //__________________________________
+  //  Timestep timeIndex has been read completely; release its buffers and
+  //  queue the files for timeIndex+1 ... timeIndex+depth.
+  void advance( const int timeIndex );
+
+  //__________________________________
+  //  statistics
+  size_t numHits()   const { return d_hits; }
+  size_t numMisses() const { return d_misses; }
+
+private:
+
+  typedef std::pair<int, std::string> FileKey;      // timeIndex, relative filename
+
+  void run();
+
+  bool stalled() const;
+
+  bool readFile( const std::string & filename,
+                 const FileKey     & key );
+
+  std::vector<std::string> d_ts_directories;
+  int                      d_depth;
+  size_t                   d_maxBytes;
+
+  std::mutex               d_mutex;
+  std::condition_variable  d_cv;
+  std::thread              d_thread;
+  bool                     d_stop {false};
+  bool                     d_waitingForRoom {false};  // thread is waiting on d_maxBytes
+  FileKey                  d_waitingKey;              //   for this file
+  size_t                   d_waitingSize {0};         //   of this size
+
+  int                      d_consumed {-1};          // last timeIndex passed to advance()
+  std::map<int, std::set<std::string> >  d_filesRead; // files read by query(), per timeIndex
+  std::set<std::string>    d_fileSet;                // files prefetched in upcoming timesteps
+
+  std::deque<FileKey>      d_queue;                  // files waiting to be read
+  std::set<FileKey>        d_queued;
+  std::set<FileKey>        d_inFlight;               // files the thread is reading
+  std::map<FileKey, std::shared_ptr<const std::string> > d_buffers;
+  size_t                   d_bytes {0};              // bytes reserved by d_buffers and d_inFlight
+
+  size_t                   d_hits   {0};
+  size_t                   d_misses {0};
+};
+
+} // End namespace Uintah
+
+#endif
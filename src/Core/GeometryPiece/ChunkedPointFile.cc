@@ -0,0 +1,188 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/GeometryPiece/ChunkedPointFile.h>
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Util/Endian.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace Uintah;
+using namespace std;
+
+const char ChunkedPointFile::MAGIC[8] = { 'U','P','T','C','H','N','K','1' };
+
+//______________________________________________________________________
+//
+ChunkedPointFile::ChunkedPointFile( const string & file_name )
+  : d_file_name( file_name )
+  , d_needflip( false )
+  , d_ncols( 0 )
+  , d_npoints( 0 )
+{
+  d_source.open( file_name.c_str(), ios::in | ios::binary );
+  if( !d_source ){
+    throw ProblemSetupException("ERROR: opening geometry file '"+file_name+"'\nFailed to find points file",
+                                __FILE__, __LINE__);
+  }
+
+  char magic[8];
+  d_source.read( magic, sizeof(magic) );
+  if( !d_source || memcmp( magic, MAGIC, sizeof(magic) ) != 0 ){
+    throw ProblemSetupException("ERROR: geometry file '"+file_name+"' is not a chunked point file.\n"
+                                "Use pts2chunk to convert text/lsb/msb point files.",
+                                __FILE__, __LINE__);
+  }
+
+  uint32_t tag;
+  d_source.read( (char*)&tag, sizeof(uint32_t) );
+  if( tag != ENDIAN_TAG ){
+    swapbytes( tag );
+    if( tag != ENDIAN_TAG ){
+      throw ProblemSetupException("ERROR: geometry file '"+file_name+"' has an unknown byte order tag",
+                                  __FILE__, __LINE__);
+    }
+    d_needflip = true;
+  }
+
+  uint32_t ncols;
+  uint64_t nchunks;
+  readValue( ncols );
+  readValue( d_npoints );
+  readValue( nchunks );
+  d_ncols = ncols;
+
+  double bb[6];
+  for( int i = 0; i < 6; i++ ){
+    readValue( bb[i] );
+  }
+  d_box = Box( Point( bb[0], bb[1], bb[2] ), Point( bb[3], bb[4], bb[5] ) );
+
+  d_chunks.resize( nchunks );
+  for( uint64_t c = 0; c < nchunks; c++ ){
+    for( int i = 0; i < 6; i++ ){
+      readValue( bb[i] );
+    }
+    Chunk & chunk = d_chunks[c];
+    chunk.box = Box( Point( bb[0], bb[1], bb[2] ), Point( bb[3], bb[4], bb[5] ) );
+    readValue( chunk.offset );
+    readValue( chunk.numPoints );
+  }
+
+  if( !d_source ){
+    throw ProblemSetupException("ERROR: failed while reading the chunk index of '"+file_name+"'",
+                                __FILE__, __LINE__);
+  }
+}
+//______________________________________________________________________
+//
+ChunkedPointFile::~ChunkedPointFile()
+{
+  d_source.close();
+}
+//______________________________________________________________________
+//
+template<class T>
+void
+ChunkedPointFile::readValue( T & val )
+{
+  d_source.read( (char*)&val, sizeof(T) );
+  if( d_needflip ){
+    swapbytes( val );
+  }
+}
+//______________________________________________________________________
+//  The chunk boxes are tight around their points and may be degenerate
+//  (a single point), so the overlap test is inclusive.
+void
+ChunkedPointFile::findChunks( const Box & region, vector<int> & chunks ) const
+{
+  const Point rlow  = region.lower();
+  const Point rhigh = region.upper();
+
+  for( unsigned int c = 0; c < d_chunks.size(); c++ ){
+    const Point clow  = d_chunks[c].box.lower();
+    const Point chigh = d_chunks[c].box.upper();
+
+    if( clow.x() <= rhigh.x() && chigh.x() >= rlow.x() &&
+        clow.y() <= rhigh.y() && chigh.y() >= rlow.y() &&
+        clow.z() <= rhigh.z() && chigh.z() >= rlow.z() ){
+      chunks.push_back( c );
+    }
+  }
+}
+//______________________________________________________________________
+//
+void
+ChunkedPointFile::readChunk( int i, vector<double> & records )
+{
+  const Chunk & chunk = d_chunks[i];
+  const size_t nvals = chunk.numPoints * ( 3 + d_ncols );
+
+  records.resize( nvals );
+  if( nvals == 0 ){
+    return;
+  }
+
+  d_source.clear();
+  d_source.seekg( chunk.offset, ios::beg );
+  d_source.read( (char*)&records[0], nvals * sizeof(double) );
+
+  if( !d_source ){
+    ostringstream warn;
+    warn << "ERROR: failed while reading chunk " << i << " (" << chunk.numPoints
+         << " points) of geometry file '" << d_file_name << "'";
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
+  }
+
+  if( d_needflip ){
+    for( size_t n = 0; n < nvals; n++ ){
+      swapbytes( records[n] );
+    }
+  }
+}
+//______________________________________________________________________
+//
+uint64_t
+ChunkedPointFile::mortonKey( uint32_t i, uint32_t j, uint32_t k )
+{
+  uint64_t key = 0;
+  for( int b = 0; b < 21; b++ ){
+    key |= ( (uint64_t)( ( i >> b ) & 1 ) << ( 3*b     ) )
+        |  ( (uint64_t)( ( j >> b ) & 1 ) << ( 3*b + 1 ) )
+        |  ( (uint64_t)( ( k >> b ) & 1 ) << ( 3*b + 2 ) );
+  }
+  return key;
+}
+//______________________________________________________________________
+//
+uint64_t
+ChunkedPointFile::headerSize( uint64_t nchunks )
+{
+  const uint64_t fixed = sizeof(MAGIC) + 2*sizeof(uint32_t) + 2*sizeof(uint64_t) + 6*sizeof(double);
+  const uint64_t entry = 6*sizeof(double) + 2*sizeof(uint64_t);
+  return fixed + nchunks * entry;
+}
@@ -0,0 +1,137 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef __CHUNKED_POINT_FILE_H__
+#define __CHUNKED_POINT_FILE_H__
+
+#include <Core/Grid/Box.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+/////////////////////////////////////////////////////////////////////////////
+/*!
+        
+  \class ChunkedPointFile
+        
+  \brief Spatially indexed, chunked binary point file used by the
+  FileGeometryPiece (format "chunked").
+
+  The points are bucketed along a Morton (Z-order) curve and stored in
+  contiguous chunks.  The header carries the bounding box of every chunk so
+  a reader only has to touch the chunks that overlap the region it owns,
+  instead of every rank reading (and keeping) the whole data set.
+
+  File layout (all values in the byte order of the writer, which is
+  recorded by the endian tag):
+  \verbatim
+    char     magic[8]           "UPTCHNK1"
+    uint32   endian tag         0x01020304
+    uint32   number of columns  beyond x,y,z
+    uint64   number of points
+    uint64   number of chunks
+    double   bbox[6]            xmin ymin zmin xmax ymax zmax
+    nchunks x { double bbox[6]; uint64 offset; uint64 npoints; }
+    chunk data:  npoints x (3 + ncols) doubles per chunk
+  \endverbatim
+
+  Files are produced from the text/lsb/msb point files with the
+  StandAlone/tools/pfs/pts2chunk converter.
+*/
+/////////////////////////////////////////////////////////////////////////////
+
+  class ChunkedPointFile {
+
+  public:
+
+    struct Chunk {
+      Box      box;
+      uint64_t offset;
+      uint64_t numPoints;
+    };
+
+    static const char     MAGIC[8];
+    static const uint32_t ENDIAN_TAG = 0x01020304;
+
+    //////////////////////////////////////////////////////////////////////
+    /*! Opens the file and reads the header and the chunk index.  Throws
+        a ProblemSetupException if the file is missing or malformed.    */
+    //////////////////////////////////////////////////////////////////////
+    ChunkedPointFile( const std::string & file_name );
+
+    ~ChunkedPointFile();
+
+    const Box & getBoundingBox() const { return d_box; }
+
+    int      numColumns() const { return d_ncols; }
+    uint64_t numPoints()  const { return d_npoints; }
+
+    const std::vector<Chunk> & getChunks() const { return d_chunks; }
+
+    //////////////////////////////////////////////////////////////////////
+    /*! Returns the indices of the chunks whose bounding box overlaps
+        region.                                                         */
+    //////////////////////////////////////////////////////////////////////
+    void findChunks( const Box & region, std::vector<int> & chunks ) const;
+
+    //////////////////////////////////////////////////////////////////////
+    /*! Reads chunk i into records (native byte order), one record of
+        (3 + numColumns()) doubles per point.                           */
+    //////////////////////////////////////////////////////////////////////
+    void readChunk( int i, std::vector<double> & records );
+
+    //////////////////////////////////////////////////////////////////////
+    /*! Interleaves the lower 21 bits of i,j,k into a Morton key.       */
+    //////////////////////////////////////////////////////////////////////
+    static uint64_t mortonKey( uint32_t i, uint32_t j, uint32_t k );
+
+    //////////////////////////////////////////////////////////////////////
+    /*! Size in bytes of the header plus the chunk index.               */
+    //////////////////////////////////////////////////////////////////////
+    static uint64_t headerSize( uint64_t nchunks );
+
+  private:
+
+    ChunkedPointFile( const ChunkedPointFile & );
+    ChunkedPointFile & operator=( const ChunkedPointFile & );
+
+    template<class T> void readValue( T & val );
+
+    std::string        d_file_name;
+    std::ifstream      d_source;
+    bool               d_needflip;
+    int                d_ncols;
+    uint64_t           d_npoints;
+    Box                d_box;
+    std::vector<Chunk> d_chunks;
+  };
+
+} // End namespace Uintah
+
+#endif // __CHUNKED_POINT_FILE_H__
@@ -23,6 +23,7 @@
  */
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/GeometryPiece/FileGeometryPiece.h>
+#include <Core/GeometryPiece/ChunkedPointFile.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Math/Matrix3.h>
 #include <Core/Parallel/Parallel.h>
@@ -116,15 +117,48 @@ FileGeometryPiece::FileGeometryPiece( ProblemSpecP & ps )
   }
   proc0cout << endl;
   
+  // number of columns following x,y,z in every point record
+  d_ncols = 0;
+  for(list<string>::const_iterator vit(d_vars.begin());vit!=d_vars.end();vit++){
+    if(*vit=="p.volume" || *vit=="p.temperature" || *vit=="p.color") {
+      d_ncols += 1;
+    } else if(*vit=="p.externalforce" || *vit=="p.fiberdir" || *vit=="p.velocity" ||
+              *vit=="p.rvec1" || *vit=="p.rvec2" || *vit=="p.rvec3") {
+      d_ncols += 3;
+    }
+  }
+
   ps->getWithDefault("format",d_file_format,"text");
   if (d_file_format=="bin"){   
     d_file_format = isLittleEndian()?"lsb":"msb";
   }
 
+  const bool iamlittle = isLittleEndian();
+  d_needflip = (iamlittle && (d_file_format=="msb")) || (!iamlittle && (d_file_format=="lsb"));
+
   ps->getWithDefault("usePFS",d_usePFS,true);
 
   Point min(1e30,1e30,1e30), max(-1e30,-1e30,-1e30);
-  if(d_usePFS){
+  if(d_file_format=="chunked"){
+    // Only the header and the chunk index are read here, the points
+    // are read per patch in readPoints().
+    d_usePFS = false;
+
+    ChunkedPointFile source(d_file_name);
+    if(source.numColumns() != d_ncols){
+      std::ostringstream warn;
+      warn << "ERROR: geometry file (" << d_file_name << ") has " << source.numColumns()
+           << " columns per point in addition to x,y,z\n"
+           << "However the <var> tags in the ups file require " << d_ncols << ".\n";
+      throw ProblemSetupException(warn.str(),__FILE__, __LINE__);
+    }
+    min = source.getBoundingBox().lower();
+    max = source.getBoundingBox().upper();
+
+    proc0cout << "File Geometry Piece: " << d_file_name << " contains " << source.numPoints()
+              << " points in " << source.getChunks().size() << " chunks" << endl;
+  }
+  else if(d_usePFS){
     // We must first read in the min and max from file.0 so
     // that we can determine the BoundingBox for the geometry
     string file_name = numbered_str(d_file_name+".", 0);
@@ -169,6 +203,7 @@ FileGeometryPiece::FileGeometryPiece( ProblemSpecP & ps )
 //______________________________________________________________________
 //
 FileGeometryPiece::FileGeometryPiece(const string& /*file_name*/)
+  : d_needflip(false), d_ncols(0)
 {
   name_ = "Unnamed " + TYPE_NAME + " from file_name";
 }
@@ -224,16 +259,13 @@ FileGeometryPiece::read_bbox(std::istream & source, Point & min,
     source >> min(0) >> min(1) >> min(2) >> max(0) >> max(1) >> max(2);
    
   } else {
-    // FIXME: never changes, should save this !
-    const bool iamlittle = isLittleEndian();
-    const bool needflip = (iamlittle && (d_file_format=="msb")) || (!iamlittle && (d_file_format=="lsb"));
     double t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); min(0) = t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); min(1) = t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); min(2) = t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); max(0) = t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); max(1) = t;
-    source.read((char *)&t, sizeof(double)); if(needflip) swapbytes(t); max(2) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); min(0) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); min(1) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); min(2) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); max(0) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); max(1) = t;
+    source.read((char *)&t, sizeof(double)); if(d_needflip) swapbytes(t); max(2) = t;
   }
 }
 //______________________________________________________________________
@@ -241,217 +273,115 @@ FileGeometryPiece::read_bbox(std::istream & source, Point & min,
 bool
 FileGeometryPiece::read_line(std::istream & is, Point & xmin, Point & xmax)
 {
-  double x1,x2,x3;
+  d_record.resize(3 + d_ncols);
 
-  // CPTI and CPDI can pass the size matrix columns containing rvec1, rvec2, rvec3
-  // Other interpolators will default to grid spacing and default orientation
-  Matrix3 size(d_DX.x(),0.,0.,0.,d_DX.y(),0.,0.,0.,d_DX.z());
-  // grid spacing for normalizing size
-  Matrix3 gsize((1./d_DX.x()),0.,0.,0.,(1./d_DX.y()),0.,0.,0.,(1./d_DX.z()));
-  bool file_has_size=false;
-  bool file_has_volume=false;
- 
   //__________________________________
   //  TEXT FILE
   if(d_file_format=="text") {
-    double v1,v2,v3;
-    
     // line always starts with coordinates
-    is >> x1 >> x2 >> x3;
+    is >> d_record[0] >> d_record[1] >> d_record[2];
     if(is.eof()){
      return false; // out of points
     }
-    // Particle coordinates
-    d_points.push_back(Point(x1,x2,x3));
-    
-
-    for(list<string>::const_iterator vit(d_vars.begin());vit!=d_vars.end();vit++) {
-      if (*vit=="p.volume") {
-        if(is >> v1) {
-          cout << "v1 = " << v1 << endl;
-          d_volume.push_back(v1);
-          file_has_volume=true;
-        }
-      } else if(*vit=="p.temperature") {
-        if(is >> v1){
-          d_temperature.push_back(v1);
-        }
-      } else if(*vit=="p.color") {
-        if(is >> v1){
-          d_color.push_back(v1);
-        }
-      } else if(*vit=="p.externalforce") {
-        if(is >> v1 >> v2 >> v3){
-          d_forces.push_back(Vector(v1,v2,v3));
-        }
-      } else if(*vit=="p.fiberdir") {
-        if(is >> v1 >> v2 >> v3){
-          d_fiberdirs.push_back(Vector(v1,v2,v3));
-        }  
-      } else if(*vit=="p.rvec1") {
-        if(is >> v1 >> v2 >> v3){
-          d_rvec1.push_back(Vector(v1,v2,v3));
-          size(0,0)=v1;
-          size(1,0)=v2;
-          size(2,0)=v3;
-          file_has_size=true;
-        }  
-      } else if(*vit=="p.rvec2") {
-        if(is >> v1 >> v2 >> v3){
-          d_rvec2.push_back(Vector(v1,v2,v3));
-          size(0,1)=v1;
-          size(1,1)=v2;
-          size(2,1)=v3;
-          file_has_size=true;
-        }  
-      } else if(*vit=="p.rvec3") {
-        if(is >> v1 >> v2 >> v3){
-          d_rvec3.push_back(Vector(v1,v2,v3));
-          size(0,2)=v1;
-          size(1,2)=v2;
-          size(2,2)=v3;
-          file_has_size=true;
-        }  
-      } else if(*vit=="p.velocity") {
-        if(is >> v1 >> v2 >> v3){
-          d_velocity.push_back(Vector(v1,v2,v3));
-        }
-      }
 
-      if(!is) {
-        std::ostringstream warn;
-        warn << "Failed while reading point text point file \n"
-             << "Position: "<< Point(x1,x2,x3) << "\n"; 
-        throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
-      }
+    for(int c = 3; c < 3 + d_ncols; c++) {
+      is >> d_record[c];
     }
 
     //__________________________________
     //  BINARY FILE
   } else if(d_file_format=="lsb" || d_file_format=="msb") {
-    // read unformatted binary numbers
-    
-    double v[3];
-    
-    // never changes, should save this !
-    const bool iamlittle = isLittleEndian();
-    const bool needflip = (iamlittle && (d_file_format=="msb")) || (!iamlittle && (d_file_format=="lsb"));
-
-    is.read((char*)&x1, sizeof(double)); 
-    
+    // read unformatted binary numbers, one record at a time
+    is.read((char*)&d_record[0], sizeof(double));
+
     if(!is){
       return false;  // out of points
     }
-    
-    is.read((char*)&x2, sizeof(double));
-    is.read((char*)&x3, sizeof(double));
-    if(needflip) {
-      swapbytes(x1);
-      swapbytes(x2);
-      swapbytes(x3);
-    }
-    d_points.push_back(Point(x1,x2,x3));
-    //__________________________________
-    //
-    for(list<string>::const_iterator vit(d_vars.begin());vit!=d_vars.end();vit++) {
-      if (*vit=="p.volume") {
-        if(is.read((char*)&v[0], sizeof(double))) {
-          if(needflip){ 
-            swapbytes(v[0]);
-          }
-          d_volume.push_back(v[0]);
-          file_has_volume=true;
-        }
-      } else if(*vit=="p.temperature") {
-        if(is.read((char*)&v[0], sizeof(double))) {
-          if(needflip){
-            swapbytes(v[0]);
-          }
-          d_temperature.push_back(v[0]);
-        }
-      } else if(*vit=="p.color") {
-        if(is.read((char*)&v[0], sizeof(double))) {
-          if(needflip){
-            swapbytes(v[0]);
-          }
-          d_color.push_back(v[0]);
-        }
-      } else if(*vit=="p.externalforce") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_forces.push_back(Vector(v[0],v[1],v[2]));
-        }
-      } else if(*vit=="p.fiberdir") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_fiberdirs.push_back(Vector(v[0],v[1],v[2]));
-        }
-      } else if(*vit=="p.rvec1") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_rvec1.push_back(Vector(v[0],v[1],v[2]));
-          size(0,0)=v[0];
-          size(1,0)=v[1];
-          size(2,0)=v[2];
-          file_has_size=true;
-        }
-      } else if(*vit=="p.rvec2") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_rvec2.push_back(Vector(v[0],v[1],v[2]));
-          size(0,1)=v[0];
-          size(1,1)=v[1];
-          size(2,1)=v[2];
-          file_has_size=true;
-        }
-      } else if(*vit=="p.rvec3") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_rvec3.push_back(Vector(v[0],v[1],v[2]));
-          size(0,2)=v[0];
-          size(1,2)=v[1];
-          size(2,2)=v[2];
-          file_has_size=true;
-        }
-      } else if(*vit=="p.velocity") {
-        if(is.read((char*)&v[0], sizeof(double)*3)) {
-          if(needflip) {
-            swapbytes(v[0]);
-            swapbytes(v[1]);
-            swapbytes(v[2]);
-          }
-          d_velocity.push_back(Vector(v[0],v[1],v[2]));
-        }  
-      }          
-      if(!is){
-        std::ostringstream warn;
-        warn << "Failed while reading point text point file \n"
-             << "Position: "<< Point(x1,x2,x3) << "\n";
-        throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
+
+    is.read((char*)&d_record[1], sizeof(double)*(2 + d_ncols));
+
+    if(d_needflip) {
+      for(unsigned int c = 0; c < d_record.size(); c++) {
+        swapbytes(d_record[c]);
       }
-      
+    }
+  } else {
+    return false;
+  }
+
+  if(!is) {
+    std::ostringstream warn;
+    warn << "Failed while reading point file \n"
+         << "Position: "<< Point(d_record[0],d_record[1],d_record[2]) << "\n";
+    throw ProblemSetupException(warn.str(), __FILE__, __LINE__);
+  }
+
+  addRecord(&d_record[0], xmin, xmax);
+  return true;
+}
+//______________________________________________________________________
+//  Append one point record (x,y,z followed by the <var> columns in the
+//  order they appear in the input file) to the point lists.
+void
+FileGeometryPiece::addRecord(const double* rec, Point & xmin, Point & xmax)
+{
+  // CPTI and CPDI can pass the size matrix columns containing rvec1, rvec2, rvec3
+  // Other interpolators will default to grid spacing and default orientation
+  Matrix3 size(d_DX.x(),0.,0.,0.,d_DX.y(),0.,0.,0.,d_DX.z());
+  // grid spacing for normalizing size
+  Matrix3 gsize((1./d_DX.x()),0.,0.,0.,(1./d_DX.y()),0.,0.,0.,(1./d_DX.z()));
+  bool file_has_size=false;
+  bool file_has_volume=false;
+
+  // record always starts with coordinates
+  const Point pt(rec[0],rec[1],rec[2]);
+  d_points.push_back(pt);
+
+  const double* v = rec + 3;
+  for(list<string>::const_iterator vit(d_vars.begin());vit!=d_vars.end();vit++) {
+    if (*vit=="p.volume") {
+      d_volume.push_back(v[0]);
+      file_has_volume=true;
+      v += 1;
+    } else if(*vit=="p.temperature") {
+      d_temperature.push_back(v[0]);
+      v += 1;
+    } else if(*vit=="p.color") {
+      d_color.push_back(v[0]);
+      v += 1;
+    } else if(*vit=="p.externalforce") {
+      d_forces.push_back(Vector(v[0],v[1],v[2]));
+      v += 3;
+    } else if(*vit=="p.fiberdir") {
+      d_fiberdirs.push_back(Vector(v[0],v[1],v[2]));
+      v += 3;
+    } else if(*vit=="p.rvec1") {
+      d_rvec1.push_back(Vector(v[0],v[1],v[2]));
+      size(0,0)=v[0];
+      size(1,0)=v[1];
+      size(2,0)=v[2];
+      file_has_size=true;
+      v += 3;
+    } else if(*vit=="p.rvec2") {
+      d_rvec2.push_back(Vector(v[0],v[1],v[2]));
+      size(0,1)=v[0];
+      size(1,1)=v[1];
+      size(2,1)=v[2];
+      file_has_size=true;
+      v += 3;
+    } else if(*vit=="p.rvec3") {
+      d_rvec3.push_back(Vector(v[0],v[1],v[2]));
+      size(0,2)=v[0];
+      size(1,2)=v[1];
+      size(2,2)=v[2];
+      file_has_size=true;
+      v += 3;
+    } else if(*vit=="p.velocity") {
+      d_velocity.push_back(Vector(v[0],v[1],v[2]));
+      v += 3;
     }
   }
+
   if(file_has_size){
     // CPTI and CPDI populate size matrix with Rvectors defining the particle domain in columns
     // proc0cout << endl << "<res> is ignored for CPDI and CPTI particle domain import." << endl;
@@ -479,16 +409,18 @@ FileGeometryPiece::read_line(std::istream & is, Point & xmin, Point & xmax)
     d_size.push_back(size);
   }
 
-  xmin = Min(xmin, Point(x1,x2,x3));
-  xmax = Max(xmax, Point(x1,x2,x3));
-  return true;
+  xmin = Min(xmin, pt);
+  xmax = Max(xmax, pt);
 }
 //______________________________________________________________________
 //
 void
-FileGeometryPiece::readPoints(int patchID)
+FileGeometryPiece::readPoints(int patchID, const Box & region)
 {
-  if(d_usePFS){
+  if(d_file_format=="chunked"){
+    readChunkedPoints(region);
+  }
+  else if(d_usePFS){
     std::ifstream source;
   
     Point minpt( 1e30, 1e30, 1e30);
@@ -517,6 +449,54 @@ FileGeometryPiece::readPoints(int patchID)
   }
 }
 //______________________________________________________________________
+//  Only the chunks whose bounding box overlaps the region are read and
+//  only the points inside the region are kept.  The point lists are
+//  emptied first so that memory is bounded by the points of one patch.
+void
+FileGeometryPiece::readChunkedPoints(const Box & region)
+{
+  deletePoints();
+  deleteVolume();
+  deleteSizes();
+  deleteTemperature();
+  d_color.clear();
+  d_forces.clear();
+  d_fiberdirs.clear();
+  d_velocity.clear();
+  d_rvec1.clear();
+  d_rvec2.clear();
+  d_rvec3.clear();
+
+  ChunkedPointFile source(d_file_name);
+
+  vector<int> chunks;
+  source.findChunks(region, chunks);
+
+  const Point rlow  = region.lower();
+  const Point rhigh = region.upper();
+  const int   nvals = 3 + d_ncols;
+
+  Point minpt( 1e30, 1e30, 1e30);
+  Point maxpt(-1e30,-1e30,-1e30);
+
+  for(unsigned int c = 0; c < chunks.size(); c++) {
+    source.readChunk(chunks[c], d_record);
+
+    const size_t npts = d_record.size()/nvals;
+    for(size_t n = 0; n < npts; n++) {
+      const double* rec = &d_record[n*nvals];
+      if(rec[0] >= rlow.x() && rec[0] <= rhigh.x() &&
+         rec[1] >= rlow.y() && rec[1] <= rhigh.y() &&
+         rec[2] >= rlow.z() && rec[2] <= rhigh.z()) {
+        addRecord(rec, minpt, maxpt);
+      }
+    }
+  }
+
+  // release the scratch space, chunks can be large
+  vector<double>().swap(d_record);
+}
+//______________________________________________________________________
 //
 unsigned int
 FileGeometryPiece::createPoints()
@@ -77,6 +77,9 @@ namespace Uintah {
     lsb   - least significant byte binary double
     msb   - most significant byte binary double
     bin   - use native binary ordering.
+    chunked - spatially indexed chunked binary file (see ChunkedPointFile),
+            written by the pts2chunk tool.  Each rank only reads the
+            chunks that overlap its patches, no PFS split is needed.
     
     Note, for all formats (text and binary), there needs to be a 128 line
     buffer containing the bounding box of the whole data set in every file.
@@ -126,7 +129,11 @@ namespace Uintah {
     //  Returns the bounding box surrounding the cylinder.
     virtual Box getBoundingBox() const;
 
-    void readPoints(int pid);
+    //////////////////////////////////////////////////////////////////////
+    /*! Reads the points for a patch.  The PFS file set is selected by
+        the patch id, the chunked format reads the points inside region.*/
+    //////////////////////////////////////////////////////////////////////
+    void readPoints(int pid, const Box& region);
 
     unsigned int createPoints();
 
@@ -143,10 +150,15 @@ namespace Uintah {
     std::list<std::string> d_vars;
     bool                   d_usePFS;
     bool                   d_useCPTI;
+    bool                   d_needflip;     // binary byte order differs from ours
+    int                    d_ncols;        // columns following x,y,z per point
+    std::vector<double>    d_record;       // scratch space for point records
 
     void checkFileType(std::ifstream & source, std::string& fileType, std::string& filename);
     
     bool read_line(std::istream & is, Point & xmin, Point & xmax);
+    void addRecord(const double* rec, Point & xmin, Point & xmax);
+    void readChunkedPoints(const Box & region);
     void read_bbox(std::istream & source, Point & lowpt, Point & highpt) const;
     virtual void outputHelper( ProblemSpecP & ps ) const;
   };
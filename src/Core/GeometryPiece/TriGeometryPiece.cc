@@ -25,6 +25,7 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Exceptions/ProblemSetupException.h>
 #include <Core/GeometryPiece/TriGeometryPiece.h>
+#include <Core/GeometryPiece/UniformGrid.h>
 #include <Core/Geometry/Plane.h>
 #include <Core/Grid/Box.h>
 #include <Core/Malloc/Allocator.h>
@@ -43,6 +44,12 @@ using namespace std;
 #undef  USE_PLANES
 
 const string TriGeometryPiece::TYPE_NAME = "tri";
+
+// Ray directions of insideNewest(): nearly, but not exactly, the ordinal
+// directions so that rays do not run along the edges of axis aligned meshes.
+static const Vector s_rayx( 1.,    1.e-6, 1.e-8 );
+static const Vector s_rayy( 1.e-8, 1.,    1.e-6 );
+static const Vector s_rayz( 1.e-6, 1.e-8, 1.    );
 //______________________________________________________________________
 //
 
@@ -60,13 +67,7 @@ TriGeometryPiece::TriGeometryPiece(ProblemSpecP &ps)
 
   // cout << "Triangulated surfaces read: \t" <<d_tri.size() <<endl;
 
-  // The Tri class sits inside of UniformGrid.h
-  list<Tri> tri_list;
-  Tri tri;
-
-  tri_list = tri.makeTriList( d_tri, d_points) ;
-  d_grid   = scinew UniformGrid(d_box);
-  d_grid->buildUniformGrid(tri_list);
+  d_bvh.build( d_points, d_tri );
   d_points.clear();
 }
 
@@ -87,13 +88,7 @@ TriGeometryPiece::TriGeometryPiece(string filename)
 
   // cout << "Triangulated surfaces read: \t" <<d_tri.size() <<endl;
 
-  // The Tri class sits inside of UniformGrid.h
-  list<Tri> tri_list;
-  Tri tri;
-
-  tri_list = tri.makeTriList(d_tri,d_points);
-  d_grid   = scinew UniformGrid(d_box);
-  d_grid->buildUniformGrid(tri_list);
+  d_bvh.build( d_points, d_tri );
 }
 
 //______________________________________________________________________
@@ -109,8 +104,7 @@ TriGeometryPiece::TriGeometryPiece(const TriGeometryPiece& copy)
 #endif
 //  d_boxes = copy.d_boxes;
 
-  d_grid = scinew UniformGrid(*copy.d_grid);
-
+  d_bvh = copy.d_bvh;
 }
 
 //______________________________________________________________________
@@ -133,8 +127,6 @@ TriGeometryPiece& TriGeometryPiece::operator=(const TriGeometryPiece& rhs)
 
 //  d_boxes.clear();
 
-  delete d_grid;
-
   // Copy the rhs stuff
   d_box = rhs.d_box;
   d_points = rhs.d_points;
@@ -144,7 +136,7 @@ TriGeometryPiece& TriGeometryPiece::operator=(const TriGeometryPiece& rhs)
 #endif
 //  d_boxes = rhs.d_boxes;
 
-  d_grid = scinew UniformGrid(*rhs.d_grid);
+  d_bvh = rhs.d_bvh;
 
   return *this;
 }
@@ -159,8 +151,6 @@ TriGeometryPiece::~TriGeometryPiece()
 #ifdef USE_PLANES
   d_planes.clear();
 #endif
-
-  delete d_grid;
 }
 
 //______________________________________________________________________
@@ -202,13 +192,9 @@ TriGeometryPiece::insideNewest(const Point & p,
     return false;
   }
   
-  int crossx=0;
-  int crossy=0;
-  int crossz=0;
-  
-  d_grid->countIntersectionsx(p,crossx);
-  d_grid->countIntersectionsy(p,crossy);
-  d_grid->countIntersectionsz(p,crossz);
+  int crossx = d_bvh.countCrossings( p, s_rayx );
+  int crossy = d_bvh.countCrossings( p, s_rayy );
+  int crossz = d_bvh.countCrossings( p, s_rayz );
   
   //  cout << "Point " << p << " has " << cross << " crossings " << endl;
   if ((crossx % 2 == 1 && crossy % 2 ==1)||
@@ -239,7 +225,7 @@ TriGeometryPiece::insideNew(const Point & p,
     return false;
   }
   
-  d_grid->countIntersections(p,cross);
+  cross = d_bvh.countCrossings( p, Vector(1.,0.,0.) );
   //  cout << "Point " << p << " has " << cross << " crossings " << endl;
   if (cross % 2) {
     return true;
@@ -251,6 +237,65 @@ TriGeometryPiece::insideNew(const Point & p,
 //______________________________________________________________________
 //
 
+void
+TriGeometryPiece::inside(const vector<Point>& pts,
+                         const bool useNewestVersion,
+                         vector<bool>& result) const
+{
+  const int n = pts.size();
+  result.assign(n, false);
+
+  // only the points inside the bounding box are traced
+  vector<Point> candidates;
+  vector<int>   index;
+  candidates.reserve(n);
+  index.reserve(n);
+  for (int i = 0; i < n; i++) {
+    const Point& p = pts[i];
+    if (p == Max(p,d_box.lower()) && p == Min(p,d_box.upper())) {
+      candidates.push_back(p);
+      index.push_back(i);
+    }
+  }
+
+  const int nc = candidates.size();
+  if (nc == 0) {
+    return;
+  }
+
+  if (useNewestVersion) {
+    vector<int> crossx(nc), crossy(nc), crossz(nc);
+    d_bvh.countCrossings( &candidates[0], nc, s_rayx, &crossx[0] );
+    d_bvh.countCrossings( &candidates[0], nc, s_rayy, &crossy[0] );
+    d_bvh.countCrossings( &candidates[0], nc, s_rayz, &crossz[0] );
+
+    // two or more of the three rays have to agree
+    for (int i = 0; i < nc; i++) {
+      int votes = crossx[i] % 2 + crossy[i] % 2 + crossz[i] % 2;
+      result[index[i]] = (votes >= 2);
+    }
+  } else {
+    vector<int> cross(nc);
+    d_bvh.countCrossings( &candidates[0], nc, Vector(1.,0.,0.), &cross[0] );
+
+    for (int i = 0; i < nc; i++) {
+      result[index[i]] = (cross[i] % 2 == 1);
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+
+bool
+TriGeometryPiece::surfaceIntersects(const Box& box) const
+{
+  return d_bvh.intersects(box);
+}
+
+//______________________________________________________________________
+//
+
 bool
 TriGeometryPiece::inside(const Point &p,
                          const bool useNewestVersion=false) const
@@ -26,7 +26,7 @@
 #define __TRI_GEOMETRY_OBJECT_H__
 
 #include <Core/GeometryPiece/GeometryPiece.h>
-#include <Core/GeometryPiece/UniformGrid.h>
+#include <Core/GeometryPiece/TriangleBVH.h>
 #include <Core/Grid/Box.h>
 
 #include <Core/Geometry/Point.h>
@@ -65,6 +65,8 @@ DESCRIPTION
    Requires one input: file name (convetion use suffix .dat).
    There are methods for checking if a point is inside the surface
    and also for determining the bounding box for the surface.
+   The triangles are kept in a bounding volume hierarchy (TriangleBVH),
+   the inside tests count ray crossings against it.
    The input form looks like this:
        <tri>
          <file>surface.dat</file>
@@ -106,6 +108,18 @@ WARNING
          // directions
          bool insideNewest(const Point &p, int& cross) const;
 
+         //////////
+         // Inside test for a set of points at once.  The rays of all the
+         // points are traced through the BVH as packets.
+         void inside(const std::vector<Point>& pts,
+                     const bool useNewestVersion,
+                     std::vector<bool>& result) const;
+
+         //////////
+         // Returns false only if no triangle of the surface touches the box,
+         // in which case every point of the box is on the same side of it.
+         bool surfaceIntersects(const Box& box) const;
+
          //////////
          // Returns the bounding box surrounding the triangulated surface.
          virtual Box getBoundingBox() const;
@@ -117,16 +131,11 @@ WARNING
          inline int getNumIntersections( const Point & start, 
                                          const Point & end, 
                                          double      & min_distance ){
-           int intersections = 0;
-           
-           d_grid->countIntersections( start, end, intersections, min_distance );
-           return intersections;
+           return d_bvh.countCrossings( start, end, min_distance );
          }
 
          inline int getNumIntersections( const Point& start ){
-           int intersections = 0;
-           d_grid->countIntersections( start, intersections );
-           return intersections;
+           return d_bvh.countCrossings( start, Vector(1.,0.,0.) );
          }
 
       private:
@@ -149,7 +158,7 @@ WARNING
          std::vector<Plane>     d_planes;
 //         std::vector<Box>       d_boxes;
 
-         UniformGrid* d_grid;
+         TriangleBVH d_bvh;
 
       };
 
@@ -0,0 +1,437 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <Core/GeometryPiece/TriangleBVH.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+using namespace Uintah;
+using namespace std;
+
+namespace {
+
+  inline double dot( const double a[3], const double b[3] )
+  {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+  }
+
+  inline void cross( const double a[3], const double b[3], double c[3] )
+  {
+    c[0] = a[1]*b[2] - a[2]*b[1];
+    c[1] = a[2]*b[0] - a[0]*b[2];
+    c[2] = a[0]*b[1] - a[1]*b[0];
+  }
+
+  const double s_infinity = numeric_limits<double>::max();
+}
+
+//______________________________________________________________________
+//
+TriangleBVH::TriangleBVH()
+{
+}
+
+TriangleBVH::~TriangleBVH()
+{
+}
+
+//______________________________________________________________________
+//
+void
+TriangleBVH::build( const vector<Point>     & points,
+                    const vector<IntVector> & tris )
+{
+  d_nodes.clear();
+  d_tris.clear();
+
+  const int ntris = tris.size();
+  if( ntris == 0 ){
+    return;
+  }
+
+  vector<Triangle> unsorted( ntris );
+  vector<double>   centroids( 3*ntris );
+  vector<int>      order( ntris );
+
+  for( int i = 0; i < ntris; i++ ){
+    const Point & p0 = points[ tris[i].x() ];
+    const Point & p1 = points[ tris[i].y() ];
+    const Point & p2 = points[ tris[i].z() ];
+
+    Triangle & tri = unsorted[i];
+    for( int d = 0; d < 3; d++ ){
+      tri.v0[d] = p0(d);
+      tri.e1[d] = p1(d) - p0(d);
+      tri.e2[d] = p2(d) - p0(d);
+      tri.lo[d] = min( p0(d), min( p1(d), p2(d) ) );
+      tri.hi[d] = max( p0(d), max( p1(d), p2(d) ) );
+      centroids[3*i+d] = ( p0(d) + p1(d) + p2(d) )/3.0;
+    }
+    order[i] = i;
+  }
+
+  d_nodes.reserve( 2*ntris/LEAF_SIZE + 1 );
+  buildNode( order, centroids, unsorted, 0, ntris );
+
+  // store the triangles in leaf order
+  d_tris.resize( ntris );
+  for( int i = 0; i < ntris; i++ ){
+    d_tris[i] = unsorted[ order[i] ];
+  }
+}
+
+//______________________________________________________________________
+//
+int
+TriangleBVH::buildNode( vector<int>            & order,
+                        const vector<double>   & centroids,
+                        const vector<Triangle> & tris,
+                        int begin, int end )
+{
+  const int index = d_nodes.size();
+  d_nodes.push_back( Node() );
+
+  Node node;
+  double clo[3], chi[3];
+  for( int d = 0; d < 3; d++ ){
+    node.lo[d] =  s_infinity;
+    node.hi[d] = -s_infinity;
+    clo[d]     =  s_infinity;
+    chi[d]     = -s_infinity;
+  }
+
+  for( int i = begin; i < end; i++ ){
+    const Triangle & tri = tris[ order[i] ];
+    for( int d = 0; d < 3; d++ ){
+      node.lo[d] = min( node.lo[d], tri.lo[d] );
+      node.hi[d] = max( node.hi[d], tri.hi[d] );
+      clo[d]     = min( clo[d], centroids[3*order[i]+d] );
+      chi[d]     = max( chi[d], centroids[3*order[i]+d] );
+    }
+  }
+
+  node.right = -1;
+  node.first = begin;
+  node.count = end - begin;
+
+  // split along the longest axis of the centroids
+  int axis = 0;
+  if( chi[1]-clo[1] > chi[axis]-clo[axis] ) axis = 1;
+  if( chi[2]-clo[2] > chi[axis]-clo[axis] ) axis = 2;
+
+  if( node.count > LEAF_SIZE && chi[axis] > clo[axis] ){
+    const int mid = ( begin + end )/2;
+    nth_element( order.begin()+begin, order.begin()+mid, order.begin()+end,
+                 [&]( int a, int b ){ return centroids[3*a+axis] < centroids[3*b+axis]; } );
+
+    node.count = 0;
+    buildNode( order, centroids, tris, begin, mid );
+    node.right = buildNode( order, centroids, tris, mid, end );
+  }
+
+  d_nodes[index] = node;
+  return index;
+}
+
+//______________________________________________________________________
+//  Slab test.  A zero direction component is handled explicitly so that
+//  a ray lying in a slab plane does not produce 0*inf.
+bool
+TriangleBVH::rayHitsBox( const Node   & node,
+                         const double   org[3],
+                         const double   inv[3],
+                         double         tmax ) const
+{
+  double tnear = 0.0;
+  double tfar  = tmax;
+
+  for( int d = 0; d < 3; d++ ){
+    if( inv[d] == s_infinity ){
+      if( org[d] < node.lo[d] || org[d] > node.hi[d] ){
+        return false;
+      }
+      continue;
+    }
+    double t0 = ( node.lo[d] - org[d] )*inv[d];
+    double t1 = ( node.hi[d] - org[d] )*inv[d];
+    if( t0 > t1 ){
+      std::swap( t0, t1 );
+    }
+    tnear = max( tnear, t0 );
+    tfar  = min( tfar,  t1 );
+    if( tnear > tfar ){
+      return false;
+    }
+  }
+  return true;
+}
+
+//______________________________________________________________________
+//  Moller-Trumbore, edges and vertices are inclusive.
+bool
+TriangleBVH::rayHitsTriangle( const Triangle & tri,
+                              const double     org[3],
+                              const double     dir[3],
+                              double         & t ) const
+{
+  double p[3];
+  cross( dir, tri.e2, p );
+  const double det = dot( tri.e1, p );
+  if( det == 0.0 ){
+    return false;   // ray parallel to the triangle
+  }
+  const double inv = 1.0/det;
+
+  const double s[3] = { org[0]-tri.v0[0], org[1]-tri.v0[1], org[2]-tri.v0[2] };
+  const double u = dot( s, p )*inv;
+  if( u < 0.0 || u > 1.0 ){
+    return false;
+  }
+
+  double q[3];
+  cross( s, tri.e1, q );
+  const double v = dot( dir, q )*inv;
+  if( v < 0.0 || u + v > 1.0 ){
+    return false;
+  }
+
+  t = dot( tri.e2, q )*inv;
+  return t >= 0.0;
+}
+
+//______________________________________________________________________
+//
+void
+TriangleBVH::collectHits( const double     org[3],
+                          const double     dir[3],
+                          double           tmax,
+                          vector<double> & hits ) const
+{
+  if( d_nodes.empty() ){
+    return;
+  }
+
+  double inv[3];
+  for( int d = 0; d < 3; d++ ){
+    inv[d] = ( dir[d] == 0.0 ) ? s_infinity : 1.0/dir[d];
+  }
+
+  int stack[128];
+  int top = 0;
+  stack[top++] = 0;
+
+  while( top > 0 ){
+    const int  index = stack[--top];
+    const Node & node = d_nodes[index];
+    if( !rayHitsBox( node, org, inv, tmax ) ){
+      continue;
+    }
+    if( node.count > 0 ){
+      for( int i = node.first; i < node.first + node.count; i++ ){
+        double t;
+        if( rayHitsTriangle( d_tris[i], org, dir, t ) && t <= tmax ){
+          hits.push_back( t );
+        }
+      }
+    } else {
+      stack[top++] = node.right;
+      stack[top++] = index + 1;
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+int
+TriangleBVH::countUnique( vector<double> & hits )
+{
+  sort( hits.begin(), hits.end() );
+  return unique( hits.begin(), hits.end() ) - hits.begin();
+}
+
+//______________________________________________________________________
+//
+int
+TriangleBVH::countCrossings( const Point & origin, const Vector & dir ) const
+{
+  const double org[3] = { origin.x(), origin.y(), origin.z() };
+  const double d[3]   = { dir.x(), dir.y(), dir.z() };
+
+  vector<double> hits;
+  collectHits( org, d, s_infinity, hits );
+  return countUnique( hits );
+}
+
+//______________________________________________________________________
+//
+int
+TriangleBVH::countCrossings( const Point & start,
+                             const Point & end,
+                             double      & min_distance ) const
+{
+  const double org[3] = { start.x(), start.y(), start.z() };
+  const double d[3]   = { end.x()-start.x(), end.y()-start.y(), end.z()-start.z() };
+
+  vector<double> hits;
+  collectHits( org, d, 1.0, hits );
+
+  min_distance = 1.e10;
+  if( !hits.empty() ){
+    min_distance = *min_element( hits.begin(), hits.end() ) * ( end - start ).length();
+  }
+  return countUnique( hits );
+}
+
+//______________________________________________________________________
+//  Rays are processed in packets of up to PACKET_SIZE.  Each stack entry
+//  carries the mask of the rays that reached the node, a node is skipped
+//  as soon as none of them hits its box.
+void
+TriangleBVH::countCrossings( const Point  * origins,
+                             int            n,
+                             const Vector & direction,
+                             int          * crossings ) const
+{
+  const double dir[3] = { direction.x(), direction.y(), direction.z() };
+  double inv[3];
+  for( int d = 0; d < 3; d++ ){
+    inv[d] = ( dir[d] == 0.0 ) ? s_infinity : 1.0/dir[d];
+  }
+
+  vector< vector<double> > hits( PACKET_SIZE );
+
+  for( int first = 0; first < n; first += PACKET_SIZE ){
+    const int npacket = min( (int)PACKET_SIZE, n - first );
+
+    for( int r = 0; r < npacket; r++ ){
+      hits[r].clear();
+    }
+
+    if( !d_nodes.empty() ){
+      const uint64_t all = ( npacket == 64 ) ? ~(uint64_t)0 : ( ( (uint64_t)1 << npacket ) - 1 );
+
+      int      stack[128];
+      uint64_t masks[128];
+      int top = 0;
+      stack[top] = 0;
+      masks[top] = all;
+      top++;
+
+      while( top > 0 ){
+        top--;
+        const int    index = stack[top];
+        const Node & node  = d_nodes[index];
+        uint64_t     mask  = 0;
+
+        for( int r = 0; r < npacket; r++ ){
+          if( ( masks[top] >> r ) & 1 ){
+            const Point & o = origins[first + r];
+            const double org[3] = { o.x(), o.y(), o.z() };
+            if( rayHitsBox( node, org, inv, s_infinity ) ){
+              mask |= (uint64_t)1 << r;
+            }
+          }
+        }
+        if( mask == 0 ){
+          continue;
+        }
+
+        if( node.count > 0 ){
+          for( int r = 0; r < npacket; r++ ){
+            if( ( mask >> r ) & 1 ){
+              const Point & o = origins[first + r];
+              const double org[3] = { o.x(), o.y(), o.z() };
+              for( int i = node.first; i < node.first + node.count; i++ ){
+                double t;
+                if( rayHitsTriangle( d_tris[i], org, dir, t ) ){
+                  hits[r].push_back( t );
+                }
+              }
+            }
+          }
+        } else {
+          stack[top] = node.right;
+          masks[top] = mask;
+          top++;
+          stack[top] = index + 1;
+          masks[top] = mask;
+          top++;
+        }
+      }
+    }
+
+    for( int r = 0; r < npacket; r++ ){
+      crossings[first + r] = countUnique( hits[r] );
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+TriangleBVH::intersects( const Box & box ) const
+{
+  if( d_nodes.empty() ){
+    return false;
+  }
+
+  const Point blo = box.lower();
+  const Point bhi = box.upper();
+
+  int stack[128];
+  int top = 0;
+  stack[top++] = 0;
+
+  while( top > 0 ){
+    const int    index = stack[--top];
+    const Node & node  = d_nodes[index];
+
+    bool overlap = true;
+    for( int d = 0; d < 3; d++ ){
+      if( node.lo[d] > bhi(d) || node.hi[d] < blo(d) ){
+        overlap = false;
+      }
+    }
+    if( !overlap ){
+      continue;
+    }
+
+    if( node.count > 0 ){
+      for( int i = node.first; i < node.first + node.count; i++ ){
+        const Triangle & tri = d_tris[i];
+        if( tri.lo[0] <= bhi(0) && tri.hi[0] >= blo(0) &&
+            tri.lo[1] <= bhi(1) && tri.hi[1] >= blo(1) &&
+            tri.lo[2] <= bhi(2) && tri.hi[2] >= blo(2) ){
+          return true;
+        }
+      }
+    } else {
+      stack[top++] = node.right;
+      stack[top++] = index + 1;
+    }
+  }
+  return false;
+}
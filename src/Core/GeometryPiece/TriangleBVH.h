@@ -0,0 +1,145 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef __TRIANGLE_BVH_H__
+#define __TRIANGLE_BVH_H__
+
+#include <Core/Grid/Box.h>
+#include <Core/Geometry/Point.h>
+#include <Core/Geometry/Vector.h>
+#include <Core/Geometry/IntVector.h>
+
+#include <vector>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   TriangleBVH
+
+   Bounding volume hierarchy over the triangles of a TriGeometryPiece.
+
+GENERAL INFORMATION
+
+   TriangleBVH.h
+
+KEYWORDS
+   TriGeometryPiece BVH ray casting
+
+DESCRIPTION
+   The triangles are sorted into a binary tree of axis aligned boxes
+   (median split along the longest axis of the triangle centroids, at most
+   LEAF_SIZE triangles per leaf).  The tree is stored flat, in depth first
+   order, so the left child of a node is always the next node.
+
+   Rays are counted against the surface either one at a time or as a packet
+   of rays sharing a direction, in which case a node is visited once for all
+   the rays of the packet that hit its box.  Hits at the same distance along
+   a ray (a ray through an edge shared by two triangles) are counted once,
+   as the UniformGrid did.
+
+   intersects(box) is conservative: it may report an overlap for a box that
+   is close to, but does not touch, the surface.  It never misses one.
+
+WARNING
+
+****************************************/
+
+  class TriangleBVH {
+
+  public:
+
+    TriangleBVH();
+    ~TriangleBVH();
+
+    void build( const std::vector<Point>     & points,
+                const std::vector<IntVector> & tris );
+
+    bool empty() const { return d_nodes.empty(); }
+
+    //////////
+    // Number of surface crossings of the ray origin + t*dir, t >= 0
+    int countCrossings( const Point & origin, const Vector & dir ) const;
+
+    //////////
+    // Number of surface crossings of the segment start -> end, and the
+    // distance from start to the nearest one (1e10 if there is none)
+    int countCrossings( const Point & start, const Point & end, double & min_distance ) const;
+
+    //////////
+    // Packet version: crossings[i] is the number of surface crossings of
+    // the ray origins[i] + t*dir, t >= 0
+    void countCrossings( const Point  * origins,
+                         int            n,
+                         const Vector & dir,
+                         int          * crossings ) const;
+
+    //////////
+    // Does any triangle (bounding box) overlap the box?
+    bool intersects( const Box & box ) const;
+
+  private:
+
+    enum { LEAF_SIZE = 4, PACKET_SIZE = 64 };
+
+    struct Node {
+      double lo[3];
+      double hi[3];
+      int    right;     // interior: index of the right child
+      int    first;     // leaf: first triangle
+      int    count;     // leaf: number of triangles, 0 for interior nodes
+    };
+
+    // triangle stored as vertex 0 and the two edges from it
+    struct Triangle {
+      double v0[3];
+      double e1[3];
+      double e2[3];
+      double lo[3];
+      double hi[3];
+    };
+
+    int buildNode( std::vector<int>          & order,
+                   const std::vector<double> & centroids,
+                   const std::vector<Triangle> & tris,
+                   int begin, int end );
+
+    bool rayHitsBox( const Node & node, const double org[3], const double inv[3], double tmax ) const;
+
+    bool rayHitsTriangle( const Triangle & tri, const double org[3], const double dir[3], double & t ) const;
+
+    void collectHits( const double org[3], const double dir[3], double tmax,
+                      std::vector<double> & hits ) const;
+
+    static int countUnique( std::vector<double> & hits );
+
+    std::vector<Node>     d_nodes;
+    std::vector<Triangle> d_tris;
+  };
+
+} // End namespace Uintah
+
+#endif // __TRIANGLE_BVH_H__
@@ -31,6 +31,7 @@ SRCDIR := Core/GeometryPiece
 
 SRCS += \
 	$(SRCDIR)/BoxGeometryPiece.cc            \
+	$(SRCDIR)/ChunkedPointFile.cc            \
 	$(SRCDIR)/ConeGeometryPiece.cc           \
 	$(SRCDIR)/CylinderGeometryPiece.cc       \
 	$(SRCDIR)/CylinderShellPiece.cc          \
@@ -52,6 +53,7 @@ SRCS += \
 	$(SRCDIR)/SphereShellPiece.cc            \
 	$(SRCDIR)/TorusGeometryPiece.cc          \
 	$(SRCDIR)/TriGeometryPiece.cc            \
+	$(SRCDIR)/TriangleBVH.cc                 \
 	$(SRCDIR)/LineSegGeometryPiece.cc        \
 	$(SRCDIR)/UniformGrid.cc                 \
 	$(SRCDIR)/UnionGeometryPiece.cc          \
@@ -31,12 +31,14 @@
 #include <Core/Grid/Level.h>
 #include <Core/Grid/Variables/CCVariable.h>
 #include <Core/Grid/Variables/CellIterator.h>
+#include <Core/Grid/Variables/RowRange.h>
 #include <Core/Math/FastMatrix.h>
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Geometry/IntVector.h>
 #include <Core/Math/MiscMath.h>
 
 #include <sstream>
+#include <vector>
 
 
 
@@ -53,10 +55,30 @@ template<class T>
                            const Uintah::IntVector& fh,
                            CCVariable<T>& q_FineLevel)
 {
-  for(CellIterator iter(fl,fh); !iter.done(); iter++){
-    Uintah::IntVector f_cell = *iter;
-    Uintah::IntVector c_cell = fineLevel->mapCellToCoarser(f_cell);
-    q_FineLevel[f_cell] = q_CL[c_cell];
+  if( fh.x() <= fl.x() || fh.y() <= fl.y() || fh.z() <= fl.z() ) {
+    return;
+  }
+
+  // the coarse x index of every fine x index, the map is separable
+  const int nx = fh.x() - fl.x();
+  std::vector<int> c_x( nx );
+  for( int n = 0; n < nx; n++ ) {
+    c_x[n] = fineLevel->mapCellToCoarser( Uintah::IntVector( fl.x() + n, fl.y(), fl.z() ) ).x();
+  }
+
+  RowAccessor<const T> q_C( q_CL );
+  RowAccessor<T>       q_F( q_FineLevel );
+
+  for( int k = fl.z(); k < fh.z(); k++ ) {
+    for( int j = fl.y(); j < fh.y(); j++ ) {
+      const Uintah::IntVector c_cell = fineLevel->mapCellToCoarser( Uintah::IntVector( fl.x(), j, k ) );
+      const T* q_c = q_C.row( c_cell.y(), c_cell.z() );
+      T*       q_f = q_F.row( j, k ) + fl.x();
+
+      for( int n = 0; n < nx; n++ ) {
+        q_f[n] = q_c[ c_x[n] ];
+      }
+    }
   }
 }
 
@@ -103,6 +125,42 @@ Q_fc_plane_2 is identical to Q_fc_plane_1 with except for a z offset.
 
 Q_FC =(1-z)Q_fc_plane_1 + (z) * Q_fc_plane2
 _____________________________________________________________________*/
+//______________________________________________________________________
+//  One direction of linearInterpolation: for each fine index in [fl, fh)
+//  along dir, the coarse index c, the offset to the second coarse cell
+//  (-1, 0, 1) and the weight w of the second cell.
+inline void linearInterpolationAxis(const Level* fineLevel,
+                                    const int dir,
+                                    const std::vector<double>& norm_dist,
+                                    const Uintah::IntVector& refineRatio,
+                                    const Uintah::IntVector& fl,
+                                    const Uintah::IntVector& fh,
+                                    std::vector<int>& c,
+                                    std::vector<int>& offset,
+                                    std::vector<double>& w)
+{
+  const int n = fh[dir] - fl[dir];
+  c.resize(n);
+  offset.resize(n);
+  w.resize(n);
+
+  for( int i = 0; i < n; i++ ) {
+    Uintah::IntVector f_cell( fl );
+    f_cell[dir] = fl[dir] + i;
+    c[i] = fineLevel->mapCellToCoarser(f_cell)[dir];
+
+    // index of the fine cell, relative to the coarse cell center
+    const double dist = norm_dist[ f_cell[dir] - c[i] * refineRatio[dir] ];
+
+    offset[i]  = Uintah::Sign(dist);                // returns +/- 1.0
+    offset[i] *= Uintah::RoundUp(fabs(dist));       // 0 if dist = 0
+    w[i]       = fabs(dist);                        // always +
+  }
+}
+
+//______________________________________________________________________
+//  Row by row: the coarse indices, offsets and weights are computed once
+//  per direction, the inner loop runs along a fine x-row.
 template<class T>
   void linearInterpolation(constCCVariable<T>& q_CL,// course level
                            const Level* coarseLevel,
@@ -112,6 +170,10 @@ template<class T>
                            const Uintah::IntVector& fh,
                            CCVariable<T>& q_FineLevel)
 {
+  if( fh.x() <= fl.x() || fh.y() <= fl.y() || fh.z() <= fl.z() ) {
+    return;
+  }
+
   // compute the normalized distance between the fine and coarse cell centers
   std::vector<double> norm_dist_x(refineRatio.x());
   std::vector<double> norm_dist_y(refineRatio.y());
@@ -120,77 +182,63 @@ template<class T>
   normalizedDistance_CC(refineRatio.y(),norm_dist_y);
   normalizedDistance_CC(refineRatio.z(),norm_dist_z);
 
-  for(CellIterator iter(fl,fh); !iter.done(); iter++){
-    Uintah::IntVector f_cell = *iter;
-    Uintah::IntVector c_cell = fineLevel->mapCellToCoarser(f_cell);
-    //__________________________________
-    // compute the index of the fine cell, relative to the
-    // coarse cell center.
-    Uintah::IntVector relativeIndx = f_cell - (c_cell * refineRatio);
-
-    Vector dist;  // normalized distance
-    dist.x(norm_dist_x[relativeIndx.x()]);
-    dist.y(norm_dist_y[relativeIndx.y()]);
-    dist.z(norm_dist_z[relativeIndx.z()]);
-
-    //__________________________________
-    // Offset for coarse level surrounding cells:
-    // determine the direction to the surrounding interpolation cells
-    int i = Uintah::Sign(dist.x());   // returns +/- 1.0
-    int j = Uintah::Sign(dist.y());
-    int k = Uintah::Sign(dist.z());
-
-    i *= Uintah::RoundUp(fabs(dist.x()));  // if dist.x,y,z() = 0 then set (i,j,k) = 0
-    j *= Uintah::RoundUp(fabs(dist.y()));  // Only need surrounding coarse cell data if dist != 0
-    k *= Uintah::RoundUp(fabs(dist.z()));  // This is especially true for 1D and 2D problems
-
-    //__________________________________
-    //  Find the weights
-    double x = fabs(dist.x());  // The normalized distance is always +
-    double y = fabs(dist.y());
-    double z = fabs(dist.z());
-
-    double w0 = (1.0 - x) * (1.0 - y);
-    double w1 = x * (1.0 - y);
-    double w2 = y * (1.0 - x);
-    double w3 = x * y;
-
-    T q_XY_Plane_1   // X-Y plane closest to the fine level cell
-        = w0 * q_CL[c_cell]
-        + w1 * q_CL[c_cell + Uintah::IntVector( i, 0, 0)]
-        + w2 * q_CL[c_cell + Uintah::IntVector( 0, j, 0)]
-        + w3 * q_CL[c_cell + Uintah::IntVector( i, j, 0)];
-
-    T q_XY_Plane_2   // X-Y plane furthest from the fine level cell
-        = w0 * q_CL[c_cell + Uintah::IntVector( 0, 0, k)]
-        + w1 * q_CL[c_cell + Uintah::IntVector( i, 0, k)]
-        + w2 * q_CL[c_cell + Uintah::IntVector( 0, j, k)]
-        + w3 * q_CL[c_cell + Uintah::IntVector( i, j, k)];
-
-    // interpolate the two X-Y planes in the k direction
-    q_FineLevel[f_cell] = (1.0 - z) * q_XY_Plane_1 + z * q_XY_Plane_2;
-
-    //__________________________________
-    //  Debugging
-#if 0
-      Uintah::IntVector half  = (fh - fl )/Uintah::IntVector(2,2,2) + fl;
-      if ((f_cell.y() == half.y() && f_cell.z() == half.z())){
-       cout.setf(ios::scientific,ios::floatfield);
-       cout.precision(5);
-       cout << " f_cell " << f_cell << " c_cell "<< c_cell << " offset ["<<i<<","<<j<<","<<k<<"]  " << endl;
-       cout << " relative indx " << relativeIndx  << endl;
-       cout << "dist "<< dist << " dir " << dir <<  endl;
-       cout << " q_CL[c_cell]                       "                           << q_CL[c_cell]                       << " w0 " << w0 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( " << i << ", 0, 0)] "                 << q_CL[c_cell + Uintah::IntVector( i, 0, 0)] << " w1 " << w1 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( 0, " << j << ", 0)] "                 << q_CL[c_cell + Uintah::IntVector( 0, j, 0)] << " w2 " << w2 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( "<< i << ", " << j << ", 0)] "        << q_CL[c_cell + Uintah::IntVector( i, j, 0)] << " w3 " << w3 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( 0, 0, "<<k<<")] "                     << q_CL[c_cell + Uintah::IntVector( 0, 0, k)] << " w0 " << w0 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( "<< i << ", 0, "<<k<<")] "            << q_CL[c_cell + Uintah::IntVector( i, 0, k)] << " w1 " << w1 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( 0, "<< j <<", "<<k<<")] "             << q_CL[c_cell + Uintah::IntVector( 0, j, k)] << " w2 " << w2 << endl;
-       cout << " q_CL[c_cell + Uintah::IntVector( "<< i << ", " << j << ", "<< k <<")] " << q_CL[c_cell + Uintah::IntVector( i, j, k)] << " w3 " << w3 <<endl;
-       cout << " q_XY_Plane_1 " << q_XY_Plane_1 << " q_XY_Plane_2 " << q_XY_Plane_2 << " q_FineLevel[f_cell] "<< q_FineLevel[f_cell] << endl;
+  std::vector<int>    c_x, c_y, c_z;
+  std::vector<int>    i_x, j_y, k_z;
+  std::vector<double> w_x, w_y, w_z;
+  linearInterpolationAxis(fineLevel, 0, norm_dist_x, refineRatio, fl, fh, c_x, i_x, w_x);
+  linearInterpolationAxis(fineLevel, 1, norm_dist_y, refineRatio, fl, fh, c_y, j_y, w_y);
+  linearInterpolationAxis(fineLevel, 2, norm_dist_z, refineRatio, fl, fh, c_z, k_z, w_z);
+
+  RowAccessor<const T> q_C( q_CL );
+  RowAccessor<T>       q_F( q_FineLevel );
+
+  const int nx = fh.x() - fl.x();
+
+  for( int fk = 0; fk < fh.z() - fl.z(); fk++ ) {
+    const int    cz = c_z[fk];
+    const int    k  = k_z[fk];
+    const double z  = w_z[fk];
+
+    for( int fj = 0; fj < fh.y() - fl.y(); fj++ ) {
+      const int    cy = c_y[fj];
+      const int    j  = j_y[fj];
+      const double y  = w_y[fj];
+
+      // coarse rows:  (0,0,0), (0,j,0), (0,0,k), (0,j,k)
+      const T* q_00 = q_C.row( cy,     cz     );
+      const T* q_j0 = q_C.row( cy + j, cz     );
+      const T* q_0k = q_C.row( cy,     cz + k );
+      const T* q_jk = q_C.row( cy + j, cz + k );
+      T*       q_f  = q_F.row( fl.y() + fj, fl.z() + fk ) + fl.x();
+
+      for( int n = 0; n < nx; n++ ) {
+        const int    c = c_x[n];
+        const int    i = i_x[n];
+        const double x = w_x[n];
+
+        //__________________________________
+        //  Find the weights
+        double w0 = (1.0 - x) * (1.0 - y);
+        double w1 = x * (1.0 - y);
+        double w2 = y * (1.0 - x);
+        double w3 = x * y;
+
+        T q_XY_Plane_1   // X-Y plane closest to the fine level cell
+            = w0 * q_00[c]
+            + w1 * q_00[c + i]
+            + w2 * q_j0[c]
+            + w3 * q_j0[c + i];
+
+        T q_XY_Plane_2   // X-Y plane furthest from the fine level cell
+            = w0 * q_0k[c]
+            + w1 * q_0k[c + i]
+            + w2 * q_jk[c]
+            + w3 * q_jk[c + i];
+
+        // interpolate the two X-Y planes in the k direction
+        q_f[n] = (1.0 - z) * q_XY_Plane_1 + z * q_XY_Plane_2;
+      }
     }
-#endif
   }
 }
 //______________________________________________________________________
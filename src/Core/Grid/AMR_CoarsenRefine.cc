@@ -28,16 +28,73 @@
 #include <Core/Geometry/Vector.h>
 #include <Core/Grid/AMR.h>
 #include <Core/Grid/Level.h>
+#include <Core/Grid/Variables/RowRange.h>
+#include <Core/Parallel/ThreadExecutor.h>
 #include <Core/Util/DebugStream.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace {
   Uintah::DebugStream cout_dbg("AMR_CoarsenRefine", "AMR_CoarsenRefine", "AMR - coarsening and refining operations", false);
 }
 
+namespace {
+
+  //______________________________________________________________________
+  //  For each coarse index c in [cl, ch) along direction dir, the fine
+  //  cells [b, e) under c that lie inside the fine region [fl, fh].
+  //  The maps are separable, so the 3D ranges are products of these.
+  void fineRange( const Uintah::Level* coarseLevel,
+                  const int dir,
+                  const int ratio,
+                  const Uintah::IntVector& cl,
+                  const Uintah::IntVector& ch,
+                  const Uintah::IntVector& fl,
+                  const Uintah::IntVector& fh,
+                  std::vector<int>& b,
+                  std::vector<int>& e )
+  {
+    const int n = ch[dir] - cl[dir];
+    b.resize( n );
+    e.resize( n );
+    for( int c = 0; c < n; c++ ) {
+      Uintah::IntVector idx( cl );
+      idx[dir] = cl[dir] + c;
+      const int start = coarseLevel->mapCellToFiner( idx )[dir];
+
+      b[c] = std::max( start,             fl[dir] );
+      e[c] = std::min( start + ratio - 1, fh[dir] ) + 1;
+      e[c] = std::max( e[c], b[c] );
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  struct FineRanges {
+    std::vector<int> xb, xe, yb, ye, zb, ze;
+
+    FineRanges( const Uintah::Level* coarseLevel,
+                const Uintah::IntVector& refinementRatio,
+                const Uintah::IntVector& cl,
+                const Uintah::IntVector& ch,
+                const Uintah::IntVector& fl,
+                const Uintah::IntVector& fh )
+    {
+      fineRange( coarseLevel, 0, refinementRatio.x(), cl, ch, fl, fh, xb, xe );
+      fineRange( coarseLevel, 1, refinementRatio.y(), cl, ch, fl, fh, yb, ye );
+      fineRange( coarseLevel, 2, refinementRatio.z(), cl, ch, fl, fh, zb, ze );
+    }
+  };
+}
+
 namespace Uintah {
 
 //______________________________________________________________________
-//
+//  The fine cells under a coarse row are visited as fine x-rows: for each
+//  fine (y,z) row under the coarse row the fine cells of every coarse
+//  cell are accumulated into a row buffer.  The summation order within a
+//  coarse cell (z, then y, then x) is the one of the cell by cell loop.
 template<typename T>
 void coarsenDriver_std(const IntVector& cl, 
                        const IntVector& ch,                     
@@ -49,41 +106,65 @@ void coarsenDriver_std(const IntVector& cl,
                        constCCVariable<T>& fine_q_CC,
                        CCVariable<T>& coarse_q_CC )
 {
-  T zero(0.0);
-  // iterate over coarse level cells
-  for(CellIterator iter(cl, ch); !iter.done(); iter++){
-    IntVector c = *iter;
-    T q_CC_tmp(zero);
-    IntVector fineStart = coarseLevel->mapCellToFiner(c);
-
-    double count = 0;
-    // for each coarse level cell iterate over the fine level cells   
-    for(CellIterator inside(IntVector(0,0,0),refinementRatio );
-        !inside.done(); inside++){
-      IntVector fc = fineStart + *inside;
-      
-      if( fc.x() >= fl.x() && fc.y() >= fl.y() && fc.z() >= fl.z() &&
-          fc.x() <= fh.x() && fc.y() <= fh.y() && fc.z() <= fh.z() ) {
-        q_CC_tmp += fine_q_CC[fc];
-        count +=1.0;
-        //std::cout << "    " << fc << "   fine_q_CC " << fine_q_CC[fc] <<" q_CC_tmp: " << q_CC_tmp << endl;
+  if( ch.x() <= cl.x() || ch.y() <= cl.y() || ch.z() <= cl.z() ) {
+    return;
+  }
+
+  const FineRanges r( coarseLevel, refinementRatio, cl, ch, fl, fh );
+
+  RowAccessor<const T> fine( fine_q_CC );
+  RowAccessor<T>       coarse( coarse_q_CC );
+
+  const T zero(0.0);
+  const int nx = ch.x() - cl.x();
+  std::vector<T> q_CC_tmp( nx );
+
+  // iterate over coarse level rows
+  for( int k = cl.z(); k < ch.z(); k++ ) {
+    const int kk = k - cl.z();
+
+    for( int j = cl.y(); j < ch.y(); j++ ) {
+      const int jj = j - cl.y();
+
+      std::fill( q_CC_tmp.begin(), q_CC_tmp.end(), zero );
+
+      // for each coarse level cell iterate over the fine level cells
+      for( int fz = r.zb[kk]; fz < r.ze[kk]; fz++ ) {
+        for( int fy = r.yb[jj]; fy < r.ye[jj]; fy++ ) {
+          const T* f = fine.row( fy, fz );
+
+          for( int n = 0; n < nx; n++ ) {
+            T sum = q_CC_tmp[n];
+            for( int fx = r.xb[n]; fx < r.xe[n]; fx++ ) {
+              sum += f[fx];
+            }
+            q_CC_tmp[n] = sum;
+          }
+        }
       }
+
+      T* c = coarse.row( j, k ) + cl.x();
+      for( int n = 0; n < nx; n++ ) {
+        c[n] = q_CC_tmp[n]*ratio;
+      }
+
+      //__________________________________
+      //  bulletproofing
+      #if SCI_ASSERTION_LEVEL > 0
+        for( int n = 0; n < nx; n++ ) {
+          double count = (double) ( r.xe[n] - r.xb[n] ) * ( r.ye[jj] - r.yb[jj] ) * ( r.ze[kk] - r.zb[kk] );
+
+          if ( (fabs(ratio - 1.0/count) > 2 * DBL_EPSILON) && ratio != 1 ) {
+            std::ostringstream msg;
+            msg << " ERROR:  coarsenDriver_std: coarse cell " << IntVector( cl.x() + n, j, k ) << "\n"
+                <<  "Only (" << count << ") fine level cells were used to compute the coarse cell value."
+                << " There should have been ("<< 1/ratio << ") cells used";
+
+            throw InternalError(msg.str(),__FILE__,__LINE__);
+          }
+        }
+      #endif
     }
-    coarse_q_CC[c] =q_CC_tmp*ratio;
-    
-    //__________________________________
-    //  bulletproofing
-    #if SCI_ASSERTION_LEVEL > 0
-      if ( (fabs(ratio - 1.0/count) > 2 * DBL_EPSILON) && ratio != 1 ) {
-        std::ostringstream msg;
-        msg << " ERROR:  coarsenDriver_std: coarse cell " << c << "\n" 
-            <<  "Only (" << count << ") fine level cells were used to compute the coarse cell value."
-            << " There should have been ("<< 1/ratio << ") cells used";
-
-      throw InternalError(msg.str(),__FILE__,__LINE__);
-      } 
-    #endif
-    //std::cout << c << "   coarse_q_CC " << coarse_q_CC[c] << " ratio " << ratio << endl;
   }
 }
 
@@ -100,30 +181,150 @@ void coarsenDriver_massWeighted( const IntVector & cl,
                                  constCCVariable<T>& fine_q_CC,
                                  CCVariable<T>& coarse_q_CC )
 {
-  T zero(0.0);
-  // iterate over coarse level cells
-  for(CellIterator iter(cl, ch); !iter.done(); iter++){
-    IntVector c = *iter;
-    T q_CC_tmp(zero);
-    double mass_CC_tmp=0.;
-    IntVector fineStart = coarseLevel->mapCellToFiner(c);
-
-    // for each coarse level cell iterate over the fine level cells   
-    for(CellIterator inside(IntVector(0,0,0),refinementRatio );
-        !inside.done(); inside++){
-      IntVector fc = fineStart + *inside;
-      
-      if( fc.x() >= fl.x() && fc.y() >= fl.y() && fc.z() >= fl.z() &&
-          fc.x() <= fh.x() && fc.y() <= fh.y() && fc.z() <= fh.z() ) {
-        q_CC_tmp += fine_q_CC[fc]*cMass[fc];
-        mass_CC_tmp += cMass[fc];
+  if( ch.x() <= cl.x() || ch.y() <= cl.y() || ch.z() <= cl.z() ) {
+    return;
+  }
+
+  const FineRanges r( coarseLevel, refinementRatio, cl, ch, fl, fh );
+
+  RowAccessor<const double> mass( cMass );
+  RowAccessor<const T>      fine( fine_q_CC );
+  RowAccessor<T>            coarse( coarse_q_CC );
+
+  const T zero(0.0);
+  const int nx = ch.x() - cl.x();
+  std::vector<T>      q_CC_tmp( nx );
+  std::vector<double> mass_CC_tmp( nx );
+
+  // iterate over coarse level rows
+  for( int k = cl.z(); k < ch.z(); k++ ) {
+    const int kk = k - cl.z();
+
+    for( int j = cl.y(); j < ch.y(); j++ ) {
+      const int jj = j - cl.y();
+
+      std::fill( q_CC_tmp.begin(),    q_CC_tmp.end(),    zero );
+      std::fill( mass_CC_tmp.begin(), mass_CC_tmp.end(), 0.0 );
+
+      // for each coarse level cell iterate over the fine level cells
+      for( int fz = r.zb[kk]; fz < r.ze[kk]; fz++ ) {
+        for( int fy = r.yb[jj]; fy < r.ye[jj]; fy++ ) {
+          const T*      f = fine.row( fy, fz );
+          const double* m = mass.row( fy, fz );
+
+          for( int n = 0; n < nx; n++ ) {
+            T      q_sum = q_CC_tmp[n];
+            double m_sum = mass_CC_tmp[n];
+            for( int fx = r.xb[n]; fx < r.xe[n]; fx++ ) {
+              q_sum += f[fx]*m[fx];
+              m_sum += m[fx];
+            }
+            q_CC_tmp[n]    = q_sum;
+            mass_CC_tmp[n] = m_sum;
+          }
+        }
+      }
+
+      T* c = coarse.row( j, k ) + cl.x();
+      for( int n = 0; n < nx; n++ ) {
+        c[n] = q_CC_tmp[n]/mass_CC_tmp[n];
       }
-      
     }
-    coarse_q_CC[c] =q_CC_tmp/mass_CC_tmp;
   }
 }
 
+//______________________________________________________________________
+//
+FineToCoarseBatch::FineToCoarseBatch( DataWarehouse* dw,
+                                      const Patch* coarsePatch,
+                                      const Level* coarseLevel,
+                                      const Level* fineLevel )
+  : d_dw( dw )
+  , d_coarsePatch( coarsePatch )
+  , d_coarseLevel( coarseLevel )
+  , d_fineLevel( fineLevel )
+{
+}
+
+//______________________________________________________________________
+//
+template<class T>
+void
+FineToCoarseBatch::fetch( std::vector< Item<T> >& items,
+                          const PatchPair& pair )
+{
+  for( auto& item : items ) {
+    item.fine.emplace_back();
+    d_dw->getRegion( item.fine.back(), item.label, item.indx, d_fineLevel, pair.fl, pair.fh, false );
+  }
+}
+
+//______________________________________________________________________
+//
+template<class T>
+void
+FineToCoarseBatch::coarsen( std::vector< Item<T> >& items,
+                            const PatchPair& pair,
+                            const int ipair )
+{
+  for( auto& item : items ) {
+    coarsenDriver_std( pair.cl, pair.ch, pair.fl, pair.fh, d_refineRatio,
+                       item.computesAve ? d_inv_RR : 1.0, d_coarseLevel,
+                       item.fine[ipair], *item.q_CC );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+FineToCoarseBatch::execute()
+{
+  if( d_double.empty() && d_float.empty() && d_vector.empty() && d_int.empty() ) {
+    return;
+  }
+
+  d_refineRatio = d_fineLevel->getRefinementRatio();
+  d_inv_RR      = 1.0/( (double)(d_refineRatio.x() * d_refineRatio.y() * d_refineRatio.z()) );
+
+  //__________________________________
+  //  the fine/coarse patch pairs and the fine data of every variable,
+  //  fetched once
+  Level::selectType finePatches;
+  d_coarsePatch->getFineLevelPatches(finePatches);
+
+  std::vector<PatchPair> pairs;
+  for(size_t i=0;i<finePatches.size();i++){
+    PatchPair pair;
+    getFineLevelRange(d_coarsePatch, finePatches[i], pair.cl, pair.ch, pair.fl, pair.fh);
+
+    if (pair.fh.x() <= pair.fl.x() || pair.fh.y() <= pair.fl.y() || pair.fh.z() <= pair.fl.z()) {
+      continue;
+    }
+
+    cout_dbg << " fineToCoarseOperator: finePatch "<< pair.fl << " " << pair.fh
+             << " coarsePatch "<< pair.cl << " " << pair.ch << std::endl;
+
+    fetch( d_double, pair );
+    fetch( d_float,  pair );
+    fetch( d_vector, pair );
+    fetch( d_int,    pair );
+    pairs.push_back( pair );
+  }
+
+  //__________________________________
+  //  The pairs cover disjoint coarse regions
+  ThreadExecutor::runTasks( (int) pairs.size(), [&]( int p ) {
+    coarsen( d_double, pairs[p], p );
+    coarsen( d_float,  pairs[p], p );
+    coarsen( d_vector, pairs[p], p );
+    coarsen( d_int,    pairs[p], p );
+  });
+
+  d_double.clear();
+  d_float.clear();
+  d_vector.clear();
+  d_int.clear();
+}
 
 //_____________________________________________________________________
 //   Averages the interior fine patch data onto the coarse patch
@@ -138,37 +339,9 @@ void fineToCoarseOperator(CCVariable<T>& q_CC,
                           const Level* coarseLevel,
                           const Level* fineLevel)
 {
-  Level::selectType finePatches;
-  coarsePatch->getFineLevelPatches(finePatches);
-                          
-  for(size_t i=0;i<finePatches.size();i++){
-    const Patch* finePatch = finePatches[i];
-
-    IntVector cl, ch, fl, fh;
-    getFineLevelRange(coarsePatch, finePatch, cl, ch, fl, fh);
-
-    if (fh.x() <= fl.x() || fh.y() <= fl.y() || fh.z() <= fl.z()) {
-      continue;
-    }
-    
-    constCCVariable<T> fine_q_CC;
-    dw->getRegion(fine_q_CC,  varLabel, indx, fineLevel, fl, fh, false);
-    
-    cout_dbg << " fineToCoarseOperator: finePatch "<< fl << " " << fh 
-             << " coarsePatch "<< cl << " " << ch << std::endl;
-             
-    IntVector r_Ratio = fineLevel->getRefinementRatio();
-    
-    double inv_RR = 1.0;    
-    
-    if(computesAve){
-      inv_RR = 1.0/( (double)(r_Ratio.x() * r_Ratio.y() * r_Ratio.z()) );
-    }
-
-
-    coarsenDriver_std(cl, ch, fl, fh, r_Ratio, inv_RR, coarseLevel,                
-                      fine_q_CC, q_CC );
-  }
+  FineToCoarseBatch batch( dw, coarsePatch, coarseLevel, fineLevel );
+  batch.add( q_CC, computesAve, varLabel, indx );
+  batch.execute();
 //  cout_dbg.setActive(false);// turn off the switch for cout_dbg  (turn off tsanitizer warnings)
 }
 
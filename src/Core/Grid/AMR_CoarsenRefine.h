@@ -29,6 +29,8 @@
 #include <Core/Grid/Variables/VarLabel.h>
 #include <CCA/Ports/DataWarehouseP.h>
 
+#include <vector>
+
 
 namespace Uintah {
 
@@ -55,6 +57,75 @@ namespace Uintah {
                                      constCCVariable<double>& cMass,
                                      constCCVariable<T>& fine_q_CC,
                                      CCVariable<T>& coarse_q_CC );
+  //______________________________________________________________________
+  //  Coarsens several variables of one coarse patch together: the fine
+  //  patches under the coarse patch and their ranges are found once, the
+  //  fine data of each variable is fetched once per fine patch and the
+  //  fine/coarse patch pairs are coarsened in parallel (ThreadExecutor).
+  //  execute() is equivalent to calling fineToCoarseOperator() for every
+  //  variable added.
+  class FineToCoarseBatch {
+  public:
+    FineToCoarseBatch( DataWarehouse* dw,
+                       const Patch* coarsePatch,
+                       const Level* coarseLevel,
+                       const Level* fineLevel );
+
+    // T: double, float, Vector or int
+    template<class T>
+    void add( CCVariable<T>& q_CC,
+              const bool computesAve,
+              const VarLabel* varLabel,
+              const int indx )
+    {
+      Item<T> item;
+      item.q_CC        = &q_CC;
+      item.computesAve = computesAve;
+      item.label       = varLabel;
+      item.indx        = indx;
+      items( (T*) nullptr ).push_back( item );
+    }
+
+    void execute();
+
+  private:
+    template<class T>
+    struct Item {
+      CCVariable<T>*                  q_CC;
+      bool                            computesAve;
+      const VarLabel*                 label;
+      int                             indx;
+      std::vector< constCCVariable<T> > fine;     // one per patch pair
+    };
+
+    struct PatchPair {
+      IntVector cl, ch, fl, fh;
+    };
+
+    std::vector< Item<double> >& items( double* ) { return d_double; }
+    std::vector< Item<float> >&  items( float*  ) { return d_float;  }
+    std::vector< Item<Vector> >& items( Vector* ) { return d_vector; }
+    std::vector< Item<int> >&    items( int*    ) { return d_int;    }
+
+    template<class T>
+    void fetch( std::vector< Item<T> >& items, const PatchPair& pair );
+
+    template<class T>
+    void coarsen( std::vector< Item<T> >& items, const PatchPair& pair, const int ipair );
+
+    DataWarehouse* d_dw;
+    const Patch*   d_coarsePatch;
+    const Level*   d_coarseLevel;
+    const Level*   d_fineLevel;
+    IntVector      d_refineRatio;
+    double         d_inv_RR;
+
+    std::vector< Item<double> > d_double;
+    std::vector< Item<float> >  d_float;
+    std::vector< Item<Vector> > d_vector;
+    std::vector< Item<int> >    d_int;
+  };
+
   template<class T>
   void fineToCoarseOperator(CCVariable<T>& q_CC,
                             const bool,
@@ -0,0 +1,130 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Grid/BoundaryConditions/BCCellList.h>
+#include <Core/Exceptions/InternalError.h>
+
+#include <mutex>
+#include <sstream>
+
+using namespace Uintah;
+
+//--------------------------------------------------------------------------------------------------
+
+BCCellList::BCCellList()
+  : d_low(0,0,0), d_high(0,0,0), d_isBox(true)
+{
+}
+
+//--------------------------------------------------------------------------------------------------
+
+BCCellList::BCCellList( const Iterator& cells )
+  : d_low(0,0,0), d_high(0,0,0), d_isBox(true)
+{
+  Iterator iter(cells);
+  d_cells.reserve( iter.size() );
+  for (iter.reset(); !iter.done(); iter++) {
+    d_cells.push_back( *iter );
+  }
+
+  if (d_cells.empty()) {
+    return;
+  }
+
+  d_low  = d_cells[0];
+  d_high = d_cells[0];
+  for (const IntVector& c : d_cells) {
+    d_low  = Min(d_low,  c);
+    d_high = Max(d_high, c);
+  }
+  d_high += IntVector(1,1,1);
+
+  // a box if the cells are the box in x-fastest order, which is what
+  // GridIterator produces for a full face
+  const IntVector extent = d_high - d_low;
+  d_isBox = ( (long) extent.x() * extent.y() * extent.z() == (long) d_cells.size() );
+  if (d_isBox) {
+    std::size_t n = 0;
+    for (int k = d_low.z(); k < d_high.z() && d_isBox; k++) {
+      for (int j = d_low.y(); j < d_high.y() && d_isBox; j++) {
+        for (int i = d_low.x(); i < d_high.x(); i++, n++) {
+          if (d_cells[n] != IntVector(i,j,k)) {
+            d_isBox = false;
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+void
+BCCellList::checkInside( const Layout& layout ) const
+{
+  if (d_cells.empty()) {
+    return;
+  }
+
+  const IntVector end = layout.offset + layout.size;
+  if (d_low.x() < layout.offset.x() || d_low.y() < layout.offset.y() || d_low.z() < layout.offset.z() ||
+      d_high.x() > end.x()          || d_high.y() > end.y()          || d_high.z() > end.z()) {
+    std::ostringstream msg;
+    msg << "BCCellList: boundary cells " << d_low << " - " << d_high
+        << " are outside of the variable's data " << layout.offset << " - " << end;
+    throw InternalError( msg.str(), __FILE__, __LINE__ );
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
+const std::vector<int>&
+BCCellList::offsets( const Layout& layout ) const
+{
+  std::lock_guard<Uintah::MasterLock> guard( d_lock );
+
+  for (const auto& compiled : d_compiled) {
+    if (compiled->layout == layout) {
+      return compiled->offsets;
+    }
+  }
+
+  checkInside( layout );
+
+  std::unique_ptr<Compiled> compiled( new Compiled );
+  compiled->layout = layout;
+  compiled->offsets.resize( d_cells.size() );
+
+  const long nx  = layout.size.x();
+  const long nxy = nx * layout.size.y();
+  for (std::size_t n = 0; n < d_cells.size(); n++) {
+    const IntVector c = d_cells[n] - layout.offset;
+    compiled->offsets[n] = (int) ( c.x() + nx * c.y() + nxy * c.z() );
+  }
+
+  d_compiled.push_back( std::move(compiled) );
+  return d_compiled.back()->offsets;
+}
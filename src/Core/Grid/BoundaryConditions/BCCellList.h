@@ -0,0 +1,116 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef UINTAH_GRID_BCCellList_H
+#define UINTAH_GRID_BCCellList_H
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/Iterator.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <memory>
+#include <vector>
+
+namespace Uintah {
+
+  /*!
+
+  \class BCCellList
+
+  \brief The cells of a boundary condition iterator, flattened once per
+         patch so that the BC kernels (BCUtils.h) don't go through the
+         virtual BaseIterator interface for every cell of every variable.
+
+  The cells are kept in iterator order.  When they fill a box (a whole
+  face, SideBCData) the list is only the box and the kernels loop over it
+  directly.  Otherwise the linear offsets of the cells into a variable
+  are computed the first time a variable with that memory layout is seen
+  and reused for every variable, material and timestep with the same
+  layout.
+
+  */
+
+  class BCCellList {
+  public:
+
+    /// The memory layout of a variable: the index of its first element
+    /// and the dimensions of the allocated data (Array3Window offset and
+    /// Array3Data size).
+    struct Layout {
+      IntVector offset;
+      IntVector size;
+
+      bool operator==( const Layout& rhs ) const {
+        return offset == rhs.offset && size == rhs.size;
+      }
+    };
+
+    BCCellList();
+
+    /// Flatten the cells of an iterator.
+    explicit BCCellList( const Iterator& cells );
+
+    int  size()  const { return (int) d_cells.size(); }
+    bool empty() const { return d_cells.empty(); }
+
+    /// True if the cells are exactly the box [low(), high()).
+    bool isBox() const { return d_isBox; }
+
+    /// Bounding box of the cells.
+    const IntVector& low()  const { return d_low; }
+    const IntVector& high() const { return d_high; }
+
+    /// The cells, in the order of the iterator.
+    const std::vector<IntVector>& cells() const { return d_cells; }
+
+    /// Throws an InternalError if a cell lies outside of the data.
+    void checkInside( const Layout& layout ) const;
+
+    /// Linear offsets of the cells into data with the given layout.
+    /// Throws an InternalError if a cell lies outside of the data.
+    const std::vector<int>& offsets( const Layout& layout ) const;
+
+  private:
+
+    BCCellList( const BCCellList& );
+    BCCellList& operator=( const BCCellList& );
+
+    struct Compiled {
+      Layout           layout;
+      std::vector<int> offsets;
+    };
+
+    std::vector<IntVector> d_cells;
+    IntVector              d_low;
+    IntVector              d_high;
+    bool                   d_isBox;
+
+    mutable std::vector< std::unique_ptr<Compiled> > d_compiled;
+    mutable Uintah::MasterLock                       d_lock;
+  };
+
+} // End namespace Uintah
+
+#endif
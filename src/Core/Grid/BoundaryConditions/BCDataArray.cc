@@ -489,6 +489,23 @@ BCDataArray::getCellFaceIterator( int mat_id, Iterator & b_ptr, int ichild ) con
 
 //------------------------------------------------------------------------------------------------
 
+const BCCellList&
+BCDataArray::getCellFaceList( int mat_id, int ichild ) const
+{
+  bcDataArrayType::const_iterator itr = d_BCDataArray.find(mat_id);
+  if (itr == d_BCDataArray.end()) {
+    itr = d_BCDataArray.find(-1);
+  }
+  if (itr != d_BCDataArray.end()) {
+    return itr->second[ichild]->getCellFaceList();
+  }
+
+  static const BCCellList empty;
+  return empty;
+}
+
+//------------------------------------------------------------------------------------------------
+
 void BCDataArray::getNodeFaceIterator(int mat_id, Iterator& b_ptr, int ichild) const
 {
   bcDataArrayType::const_iterator itr = d_BCDataArray.find(mat_id);
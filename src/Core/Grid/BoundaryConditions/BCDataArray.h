@@ -105,6 +105,9 @@ namespace Uintah {
      /// Get the cell centered face iterator for the ith face child on mat_id.
      void getCellFaceIterator(int mat_id,Iterator& b_ptr, int ichild) const;
 
+     /// Get the flattened cells of the ith face child on mat_id (see BCCellList).
+     const BCCellList& getCellFaceList(int mat_id, int ichild) const;
+
      /// Get the node centered face iterator for the ith face child on mat_id.
      void getNodeFaceIterator(int mat_id,Iterator& b_ptr, int ichild) const;
 
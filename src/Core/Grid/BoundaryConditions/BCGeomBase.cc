@@ -32,6 +32,7 @@
 #include <Core/Grid/BoundaryConditions/BCDataArray.h>
 
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 
@@ -57,6 +58,7 @@ BCGeomBase::BCGeomBase()
 BCGeomBase::BCGeomBase(const BCGeomBase& rhs)
 {
   d_cells           = rhs.d_cells;
+  d_cellList        = rhs.d_cellList;
   d_nodes           = rhs.d_nodes;
   d_bcname          = rhs.d_bcname;
   d_bndtype         = rhs.d_bndtype;
@@ -73,6 +75,7 @@ BCGeomBase& BCGeomBase::operator=(const BCGeomBase& rhs)
     return *this;
 
   d_cells           = rhs.d_cells;
+  d_cellList        = rhs.d_cellList;
   d_nodes           = rhs.d_nodes;
   d_bcname          = rhs.d_bcname;
   d_bndtype         = rhs.d_bndtype;
@@ -97,6 +100,20 @@ void BCGeomBase::getCellFaceIterator(Iterator& b_ptr)
 
 //--------------------------------------------------------------------------------------------------
 
+const BCCellList& BCGeomBase::getCellFaceList()
+{
+  // tasks on the same patch may ask concurrently
+  static Uintah::MasterLock cellListLock;
+  std::lock_guard<Uintah::MasterLock> guard(cellListLock);
+
+  if (!d_cellList) {
+    d_cellList = std::make_shared<const BCCellList>(d_cells);
+  }
+  return *d_cellList;
+}
+
+//--------------------------------------------------------------------------------------------------
+
 void BCGeomBase::getNodeFaceIterator(Iterator& b_ptr)
 {
   b_ptr = d_nodes;
@@ -154,6 +171,7 @@ void BCGeomBase::determineIteratorLimits( const Patch::FaceType   face,
     }
     d_cells = list_cells;
   }
+  d_cellList.reset();
   if (vec_nodes.empty()) {
     d_nodes = GridIterator(IntVector(0,0,0),IntVector(0,0,0));
   }
@@ -268,6 +286,7 @@ void BCGeomBase::determineInteriorBndIteratorLimits( const Patch::FaceType   fac
     }
     d_cells = list_cells;
   }
+  d_cellList.reset();
 
 
   // Now for nodes...
@@ -25,6 +25,7 @@
 #ifndef UINTAH_GRID_BCGeomBase_H
 #define UINTAH_GRID_BCGeomBase_H
 
+#include <Core/Grid/BoundaryConditions/BCCellList.h>
 #include <Core/Grid/BoundaryConditions/BCData.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Geometry/Point.h>
@@ -32,6 +33,7 @@
 #include <Core/Grid/Variables/BaseIterator.h>
 #include <Core/Util/DebugStream.h>
 
+#include <memory>
 #include <vector>
 #include <typeinfo>
 #include <iterator>
@@ -153,6 +155,10 @@ namespace Uintah {
 
     void getCellFaceIterator(Iterator& b_ptr);
 
+    /// The cells of getCellFaceIterator() flattened for the BC kernels,
+    /// built on first use.
+    const BCCellList& getCellFaceList();
+
     void getNodeFaceIterator(Iterator& b_ptr);
 
     bool hasIterator(){return (d_cells.size() > 0);}
@@ -201,6 +207,7 @@ namespace Uintah {
   protected:
     Iterator          d_cells;
     Iterator          d_nodes;
+    std::shared_ptr<const BCCellList> d_cellList;   // reset whenever d_cells changes
     std::string       d_bcname;
     std::string       d_bndtype;
     ParticleBndSpec   d_particleBndSpec;
@@ -23,12 +23,15 @@
  */
 #ifndef Packages_Uintah_Core_Grid_BC_BCUtils_h
 #define Packages_Uintah_Core_Grid_BC_BCUtils_h
+#include <Core/Grid/BoundaryConditions/BCCellList.h>
 #include <Core/Grid/BoundaryConditions/BCDataArray.h>
 #include <Core/Grid/BoundaryConditions/BoundCond.h>
 #include <Core/Grid/Variables/CCVariable.h>
 #include <Core/Grid/Variables/CellIterator.h>
 #include <Core/Grid/Patch.h>
 
+#include <vector>
+
 namespace Uintah {
   
   void is_BC_specified(const ProblemSpecP& prob_spec, std::string variable, const MaterialSubset* matls);
@@ -245,6 +248,169 @@ namespace Uintah {
     int nCells = bound_ptr.size();
     return nCells;
   }
-  
+
+  //______________________________________________________________________
+  //  Kernels over the flattened boundary cells of a face child (see
+  //  BCCellList, BCDataArray::getCellFaceList).  Each takes nVars
+  //  variables so that variables sharing a face child and BC kind are
+  //  set in one pass over the cells.
+
+  /// Memory layout of a cell centered variable, for BCCellList::offsets().
+  template<class T>
+  BCCellList::Layout getBCLayout( CCVariable<T>& var )
+  {
+    BCCellList::Layout layout;
+    layout.offset = var.getWindow()->getOffset();
+    layout.size   = var.getWindow()->getData()->size();
+    return layout;
+  }
+
+  /// Linear distance between cell c and cell c + dir in a variable with
+  /// the given layout.
+  inline int getBCStride( const BCCellList::Layout& layout, const IntVector& dir )
+  {
+    return dir.x() + layout.size.x() * ( dir.y() + layout.size.y() * dir.z() );
+  }
+
+  /// Calls op(data, offset, v) for every boundary cell and variable v,
+  /// where data[offset] is the cell in variable v.  Returns the number of
+  /// boundary cells.
+  template<class T, class Op>
+  int applyBC_CC( CCVariable<T>* const vars[],
+                  const int nVars,
+                  const BCCellList& cells,
+                  Op op )
+  {
+    if( cells.empty() ) {
+      return 0;
+    }
+
+    std::vector<T*>                 data( nVars );
+    std::vector<BCCellList::Layout> layouts( nVars );
+    bool sameLayout = true;
+    for( int v = 0; v < nVars; v++ ) {
+      data[v]    = vars[v]->getPointer();
+      layouts[v] = getBCLayout( *vars[v] );
+      sameLayout = sameLayout && ( layouts[v] == layouts[0] );
+    }
+
+    if( cells.isBox() ) {
+      // whole face: rows along x are contiguous in every variable
+      const IntVector l = cells.low();
+      const IntVector h = cells.high();
+      for( int v = 0; v < nVars; v++ ) {
+        const BCCellList::Layout& layout = layouts[v];
+        cells.checkInside( layout );
+        T* const d = data[v];
+        for( int k = l.z(); k < h.z(); k++ ) {
+          for( int j = l.y(); j < h.y(); j++ ) {
+            const int row = getBCStride( layout, IntVector( l.x(), j, k ) - layout.offset );
+            for( int i = 0; i < h.x() - l.x(); i++ ) {
+              op( d, row + i, v );
+            }
+          }
+        }
+      }
+    }
+    else if( sameLayout ) {
+      const std::vector<int>& offsets = cells.offsets( layouts[0] );
+      const int nCells = offsets.size();
+      for( int n = 0; n < nCells; n++ ) {
+        const int o = offsets[n];
+        for( int v = 0; v < nVars; v++ ) {
+          op( data[v], o, v );
+        }
+      }
+    }
+    else {
+      for( int v = 0; v < nVars; v++ ) {
+        const std::vector<int>& offsets = cells.offsets( layouts[v] );
+        T* const d = data[v];
+        const int nCells = offsets.size();
+        for( int n = 0; n < nCells; n++ ) {
+          op( d, offsets[n], v );
+        }
+      }
+    }
+    return cells.size();
+  }
+
+  //______________________________________________________________________
+  //  Dirichlet BC:    CCVariables
+  template<class T>
+  int setDirichletBC_CC( CCVariable<T>* const vars[],
+                         const T values[],
+                         const int nVars,
+                         const BCCellList& cells )
+  {
+    return applyBC_CC( vars, nVars, cells,
+                       [values]( T* d, const int o, const int v ) { d[o] = values[v]; } );
+  }
+
+  template<class T>
+  int setDirichletBC_CC( CCVariable<T>& var,
+                         const BCCellList& cells,
+                         const T& value )
+  {
+    CCVariable<T>* vars[1] = { &var };
+    return setDirichletBC_CC( vars, &value, 1, cells );
+  }
+
+  //______________________________________________________________________
+  //  Neumann BC:  CCVariables, zero gradient (symmetry for scalars) when
+  //  the value is 0
+  template<class T>
+  int setNeumannBC_CC( const Patch* patch,
+                       const Patch::FaceType face,
+                       CCVariable<T>* const vars[],
+                       const T values[],
+                       const int nVars,
+                       const BCCellList& cells,
+                       const Vector& cell_dx )
+  {
+    const IntVector oneCell = patch->faceDirection(face);
+    const IntVector dir     = patch->getFaceAxes(face);
+    const double    dx      = cell_dx[dir[0]];
+
+    // offset of the interior neighbor of a boundary cell, per variable
+    std::vector<int> adj( nVars );
+    for( int v = 0; v < nVars; v++ ) {
+      adj[v] = -getBCStride( getBCLayout( *vars[v] ), oneCell );
+    }
+    const int* const a = adj.data();
+
+    bool allZero = true;
+    for( int v = 0; v < nVars; v++ ) {
+      allZero = allZero && ( values[v] == T(0) );
+    }
+
+    if( allZero ) {   //    Z E R O  N E U M A N N
+      return applyBC_CC( vars, nVars, cells,
+                         [a]( T* d, const int o, const int v ) { d[o] = d[o + a[v]]; } );
+    }
+                      //    N E U M A N N  First Order differencing
+    return applyBC_CC( vars, nVars, cells,
+                       [values, a, dx]( T* d, const int o, const int v ) {
+                         if( values[v] == T(0) ) {
+                           d[o] = d[o + a[v]];
+                         }
+                         else {
+                           d[o] = d[o + a[v]] - values[v] * dx;
+                         }
+                       } );
+  }
+
+  template<class T>
+  int setNeumannBC_CC( const Patch* patch,
+                       const Patch::FaceType face,
+                       CCVariable<T>& var,
+                       const BCCellList& cells,
+                       const T& value,
+                       const Vector& cell_dx )
+  {
+    CCVariable<T>* vars[1] = { &var };
+    return setNeumannBC_CC( patch, face, vars, &value, 1, cells, cell_dx );
+  }
+
 } // End namespace Uintah
 #endif
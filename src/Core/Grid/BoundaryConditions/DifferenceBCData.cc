@@ -152,6 +152,7 @@ void DifferenceBCData::determineIteratorLimits(Patch::FaceType face,
   right->getNodeFaceIterator(right_node);
   
   d_cells = DifferenceIterator(left_cell,right_cell);
+  d_cellList.reset();
   d_nodes = DifferenceIterator(left_node,right_node);
   
   
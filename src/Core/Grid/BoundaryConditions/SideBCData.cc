@@ -106,6 +106,7 @@ void SideBCData::determineIteratorLimits(Patch::FaceType face,
   IntVector l,h;
   patch->getFaceCells(face,0,l,h);
   d_cells = GridIterator(l,h);
+  d_cellList.reset();
 
 #if 0
   std::cout << "d_cells->begin() = " << d_cells->begin() << " d_cells->end() = " 
@@ -168,6 +168,7 @@ std::cout << " \n\n You weren't suppose to get in UnionBCData::determineIterator
   }
 
   d_cells = UnionIterator(cells);   
+  d_cellList.reset();
   d_nodes = UnionIterator(nodes); 
 
 
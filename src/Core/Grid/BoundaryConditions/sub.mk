@@ -35,6 +35,7 @@ SRCS     += \
 	$(SRCDIR)/BoundCondReader.cc \
 	$(SRCDIR)/BCData.cc \
 	$(SRCDIR)/BCDataArray.cc \
+	$(SRCDIR)/BCCellList.cc \
 	$(SRCDIR)/BCGeomBase.cc \
 	$(SRCDIR)/UnionBCData.cc \
 	$(SRCDIR)/DifferenceBCData.cc \
@@ -33,6 +33,15 @@
 
 #include <cstddef>
 
+#ifndef UINTAH_ENABLE_KOKKOS
+#include <Core/Parallel/LoopTileExecutor.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <vector>
+#endif
+
 namespace Uintah {
 
 //#if defined( UINTAH_ENABLE_KOKKOS )
@@ -171,6 +180,80 @@ void parallel_reduce_min( BlockRange const & r, const Functor & f, ReductionType
 
 #else
 
+namespace Impl {
+
+//______________________________________________________________________
+// Split a BlockRange into tiles of whole i-rows, about
+// LoopTileExecutor::getTileSize() cells each.  Rows are numbered j fastest,
+// so a tile is a contiguous piece of the (k,j) row space.
+class BlockRangeTiles
+{
+public:
+
+  explicit BlockRangeTiles( BlockRange const & r )
+    : m_ib( r.begin(0) ), m_ie( r.end(0) )
+    , m_jb( r.begin(1) ), m_nj( r.end(1) - r.begin(1) )
+    , m_kb( r.begin(2) ), m_nk( r.end(2) - r.begin(2) )
+  {
+    const int ni    = m_ie - m_ib;
+    const long rows = (long)m_nj * m_nk;
+    m_rows_per_tile = ( ni > 0 ) ? LoopTileExecutor::getTileSize() / ni : 1;
+    if ( m_rows_per_tile < 1 ) {
+      m_rows_per_tile = 1;
+    }
+    m_num_tiles = ( ni > 0 ) ? (int)( ( rows + m_rows_per_tile - 1 ) / m_rows_per_tile ) : 0;
+  }
+
+  int numTiles() const { return m_num_tiles; }
+
+  // f(i,j,k) for every cell of the tile
+  template <typename CellFunctor>
+  void forEachCell( int tile, const CellFunctor & f ) const
+  {
+    const long first = (long)tile * m_rows_per_tile;
+    const long last  = std::min( first + m_rows_per_tile, (long)m_nj * m_nk );
+    for ( long row = first; row < last; ++row ) {
+      const int j = m_jb + (int)( row % m_nj );
+      const int k = m_kb + (int)( row / m_nj );
+      for ( int i = m_ib; i < m_ie; ++i ) {
+        f( i, j, k );
+      }
+    }
+  }
+
+private:
+  int  m_ib, m_ie;
+  int  m_jb, m_nj;
+  int  m_kb, m_nk;
+  long m_rows_per_tile;
+  int  m_num_tiles;
+};
+
+//______________________________________________________________________
+// Identity and join of the reduction types used with parallel_reduce_sum.
+template <typename T>
+inline T reduction_identity() { return T(); }
+
+template <typename T>
+inline void reduction_join( T & a, const T & b ) { a += b; }
+
+inline void reduction_join( bool & a, const bool & b ) { a = a || b; }
+
+template <typename T, std::size_t N>
+inline void reduction_join( std::array<T, N> & a, const std::array<T, N> & b )
+{
+  for ( std::size_t n = 0; n < N; ++n ) {
+    reduction_join( a[n], b[n] );
+  }
+}
+
+} // namespace Impl
+
+//______________________________________________________________________
+// Without Kokkos the loops below are split into tiles that are executed on
+// the idle threads of the scheduler (see LoopTileExecutor).  With no idle
+// threads, or inside another parallel loop, they are plain serial loops.
+
 template <typename Functor>
 void parallel_for( BlockRange const & r, const Functor & f )
 {
@@ -178,6 +261,16 @@ void parallel_for( BlockRange const & r, const Functor & f )
   const int jb = r.begin(1); const int je = r.end(1);
   const int kb = r.begin(2); const int ke = r.end(2);
 
+  if ( LoopTileExecutor::useThreads() ) {
+    const Impl::BlockRangeTiles tiles( r );
+    if ( tiles.numTiles() > 1 ) {
+      LoopTileExecutor::run( tiles.numTiles(), [&]( int tile ) {
+        tiles.forEachCell( tile, f );
+      });
+      return;
+    }
+  }
+
   for (int k=kb; k<ke; ++k) {
   for (int j=jb; j<je; ++j) {
   for (int i=ib; i<ie; ++i) {
@@ -192,6 +285,16 @@ void parallel_for( BlockRange const & r, const Functor & f, const Option& op )
   const int jb = r.begin(1); const int je = r.end(1);
   const int kb = r.begin(2); const int ke = r.end(2);
 
+  if ( LoopTileExecutor::useThreads() ) {
+    const Impl::BlockRangeTiles tiles( r );
+    if ( tiles.numTiles() > 1 ) {
+      LoopTileExecutor::run( tiles.numTiles(), [&]( int tile ) {
+        tiles.forEachCell( tile, [&]( int i, int j, int k ) { f(op,i,j,k); } );
+      });
+      return;
+    }
+  }
+
   for (int k=kb; k<ke; ++k) {
   for (int j=jb; j<je; ++j) {
   for (int i=ib; i<ie; ++i) {
@@ -199,6 +302,9 @@ void parallel_for( BlockRange const & r, const Functor & f, const Option& op )
   }}}
 };
 
+// Each tile reduces into its own partial.  The partials are joined in tile
+// order when deterministic reductions are requested, otherwise as the tiles
+// finish.
 template <typename Functor, typename ReductionType>
 void parallel_reduce_sum( BlockRange const & r, const Functor & f, ReductionType & red  )
 {
@@ -206,6 +312,35 @@ void parallel_reduce_sum( BlockRange const & r, const Functor & f, ReductionType
   const int jb = r.begin(1); const int je = r.end(1);
   const int kb = r.begin(2); const int ke = r.end(2);
 
+  if ( LoopTileExecutor::useThreads() ) {
+    const Impl::BlockRangeTiles tiles( r );
+    const int nTiles = tiles.numTiles();
+    if ( nTiles > 1 ) {
+      if ( LoopTileExecutor::deterministicReductions() ) {
+        struct Partial { ReductionType value; };  // not std::vector<bool>
+        std::vector<Partial> partial( nTiles );
+        LoopTileExecutor::run( nTiles, [&]( int tile ) {
+          ReductionType tmp = Impl::reduction_identity<ReductionType>();
+          tiles.forEachCell( tile, [&]( int i, int j, int k ) { f(i,j,k,tmp); } );
+          partial[tile].value = tmp;
+        });
+        for ( int tile = 0; tile < nTiles; ++tile ) {
+          Impl::reduction_join( red, partial[tile].value );
+        }
+      }
+      else {
+        std::mutex join_lock;
+        LoopTileExecutor::run( nTiles, [&]( int tile ) {
+          ReductionType tmp = Impl::reduction_identity<ReductionType>();
+          tiles.forEachCell( tile, [&]( int i, int j, int k ) { f(i,j,k,tmp); } );
+          std::lock_guard<std::mutex> lock( join_lock );
+          Impl::reduction_join( red, tmp );
+        });
+      }
+      return;
+    }
+  }
+
   ReductionType tmp = red;
   for (int k=kb; k<ke; ++k) {
   for (int j=jb; j<je; ++j) {
@@ -215,6 +350,7 @@ void parallel_reduce_sum( BlockRange const & r, const Functor & f, ReductionType
   red = tmp;
 };
 
+// The minimum doesn't depend on the order, each tile starts from red.
 template <typename Functor, typename ReductionType>
 void parallel_reduce_min( BlockRange const & r, const Functor & f, ReductionType & red  )
 {
@@ -222,6 +358,24 @@ void parallel_reduce_min( BlockRange const & r, const Functor & f, ReductionType
   const int jb = r.begin(1); const int je = r.end(1);
   const int kb = r.begin(2); const int ke = r.end(2);
 
+  if ( LoopTileExecutor::useThreads() ) {
+    const Impl::BlockRangeTiles tiles( r );
+    const int nTiles = tiles.numTiles();
+    if ( nTiles > 1 ) {
+      const ReductionType init = red;
+      std::mutex join_lock;
+      LoopTileExecutor::run( nTiles, [&]( int tile ) {
+        ReductionType tmp = init;
+        tiles.forEachCell( tile, [&]( int i, int j, int k ) { f(i,j,k,tmp); } );
+        std::lock_guard<std::mutex> lock( join_lock );
+        if ( tmp < red ) {
+          red = tmp;
+        }
+      });
+      return;
+    }
+  }
+
   ReductionType tmp = red;
   for (int k=kb; k<ke; ++k) {
   for (int j=jb; j<je; ++j) {
@@ -28,11 +28,35 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Geometry/IntVector.h>
 #include <Core/Parallel/BufferInfo.h>
+#include <Core/Parallel/MasterLock.h>
 
+#include <map>
+#include <mutex>
 #include <string>
+#include <tuple>
 
 using namespace Uintah;
 
+namespace {
+
+  // Committed MPI datatypes of the ghost regions, see getMPIBuffer()
+  struct MPITypeKey {
+    MPI_Fint basetype;
+    int      nx, ny, nz;
+    int      stride_y, stride_z;
+
+    bool operator<( const MPITypeKey& o ) const
+    {
+      return std::tie( basetype, nx, ny, nz, stride_y, stride_z ) <
+             std::tie( o.basetype, o.nx, o.ny, o.nz, o.stride_y, o.stride_z );
+    }
+  };
+
+  const std::size_t                      MAX_CACHED_MPI_TYPES = 4096;
+  std::map<MPITypeKey, MPI_Datatype>     g_mpi_types;
+  Uintah::MasterLock                     g_mpi_type_lock{};
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 void
@@ -49,6 +73,34 @@ GridVariableBase::getMPIBuffer(       BufferInfo & buffer,
   char* startbuf = (char*)getBasePointer();
   startbuf += strides.x()*off.x()+strides.y()*off.y()+strides.z()*off.z();
   IntVector d = high-low;
+
+  //__________________________________
+  //  A region that is one piece of memory (whole x-y planes, or part of
+  //  a single x row or x-y plane) goes out as a plain array of the base type
+  const bool contiguousY = ( d.y() == 1 || d.x() == s.x() );
+  const bool contiguousZ = ( d.z() == 1 || ( d.x() == s.x() && d.y() == s.y() ) );
+  if ( contiguousY && contiguousZ ) {
+    MPI_Aint lb, extent;
+    Uintah::MPI::Type_get_extent( basetype, &lb, &extent );
+    if ( lb == 0 && extent == strides.x() ) {
+      buffer.add( startbuf, d.x() * d.y() * d.z(), basetype, false );
+      return;
+    }
+  }
+
+  //__________________________________
+  //  Otherwise a 3D hvector, committed once per base type, region shape
+  //  and memory layout and kept for the following timesteps
+  MPITypeKey key{ MPI_Type_c2f(basetype), d.x(), d.y(), d.z(), strides.y(), strides.z() };
+  {
+    std::lock_guard<Uintah::MasterLock> guard( g_mpi_type_lock );
+    auto iter = g_mpi_types.find( key );
+    if ( iter != g_mpi_types.end() ) {
+      buffer.add( startbuf, 1, iter->second, false );
+      return;
+    }
+  }
+
   MPI_Datatype type1d;
   Uintah::MPI::Type_create_hvector(d.x(), 1, strides.x(), basetype, &type1d);
 
@@ -62,6 +114,19 @@ GridVariableBase::getMPIBuffer(       BufferInfo & buffer,
   Uintah::MPI::Type_free(   &type2d );
   Uintah::MPI::Type_commit( &type3d );
 
+  {
+    std::lock_guard<Uintah::MasterLock> guard( g_mpi_type_lock );
+    if ( g_mpi_types.size() < MAX_CACHED_MPI_TYPES ) {
+      auto result = g_mpi_types.insert( std::make_pair( key, type3d ) );
+      if ( !result.second ) {
+        // another thread cached the same shape first
+        Uintah::MPI::Type_free( &type3d );
+      }
+      buffer.add( startbuf, 1, result.first->second, false );
+      return;
+    }
+  }
+
   buffer.add( startbuf, 1, type3d, true );
 }
 
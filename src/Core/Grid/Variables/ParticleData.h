@@ -26,12 +26,33 @@
 #define UINTAH_HOMEBREW_PARTICLEDATA_H
 
 #include <Core/Util/RefCounted.h>
+#include <Core/Grid/Variables/ParticleDataPool.h>
 #include <Core/Grid/Variables/ParticleSubset.h> // For particleIndex
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
 namespace Uintah {
 
 template<class T> class ParticleVariable; // Forward Declaration
 
+// Bulk copy of particle values
+template<class T>
+inline void copyParticleValues(T* dst, const T* src, particleIndex n, std::true_type /*trivially copyable*/)
+{
+  if(n > 0)
+    std::memcpy(dst, src, n*sizeof(T));
+}
+
+template<class T>
+inline void copyParticleValues(T* dst, const T* src, particleIndex n, std::false_type)
+{
+  for(particleIndex i = 0; i < n; i++)
+    dst[i] = src[i];
+}
+
 /**************************************
 
 CLASS
@@ -65,57 +86,153 @@ WARNING
       virtual ~ParticleData();
 
       //////////
-      // Insert Documentation Here:
-      void resize(int newSize) {
-        T* newdata = scinew T[newSize];
-        if(data){
-          int smaller = ((newSize < size ) ? newSize:size);
-          for(int i = 0; i < smaller; i++)
-            newdata[i] = data[i];
-          delete[] data;
-        }
-        data = newdata;
-        size = newSize;
-      }
+      // Change the number of particles, keeping the first min(size, newSize)
+      // values.  The storage only moves when newSize exceeds the capacity,
+      // which then grows by at least half, or when it drops well below it.
+      void resize(int newSize);
+
+      //////////
+      // Change the number of particles, discarding the values.  All of
+      // them are default-constructed, as in new storage, but the storage
+      // is kept under the same conditions as with resize().
+      void reallocate(int newSize);
+
+      //////////
+      // Number of particles that fit without moving the storage
+      particleIndex capacity() const { return d_capacity; }
 
    private:
       ParticleData(const ParticleData<T>&);
       ParticleData<T>& operator=(const ParticleData<T>&);
       friend class ParticleVariable<T>;
-      
+
+      // Storage for at least n particles from the ParticleDataPool
+      void allocateStorage(particleIndex n);
+      void releaseStorage();
+
+      // Copy n values, a memcpy for trivially copyable types
+      static void copyValues(T* dst, const T* src, particleIndex n);
+
       //////////
       // Insert Documentation Here:
       T* data;
       particleIndex size;
+      particleIndex d_capacity;
+      size_t d_bytes;
    };
    
    template<class T>
       ParticleData<T>::ParticleData()
+        : data(0), size(0), d_capacity(0), d_bytes(0)
       {
-        data=0;
       }
    
    template<class T>
      ParticleData<T>::ParticleData(particleIndex size)
-     : size(size)
+       : data(0), size(size), d_capacity(0), d_bytes(0)
       {
-        data = scinew T[size];
+        allocateStorage(size);
       }
       
    template<class T>
       ParticleData<T>::~ParticleData()
       {
-        if(data)
-          delete[] data;
+        releaseStorage();
       }
 
+   template<class T>
+     void ParticleData<T>::allocateStorage(particleIndex n)
+     {
+       d_bytes = (n > 0 ? n : 1)*sizeof(T);
+       data = static_cast<T*>(ParticleDataPool::allocate(d_bytes));
+       d_capacity = d_bytes/sizeof(T);
+       // default-initialize, as new T[n] would
+       for(particleIndex i = 0; i < d_capacity; i++)
+         new (&data[i]) T;
+     }
+
+   template<class T>
+     void ParticleData<T>::releaseStorage()
+     {
+       if(data){
+         for(particleIndex i = 0; i < d_capacity; i++)
+           data[i].~T();
+         ParticleDataPool::release(data, d_bytes);
+       }
+       data = 0;
+       d_capacity = 0;
+       d_bytes = 0;
+     }
+
+   template<class T>
+     void ParticleData<T>::copyValues(T* dst, const T* src, particleIndex n)
+     {
+       copyParticleValues(dst, src, n, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+     }
+
+   template<class T>
+     void ParticleData<T>::resize(int newSize)
+     {
+       // Shrink the storage only for large drops so that a population that
+       // fluctuates around a size doesn't keep reallocating.
+       bool grow   = newSize > d_capacity;
+       bool shrink = d_capacity > 1024 && newSize < d_capacity/4;
+       if(data && !grow && !shrink){
+         // the particles exposed again start out as in fresh storage
+         for(particleIndex i = size; i < newSize; i++){
+           data[i].~T();
+           new (&data[i]) T;
+         }
+         size = newSize;
+         return;
+       }
+
+       T* olddata = data;
+       particleIndex oldsize = size;
+       particleIndex oldcapacity = d_capacity;
+       size_t oldbytes = d_bytes;
+
+       particleIndex request = newSize;
+       if(grow && olddata)
+         request = std::max<particleIndex>(newSize, oldcapacity + oldcapacity/2);
+       allocateStorage(request);
+
+       if(olddata){
+         copyValues(data, olddata, std::min<particleIndex>(oldsize, newSize));
+         for(particleIndex i = 0; i < oldcapacity; i++)
+           olddata[i].~T();
+         ParticleDataPool::release(olddata, oldbytes);
+       }
+       size = newSize;
+     }
+
+   template<class T>
+     void ParticleData<T>::reallocate(int newSize)
+     {
+       bool grow   = newSize > d_capacity;
+       bool shrink = d_capacity > 1024 && newSize < d_capacity/4;
+       if(data && !grow && !shrink){
+         for(particleIndex i = 0; i < newSize; i++){
+           data[i].~T();
+           new (&data[i]) T;
+         }
+       } else {
+         particleIndex request = newSize;
+         if(grow && data)
+           request = std::max<particleIndex>(newSize, d_capacity + d_capacity/2);
+         releaseStorage();
+         allocateStorage(request);
+       }
+       size = newSize;
+     }
+
    template<class T>
      ParticleData<T>& ParticleData<T>::operator=(const ParticleData<T>& copy)
      {
-       for(particleIndex i=0;i<size;i++)
-         data[i] = copy.data[i];
+       copyValues(data, copy.data, size);
        return *this;
      }
+
 } // End namespace Uintah
    
 #endif
@@ -0,0 +1,166 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Grid/Variables/ParticleDataPool.h>
+
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace Uintah;
+
+namespace {
+
+  struct PoolState {
+    std::mutex                              lock;
+    std::map< size_t, std::vector<void*> >  free_blocks;   // size class -> blocks
+    size_t                                  cached_bytes     = 0;
+    size_t                                  max_cached_bytes = size_t(512) << 20;
+  };
+
+  // Never destroyed: particle variables held by static objects may still
+  // be released during static destruction.
+  PoolState& pool()
+  {
+    static PoolState* state = new PoolState;
+    return *state;
+  }
+
+}
+
+//______________________________________________________________________
+//
+size_t
+ParticleDataPool::sizeClass( size_t bytes )
+{
+  const size_t minBytes = 64;
+  if( bytes <= minBytes ) {
+    return minBytes;
+  }
+
+  // four classes between consecutive powers of two, at most 25% waste
+  size_t pow2 = minBytes;
+  while( pow2*2 <= bytes ) {
+    pow2 *= 2;
+  }
+  const size_t step = pow2/4;
+  return ( (bytes + step - 1)/step )*step;
+}
+
+//______________________________________________________________________
+//
+void*
+ParticleDataPool::allocate( size_t & bytes )
+{
+  bytes = sizeClass( bytes );
+  {
+    PoolState& p = pool();
+    std::lock_guard<std::mutex> lock( p.lock );
+    auto iter = p.free_blocks.find( bytes );
+    if( iter != p.free_blocks.end() && !iter->second.empty() ) {
+      void* ptr = iter->second.back();
+      iter->second.pop_back();
+      p.cached_bytes -= bytes;
+      return ptr;
+    }
+  }
+  return ::operator new( bytes );
+}
+
+//______________________________________________________________________
+//
+void
+ParticleDataPool::release( void * ptr, size_t bytes )
+{
+  if( ptr == nullptr ) {
+    return;
+  }
+  {
+    PoolState& p = pool();
+    std::lock_guard<std::mutex> lock( p.lock );
+    if( p.cached_bytes + bytes <= p.max_cached_bytes ) {
+      p.free_blocks[bytes].push_back( ptr );
+      p.cached_bytes += bytes;
+      return;
+    }
+  }
+  ::operator delete( ptr );
+}
+
+//______________________________________________________________________
+//
+void
+ParticleDataPool::clear()
+{
+  std::map< size_t, std::vector<void*> > blocks;
+  {
+    PoolState& p = pool();
+    std::lock_guard<std::mutex> lock( p.lock );
+    blocks.swap( p.free_blocks );
+    p.cached_bytes = 0;
+  }
+  for( auto & entry : blocks ) {
+    for( void* ptr : entry.second ) {
+      ::operator delete( ptr );
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+ParticleDataPool::setMaxCachedBytes( size_t bytes )
+{
+  {
+    PoolState& p = pool();
+    std::lock_guard<std::mutex> lock( p.lock );
+    p.max_cached_bytes = bytes;
+    if( p.cached_bytes <= p.max_cached_bytes ) {
+      return;
+    }
+  }
+  clear();
+}
+
+//______________________________________________________________________
+//
+size_t
+ParticleDataPool::getMaxCachedBytes()
+{
+  PoolState& p = pool();
+  std::lock_guard<std::mutex> lock( p.lock );
+  return p.max_cached_bytes;
+}
+
+//______________________________________________________________________
+//
+size_t
+ParticleDataPool::getCachedBytes()
+{
+  PoolState& p = pool();
+  std::lock_guard<std::mutex> lock( p.lock );
+  return p.cached_bytes;
+}
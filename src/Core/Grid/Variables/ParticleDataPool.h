@@ -0,0 +1,90 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef UINTAH_HOMEBREW_PARTICLEDATAPOOL_H
+#define UINTAH_HOMEBREW_PARTICLEDATAPOOL_H
+
+#include <cstddef>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   ParticleDataPool
+
+GENERAL INFORMATION
+
+   ParticleDataPool.h
+
+KEYWORDS
+   ParticleData, ParticleVariable, memory pool
+
+DESCRIPTION
+   Recycles the storage of particle variables.  Requests are rounded up
+   to a size class (four classes per power of two) and freed blocks are
+   kept on a free list per class, so the variables released when a
+   timestep's old DataWarehouse is scrubbed feed the allocations of the
+   next timestep instead of going back to the system allocator.  Every
+   variable of a patch/material has the same number of particles, so the
+   variables of a subset land in the same few classes and are recycled
+   together.
+
+   At most getMaxCachedBytes() bytes are kept on the free lists; blocks
+   beyond that are returned to the system.
+
+WARNING
+   Thread safe.
+
+****************************************/
+
+class ParticleDataPool {
+
+public:
+
+  // Returns a block of at least 'bytes' bytes, 'bytes' is set to the
+  // usable size of the block.
+  static void* allocate( size_t & bytes );
+
+  // Return a block obtained from allocate(); 'bytes' is the usable size.
+  static void release( void * ptr, size_t bytes );
+
+  // Free every cached block.
+  static void clear();
+
+  static void   setMaxCachedBytes( size_t bytes );
+  static size_t getMaxCachedBytes();
+  static size_t getCachedBytes();
+
+  // Size class (usable size) a request of 'bytes' bytes is rounded up to.
+  static size_t sizeClass( size_t bytes );
+
+private:
+  ParticleDataPool();
+};
+
+} // End namespace Uintah
+
+#endif
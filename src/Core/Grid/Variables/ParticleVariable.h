@@ -286,15 +286,21 @@ private:
   template<class T>
   void ParticleVariable<T>::allocate(ParticleSubset* pset)
   {
-    if (d_pdata && d_pdata->removeReference()) {
-      delete d_pdata;
-    }
     if (d_pset && d_pset->removeReference()) {
       delete d_pset;
     }
-
     d_pset = pset;
     d_pset->addReference();
+
+    // Reuse the storage if no other variable shares it
+    if (d_pdata && d_pdata->getReferenceCount() == 1) {
+      d_pdata->reallocate(pset->numParticles());
+      return;
+    }
+
+    if (d_pdata && d_pdata->removeReference()) {
+      delete d_pdata;
+    }
     d_pdata = scinew ParticleData<T>(pset->numParticles());
     d_pdata->addReference();
   }
@@ -400,14 +406,19 @@ template<class T>
                               const std::vector<ParticleVariableBase*> &srcs,
                               particleIndex extra)
   {
-    if(d_pdata && d_pdata->removeReference())
-      delete d_pdata;
     if(d_pset && d_pset->removeReference())
       delete d_pset;
     d_pset = pset;
     pset->addReference();
-    d_pdata=scinew ParticleData<T>(pset->numParticles());
-    d_pdata->addReference();
+    if(d_pdata && d_pdata->getReferenceCount() == 1){
+      d_pdata->reallocate(pset->numParticles());
+    }
+    else {
+      if(d_pdata && d_pdata->removeReference())
+        delete d_pdata;
+      d_pdata=scinew ParticleData<T>(pset->numParticles());
+      d_pdata->addReference();
+    }
     ASSERTEQ(subsets.size(), srcs.size());
     ParticleSubset::iterator dstiter = pset->begin();
     for(int i=0;i<(int)subsets.size();i++){
@@ -0,0 +1,225 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef UINTAH_HOMEBREW_RowRange_H
+#define UINTAH_HOMEBREW_RowRange_H
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/Array3Window.h>
+#include <Core/Grid/Variables/CellIterator.h>
+#include <Core/Grid/Variables/NodeIterator.h>
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Util/Assert.h>
+
+#include <algorithm>
+#include <type_traits>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   RowRange, RowAccessor
+
+GENERAL INFORMATION
+
+   RowRange.h
+
+KEYWORDS
+   CellIterator, NodeIterator, rows, vectorization
+
+DESCRIPTION
+   Iteration over a box of cells or nodes one x-row at a time, without
+   the per-cell IntVector indexing of CellIterator/NodeIterator.
+
+   A RowRange is the box, a RowAccessor is a base pointer and the y and
+   z strides of one grid variable.  for_each_row() calls f(j, k, ib, ie)
+   for every row of the box and accessor.row(j,k)[i] is cell (i,j,k) of
+   the variable, so the inner loop over i is a unit stride loop the
+   compiler can vectorize:
+
+     RowAccessor<const double> rho( rho_CC );
+     RowAccessor<double>       mass( mass_L );
+     for_each_row( RowRange( patch->getCellIterator() ),
+                   [&]( int j, int k, int ib, int ie ) {
+       const double* r = rho.row(j,k);
+       double*       m = mass.row(j,k);
+       for( int i = ib; i < ie; i++ ) {
+         m[i] = r[i] * vol;
+       }
+     });
+
+   parallel_for_rows() is the same loop split into tiles of whole rows
+   that run on the idle scheduler threads (see LoopTileExecutor).
+
+WARNING
+   The rows must lie inside the data of every accessed variable; this is
+   only checked with SCI_ASSERTION_LEVEL >= 3.
+
+****************************************/
+
+class RowRange {
+  public:
+
+    RowRange( const IntVector& low, const IntVector& high )
+      : d_low(low), d_high(high) {}
+
+    explicit RowRange( const CellIterator& iter )
+      : d_low( iter.begin() ), d_high( iter.end() ) {}
+
+    explicit RowRange( const NodeIterator& iter )
+      : d_low( iter.begin() ), d_high( iter.end() ) {}
+
+    inline IntVector low()  const { return d_low; }
+    inline IntVector high() const { return d_high; }
+
+    inline bool empty() const {
+      return d_high.x() <= d_low.x() || d_high.y() <= d_low.y() || d_high.z() <= d_low.z();
+    }
+
+    //////////
+    // Number of x-rows and of cells in the range
+    inline long numRows() const {
+      return empty() ? 0 : (long) ( d_high.y() - d_low.y() ) * ( d_high.z() - d_low.z() );
+    }
+
+    inline long size() const {
+      return numRows() * ( empty() ? 0 : d_high.x() - d_low.x() );
+    }
+
+  private:
+    IntVector d_low;
+    IntVector d_high;
+};
+
+//______________________________________________________________________
+//
+template<class T>
+class RowAccessor {
+  public:
+
+    typedef typename std::remove_const<T>::type value_type;
+
+    //////////
+    // Bind to a grid variable: CC/NC/SFC variables and their const
+    // versions.  T must be const for the const variables.
+    template<class Var>
+    explicit RowAccessor( Var& var )
+    {
+      const Array3Window<value_type>* window = var.getWindow();
+      const IntVector offset = window->getOffset();
+      const IntVector size   = window->getData()->size();
+
+      d_sy   = size.x();
+      d_sz   = (long) size.x() * size.y();
+      d_base = var.getPointer() - ( offset.x() + offset.y() * d_sy + offset.z() * d_sz );
+#if SCI_ASSERTION_LEVEL >= 3
+      d_low  = window->getLowIndex();
+      d_high = window->getHighIndex();
+#endif
+    }
+
+    //////////
+    // Pointer p to row (j,k) with p[i] the value at (i,j,k)
+    inline T* row( int j, int k ) const {
+      ASSERTL3( j >= d_low.y() && j < d_high.y() && k >= d_low.z() && k < d_high.z() );
+      return d_base + ( j * d_sy + k * d_sz );
+    }
+
+    inline T& operator()( int i, int j, int k ) const {
+      ASSERTL3( i >= d_low.x() && i < d_high.x() );
+      return row(j,k)[i];
+    }
+
+    //////////
+    // Distance between (i,j,k) and (i,j,k) + dir, in elements
+    inline long stride( const IntVector& dir ) const {
+      return dir.x() + dir.y() * d_sy + dir.z() * d_sz;
+    }
+
+  private:
+    T*   d_base;
+    long d_sy;
+    long d_sz;
+#if SCI_ASSERTION_LEVEL >= 3
+    IntVector d_low;
+    IntVector d_high;
+#endif
+};
+
+//______________________________________________________________________
+//  f(j, k, ib, ie) for every x-row of the range, in memory order
+template<class Functor>
+inline void for_each_row( const RowRange& range, const Functor& f )
+{
+  if( range.empty() ) {
+    return;
+  }
+
+  const IntVector l = range.low();
+  const IntVector h = range.high();
+  for( int k = l.z(); k < h.z(); k++ ) {
+    for( int j = l.y(); j < h.y(); j++ ) {
+      f( j, k, l.x(), h.x() );
+    }
+  }
+}
+
+//______________________________________________________________________
+//  for_each_row() split into tiles of about LoopTileExecutor::getTileSize()
+//  cells.  Rows must be independent of each other.
+template<class Functor>
+inline void parallel_for_rows( const RowRange& range, const Functor& f )
+{
+  const long nRows = range.numRows();
+  if( nRows == 0 ) {
+    return;
+  }
+
+  const IntVector l  = range.low();
+  const IntVector h  = range.high();
+  const int       nj = h.y() - l.y();
+
+  if( LoopTileExecutor::useThreads() ) {
+    const long rowsPerTile = std::max( 1L, (long) LoopTileExecutor::getTileSize() / ( h.x() - l.x() ) );
+    const int  nTiles      = (int) ( ( nRows + rowsPerTile - 1 ) / rowsPerTile );
+
+    if( nTiles > 1 ) {
+      LoopTileExecutor::run( nTiles, [&]( int tile ) {
+        const long first = tile * rowsPerTile;
+        const long last  = std::min( first + rowsPerTile, nRows );
+        for( long r = first; r < last; r++ ) {
+          f( l.y() + (int) ( r % nj ), l.z() + (int) ( r / nj ), l.x(), h.x() );
+        }
+      });
+      return;
+    }
+  }
+
+  for_each_row( range, f );
+}
+
+} // End namespace Uintah
+
+#endif
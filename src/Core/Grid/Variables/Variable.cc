@@ -249,12 +249,17 @@ Variable::read(       InputContext & ic
     std::string bufferStr;
     std::string* uncompressedData = &data;
 
-    data.resize(datasize);
-    ssize_t s = ::read(ic.fd, const_cast<char*>(data.c_str()), datasize);
+    if (ic.buffer) {
+      data.assign(ic.buffer + (ic.cur - ic.bufferStart), datasize);
+    }
+    else {
+      data.resize(datasize);
+      ssize_t s = ::read(ic.fd, const_cast<char*>(data.c_str()), datasize);
 
-    if (s != datasize) {
-      std::cerr << "Error reading file: " << ic.filename << ", errno=" << errno << '\n';
-      SCI_THROW(ErrnoException("Variable::read (read call)", errno, __FILE__, __LINE__));
+      if (s != datasize) {
+        std::cerr << "Error reading file: " << ic.filename << ", errno=" << errno << '\n';
+        SCI_THROW(ErrnoException("Variable::read (read call)", errno, __FILE__, __LINE__));
+      }
     }
 
     ic.cur += datasize;
@@ -43,6 +43,7 @@ SRCS += \
         $(SRCDIR)/ComputeSet_special.cc         \
         $(SRCDIR)/GridVariableBase.cc           \
         $(SRCDIR)/LocallyComputedPatchVarMap.cc \
+        $(SRCDIR)/ParticleDataPool.cc           \
         $(SRCDIR)/ParticleSubset.cc             \
         $(SRCDIR)/ParticleVariableBase.cc       \
         $(SRCDIR)/ParticleVariable_special.cc   \
@@ -34,6 +34,7 @@
  *
  */
 
+#include <Core/Malloc/AllocatorOwners.h>
 #include <Core/Parallel/MasterLock.h>
 
 #include <sci_defs/malloc_defs.h>
@@ -52,6 +53,7 @@ struct Sentinel {
 };
 
 struct AllocBin;
+struct ThreadCache;
 
 
 struct Tag {
@@ -64,6 +66,7 @@ struct Tag {
   Tag        * prev;
   OSHunk     * hunk;
   size_t       reqsize;
+  int          owner[NumAllocOwnerKinds];
 };
 
 
@@ -107,9 +110,27 @@ struct Allocator {
 
   size_t obj_maxsize( Tag* );
 
+  // thread caching front end, see Allocator.cc
+  bool use_thread_cache( size_t size );
+
+  Tag* cache_alloc( AllocBin*, size_t size );
+
+  void cache_free( AllocBin*, Tag* );
+
+  void refill_cache( ThreadCache&, AllocBin*, int index );
+
+  void drain_cache( ThreadCache&, AllocBin*, int index, int n );
+
+  void merge_cache_stats( ThreadCache& );
+
+  void charge_owners( Tag* );
+
+  void mark_free( Tag* );
+
 
   int      strict;
   int      lazy;
+  int      thread_cache;
   FILE   * stats_out;
   char   * stats_out_filename;
   OSHunk * hunks;
@@ -116,12 +116,38 @@ namespace Uintah {
 // Objects bigger than this can't be allocated
 #define MAX_ALLOCSIZE        (1024*1024*1024)
 
+// Thread caching (MALLOC_THREAD_CACHE): objects up to TCACHE_MAXSIZE are kept in
+// per-thread free lists of up to TCACHE_BIN_BYTES each, and move between the
+// threads and the shared bins in batches, so most allocations skip the lock.
+#define TCACHE_MAXSIZE       (32*1024)
+#define TCACHE_BIN_BYTES     (256*1024)
+#define NTCACHE_BINS         (NSMALL_BINS + MEDIUM_BIN(TCACHE_MAXSIZE) + 1)
+
 static bool do_shutdown          = false;
 static int  mallocStatsAppendNum = -1;
 
 Allocator* default_allocator = nullptr;
 
 
+//______________________________________________________________________________
+// Objects handed out from a thread cache are not on their bin's inuse list
+// (they are marked with prev == self), and the allocation statistics of a
+// thread are merged into the allocator whenever its cache touches the bins.
+struct ThreadCache {
+  ~ThreadCache();
+
+  Tag    * free[NTCACHE_BINS];
+  int      count[NTCACHE_BINS];
+
+  size_t   nalloc;
+  size_t   sizealloc;
+  size_t   nfree;
+  size_t   sizefree;
+};
+
+static thread_local ThreadCache t_thread_cache;
+
+
 //______________________________________________________________________________
 //
 void
@@ -262,6 +288,11 @@ shutdown()
     }
     a->unlock();
 
+    if (AllocatorTrackingOwners()) {
+      fprintf(a->stats_out, "\n");
+      AllocatorPrintOwnerStats(a->stats_out);
+    }
+
     do_shutdown = true;
   }
 }
@@ -440,6 +471,18 @@ MakeAllocator()
     a->lazy = 0;
   }
 
+  if (getenv("MALLOC_THREAD_CACHE")) {
+    a->thread_cache = 1;
+  }
+  else {
+    a->thread_cache = 0;
+  }
+
+  // Charge allocations to the variable/task that made them
+  if (getenv("MALLOC_OWNERS")) {
+    AllocatorSetTrackingOwners(true);
+  }
+
   // Initialize stats...
   a->nmmap = 1;
   a->sizemmap = size + sizeof(OSHunk);
@@ -522,49 +565,60 @@ Allocator::alloc( size_t size
 #endif
 
   Tag* obj = nullptr;
-  lock();
-  {
-    if (!obj_bin->free) {
-      fill_bin(obj_bin);
-    }
-
-    obj = obj_bin->free;
-    obj_bin->free = obj->next;
-    if (obj_bin->free) {
-      obj_bin->free->prev = nullptr;
-    }
-
-    // Tell the hunk that we are using this one...
-    obj->hunk->ninuse++;
+  if (use_thread_cache(size)) {
+    obj = cache_alloc(obj_bin, size);
     obj->tag = tag;
 #ifdef USE_TAG_LINENUM
     obj->linenum = linenum;
 #endif
-    obj->next = obj_bin->inuse;
-    if (obj_bin->inuse) {
-      obj_bin->inuse->prev = obj;
-    }
+  }
+  else {
+    lock();
+    {
+      if (!obj_bin->free) {
+        fill_bin(obj_bin);
+      }
 
-    obj->prev = nullptr;
-    obj_bin->inuse = obj;
-    obj->reqsize = size;
-    obj_bin->ninuse++;
+      obj = obj_bin->free;
+      obj_bin->free = obj->next;
+      if (obj_bin->free) {
+        obj_bin->free->prev = nullptr;
+      }
 
-    nalloc++;
-    sizealloc += size;
-    size_t bytes_inuse = sizealloc - sizefree;
+      // Tell the hunk that we are using this one...
+      obj->hunk->ninuse++;
+      obj->tag = tag;
+#ifdef USE_TAG_LINENUM
+      obj->linenum = linenum;
+#endif
+      obj->next = obj_bin->inuse;
+      if (obj_bin->inuse) {
+        obj_bin->inuse->prev = obj;
+      }
 
-    if (sizealloc < sizefree) {
-      bytes_inuse = 0;
-    }
+      obj->prev = nullptr;
+      obj_bin->inuse = obj;
+      obj->reqsize = size;
+      obj_bin->ninuse++;
 
-    if (bytes_inuse > highwater_alloc) {
-      highwater_alloc = bytes_inuse;
-    }
+      nalloc++;
+      sizealloc += size;
+      size_t bytes_inuse = sizealloc - sizefree;
+
+      if (sizealloc < sizefree) {
+        bytes_inuse = 0;
+      }
 
-    obj_bin->nalloc++;
+      if (bytes_inuse > highwater_alloc) {
+        highwater_alloc = bytes_inuse;
+      }
+
+      obj_bin->nalloc++;
+    }
+    unlock(); // Safe to unlock now
   }
-  unlock(); // Safe to unlock now
+
+  charge_owners(obj);
 
   // Make sure that it is still cleared out...
   if (!lazy) {
@@ -735,6 +789,8 @@ Allocator::alloc_big(       size_t   size
   // Safe to unlock now
   unlock();
 
+  charge_owners(obj);
+
   // Make sure that it is still cleared out...
   if (!lazy) {
     audit(obj, OBJFREE);
@@ -787,6 +843,7 @@ Allocator::realloc( void* dobj, size_t newsize )
   // Check the simple case first...
   AllocBin* oldbin = get_bin(oldobj->bin->maxsize);
   if (newsize <= obj_maxsize(oldobj) && newsize >= oldbin->minsize) {
+    AllocatorChargeOwners(oldobj->owner, static_cast<long>(newsize) - static_cast<long>(oldobj->reqsize));
     oldobj->reqsize = newsize;
 
     // Setup the new sentinels...
@@ -885,8 +942,16 @@ void Allocator::free( void* dobj )
     audit(obj, OBJFREEING);
   }
 
+  AllocatorChargeOwners(obj->owner, -static_cast<long>(obj->reqsize));
+
   AllocBin* obj_bin = get_bin(obj->bin->maxsize);
 
+  if (obj->prev == obj) {
+    // came from a thread cache
+    cache_free(obj_bin, obj);
+    return;
+  }
+
   lock();
   nfree++;
   sizefree += obj->reqsize;
@@ -944,6 +1009,210 @@ void Allocator::free( void* dobj )
   unlock();
 }
 
+//______________________________________________________________________________
+//
+inline
+bool
+Allocator::use_thread_cache( size_t size )
+{
+  // Other allocators made with MakeAllocator() share the thread_local cache otherwise
+  return thread_cache && size <= TCACHE_MAXSIZE && this == default_allocator;
+}
+
+//______________________________________________________________________________
+//
+Tag*
+Allocator::cache_alloc( AllocBin* bin, size_t size )
+{
+  ThreadCache& tc = t_thread_cache;
+  const int index = (int)(bin - small_bins);
+
+  if (!tc.free[index]) {
+    refill_cache(tc, bin, index);
+  }
+
+  Tag* obj = tc.free[index];
+  tc.free[index] = obj->next;
+  tc.count[index]--;
+
+  obj->next = nullptr;
+  obj->prev = obj;
+  obj->reqsize = size;
+
+  tc.nalloc++;
+  tc.sizealloc += size;
+
+  return obj;
+}
+
+//______________________________________________________________________________
+//
+void
+Allocator::cache_free( AllocBin* bin, Tag* obj )
+{
+  ThreadCache& tc = t_thread_cache;
+  const int index = (int)(bin - small_bins);
+
+  tc.nfree++;
+  tc.sizefree += obj->reqsize;
+
+  mark_free(obj);
+
+  obj->next = tc.free[index];
+  tc.free[index] = obj;
+  tc.count[index]++;
+
+  const int max_cached = (int)(TCACHE_BIN_BYTES / bin->maxsize) + 2;
+  if (tc.count[index] > max_cached) {
+    drain_cache(tc, bin, index, max_cached / 2);
+  }
+}
+
+//______________________________________________________________________________
+// Moves a batch of free objects from the bin to the thread's cache.  They stay
+// counted as in use by the bin until they are drained back.
+void
+Allocator::refill_cache( ThreadCache& tc, AllocBin* bin, int index )
+{
+  const int batch = (int)(TCACHE_BIN_BYTES / bin->maxsize) / 2 + 1;
+
+  lock();
+  {
+    merge_cache_stats(tc);
+
+    for (int i = 0; i < batch; i++) {
+      if (!bin->free) {
+        fill_bin(bin);
+      }
+
+      Tag* obj = bin->free;
+      bin->free = obj->next;
+      if (bin->free) {
+        bin->free->prev = nullptr;
+      }
+
+      obj->hunk->ninuse++;
+      bin->ninuse++;
+      bin->nalloc++;
+
+      obj->next = tc.free[index];
+      tc.free[index] = obj;
+      tc.count[index]++;
+    }
+  }
+  unlock();
+}
+
+//______________________________________________________________________________
+//
+void
+Allocator::drain_cache( ThreadCache& tc, AllocBin* bin, int index, int n )
+{
+  lock();
+  {
+    merge_cache_stats(tc);
+
+    for (int i = 0; i < n && tc.free[index]; i++) {
+      Tag* obj = tc.free[index];
+      tc.free[index] = obj->next;
+      tc.count[index]--;
+
+      obj->hunk->ninuse--;
+      bin->ninuse--;
+      bin->nfree++;
+
+      obj->next = bin->free;
+      if (bin->free) {
+        bin->free->prev = obj;
+      }
+      obj->prev = nullptr;
+      bin->free = obj;
+    }
+  }
+  unlock();
+}
+
+//______________________________________________________________________________
+// Called with the lock held
+void
+Allocator::merge_cache_stats( ThreadCache& tc )
+{
+  nalloc    += tc.nalloc;
+  sizealloc += tc.sizealloc;
+  nfree     += tc.nfree;
+  sizefree  += tc.sizefree;
+
+  tc.nalloc = tc.sizealloc = tc.nfree = tc.sizefree = 0;
+
+  size_t bytes_inuse = sizealloc > sizefree ? sizealloc - sizefree : 0;
+  if (bytes_inuse > highwater_alloc) {
+    highwater_alloc = bytes_inuse;
+  }
+}
+
+//______________________________________________________________________________
+//
+ThreadCache::~ThreadCache()
+{
+  Allocator* a = default_allocator;
+  if (!a) {
+    return;
+  }
+
+  for (int index = 0; index < NTCACHE_BINS; index++) {
+    if (count[index] > 0) {
+      a->drain_cache(*this, &a->small_bins[index], index, count[index]);
+    }
+  }
+
+  a->lock();
+  a->merge_cache_stats(*this);
+  a->unlock();
+}
+
+//______________________________________________________________________________
+//
+inline
+void
+Allocator::charge_owners( Tag* obj )
+{
+  if (AllocatorTrackingOwners()) {
+    for (int kind = 0; kind < NumAllocOwnerKinds; kind++) {
+      obj->owner[kind] = AllocatorGetOwner(static_cast<AllocatorOwnerKind>(kind));
+    }
+    AllocatorChargeOwners(obj->owner, static_cast<long>(obj->reqsize));
+  }
+  else {
+    for (int kind = 0; kind < NumAllocOwnerKinds; kind++) {
+      obj->owner[kind] = 0;
+    }
+  }
+}
+
+//______________________________________________________________________________
+//
+void
+Allocator::mark_free( Tag* obj )
+{
+  char* data = (char*)obj;
+  data += sizeof(Tag);
+  Sentinel* sent1 = (Sentinel*)data;
+  data += sizeof(Sentinel);
+  char* d = (char*)data;
+  data += obj_maxsize(obj);
+  Sentinel* sent2 = (Sentinel*)data;
+
+  sent1->first_word = sent1->second_word = sent2->first_word = sent2->second_word = SENT_VAL_FREE;
+
+  if (strict) {
+    // Fill in the data region with markers.
+    unsigned int i = 0xffff5a5a;
+    for (unsigned int* p = (unsigned int*)d; p < (unsigned int*)sent2; p++) {
+      *p++ = i;
+    }
+  }
+}
+
 //______________________________________________________________________________
 //
 void Allocator::fill_bin( AllocBin* bin )
@@ -0,0 +1,205 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+
+/*
+ *  AllocatorOwners.cc: Attribution of allocations to the variable and task
+ *                      that made them.
+ *
+ *  The owner table is a fixed size static array so that neither registering
+ *  an owner nor charging it ever calls back into the allocator.
+ *
+ */
+
+#include <Core/Malloc/AllocatorOwners.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#define MAX_OWNERS         4096
+#define OWNER_NAME_LEN     64
+#define OWNER_HASH_SIZE    (2*MAX_OWNERS)
+
+namespace Uintah {
+
+namespace {
+
+struct OwnerEntry {
+  char                name[OWNER_NAME_LEN];
+  std::atomic<size_t> inuse;
+  std::atomic<size_t> highwater;
+  std::atomic<size_t> nalloc;
+};
+
+// Entry 0 of each kind is "no owner"
+OwnerEntry       s_owners[NumAllocOwnerKinds][MAX_OWNERS];
+int              s_owner_hash[NumAllocOwnerKinds][OWNER_HASH_SIZE];
+int              s_num_owners[NumAllocOwnerKinds];
+std::atomic<bool> s_tracking{false};
+
+Uintah::MasterLock s_owner_lock{};
+
+thread_local int t_owner[NumAllocOwnerKinds];
+
+const char* s_kind_names[NumAllocOwnerKinds] = { "variable", "task" };
+
+//______________________________________________________________________________
+//
+unsigned int
+hashName( const char* name )
+{
+  unsigned int h = 2166136261u;
+  for (int i = 0; i < OWNER_NAME_LEN - 1 && name[i] != '\0'; i++) {
+    h = (h ^ static_cast<unsigned char>(name[i])) * 16777619u;
+  }
+  return h;
+}
+
+} // namespace
+
+//______________________________________________________________________________
+//
+bool
+AllocatorTrackingOwners()
+{
+  return s_tracking.load(std::memory_order_relaxed);
+}
+
+//______________________________________________________________________________
+//
+void
+AllocatorSetTrackingOwners( bool track )
+{
+  s_tracking.store(track, std::memory_order_relaxed);
+}
+
+//______________________________________________________________________________
+//
+int
+AllocatorRegisterOwner( AllocatorOwnerKind kind, const char* name )
+{
+  std::lock_guard<Uintah::MasterLock> owner_guard(s_owner_lock);
+
+  int* table = s_owner_hash[kind];
+  unsigned int slot = hashName(name) % OWNER_HASH_SIZE;
+
+  while (table[slot] != 0) {
+    if (strncmp(s_owners[kind][table[slot]].name, name, OWNER_NAME_LEN - 1) == 0) {
+      return table[slot];
+    }
+    slot = (slot + 1) % OWNER_HASH_SIZE;
+  }
+
+  if (s_num_owners[kind] + 1 >= MAX_OWNERS) {
+    return 0;
+  }
+
+  int id = ++s_num_owners[kind];
+  strncpy(s_owners[kind][id].name, name, OWNER_NAME_LEN - 1);
+  s_owners[kind][id].name[OWNER_NAME_LEN - 1] = '\0';
+  table[slot] = id;
+
+  return id;
+}
+
+//______________________________________________________________________________
+//
+int
+AllocatorGetOwner( AllocatorOwnerKind kind )
+{
+  return t_owner[kind];
+}
+
+//______________________________________________________________________________
+//
+void
+AllocatorSetOwner( AllocatorOwnerKind kind, int owner )
+{
+  t_owner[kind] = owner;
+}
+
+//______________________________________________________________________________
+//
+void
+AllocatorChargeOwners( const int owners[NumAllocOwnerKinds], long bytes )
+{
+  for (int kind = 0; kind < NumAllocOwnerKinds; kind++) {
+    if (owners[kind] <= 0) {
+      continue;
+    }
+
+    OwnerEntry& entry = s_owners[kind][owners[kind]];
+    if (bytes >= 0) {
+      size_t inuse = entry.inuse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+      entry.nalloc.fetch_add(1, std::memory_order_relaxed);
+
+      size_t highwater = entry.highwater.load(std::memory_order_relaxed);
+      while (inuse > highwater && !entry.highwater.compare_exchange_weak(highwater, inuse, std::memory_order_relaxed)) {
+      }
+    }
+    else {
+      entry.inuse.fetch_sub(-bytes, std::memory_order_relaxed);
+    }
+  }
+}
+
+//______________________________________________________________________________
+//
+void
+AllocatorGetOwnerStats( AllocatorOwnerKind kind, std::vector<AllocatorOwnerStats>& stats )
+{
+  std::lock_guard<Uintah::MasterLock> owner_guard(s_owner_lock);
+
+  stats.clear();
+  for (int id = 1; id <= s_num_owners[kind]; id++) {
+    const OwnerEntry& entry = s_owners[kind][id];
+    stats.push_back(AllocatorOwnerStats{ entry.name
+                                       , entry.inuse.load(std::memory_order_relaxed)
+                                       , entry.highwater.load(std::memory_order_relaxed)
+                                       , entry.nalloc.load(std::memory_order_relaxed) });
+  }
+}
+
+//______________________________________________________________________________
+//
+void
+AllocatorPrintOwnerStats( FILE* out )
+{
+  for (int kind = 0; kind < NumAllocOwnerKinds; kind++) {
+    fprintf(out, "high-water by %s (in use, high-water, allocations):\n", s_kind_names[kind]);
+    for (int id = 1; id <= s_num_owners[kind]; id++) {
+      const OwnerEntry& entry = s_owners[kind][id];
+      fprintf(out, "%s\t%lu\t%lu\t%lu\n", entry.name
+                                        , (unsigned long)entry.inuse.load(std::memory_order_relaxed)
+                                        , (unsigned long)entry.highwater.load(std::memory_order_relaxed)
+                                        , (unsigned long)entry.nalloc.load(std::memory_order_relaxed));
+    }
+    fprintf(out, "\n");
+  }
+}
+
+} // End namespace Uintah
@@ -0,0 +1,120 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+
+/*
+ *  AllocatorOwners.h: Attribution of allocations to the variable and task
+ *                     that made them.
+ *
+ *  While an AllocatorOwnerScope is alive, every allocation the thread makes
+ *  through the Uintah allocator is charged to the named owner.  For each
+ *  owner the bytes currently in use and the high-water mark are kept, so
+ *  MemoryLog can report the memory peak of every variable and task.
+ *
+ *  Tracking is only done by the SCI malloc allocator (--enable-sci-malloc),
+ *  and only when the MALLOC_OWNERS environment variable is set.  Otherwise
+ *  the scopes cost a single flag test.
+ *
+ */
+
+#ifndef CORE_MALLOC_ALLOCATOROWNERS_H
+#define CORE_MALLOC_ALLOCATOROWNERS_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+enum AllocatorOwnerKind {
+    AllocOwnerVariable = 0
+  , AllocOwnerTask
+  , NumAllocOwnerKinds
+};
+
+struct AllocatorOwnerStats {
+  std::string m_name;
+  size_t      m_inuse;
+  size_t      m_highwater;
+  size_t      m_nalloc;
+};
+
+bool AllocatorTrackingOwners();
+
+void AllocatorSetTrackingOwners( bool track );
+
+// Returns the id of the owner with this name, 0 if the owner table is full.
+int  AllocatorRegisterOwner( AllocatorOwnerKind kind, const char * name );
+
+// The owner the calling thread's allocations are charged to (0 for none).
+int  AllocatorGetOwner( AllocatorOwnerKind kind );
+
+void AllocatorSetOwner( AllocatorOwnerKind kind, int owner );
+
+// Used by the allocator: adds 'bytes' (negative when freeing) to the owners.
+void AllocatorChargeOwners( const int owners[NumAllocOwnerKinds], long bytes );
+
+void AllocatorGetOwnerStats( AllocatorOwnerKind kind, std::vector<AllocatorOwnerStats> & stats );
+
+// Does not allocate, so it may be used while the allocator is shutting down.
+void AllocatorPrintOwnerStats( FILE * out );
+
+
+//------------------------------------------------------------------------------
+// Charges the allocations made by this thread to 'name' for the scope's lifetime.
+class AllocatorOwnerScope {
+
+  public:
+
+    AllocatorOwnerScope( AllocatorOwnerKind kind, const std::string & name )
+      : m_kind( kind )
+    {
+      if (AllocatorTrackingOwners()) {
+        m_previous = AllocatorGetOwner(kind);
+        m_active   = true;
+        AllocatorSetOwner(kind, AllocatorRegisterOwner(kind, name.c_str()));
+      }
+    }
+
+    ~AllocatorOwnerScope()
+    {
+      if (m_active) {
+        AllocatorSetOwner(m_kind, m_previous);
+      }
+    }
+
+  private:
+
+    AllocatorOwnerKind m_kind;
+    int                m_previous{0};
+    bool               m_active{false};
+
+    AllocatorOwnerScope( const AllocatorOwnerScope & )            = delete;
+    AllocatorOwnerScope& operator=( const AllocatorOwnerScope & ) = delete;
+};
+
+} // End namespace Uintah
+
+#endif // CORE_MALLOC_ALLOCATOROWNERS_H
@@ -32,9 +32,10 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 
 SRCDIR   := Core/Malloc
 
-SRCS     += $(SRCDIR)/Allocator.cc \
-            $(SRCDIR)/AllocOS.cc   \
-            $(SRCDIR)/malloc.cc    \
+SRCS     += $(SRCDIR)/Allocator.cc       \
+            $(SRCDIR)/AllocatorOwners.cc \
+            $(SRCDIR)/AllocOS.cc         \
+            $(SRCDIR)/malloc.cc          \
             $(SRCDIR)/new.cc
 
 PSELIBS := 
@@ -0,0 +1,778 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Math/BlockSparseMatrix.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Parallel/ThreadExecutor.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Uintah;
+
+namespace {
+
+  //______________________________________________________________________
+  //  The row loops are split into contiguous chunks of at least minRows
+  //  rows and run on the process-wide ThreadExecutor, on idle scheduler
+  //  threads when a threaded scheduler owns the cores.
+  const int minRows = 1024;
+
+  int numChunks( int n, int nThreads )
+  {
+    return ThreadExecutor::numChunks( n, std::max( nThreads, 1 ), minRows );
+  }
+
+  void runRows( int n, int nThreads, const ThreadExecutor::RangeFunction& job )
+  {
+    ThreadExecutor::parallelFor( n, std::max( nThreads, 1 ), minRows, job );
+  }
+
+  //______________________________________________________________________
+  //  y = A x for the block rows [begin,end)
+  template<int BS>
+  void spmvRows( const long* rowPtr, const int* cols, const double* vals,
+                 const double* x, double* y, int begin, int end )
+  {
+    for( int I = begin; I < end; I++ ) {
+      double sum[BS] = {0.0};
+      for( long k = rowPtr[I]; k < rowPtr[I+1]; k++ ) {
+        const double* blk = vals + k*BS*BS;
+        const double* xJ  = x + (long)cols[k]*BS;
+        for( int r = 0; r < BS; r++ ) {
+          for( int c = 0; c < BS; c++ ) {
+            sum[r] += blk[r*BS + c]*xJ[c];
+          }
+        }
+      }
+      for( int r = 0; r < BS; r++ ) {
+        y[(long)I*BS + r] = sum[r];
+      }
+    }
+  }
+
+  void spmvRows( int bs, const long* rowPtr, const int* cols, const double* vals,
+                 const double* x, double* y, int begin, int end )
+  {
+    for( int I = begin; I < end; I++ ) {
+      double* yI = y + (long)I*bs;
+      for( int r = 0; r < bs; r++ ) {
+        yI[r] = 0.0;
+      }
+      for( long k = rowPtr[I]; k < rowPtr[I+1]; k++ ) {
+        const double* blk = vals + k*bs*bs;
+        const double* xJ  = x + (long)cols[k]*bs;
+        for( int r = 0; r < bs; r++ ) {
+          for( int c = 0; c < bs; c++ ) {
+            yI[r] += blk[r*bs + c]*xJ[c];
+          }
+        }
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //  Reductions are summed per chunk and the chunks are then added in
+  //  order, so the result only depends on the thread count.
+  double dot( const std::vector<double>& a, const std::vector<double>& b, int nThreads )
+  {
+    const int n = (int)a.size();
+    std::vector<double> partial( numChunks( n, nThreads ), 0.0 );
+    runRows( n, nThreads, [&]( int begin, int end, int c ) {
+        double sum = 0.0;
+        for( int i = begin; i < end; i++ ) {
+          sum += a[i]*b[i];
+        }
+        partial[c] = sum;
+      } );
+
+    double sum = 0.0;
+    for( double p : partial ) {
+      sum += p;
+    }
+    return sum;
+  }
+
+  double sumAbs( const std::vector<double>& a, int nThreads )
+  {
+    const int n = (int)a.size();
+    std::vector<double> partial( numChunks( n, nThreads ), 0.0 );
+    runRows( n, nThreads, [&]( int begin, int end, int c ) {
+        double sum = 0.0;
+        for( int i = begin; i < end; i++ ) {
+          sum += std::fabs( a[i] );
+        }
+        partial[c] = sum;
+      } );
+
+    double sum = 0.0;
+    for( double p : partial ) {
+      sum += p;
+    }
+    return sum;
+  }
+
+  //______________________________________________________________________
+  //  z = M^-1 r
+  class PCGPreconditioner {
+  public:
+    PCGPreconditioner( const BlockSparseMatrix& A, Preconditioner pc, int nThreads );
+
+    void apply( const std::vector<double>& r, std::vector<double>& z ) const;
+
+  private:
+    bool factorIC0( const BlockSparseMatrix& A, double shift );
+    void setupJacobi( const BlockSparseMatrix& A );
+    void setupBlockJacobi( const BlockSparseMatrix& A );
+
+    Preconditioner      m_pc;
+    int                 m_nThreads;
+    int                 m_bs;
+    std::vector<double> m_inv;      // inverse diagonal (blocks)
+
+    // IC(0) factor, lower triangle in CSR
+    std::vector<int>    m_rowPtr;
+    std::vector<int>    m_cols;
+    std::vector<double> m_L;
+    mutable std::vector<double> m_y;
+  };
+
+  //______________________________________________________________________
+  //
+  PCGPreconditioner::PCGPreconditioner( const BlockSparseMatrix& A,
+                                        Preconditioner pc,
+                                        int nThreads )
+    : m_pc( pc ), m_nThreads( nThreads ), m_bs( A.blockSize() )
+  {
+    switch( m_pc ) {
+      case Preconditioner::None:
+        break;
+      case Preconditioner::Jacobi:
+        setupJacobi( A );
+        break;
+      case Preconditioner::BlockJacobi:
+        setupBlockJacobi( A );
+        break;
+      case Preconditioner::IC0: {
+        // Incomplete Cholesky can break down on matrices that aren't
+        // diagonally dominant enough.  Retry with a growing diagonal shift
+        // (Manteuffel) before giving up and using Jacobi.
+        double shift = 0.0;
+        bool ok = factorIC0( A, shift );
+        for( int attempt = 0; !ok && attempt < 10; attempt++ ) {
+          shift = ( shift == 0.0 ) ? 1.e-3 : 2.0*shift;
+          ok = factorIC0( A, shift );
+        }
+        if( !ok ) {
+          m_pc = Preconditioner::Jacobi;
+          setupJacobi( A );
+        }
+        break;
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  void PCGPreconditioner::setupJacobi( const BlockSparseMatrix& A )
+  {
+    const int n = A.numRows();
+    m_inv.resize( n );
+    for( int i = 0; i < n; i++ ) {
+      double d = A.diagonal( i );
+      m_inv[i] = ( d != 0.0 ) ? 1.0/d : 1.0;
+    }
+  }
+
+  //______________________________________________________________________
+  //  Invert each diagonal block with Gauss-Jordan elimination.  A singular
+  //  block falls back to the inverse of its diagonal.
+  void PCGPreconditioner::setupBlockJacobi( const BlockSparseMatrix& A )
+  {
+    const int bs  = m_bs;
+    const int bs2 = bs*bs;
+    A.getDiagonalBlocks( m_inv );
+
+    std::vector<double> a( bs2 ), inv( bs2 );
+    for( int I = 0; I < A.numBlockRows(); I++ ) {
+      double* blk = &m_inv[(long)I*bs2];
+      std::copy( blk, blk + bs2, a.begin() );
+      std::fill( inv.begin(), inv.end(), 0.0 );
+      for( int r = 0; r < bs; r++ ) {
+        inv[r*bs + r] = 1.0;
+      }
+
+      bool singular = false;
+      for( int c = 0; c < bs && !singular; c++ ) {
+        int    piv = c;
+        for( int r = c + 1; r < bs; r++ ) {
+          if( std::fabs( a[r*bs + c] ) > std::fabs( a[piv*bs + c] ) ) {
+            piv = r;
+          }
+        }
+        if( a[piv*bs + c] == 0.0 ) {
+          singular = true;
+          break;
+        }
+        if( piv != c ) {
+          for( int k = 0; k < bs; k++ ) {
+            std::swap( a[c*bs + k],   a[piv*bs + k] );
+            std::swap( inv[c*bs + k], inv[piv*bs + k] );
+          }
+        }
+        double d = 1.0/a[c*bs + c];
+        for( int k = 0; k < bs; k++ ) {
+          a[c*bs + k]   *= d;
+          inv[c*bs + k] *= d;
+        }
+        for( int r = 0; r < bs; r++ ) {
+          if( r != c && a[r*bs + c] != 0.0 ) {
+            double f = a[r*bs + c];
+            for( int k = 0; k < bs; k++ ) {
+              a[r*bs + k]   -= f*a[c*bs + k];
+              inv[r*bs + k] -= f*inv[c*bs + k];
+            }
+          }
+        }
+      }
+
+      if( singular ) {
+        std::fill( inv.begin(), inv.end(), 0.0 );
+        for( int r = 0; r < bs; r++ ) {
+          double d = blk[r*bs + r];
+          inv[r*bs + r] = ( d != 0.0 ) ? 1.0/d : 1.0;
+        }
+      }
+      std::copy( inv.begin(), inv.end(), blk );
+    }
+  }
+
+  //______________________________________________________________________
+  //  Incomplete Cholesky with the sparsity of the lower triangle of A,
+  //  computed row by row.  Returns false on a non positive pivot.
+  bool PCGPreconditioner::factorIC0( const BlockSparseMatrix& A, double shift )
+  {
+    A.getLowerCSR( m_rowPtr, m_cols, m_L );
+    const int n = A.numRows();
+
+    for( int i = 0; i < n; i++ ) {
+      const int rowBegin = m_rowPtr[i];
+      const int rowEnd   = m_rowPtr[i+1];
+
+      for( int p = rowBegin; p < rowEnd; p++ ) {
+        const int k = m_cols[p];
+
+        // s = A(i,k) - sum_{m<k} L(i,m) L(k,m)
+        double s = m_L[p];
+        int pi = rowBegin;
+        int pk = m_rowPtr[k];
+        const int kEnd = m_rowPtr[k+1] - 1;     // skip the diagonal of row k
+        while( pi < p && pk < kEnd ) {
+          if( m_cols[pi] == m_cols[pk] ) {
+            s -= m_L[pi++]*m_L[pk++];
+          }
+          else if( m_cols[pi] < m_cols[pk] ) {
+            pi++;
+          }
+          else {
+            pk++;
+          }
+        }
+
+        if( k < i ) {
+          m_L[p] = s/m_L[m_rowPtr[k+1] - 1];
+        }
+        else {
+          s += shift*std::fabs( m_L[p] );
+          if( !( s > 0.0 ) ) {
+            return false;
+          }
+          m_L[p] = std::sqrt( s );
+        }
+      }
+
+      if( rowEnd == rowBegin || m_cols[rowEnd - 1] != i ) {
+        return false;
+      }
+    }
+    m_y.resize( n );
+    return true;
+  }
+
+  //______________________________________________________________________
+  //
+  void PCGPreconditioner::apply( const std::vector<double>& r,
+                                 std::vector<double>& z ) const
+  {
+    const int n = (int)r.size();
+
+    switch( m_pc ) {
+      case Preconditioner::None:
+        runRows( n, m_nThreads, [&]( int begin, int end, int ) {
+            std::copy( r.begin() + begin, r.begin() + end, z.begin() + begin );
+          } );
+        break;
+
+      case Preconditioner::Jacobi:
+        runRows( n, m_nThreads, [&]( int begin, int end, int ) {
+            for( int i = begin; i < end; i++ ) {
+              z[i] = m_inv[i]*r[i];
+            }
+          } );
+        break;
+
+      case Preconditioner::BlockJacobi: {
+        const int bs = m_bs;
+        runRows( n/bs, m_nThreads, [&]( int begin, int end, int ) {
+            for( int I = begin; I < end; I++ ) {
+              const double* inv = &m_inv[(long)I*bs*bs];
+              const double* rI  = &r[(long)I*bs];
+              double*       zI  = &z[(long)I*bs];
+              for( int a = 0; a < bs; a++ ) {
+                double sum = 0.0;
+                for( int b = 0; b < bs; b++ ) {
+                  sum += inv[a*bs + b]*rI[b];
+                }
+                zI[a] = sum;
+              }
+            }
+          } );
+        break;
+      }
+
+      case Preconditioner::IC0: {
+        // The triangular solves are inherently sequential.
+        // L y = r
+        for( int i = 0; i < n; i++ ) {
+          double s = r[i];
+          const int diag = m_rowPtr[i+1] - 1;
+          for( int p = m_rowPtr[i]; p < diag; p++ ) {
+            s -= m_L[p]*m_y[m_cols[p]];
+          }
+          m_y[i] = s/m_L[diag];
+        }
+        // L^T z = y, column oriented
+        for( int i = n - 1; i >= 0; i-- ) {
+          const int diag = m_rowPtr[i+1] - 1;
+          z[i] = m_y[i]/m_L[diag];
+          for( int p = m_rowPtr[i]; p < diag; p++ ) {
+            m_y[m_cols[p]] -= m_L[p]*z[i];
+          }
+        }
+        break;
+      }
+    }
+  }
+
+} // End anonymous namespace
+
+//______________________________________________________________________
+//
+BlockSparseMatrix::BlockSparseMatrix()
+{
+}
+
+//______________________________________________________________________
+//
+BlockSparseMatrix::~BlockSparseMatrix()
+{
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::setSize( int nRows, int blockSize )
+{
+  if( blockSize < 1 || nRows % blockSize != 0 ) {
+    throw InternalError( "BlockSparseMatrix: the number of rows must be a multiple of the block size",
+                         __FILE__, __LINE__ );
+  }
+
+  if( nRows == d_nRows && blockSize == d_bs ) {
+    return;
+  }
+
+  d_nRows      = nRows;
+  d_bs         = blockSize;
+  d_nBlockRows = nRows/blockSize;
+  d_rowPtr.clear();
+  d_cols.clear();
+  d_diag.clear();
+  d_vals.clear();
+  d_staged.clear();
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::beginAssembly()
+{
+  clearValues();
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::clearValues()
+{
+  std::fill( d_vals.begin(), d_vals.end(), 0.0 );
+  d_staged.clear();
+}
+
+//______________________________________________________________________
+//
+long BlockSparseMatrix::findBlock( int I, int J ) const
+{
+  if( d_rowPtr.empty() ) {
+    return -1;
+  }
+  const int* begin = d_cols.data() + d_rowPtr[I];
+  const int* end   = d_cols.data() + d_rowPtr[I+1];
+  const int* it    = std::lower_bound( begin, end, J );
+  if( it == end || *it != J ) {
+    return -1;
+  }
+  return it - d_cols.data();
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::add( int i, int j, double value )
+{
+  const int I = i/d_bs;
+  const int J = j/d_bs;
+  long k = findBlock( I, J );
+  if( k >= 0 ) {
+    d_vals[k*d_bs*d_bs + (i - I*d_bs)*d_bs + (j - J*d_bs)] += value;
+  }
+  else {
+    d_staged.push_back( Triplet{ i, j, value } );
+  }
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::endAssembly()
+{
+  if( d_staged.empty() && !d_rowPtr.empty() ) {
+    return;
+  }
+  buildPattern();
+}
+
+//______________________________________________________________________
+//  Merge the current pattern, the staged entries and the diagonal blocks
+//  into a new pattern, then move the values over.
+void BlockSparseMatrix::buildPattern()
+{
+  const int  bs2 = d_bs*d_bs;
+  const long nb  = d_nBlockRows;
+
+  std::vector<long> keys;
+  keys.reserve( d_cols.size() + d_staged.size() + nb );
+  for( int I = 0; I < d_nBlockRows; I++ ) {
+    keys.push_back( I*nb + I );
+  }
+  for( int I = 0; I < (int)d_rowPtr.size() - 1; I++ ) {
+    for( long k = d_rowPtr[I]; k < d_rowPtr[I+1]; k++ ) {
+      keys.push_back( I*nb + d_cols[k] );
+    }
+  }
+  for( const Triplet& t : d_staged ) {
+    keys.push_back( (t.i/d_bs)*nb + t.j/d_bs );
+  }
+  std::sort( keys.begin(), keys.end() );
+  keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+
+  std::vector<long>   rowPtr( d_nBlockRows + 1, 0 );
+  std::vector<int>    cols( keys.size() );
+  std::vector<long>   diag( d_nBlockRows );
+  std::vector<double> vals( keys.size()*bs2, 0.0 );
+
+  for( size_t k = 0; k < keys.size(); k++ ) {
+    int I = (int)( keys[k]/nb );
+    cols[k] = (int)( keys[k]%nb );
+    rowPtr[I+1]++;
+    if( cols[k] == I ) {
+      diag[I] = k;
+    }
+  }
+  for( int I = 0; I < d_nBlockRows; I++ ) {
+    rowPtr[I+1] += rowPtr[I];
+  }
+
+  // carry over the values already in the old pattern
+  for( int I = 0; I < (int)d_rowPtr.size() - 1; I++ ) {
+    long knew = rowPtr[I];
+    for( long k = d_rowPtr[I]; k < d_rowPtr[I+1]; k++ ) {
+      while( cols[knew] != d_cols[k] ) {
+        knew++;
+      }
+      std::copy( &d_vals[k*bs2], &d_vals[k*bs2] + bs2, &vals[knew*bs2] );
+    }
+  }
+
+  d_rowPtr.swap( rowPtr );
+  d_cols.swap( cols );
+  d_diag.swap( diag );
+  d_vals.swap( vals );
+  d_patternBuilds++;
+
+  std::vector<Triplet> staged;
+  staged.swap( d_staged );
+  for( const Triplet& t : staged ) {
+    add( t.i, t.j, t.value );
+  }
+}
+
+//______________________________________________________________________
+//
+double BlockSparseMatrix::get( int i, int j ) const
+{
+  const int I = i/d_bs;
+  const int J = j/d_bs;
+  long k = findBlock( I, J );
+  if( k < 0 ) {
+    return 0.0;
+  }
+  return d_vals[k*d_bs*d_bs + (i - I*d_bs)*d_bs + (j - J*d_bs)];
+}
+
+//______________________________________________________________________
+//
+double BlockSparseMatrix::diagonal( int i ) const
+{
+  if( d_diag.empty() ) {
+    return 0.0;
+  }
+  const int I = i/d_bs;
+  const int r = i - I*d_bs;
+  return d_vals[d_diag[I]*d_bs*d_bs + r*d_bs + r];
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::setDiagonal( int i, double value )
+{
+  if( d_diag.empty() ) {
+    add( i, i, value );
+    endAssembly();
+    return;
+  }
+  const int I = i/d_bs;
+  const int r = i - I*d_bs;
+  d_vals[d_diag[I]*d_bs*d_bs + r*d_bs + r] = value;
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::eliminate( const std::vector<char>& fixed )
+{
+  const int bs = d_bs;
+  for( int I = 0; I < d_nBlockRows; I++ ) {
+    for( long k = d_rowPtr[I]; k < d_rowPtr[I+1]; k++ ) {
+      double* blk = &d_vals[k*bs*bs];
+      for( int r = 0; r < bs; r++ ) {
+        const int row = I*bs + r;
+        for( int c = 0; c < bs; c++ ) {
+          const int col = d_cols[k]*bs + c;
+          if( fixed[row] || fixed[col] ) {
+            blk[r*bs + c] = ( row == col ) ? 1.0 : 0.0;
+          }
+        }
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::multiply( const double* x, double* y, int nThreads ) const
+{
+  const long*   rowPtr = d_rowPtr.data();
+  const int*    cols   = d_cols.data();
+  const double* vals   = d_vals.data();
+  const int     bs     = d_bs;
+
+  if( d_rowPtr.empty() ) {
+    std::fill( y, y + d_nRows, 0.0 );
+    return;
+  }
+
+  runRows( d_nBlockRows, nThreads, [&]( int begin, int end, int ) {
+      switch( bs ) {
+        case 1:  spmvRows<1>( rowPtr, cols, vals, x, y, begin, end );     break;
+        case 3:  spmvRows<3>( rowPtr, cols, vals, x, y, begin, end );     break;
+        default: spmvRows( bs, rowPtr, cols, vals, x, y, begin, end );    break;
+      }
+    } );
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::getDiagonalBlocks( std::vector<double>& blocks ) const
+{
+  const int bs2 = d_bs*d_bs;
+  blocks.assign( (long)d_nBlockRows*bs2, 0.0 );
+  if( d_diag.empty() ) {
+    return;
+  }
+  for( int I = 0; I < d_nBlockRows; I++ ) {
+    std::copy( &d_vals[d_diag[I]*bs2], &d_vals[d_diag[I]*bs2] + bs2, &blocks[(long)I*bs2] );
+  }
+}
+
+//______________________________________________________________________
+//
+void BlockSparseMatrix::getLowerCSR( std::vector<int>    & rowPtr,
+                                     std::vector<int>    & cols,
+                                     std::vector<double> & vals ) const
+{
+  const int bs = d_bs;
+  rowPtr.assign( d_nRows + 1, 0 );
+  cols.clear();
+  vals.clear();
+
+  for( int I = 0; I < d_nBlockRows && !d_rowPtr.empty(); I++ ) {
+    for( int r = 0; r < bs; r++ ) {
+      const int row = I*bs + r;
+      for( long k = d_rowPtr[I]; k < d_rowPtr[I+1] && d_cols[k] <= I; k++ ) {
+        const double* blk = &d_vals[k*bs*bs];
+        for( int c = 0; c < bs; c++ ) {
+          const int col = d_cols[k]*bs + c;
+          if( col > row ) {
+            break;
+          }
+          cols.push_back( col );
+          vals.push_back( blk[r*bs + c] );
+        }
+      }
+      rowPtr[row+1] = (int)cols.size();
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+Preconditioner Uintah::parsePreconditioner( const std::string& name )
+{
+  if( name == "none" ) {
+    return Preconditioner::None;
+  }
+  else if( name == "jacobi" ) {
+    return Preconditioner::Jacobi;
+  }
+  else if( name == "block_jacobi" ) {
+    return Preconditioner::BlockJacobi;
+  }
+  else if( name == "ic0" ) {
+    return Preconditioner::IC0;
+  }
+  throw ProblemSetupException( "Unknown preconditioner '" + name +
+                               "', valid options are none, jacobi, block_jacobi and ic0",
+                               __FILE__, __LINE__ );
+}
+
+//______________________________________________________________________
+//
+std::string Uintah::preconditionerName( Preconditioner pc )
+{
+  switch( pc ) {
+    case Preconditioner::None:        return "none";
+    case Preconditioner::Jacobi:      return "jacobi";
+    case Preconditioner::BlockJacobi: return "block_jacobi";
+    case Preconditioner::IC0:         return "ic0";
+  }
+  return "unknown";
+}
+
+//______________________________________________________________________
+//
+PCGResult Uintah::pcgSolve( const BlockSparseMatrix  & A,
+                            const std::vector<double> & b,
+                            std::vector<double>       & x,
+                            Preconditioner              pc,
+                            double                      tolerance,
+                            int                         maxIterations,
+                            int                         nThreads )
+{
+  const int n = A.numRows();
+  PCGResult result;
+
+  x.resize( n, 0.0 );
+  std::vector<double> r( n ), z( n ), p( n ), q( n );
+
+  // r = b - A x
+  A.multiply( x.data(), q.data(), nThreads );
+  runRows( n, nThreads, [&]( int begin, int end, int ) {
+      for( int i = begin; i < end; i++ ) {
+        r[i] = b[i] - q[i];
+      }
+    } );
+
+  result.residual = sumAbs( r, nThreads );
+  if( result.residual <= tolerance ) {
+    result.converged = true;
+    return result;
+  }
+
+  PCGPreconditioner M( A, pc, nThreads );
+
+  double rho = 0.0;
+  for( int it = 1; it <= maxIterations; it++ ) {
+    M.apply( r, z );
+    double rhoNew = dot( r, z, nThreads );
+
+    const double beta = ( it == 1 ) ? 0.0 : rhoNew/rho;
+    rho = rhoNew;
+    runRows( n, nThreads, [&]( int begin, int end, int ) {
+        for( int i = begin; i < end; i++ ) {
+          p[i] = z[i] + beta*p[i];
+        }
+      } );
+
+    A.multiply( p.data(), q.data(), nThreads );
+    const double pq = dot( p, q, nThreads );
+    if( pq == 0.0 ) {
+      break;
+    }
+    const double alpha = rho/pq;
+
+    runRows( n, nThreads, [&]( int begin, int end, int ) {
+        for( int i = begin; i < end; i++ ) {
+          x[i] += alpha*p[i];
+          r[i] -= alpha*q[i];
+        }
+      } );
+
+    result.iterations = it;
+    result.residual   = sumAbs( r, nThreads );
+    if( result.residual <= tolerance ) {
+      result.converged = true;
+      break;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,184 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef Uintah_Core_Math_BlockSparseMatrix_h
+#define Uintah_Core_Math_BlockSparseMatrix_h
+
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   BlockSparseMatrix
+
+   Square sparse matrix in block compressed row (BSR) storage.
+
+GENERAL INFORMATION
+
+   BlockSparseMatrix.h
+
+KEYWORDS
+   Sparse, BSR, Conjugate Gradient
+
+DESCRIPTION
+   The matrix is stored as dense blockSize x blockSize blocks, one block per
+   nonzero node/node coupling, so that all the DOFs of a node (3 for the
+   implicit MPM displacements, 1 for heat conduction) share one column
+   index.
+
+   Assembly is done in two passes.  The first assembly stages the entries
+   as triplets and endAssembly() sorts them into the block pattern.  Later
+   assemblies (beginAssembly()) only zero the values and add straight into
+   the existing pattern, so the pattern is built once and then reused for
+   every Newton iteration and timestep with the same number of rows.
+   Entries that fall outside the pattern are staged again and merged into
+   it at the next endAssembly().
+
+   multiply() and the vector kernels used by pcgSolve() split the rows
+   among nThreads threads.
+
+WARNING
+   add() is not thread safe.
+
+****************************************/
+
+  class BlockSparseMatrix {
+
+  public:
+    BlockSparseMatrix();
+    ~BlockSparseMatrix();
+
+    // Set the number of (scalar) rows and the block size.  The pattern is
+    // kept if neither changed, otherwise it is discarded.
+    void setSize( int nRows, int blockSize );
+
+    int numRows()     const { return d_nRows; }
+    int blockSize()   const { return d_bs; }
+    int numBlockRows() const { return d_nBlockRows; }
+    long numBlocks()  const { return d_rowPtr.empty() ? 0 : d_rowPtr.back(); }
+
+    // Number of times the block pattern has been (re)built.
+    int numPatternBuilds() const { return d_patternBuilds; }
+
+    // Zero the values, keeping the pattern.
+    void beginAssembly();
+
+    // A(i,j) += value
+    void add( int i, int j, double value );
+
+    // Merge the staged entries into the pattern.  Cheap when nothing was
+    // staged, so it is safe to call it before every use of the matrix.
+    void endAssembly();
+
+    // Zero all values (pattern is kept) and drop the staged entries.
+    void clearValues();
+
+    // A(i,j), 0 if (i,j) is not in the pattern.
+    double get( int i, int j ) const;
+
+    // A(i,i)
+    double diagonal( int i ) const;
+
+    // Replace the rows and columns flagged in 'fixed' with those of the
+    // identity matrix.
+    void eliminate( const std::vector<char>& fixed );
+
+    // A(i,i) = value
+    void setDiagonal( int i, double value );
+
+    // y = A x
+    void multiply( const double* x, double* y, int nThreads = 1 ) const;
+
+    // Diagonal blocks, row major, blockSize*blockSize doubles each
+    void getDiagonalBlocks( std::vector<double>& blocks ) const;
+
+    // Lower triangle (including the diagonal) in scalar CSR storage, rows
+    // sorted by column.
+    void getLowerCSR( std::vector<int>    & rowPtr,
+                      std::vector<int>    & cols,
+                      std::vector<double> & vals ) const;
+
+  private:
+
+    struct Triplet {
+      int    i;
+      int    j;
+      double value;
+    };
+
+    // index of block (I,J) in d_cols/d_vals, -1 if not in the pattern
+    long findBlock( int I, int J ) const;
+
+    void buildPattern();
+
+    int d_nRows      {0};
+    int d_bs         {1};
+    int d_nBlockRows {0};
+    int d_patternBuilds {0};
+
+    std::vector<long>    d_rowPtr;   // d_nBlockRows+1
+    std::vector<int>     d_cols;     // block column of each block
+    std::vector<long>    d_diag;     // index of the diagonal block of each block row
+    std::vector<double>  d_vals;     // d_bs*d_bs values per block, row major
+    std::vector<Triplet> d_staged;   // entries outside of the pattern
+
+    BlockSparseMatrix( const BlockSparseMatrix& );
+    BlockSparseMatrix& operator=( const BlockSparseMatrix& );
+  };
+
+
+  //______________________________________________________________________
+  //  Preconditioned conjugate gradient on a symmetric BlockSparseMatrix.
+
+  enum class Preconditioner { None, Jacobi, BlockJacobi, IC0 };
+
+  // "none", "jacobi", "block_jacobi", "ic0"; throws ProblemSetupException
+  // for anything else.
+  Preconditioner parsePreconditioner( const std::string& name );
+
+  std::string preconditionerName( Preconditioner pc );
+
+  struct PCGResult {
+    int    iterations {0};
+    double residual   {0.0};    // sum_i |b - Ax|_i
+    bool   converged  {false};
+  };
+
+  // Solve A x = b starting from the contents of x.  Converges when the L1
+  // norm of the residual drops below tolerance.
+  PCGResult pcgSolve( const BlockSparseMatrix  & A,
+                      const std::vector<double> & b,
+                      std::vector<double>       & x,
+                      Preconditioner              pc,
+                      double                      tolerance     = 1.e-8,
+                      int                         maxIterations = 5000,
+                      int                         nThreads      = 1 );
+
+} // End namespace Uintah
+
+#endif
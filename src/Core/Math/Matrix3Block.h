@@ -0,0 +1,378 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_MATH_MATRIX3BLOCK_H
+#define CORE_MATH_MATRIX3BLOCK_H
+
+#include <Core/Math/Matrix3.h>
+
+#include <cmath>
+
+namespace Uintah {
+
+//______________________________________________________________________
+//
+//  class Matrix3Block
+//
+//  Structure-of-arrays storage for W 3x3 matrices, one per particle
+//  "lane".  Component (i,j) of every lane is contiguous so the kernels
+//  below are written as straight loops over lanes, which the compiler
+//  turns into packed SIMD arithmetic for W = 4 (AVX2) or W = 8 (AVX-512).
+//
+//  The kernels mirror the scalar Matrix3 operations term by term so a
+//  block result matches the scalar reference to round-off.  Lanes past
+//  the number of particles in a partial block are filled with the
+//  identity so that every kernel stays well defined on them.
+//______________________________________________________________________
+
+template <int W>
+class Matrix3Block {
+
+public:
+
+  static const int width = W;
+
+  Matrix3Block() {}
+
+  inline double & operator()( int i, int j, int lane )       { return m_mat[3*i+j][lane]; }
+  inline double   operator()( int i, int j, int lane ) const { return m_mat[3*i+j][lane]; }
+
+  // Component k = 3*i+j of all lanes
+  inline double       * component( int k )       { return m_mat[k]; }
+  inline const double * component( int k ) const { return m_mat[k]; }
+
+  inline void set( int lane, const Matrix3 & a )
+  {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        m_mat[3*i+j][lane] = a(i,j);
+      }
+    }
+  }
+
+  inline Matrix3 get( int lane ) const
+  {
+    return Matrix3(m_mat[0][lane], m_mat[1][lane], m_mat[2][lane],
+                   m_mat[3][lane], m_mat[4][lane], m_mat[5][lane],
+                   m_mat[6][lane], m_mat[7][lane], m_mat[8][lane]);
+  }
+
+  inline void identity()
+  {
+    for (int k = 0; k < 9; k++) {
+      const double value = (k % 4 == 0) ? 1.0 : 0.0;
+      for (int l = 0; l < W; l++) {
+        m_mat[k][l] = value;
+      }
+    }
+  }
+
+  // Copy n matrices in from an array (indexed through idx when given) and
+  // pad the remaining lanes with the identity.
+  template <class Array, class Index>
+  inline void gather( const Array & a, const Index * idx, int n )
+  {
+    identity();
+    for (int l = 0; l < n; l++) {
+      set(l, a[idx[l]]);
+    }
+  }
+
+  template <class Array, class Index>
+  inline void scatter( Array & a, const Index * idx, int n ) const
+  {
+    for (int l = 0; l < n; l++) {
+      a[idx[l]] = get(l);
+    }
+  }
+
+private:
+
+  alignas(8 * sizeof(double)) double m_mat[9][W];
+};
+
+typedef Matrix3Block<4> Matrix3Block4;
+typedef Matrix3Block<8> Matrix3Block8;
+
+//______________________________________________________________________
+//  c = a*b
+template <int W>
+inline void multiply( const Matrix3Block<W> & a, const Matrix3Block<W> & b, Matrix3Block<W> & c )
+{
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      const double * a0 = a.component(3*i);
+      const double * a1 = a.component(3*i+1);
+      const double * a2 = a.component(3*i+2);
+      const double * b0 = b.component(j);
+      const double * b1 = b.component(3+j);
+      const double * b2 = b.component(6+j);
+      double * cc = c.component(3*i+j);
+      for (int l = 0; l < W; l++) {
+        cc[l] = a0[l]*b0[l] + a1[l]*b1[l] + a2[l]*b2[l];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//  c = transpose(a)*b
+template <int W>
+inline void transposeMultiply( const Matrix3Block<W> & a, const Matrix3Block<W> & b, Matrix3Block<W> & c )
+{
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      const double * a0 = a.component(i);
+      const double * a1 = a.component(3+i);
+      const double * a2 = a.component(6+i);
+      const double * b0 = b.component(j);
+      const double * b1 = b.component(3+j);
+      const double * b2 = b.component(6+j);
+      double * cc = c.component(3*i+j);
+      for (int l = 0; l < W; l++) {
+        cc[l] = a0[l]*b0[l] + a1[l]*b1[l] + a2[l]*b2[l];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//  c = a*transpose(b)
+template <int W>
+inline void multiplyTranspose( const Matrix3Block<W> & a, const Matrix3Block<W> & b, Matrix3Block<W> & c )
+{
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      const double * a0 = a.component(3*i);
+      const double * a1 = a.component(3*i+1);
+      const double * a2 = a.component(3*i+2);
+      const double * b0 = b.component(3*j);
+      const double * b1 = b.component(3*j+1);
+      const double * b2 = b.component(3*j+2);
+      double * cc = c.component(3*i+j);
+      for (int l = 0; l < W; l++) {
+        cc[l] = a0[l]*b0[l] + a1[l]*b1[l] + a2[l]*b2[l];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//  Same expansion as Matrix3::Determinant()
+template <int W>
+inline void determinant( const Matrix3Block<W> & a, double * det )
+{
+  for (int l = 0; l < W; l++) {
+    det[l] = a(0,0,l)*a(1,1,l)*a(2,2,l) +
+             a(0,1,l)*a(1,2,l)*a(2,0,l) +
+             a(0,2,l)*a(1,0,l)*a(2,1,l) -
+             a(0,2,l)*a(1,1,l)*a(2,0,l) -
+             a(0,1,l)*a(1,0,l)*a(2,2,l) -
+             a(0,0,l)*a(1,2,l)*a(2,1,l);
+  }
+}
+
+//______________________________________________________________________
+//  inv = a^-1 (adjugate over determinant).  Singular lanes are left to
+//  the caller to detect through det.
+template <int W>
+inline void inverse( const Matrix3Block<W> & a, Matrix3Block<W> & inv, double * det )
+{
+  determinant(a, det);
+
+  for (int l = 0; l < W; l++) {
+    const double odet = 1.0/det[l];
+    inv(0,0,l) = (a(1,1,l)*a(2,2,l) - a(1,2,l)*a(2,1,l))*odet;
+    inv(0,1,l) = (a(0,2,l)*a(2,1,l) - a(0,1,l)*a(2,2,l))*odet;
+    inv(0,2,l) = (a(0,1,l)*a(1,2,l) - a(0,2,l)*a(1,1,l))*odet;
+    inv(1,0,l) = (a(1,2,l)*a(2,0,l) - a(1,0,l)*a(2,2,l))*odet;
+    inv(1,1,l) = (a(0,0,l)*a(2,2,l) - a(0,2,l)*a(2,0,l))*odet;
+    inv(1,2,l) = (a(0,2,l)*a(1,0,l) - a(0,0,l)*a(1,2,l))*odet;
+    inv(2,0,l) = (a(1,0,l)*a(2,1,l) - a(1,1,l)*a(2,0,l))*odet;
+    inv(2,1,l) = (a(0,1,l)*a(2,0,l) - a(0,0,l)*a(2,1,l))*odet;
+    inv(2,2,l) = (a(0,0,l)*a(1,1,l) - a(0,1,l)*a(1,0,l))*odet;
+  }
+}
+
+//______________________________________________________________________
+//
+template <int W>
+inline void trace( const Matrix3Block<W> & a, double * tr )
+{
+  for (int l = 0; l < W; l++) {
+    tr[l] = a(0,0,l) + a(1,1,l) + a(2,2,l);
+  }
+}
+
+//______________________________________________________________________
+//  Frobenius norm, as Matrix3::Norm()
+template <int W>
+inline void norm( const Matrix3Block<W> & a, double * nrm )
+{
+  for (int l = 0; l < W; l++) {
+    nrm[l] = 0.0;
+  }
+  for (int k = 0; k < 9; k++) {
+    const double * ak = a.component(k);
+    for (int l = 0; l < W; l++) {
+      nrm[l] += ak[l]*ak[l];
+    }
+  }
+  for (int l = 0; l < W; l++) {
+    nrm[l] = std::sqrt(nrm[l]);
+  }
+}
+
+//______________________________________________________________________
+//  Truncated Taylor series, as Matrix3::Exponential(num_terms)
+template <int W>
+inline void exponential( const Matrix3Block<W> & a, int num_terms, Matrix3Block<W> & exp )
+{
+  Matrix3Block<W> term, next;
+  term.identity();
+  exp.identity();
+
+  for (int kk = 0; kk < num_terms; ++kk) {
+    multiply(term, a, next);
+    const double scale = 1.0/(double)(kk+1);
+    for (int k = 0; k < 9; k++) {
+      double * t = term.component(k);
+      double * e = exp.component(k);
+      const double * n = next.component(k);
+      for (int l = 0; l < W; l++) {
+        t[l] = n[l]*scale;
+        e[l] += t[l];
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//  Polar decomposition F = RU with the scaled Bjorck-Bowie iteration of
+//  Matrix3::polarDecompositionRMB().  Every lane follows exactly the
+//  scalar sequence of iterates; a lane stops updating once it has
+//  converged and the block finishes when the slowest lane does.
+//
+//  Returns false if a lane has det(F) <= 0 or fails to converge in 200
+//  iterations (the scalar routine exits in both cases); the caller
+//  should fall back to the scalar routine to report the particle.
+template <int W>
+inline bool polarDecompositionRMB( const Matrix3Block<W> & F, Matrix3Block<W> & U, Matrix3Block<W> & R )
+{
+  double det[W];
+  determinant(F, det);
+  for (int l = 0; l < W; l++) {
+    if (!(det[l] > 0.0)) {
+      return false;
+    }
+  }
+
+  // E = (S*F^T F - I)/2 with S = 3/tr(F^T F), first guess A = sqrt(S)*F
+  Matrix3Block<W> E, A, X;
+  transposeMultiply(F, F, E);
+
+  double S[W], errz[W], err[W];
+  bool   active[W];
+  trace(E, S);
+  for (int l = 0; l < W; l++) {
+    S[l] = 3.0/S[l];
+  }
+  for (int k = 0; k < 9; k++) {
+    const double delta = (k % 4 == 0) ? 1.0 : 0.0;
+    double       * e = E.component(k);
+    double       * a = A.component(k);
+    const double * f = F.component(k);
+    for (int l = 0; l < W; l++) {
+      e[l] = (e[l]*S[l] - delta)*0.5;
+      a[l] = f[l]*std::sqrt(S[l]);
+    }
+  }
+
+  int nactive = 0;
+  for (int l = 0; l < W; l++) {
+    errz[l] = E(0,0,l)*E(0,0,l) + E(1,1,l)*E(1,1,l) + E(2,2,l)*E(2,2,l)
+            + 2.0*(E(0,1,l)*E(0,1,l) + E(1,2,l)*E(1,2,l) + E(2,0,l)*E(2,0,l));
+    active[l] = !(errz[l] + 1.0 == 1.0);
+    nactive += active[l];
+  }
+
+  int num_iters = 0;
+  while (nactive > 0) {
+
+    if (num_iters == 200) {
+      return false;
+    }
+    num_iters++;
+
+    // X = A*(I - E)
+    for (int k = 0; k < 9; k++) {
+      const double delta = (k % 4 == 0) ? 1.0 : 0.0;
+      double * e = E.component(k);
+      for (int l = 0; l < W; l++) {
+        e[l] = delta - e[l];
+      }
+    }
+    multiply(A, E, X);
+
+    for (int k = 0; k < 9; k++) {
+      double       * a = A.component(k);
+      const double * x = X.component(k);
+      for (int l = 0; l < W; l++) {
+        a[l] = active[l] ? x[l] : a[l];
+      }
+    }
+
+    // E = (A^T A - I)/2
+    transposeMultiply(A, A, E);
+    for (int k = 0; k < 9; k++) {
+      const double delta = (k % 4 == 0) ? 1.0 : 0.0;
+      double * e = E.component(k);
+      for (int l = 0; l < W; l++) {
+        e[l] = (e[l] - delta)*.5;
+      }
+    }
+
+    nactive = 0;
+    for (int l = 0; l < W; l++) {
+      err[l] = E(0,0,l)*E(0,0,l) + E(1,1,l)*E(1,1,l) + E(2,2,l)*E(2,2,l)
+             + 2.0*(E(0,1,l)*E(0,1,l) + E(1,2,l)*E(1,2,l) + E(2,0,l)*E(2,0,l));
+      if (active[l] && (err[l] >= errz[l] || err[l] + 1.0 == 1.0)) {
+        active[l] = false;
+      }
+      errz[l] = err[l];
+      nactive += active[l];
+    }
+  }
+
+  // R = A, U = R^T F
+  R = A;
+  transposeMultiply(R, F, U);
+
+  return true;
+}
+
+} // End namespace Uintah
+
+#endif // CORE_MATH_MATRIX3BLOCK_H
@@ -64,6 +64,7 @@ SRCS += \
         $(SRCDIR)/SymmMatrix3.cc       \
         $(SRCDIR)/CubeRoot.cc          \
         $(SRCDIR)/Sparse.cc            \
+        $(SRCDIR)/BlockSparseMatrix.cc \
         $(SRCDIR)/Short27.cc           \
         $(SRCDIR)/Int130.cc            \
         $(SRCDIR)/TangentModulusTensor.cc  \
@@ -0,0 +1,216 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Parallel/Parallel.h>
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+using namespace Uintah;
+
+int  LoopTileExecutor::s_num_helpers              = 0;
+bool LoopTileExecutor::s_enabled                  = true;
+int  LoopTileExecutor::s_tile_size                = 16384;
+bool LoopTileExecutor::s_deterministic_reductions = false;
+
+namespace {
+
+  struct LoopJob {
+    const LoopTileExecutor::TileFunction * body {nullptr};
+    int                                    nTiles {0};
+    std::atomic<int>                       next {0};
+    std::atomic<int>                       done {0};
+    std::mutex                             errorLock;
+    std::exception_ptr                     error;
+  };
+
+  // Posted loops, at most one per thread running a task.  A helper
+  // announces itself in g_loop_users[slot] before it dereferences the job,
+  // and the posting thread waits for the users to drain after removing the
+  // job, so a job never goes out of scope while a helper still holds it.
+  const int             MAX_LOOPS = MAX_THREADS;
+  std::atomic<LoopJob*> g_loops[MAX_LOOPS];
+  std::atomic<int>      g_loop_users[MAX_LOOPS];
+  std::atomic<int>      g_num_posted{0};
+
+  thread_local bool     t_in_tile = false;
+
+  //______________________________________________________________________
+  //
+  int workOn( LoopJob & job )
+  {
+    int count = 0;
+    while (true) {
+      const int tile = job.next.fetch_add(1);
+      if (tile >= job.nTiles) {
+        break;
+      }
+
+      const bool outer = t_in_tile;
+      t_in_tile = true;
+      try {
+        (*job.body)(tile);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(job.errorLock);
+        if (!job.error) {
+          job.error = std::current_exception();
+        }
+      }
+      t_in_tile = outer;
+
+      job.done.fetch_add(1);
+      ++count;
+    }
+    return count;
+  }
+
+} // namespace
+
+//______________________________________________________________________
+//
+void
+LoopTileExecutor::run( int nTiles, const TileFunction & body )
+{
+  if (nTiles <= 0) {
+    return;
+  }
+
+  LoopJob job;
+  job.body   = &body;
+  job.nTiles = nTiles;
+
+  int slot = -1;
+  if (nTiles > 1 && useThreads()) {
+    for (int i = 0; i < MAX_LOOPS; ++i) {
+      LoopJob* expected = nullptr;
+      if (g_loops[i].compare_exchange_strong(expected, &job)) {
+        slot = i;
+        break;
+      }
+    }
+  }
+
+  // no helpers or no free slot, run the tiles in order on this thread
+  if (slot < 0) {
+    for (int tile = 0; tile < nTiles; ++tile) {
+      body(tile);
+    }
+    return;
+  }
+
+  g_num_posted.fetch_add(1);
+
+  workOn(job);
+
+  while (job.done.load() < nTiles) {
+    std::this_thread::yield();
+  }
+
+  g_loops[slot].store(nullptr);
+  g_num_posted.fetch_sub(1);
+  while (g_loop_users[slot].load() > 0) {
+    std::this_thread::yield();
+  }
+
+  if (job.error) {
+    std::rethrow_exception(job.error);
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+LoopTileExecutor::help()
+{
+  if (g_num_posted.load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+
+  bool worked = false;
+  for (int i = 0; i < MAX_LOOPS; ++i) {
+    if (g_loops[i].load(std::memory_order_relaxed) == nullptr) {
+      continue;
+    }
+    g_loop_users[i].fetch_add(1);
+    LoopJob* job = g_loops[i].load();
+    if (job != nullptr) {
+      worked = (workOn(*job) > 0) || worked;
+    }
+    g_loop_users[i].fetch_sub(1);
+  }
+  return worked;
+}
+
+//______________________________________________________________________
+//
+void
+LoopTileExecutor::setNumHelpers( int num )
+{
+  s_num_helpers = (num > 0) ? num : 0;
+}
+
+//______________________________________________________________________
+//
+int
+LoopTileExecutor::numHelpers()
+{
+  return s_num_helpers;
+}
+
+//______________________________________________________________________
+//
+bool
+LoopTileExecutor::inParallelLoop()
+{
+  return t_in_tile;
+}
+
+//______________________________________________________________________
+//
+void
+LoopTileExecutor::setEnabled( bool state )
+{
+  s_enabled = state;
+}
+
+//______________________________________________________________________
+//
+void
+LoopTileExecutor::setTileSize( int cells )
+{
+  s_tile_size = (cells > 0) ? cells : 1;
+}
+
+//______________________________________________________________________
+//
+void
+LoopTileExecutor::setDeterministicReductions( bool state )
+{
+  s_deterministic_reductions = state;
+}
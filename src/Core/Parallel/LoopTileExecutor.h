@@ -0,0 +1,123 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_PARALLEL_LOOPTILEEXECUTOR_H
+#define CORE_PARALLEL_LOOPTILEEXECUTOR_H
+
+#include <functional>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   LoopTileExecutor
+
+GENERAL INFORMATION
+
+   LoopTileExecutor.h
+
+KEYWORDS
+   parallel_for, parallel_reduce, tiles
+
+DESCRIPTION
+   Runs the tiles of a data parallel loop (see BlockRange.hpp) on the
+   threads the scheduler already owns.  No threads are created here: the
+   thread running the task posts the loop and works on its tiles, and
+   scheduler threads that have no task to run call help() from their idle
+   loop and take tiles of the posted loops.  The number of busy threads
+   therefore never exceeds the scheduler's thread count.
+
+   A loop started from inside a tile runs serially on the calling thread.
+
+   Without helpers (MPI scheduler, Unified scheduler without extra threads)
+   run() simply executes the tiles in order on the calling thread.
+
+****************************************/
+
+class LoopTileExecutor {
+
+  public:
+
+    typedef std::function<void(int)> TileFunction;
+
+    //////////
+    // Execute body(tile) for every tile in [0, nTiles).  Returns when all
+    // tiles are done; an exception thrown by a tile is rethrown here.
+    static void run( int nTiles, const TileFunction & body );
+
+    //////////
+    // Called by an idle scheduler thread: work on the tiles of any posted
+    // loop.  Returns true if at least one tile was executed.
+    static bool help();
+
+    //////////
+    // Number of scheduler threads calling help(), 0 disables the threaded
+    // loops.  Set by the scheduler.
+    static void setNumHelpers( int num );
+    static int  numHelpers();
+
+    //////////
+    // True while the calling thread executes a tile.
+    static bool inParallelLoop();
+
+    //////////
+    // Threaded loops should be used for this loop (helpers available and
+    // not already inside a tile).
+    static bool useThreads()
+    {
+      return s_num_helpers > 0 && s_enabled && !inParallelLoop();
+    }
+
+    //////////
+    // Turn the threaded loops on and off, <Scheduler><ParallelLoops><enabled>
+    static void setEnabled( bool state );
+
+    //////////
+    // Approximate number of cells per tile, <ParallelLoops><tile_size>
+    static void setTileSize( int cells );
+    static int  getTileSize() { return s_tile_size; }
+
+    //////////
+    // Combine the partial results of reductions in tile order, so that the
+    // result doesn't depend on the number of threads or on which thread
+    // ran which tile.  <ParallelLoops><deterministic_reductions>
+    static void setDeterministicReductions( bool state );
+    static bool deterministicReductions() { return s_deterministic_reductions; }
+
+  private:
+
+    static int  s_num_helpers;
+    static bool s_enabled;
+    static int  s_tile_size;
+    static bool s_deterministic_reductions;
+
+    // eliminate public constructor
+    LoopTileExecutor();
+};
+
+} // End namespace Uintah
+
+#endif // CORE_PARALLEL_LOOPTILEEXECUTOR_H
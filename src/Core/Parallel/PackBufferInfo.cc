@@ -31,14 +31,104 @@
 
 using namespace Uintah;
 
+#include <algorithm>
+#include <climits>
 #include <iostream>
 #include <string.h>
+#include <vector>
 
 
+int  PackBufferInfo::s_pack_threshold     = INT_MAX;
+bool PackBufferInfo::s_pack_threshold_set = false;
+
 //_____________________________________________________________________________
 //
 PackBufferInfo::PackBufferInfo() : BufferInfo() {}
 
+//_____________________________________________________________________________
+//
+void
+PackBufferInfo::setPackThreshold( int bytes )
+{
+  // negative: pack every message
+  s_pack_threshold     = ( bytes < 0 ) ? INT_MAX : bytes;
+  s_pack_threshold_set = true;
+}
+
+//_____________________________________________________________________________
+//
+int
+PackBufferInfo::measurePackThreshold( MPI_Comm comm )
+{
+  int rank = 0;
+  Uintah::MPI::Comm_rank( comm, &rank );
+
+  int threshold = INT_MAX;
+
+  if ( rank == 0 ) {
+    // a y face of an n^3 block of doubles: n rows of n doubles, one per z plane
+    const int max_n = 128;
+    std::vector<double> src( (max_n + 2) * (max_n + 2) * (max_n + 2), 1.0 );
+    std::vector<double> dst( src.size(), 0.0 );
+    std::vector<char>   packed( max_n * max_n * sizeof(double) + 1024 );
+    std::vector<char>   received( packed.size() );
+
+    bool datatype_wins = false;
+
+    for ( int n = max_n; n >= 4; n /= 2 ) {
+      const int      bytes  = n * n * sizeof(double);
+      const MPI_Aint plane  = (MPI_Aint) (n + 2) * (n + 2) * sizeof(double);
+      const int      nReps  = std::max( 4, std::min( 64, ( 1 << 20 ) / bytes ) );
+
+      MPI_Datatype type;
+      Uintah::MPI::Type_create_hvector( n, n, plane, MPI_DOUBLE, &type );
+      Uintah::MPI::Type_commit( &type );
+
+      double t_pack = 1e300;
+      double t_type = 1e300;
+      for ( int trial = 0; trial < 3; trial++ ) {
+        MPI_Request reqs[2];
+
+        double start = Uintah::MPI::Wtime();
+        for ( int rep = 0; rep < nReps; rep++ ) {
+          int position = 0;
+          Uintah::MPI::Pack( src.data(), 1, type, packed.data(), (int) packed.size(), &position, MPI_COMM_SELF );
+          Uintah::MPI::Irecv( received.data(), position, MPI_PACKED, 0, 0, MPI_COMM_SELF, &reqs[0] );
+          Uintah::MPI::Isend( packed.data(), position, MPI_PACKED, 0, 0, MPI_COMM_SELF, &reqs[1] );
+          Uintah::MPI::Waitall( 2, reqs, MPI_STATUSES_IGNORE );
+          const int size = position;
+          position = 0;
+          Uintah::MPI::Unpack( received.data(), size, &position, dst.data(), 1, type, MPI_COMM_SELF );
+        }
+        t_pack = std::min( t_pack, Uintah::MPI::Wtime() - start );
+
+        start = Uintah::MPI::Wtime();
+        for ( int rep = 0; rep < nReps; rep++ ) {
+          Uintah::MPI::Irecv( dst.data(), 1, type, 0, 0, MPI_COMM_SELF, &reqs[0] );
+          Uintah::MPI::Isend( src.data(), 1, type, 0, 0, MPI_COMM_SELF, &reqs[1] );
+          Uintah::MPI::Waitall( 2, reqs, MPI_STATUSES_IGNORE );
+        }
+        t_type = std::min( t_type, Uintah::MPI::Wtime() - start );
+      }
+      Uintah::MPI::Type_free( &type );
+
+      // from the largest size down, the threshold is the smallest size
+      // of the run of sizes for which the datatype send is faster
+      if ( t_type < t_pack ) {
+        threshold     = bytes;
+        datatype_wins = true;
+      }
+      else if ( datatype_wins || n == max_n ) {
+        break;
+      }
+    }
+  }
+
+  Uintah::MPI::Bcast( &threshold, 1, MPI_INT, 0, comm );
+
+  return threshold;
+}
+
 //_____________________________________________________________________________
 //
 PackBufferInfo::~PackBufferInfo()
@@ -60,6 +150,23 @@ PackBufferInfo::get_type( void         *& out_buf
 {
   ASSERT(count() > 0);
   if (!m_have_datatype) {
+
+    // large messages go out with their derived datatypes
+    if ( s_pack_threshold != INT_MAX ) {
+      long bytes = 0;
+      for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
+        int type_size;
+        Uintah::MPI::Type_size(m_datatypes[i], &type_size);
+        bytes += (long) m_counts[i] * type_size;
+      }
+
+      if ( bytes >= s_pack_threshold ) {
+        m_packed = false;
+        BufferInfo::get_type(out_buf, out_count, out_datatype);
+        return;
+      }
+    }
+
     int packed_size;
     int total_packed_size = 0;
     for (unsigned int i = 0; i < m_start_bufs.size(); i++) {
@@ -102,6 +209,12 @@ PackBufferInfo::pack( MPI_Comm comm, int & out_count )
 {
   ASSERT(m_have_datatype);
 
+  // sent from the variables, the send list keeps them alive
+  if (!m_packed) {
+    out_count = m_count;
+    return;
+  }
+
   int position = 0;
   int bufsize = m_packed_buffer->getBufSize();
   //for each buffer
@@ -127,6 +240,11 @@ PackBufferInfo::unpack( MPI_Comm comm, MPI_Status & status )
 {
   ASSERT(m_have_datatype);
 
+  // received in place
+  if (!m_packed) {
+    return;
+  }
+
   unsigned long bufsize = m_packed_buffer->getBufSize();
 
   int position = 0;
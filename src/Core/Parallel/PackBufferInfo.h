@@ -55,10 +55,33 @@ private:
 };
 
 
+//______________________________________________________________________
+//  Messages smaller than the pack threshold (in bytes of data) are packed
+//  into a contiguous buffer and sent as MPI_PACKED.  Larger messages are
+//  sent from and received into the variables directly with their derived
+//  datatypes, pack() and unpack() do nothing for them.  Both ends see the
+//  same entries, so they make the same choice as long as every rank uses
+//  the same threshold (see measurePackThreshold()).  By default every
+//  message is packed; a variable sent directly must not be modified
+//  before its send completes.
 class PackBufferInfo : public BufferInfo {
 
   public:
 
+    //////////
+    // Pack threshold in bytes, INT_MAX (the default) or a negative value
+    // packs every message.
+    static void setPackThreshold( int bytes );
+    static int  getPackThreshold() { return s_pack_threshold; }
+    static bool packThresholdSet() { return s_pack_threshold_set; }
+
+    //////////
+    // Collective over comm: rank 0 times packed and derived datatype
+    // self-sends of strided (ghost layer like) regions and returns the
+    // smallest message size from which the datatype send is faster.
+    // The result is broadcast so that all ranks agree.
+    static int measurePackThreshold( MPI_Comm comm );
+
     PackBufferInfo();
 
     ~PackBufferInfo();
@@ -87,11 +110,20 @@ class PackBufferInfo : public BufferInfo {
     }
 
 
+    //////////
+    // True when the message is packed, valid after get_type().
+    bool isPacked() const { return m_packed; }
+
   private:
 
     // disable copy and assignment
     PackedBuffer * m_packed_buffer{nullptr};
 
+    bool           m_packed{true};
+
+    static int     s_pack_threshold;
+    static bool    s_pack_threshold_set;
+
     // eliminate copy, assignment and move
     PackBufferInfo( const PackBufferInfo & )            = delete;
     PackBufferInfo& operator=( const PackBufferInfo & ) = delete;
@@ -27,13 +27,17 @@
 #include <Core/Exceptions/InternalError.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/ProcessorGroup.h>
+#include <Core/Parallel/ThreadExecutor.h>
 #include <Core/Parallel/UintahMPI.h>
 
 #include <sci_defs/kokkos_defs.h>
 
+#include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <sstream>
+#include <string>
 #include <thread>
 
 #ifdef _OPENMP
@@ -262,6 +266,27 @@ Parallel::initializeManager( int& argc , char**& argv )
   Uintah::AllocatorMallocStatsAppendNumber( s_world_rank );
 #endif
 
+  // ranks sharing a node share its cores, this is the budget for all the
+  // threads of this process (see ThreadExecutor)
+  {
+    MPI_Comm node_comm;
+    int      node_size = 1;
+#if UINTAH_ENABLE_MPI3
+    status = Uintah::MPI::Comm_split_type(Uintah::worldComm_, MPI_COMM_TYPE_SHARED, s_world_rank, MPI_INFO_NULL, &node_comm);
+#else
+    char name[MPI_MAX_PROCESSOR_NAME];
+    int  len = 0;
+    Uintah::MPI::Get_processor_name(name, &len);
+    const int color = (int)(std::hash<std::string>()(std::string(name, len)) & 0x7fffffff);
+    status = Uintah::MPI::Comm_split(Uintah::worldComm_, color, s_world_rank, &node_comm);
+#endif
+    if (status == MPI_SUCCESS) {
+      Uintah::MPI::Comm_size(node_comm, &node_size);
+      Uintah::MPI::Comm_free(&node_comm);
+    }
+    ThreadExecutor::setMaxThreads(ThreadExecutor::maxThreads() / std::max(node_size, 1));
+  }
+
 #ifdef UINTAH_ENABLE_KOKKOS
     s_root_context = scinew ProcessorGroup(nullptr, Uintah::worldComm_, s_world_rank, s_world_size, s_num_partitions);
 #else
@@ -271,6 +296,7 @@ Parallel::initializeManager( int& argc , char**& argv )
   if (s_root_context->myRank() == 0) {
     std::string plural = (s_root_context->nRanks() > 1) ? "processes" : "process";
     std::cout << "Parallel: " << s_root_context->nRanks() << " MPI " << plural << " (using MPI)\n";
+    std::cout << "Parallel: " << ThreadExecutor::maxThreads() << " cores per MPI process\n";
 
 #ifdef THREADED_MPI_AVAILABLE
 
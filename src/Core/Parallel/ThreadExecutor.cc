@@ -0,0 +1,329 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Parallel/ThreadExecutor.h>
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Parallel/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef __APPLE__
+#  include <sched.h>
+#endif
+
+using namespace Uintah;
+
+int ThreadExecutor::s_max_threads       = std::max( 1u, std::thread::hardware_concurrency() );
+int ThreadExecutor::s_scheduler_threads = 0;
+
+namespace {
+
+  struct PoolJob {
+    const ThreadExecutor::TaskFunction * body {nullptr};
+    int                                  nTasks {0};
+    int                                  nHelpers {0};
+    std::atomic<int>                     next {0};
+    std::mutex                           errorLock;
+    std::exception_ptr                   error;
+  };
+
+  // true while the calling thread executes a pool task
+  thread_local bool t_in_task = false;
+
+  //______________________________________________________________________
+  //
+  void workOn( PoolJob & job )
+  {
+    const bool outer = t_in_task;
+    t_in_task = true;
+    while (true) {
+      const int task = job.next.fetch_add(1);
+      if (task >= job.nTasks) {
+        break;
+      }
+      try {
+        (*job.body)(task);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(job.errorLock);
+        if (!job.error) {
+          job.error = std::current_exception();
+        }
+      }
+    }
+    t_in_task = outer;
+  }
+
+  //______________________________________________________________________
+  //  Helper threads used when no scheduler threads exist.  They are
+  //  started on first use and kept for the life of the process so that
+  //  the many short loops of a Krylov solve don't pay for thread creation.
+  //  One job runs at a time, a second caller runs its tasks serially.
+  class ThreadPool {
+  public:
+
+    static ThreadPool& instance()
+    {
+      static ThreadPool pool;
+      return pool;
+    }
+
+    // Run job on the calling thread and job.nHelpers pool threads.
+    // Returns false, without running anything, if the pool is in use.
+    bool run( PoolJob & job )
+    {
+      std::unique_lock<std::mutex> runLock(m_runLock, std::try_to_lock);
+      if (!runLock.owns_lock()) {
+        return false;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        while ((int)m_threads.size() < job.nHelpers) {
+          m_threads.emplace_back(&ThreadPool::worker, this, (int)m_threads.size());
+        }
+        m_job      = &job;
+        m_nHelpers = job.nHelpers;
+        m_pending  = job.nHelpers;
+        ++m_generation;
+      }
+      m_cv.notify_all();
+
+      workOn(job);
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_doneCv.wait(lock, [this] { return m_pending == 0; });
+      m_job = nullptr;
+      return true;
+    }
+
+    ~ThreadPool()
+    {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_cv.notify_all();
+      for (auto & t : m_threads) {
+        t.join();
+      }
+    }
+
+  private:
+
+    ThreadPool() {}
+
+    void worker( int id )
+    {
+      unsigned long seen = 0;
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while (true) {
+        m_cv.wait(lock, [&] { return m_stop || m_generation != seen; });
+        if (m_stop) {
+          return;
+        }
+        seen = m_generation;
+        if (id >= m_nHelpers) {
+          continue;
+        }
+        PoolJob* job = m_job;
+        lock.unlock();
+
+        workOn(*job);
+
+        lock.lock();
+        if (--m_pending == 0) {
+          m_doneCv.notify_one();
+        }
+      }
+    }
+
+    std::vector<std::thread> m_threads;
+    std::mutex               m_runLock;
+    std::mutex               m_mutex;
+    std::condition_variable  m_cv;
+    std::condition_variable  m_doneCv;
+    PoolJob*                 m_job {nullptr};
+    int                      m_nHelpers {0};
+    int                      m_pending {0};
+    unsigned long            m_generation {0};
+    bool                     m_stop {false};
+  };
+
+} // namespace
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::setMaxThreads( int num )
+{
+  s_max_threads = (num > 0) ? num : 1;
+}
+
+//______________________________________________________________________
+//
+int
+ThreadExecutor::maxThreads()
+{
+  return s_max_threads;
+}
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::startWorkers( int num, const TaskFunction & driver )
+{
+  setAffinity(0);
+
+  for (int i = 1; i <= num; ++i) {
+    std::thread worker( [driver, i]() {
+      setAffinity(i);
+      driver(i);
+    });
+    worker.detach();
+  }
+
+  s_scheduler_threads += num + 1;
+}
+
+//______________________________________________________________________
+//
+int
+ThreadExecutor::numSchedulerThreads()
+{
+  return s_scheduler_threads;
+}
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::reserveThreads( int num )
+{
+  s_scheduler_threads += std::max(num, 0);
+}
+
+//______________________________________________________________________
+//
+int
+ThreadExecutor::threadsPerTask()
+{
+  int busy = s_scheduler_threads;
+
+  // components may ask before the scheduler has started its threads
+  if (busy == 0) {
+    busy = std::max(Parallel::getNumThreads(), 1);
+    if (Parallel::getNumPartitions() > 0 && Parallel::getThreadsPerPartition() > 0) {
+      busy = std::max(busy, Parallel::getNumPartitions() * Parallel::getThreadsPerPartition());
+    }
+  }
+  return std::max(1, s_max_threads / busy);
+}
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::runTasks( int nTasks, const TaskFunction & body, int nThreads )
+{
+  if (nTasks <= 0) {
+    return;
+  }
+
+  int threads = (nThreads > 0) ? std::min(nThreads, s_max_threads) : s_max_threads;
+  threads = std::min(threads, nTasks);
+
+  const bool nested = t_in_task || LoopTileExecutor::inParallelLoop();
+
+  if (threads > 1 && !nested) {
+
+    // the scheduler owns the cores, use its idle threads
+    if (s_scheduler_threads > 0) {
+      LoopTileExecutor::run(nTasks, body);
+      return;
+    }
+
+    PoolJob job;
+    job.body     = &body;
+    job.nTasks   = nTasks;
+    job.nHelpers = threads - 1;
+    if (ThreadPool::instance().run(job)) {
+      if (job.error) {
+        std::rethrow_exception(job.error);
+      }
+      return;
+    }
+  }
+
+  for (int task = 0; task < nTasks; ++task) {
+    body(task);
+  }
+}
+
+//______________________________________________________________________
+//
+int
+ThreadExecutor::numChunks( int n, int nThreads, int minChunk )
+{
+  const int threads = (nThreads > 0) ? nThreads : s_max_threads;
+  return std::max(1, std::min(threads, n / std::max(minChunk, 1)));
+}
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::parallelFor( int n, int nThreads, int minChunk, const RangeFunction & body )
+{
+  const int nChunks = numChunks(n, nThreads, minChunk);
+  if (nChunks == 1) {
+    body(0, n, 0);
+    return;
+  }
+
+  runTasks(nChunks, [&](int chunk) {
+    const int begin = (int)((long)n * chunk / nChunks);
+    const int end   = (int)((long)n * (chunk + 1) / nChunks);
+    body(begin, end, chunk);
+  }, nChunks);
+}
+
+//______________________________________________________________________
+//
+void
+ThreadExecutor::setAffinity( int core )
+{
+#ifndef __APPLE__
+  // disable affinity on OSX since sched_setaffinity() is not available in OSX API
+  cpu_set_t mask;
+  unsigned int len = sizeof(mask);
+  CPU_ZERO(&mask);
+  CPU_SET(core, &mask);
+  sched_setaffinity(0, len, &mask);
+#endif
+}
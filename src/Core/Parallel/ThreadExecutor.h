@@ -0,0 +1,134 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+
+#ifndef CORE_PARALLEL_THREADEXECUTOR_H
+#define CORE_PARALLEL_THREADEXECUTOR_H
+
+#include <functional>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   ThreadExecutor
+
+GENERAL INFORMATION
+
+   ThreadExecutor.h
+
+KEYWORDS
+   threads, affinity, thread pool, oversubscription
+
+DESCRIPTION
+   Process-wide owner of the threads Uintah runs on.  It keeps one budget
+   of cores per MPI process (the cores of the node divided by the ranks on
+   that node) and every threaded piece of the code draws from it:
+
+     - the Unified scheduler's task runners are started by startWorkers()
+       and pinned to their cores here,
+
+     - thread pools the executor doesn't own (the Kokkos OpenMP partitions)
+       reserve their cores with reserveThreads(),
+
+     - component level work (solver row loops, particle fill, compare_uda)
+       is submitted with runTasks() or parallelFor().
+
+   While scheduler threads exist, submitted work runs as LoopTileExecutor
+   tiles on the idle scheduler threads, so it never adds threads of its
+   own.  Without scheduler threads (MPI scheduler, standalone tools) it
+   runs on a small pool owned by the executor, sized by the core budget.
+   Work submitted from inside a tile or a pool task runs serially on the
+   calling thread.
+
+****************************************/
+
+class ThreadExecutor {
+
+  public:
+
+    typedef std::function<void(int)>           TaskFunction;   // (task)
+    typedef std::function<void(int, int, int)> RangeFunction;  // (begin, end, chunk)
+
+    //////////
+    // Cores this process may keep busy.  Defaults to the hardware
+    // concurrency, Parallel::initializeManager() divides it by the number
+    // of ranks sharing the node.
+    static void setMaxThreads( int num );
+    static int  maxThreads();
+
+    //////////
+    // Start num long lived worker threads, worker i (1..num) runs driver(i)
+    // pinned to core i.  The calling thread is worker 0 and is pinned to
+    // core 0.  Used by the Unified scheduler, the threads are detached and
+    // live as long as the process.
+    static void startWorkers( int num, const TaskFunction & driver );
+
+    //////////
+    // Threads (including the main thread) a scheduler keeps busy, either
+    // started by startWorkers() or reserved by reserveThreads().
+    static int  numSchedulerThreads();
+
+    //////////
+    // Account for threads of a pool the executor doesn't own.
+    static void reserveThreads( int num );
+
+    //////////
+    // Threads a component may use inside a single scheduler task without
+    // oversubscribing the cores, at least 1.
+    static int  threadsPerTask();
+
+    //////////
+    // Execute body(task) for every task in [0, nTasks) on at most nThreads
+    // threads (0: no limit besides the core budget).  Tasks are handed
+    // out dynamically.  Returns when all tasks are done, the first
+    // exception thrown by a task is rethrown here.
+    static void runTasks( int nTasks, const TaskFunction & body, int nThreads = 0 );
+
+    //////////
+    // Split [0, n) into numChunks() contiguous chunks of at least minChunk
+    // entries and execute body(begin, end, chunk) for each.  The chunks
+    // only depend on n, nThreads and minChunk, so per chunk partial
+    // results can be combined in a reproducible order.
+    static int  numChunks( int n, int nThreads, int minChunk );
+    static void parallelFor( int n, int nThreads, int minChunk, const RangeFunction & body );
+
+    //////////
+    // Pin the calling thread to a core (no-op on OSX).
+    static void setAffinity( int core );
+
+  private:
+
+    static int s_max_threads;
+    static int s_scheduler_threads;
+
+    // eliminate public constructor
+    ThreadExecutor();
+};
+
+} // End namespace Uintah
+
+#endif // CORE_PARALLEL_THREADEXECUTOR_H
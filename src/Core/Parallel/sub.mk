@@ -34,9 +34,11 @@ SRCDIR   := Core/Parallel
 
 SRCS     += \
 	$(SRCDIR)/BufferInfo.cc              \
+	$(SRCDIR)/LoopTileExecutor.cc        \
 	$(SRCDIR)/PackBufferInfo.cc          \
 	$(SRCDIR)/Parallel.cc                \
 	$(SRCDIR)/ProcessorGroup.cc          \
+	$(SRCDIR)/ThreadExecutor.cc          \
 	$(SRCDIR)/UintahParallelComponent.cc \
 	$(SRCDIR)/UintahParallelPort.cc
 
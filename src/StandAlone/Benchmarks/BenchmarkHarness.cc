@@ -0,0 +1,273 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <StandAlone/Benchmarks/BenchmarkHarness.h>
+
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+
+using namespace Uintah;
+
+namespace {
+
+std::string jsonString( const std::string & s )
+{
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+} // namespace
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::add( const std::string & name
+                     , double              items
+                     , const std::string & units
+                     , Body                body
+                     , Body                setup
+                     , Body                teardown
+                     )
+{
+  m_entries.push_back( Entry{ name, units, items, body, setup, teardown } );
+}
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::run( std::ostream & log )
+{
+  log << std::setw(48) << std::left << "benchmark" << std::right
+      << std::setw(8)  << "calls"
+      << std::setw(14) << "median"
+      << std::setw(14) << "min"
+      << std::setw(10) << "stddev"
+      << std::setw(16) << "throughput" << "\n";
+
+  for (const Entry & e : m_entries) {
+    if (!m_options.filter.empty() && e.name.find(m_options.filter) == std::string::npos) {
+      continue;
+    }
+
+    Timers::Simple timer;
+
+    // Warmup, also measuring the cost of a single call
+    if (e.setup) {
+      e.setup();
+    }
+    double warm = 0.0;
+    int    nwarm = std::max(1, m_options.warmup);
+    timer.reset(true);
+    for (int i = 0; i < nwarm; i++) {
+      e.body();
+    }
+    warm = timer().seconds() / nwarm;
+    if (e.teardown) {
+      e.teardown();
+    }
+
+    Result r;
+    r.name  = e.name;
+    r.units = e.units;
+    r.items = e.items;
+    if (warm > 0.0) {
+      r.callsPerSample = std::max(1, static_cast<int>(std::ceil(m_options.minTime / warm)));
+    }
+
+    for (int rep = 0; rep < m_options.repetitions; rep++) {
+      if (e.setup) {
+        e.setup();
+      }
+      timer.reset(true);
+      for (int i = 0; i < r.callsPerSample; i++) {
+        e.body();
+      }
+      double t = timer().seconds();
+      if (e.teardown) {
+        e.teardown();
+      }
+      r.samples.push_back(t / r.callsPerSample);
+    }
+
+    computeStatistics(r);
+
+    std::ostringstream thru;
+    thru << std::setprecision(4) << (r.median > 0.0 ? r.items / r.median : 0.0) << " " << r.units << "/s";
+
+    log << std::setw(48) << std::left << r.name << std::right
+        << std::setw(8)  << r.callsPerSample
+        << std::setw(11) << std::setprecision(4) << r.median * 1.e6 << " us"
+        << std::setw(11) << std::setprecision(4) << r.min    * 1.e6 << " us"
+        << std::setw(9)  << std::setprecision(2) << (r.mean > 0.0 ? 100.0 * r.stddev / r.mean : 0.0) << "%"
+        << "  " << thru.str() << std::endl;
+
+    m_results.push_back(r);
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::computeStatistics( Result & r )
+{
+  if (r.samples.empty()) {
+    return;
+  }
+
+  std::vector<double> sorted = r.samples;
+  std::sort(sorted.begin(), sorted.end());
+
+  const size_t n = sorted.size();
+  r.min    = sorted.front();
+  r.max    = sorted.back();
+  r.mean   = std::accumulate(sorted.begin(), sorted.end(), 0.0) / n;
+  r.median = (n % 2) ? sorted[n/2] : 0.5 * (sorted[n/2 - 1] + sorted[n/2]);
+
+  double var = 0.0;
+  for (double s : sorted) {
+    var += (s - r.mean) * (s - r.mean);
+  }
+  r.stddev = (n > 1) ? std::sqrt(var / (n - 1)) : 0.0;
+}
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::writeJSON( std::ostream & out ) const
+{
+  out << std::setprecision(9);
+  out << "{\n"
+      << "  \"options\": {"
+      << " \"warmup\": "      << m_options.warmup
+      << ", \"repetitions\": " << m_options.repetitions
+      << ", \"min_time\": "    << m_options.minTime
+      << " },\n"
+      << "  \"benchmarks\": [\n";
+
+  for (size_t i = 0; i < m_results.size(); i++) {
+    const Result & r = m_results[i];
+    out << "    {\n"
+        << "      \"name\": "             << jsonString(r.name)  << ",\n"
+        << "      \"units\": "            << jsonString(r.units) << ",\n"
+        << "      \"items_per_call\": "   << r.items             << ",\n"
+        << "      \"calls_per_sample\": " << r.callsPerSample    << ",\n"
+        << "      \"min\": "              << r.min               << ",\n"
+        << "      \"max\": "              << r.max               << ",\n"
+        << "      \"mean\": "             << r.mean              << ",\n"
+        << "      \"median\": "           << r.median            << ",\n"
+        << "      \"stddev\": "           << r.stddev            << ",\n"
+        << "      \"throughput\": "       << (r.median > 0.0 ? r.items / r.median : 0.0) << ",\n"
+        << "      \"samples\": [";
+    for (size_t s = 0; s < r.samples.size(); s++) {
+      out << (s ? ", " : "") << r.samples[s];
+    }
+    out << "]\n"
+        << "    }" << (i + 1 < m_results.size() ? "," : "") << "\n";
+  }
+
+  out << "  ]\n"
+      << "}\n";
+}
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::finish( std::ostream & log ) const
+{
+  if (m_options.jsonFile.empty()) {
+    return;
+  }
+
+  if (m_options.jsonFile == "-") {
+    writeJSON(std::cout);
+    return;
+  }
+
+  std::ofstream out(m_options.jsonFile.c_str());
+  if (!out) {
+    log << "Unable to open " << m_options.jsonFile << " for writing\n";
+    return;
+  }
+  writeJSON(out);
+  log << "Wrote " << m_results.size() << " results to " << m_options.jsonFile << "\n";
+}
+
+//______________________________________________________________________
+//
+bool
+BenchmarkHarness::parseArgs( int & argc, char ** argv, Options & options )
+{
+  int out = 1;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    bool hasValue = (i + 1 < argc);
+
+    if (arg == "-warmup" || arg == "-reps" || arg == "-mintime" ||
+        arg == "-filter" || arg == "-json") {
+      if (!hasValue) {
+        std::cerr << "Missing value for " << arg << "\n";
+        return false;
+      }
+      std::string value = argv[++i];
+      if      (arg == "-warmup")  { options.warmup      = atoi(value.c_str()); }
+      else if (arg == "-reps")    { options.repetitions = std::max(1, atoi(value.c_str())); }
+      else if (arg == "-mintime") { options.minTime     = atof(value.c_str()); }
+      else if (arg == "-filter")  { options.filter      = value; }
+      else                        { options.jsonFile    = value; }
+    }
+    else {
+      argv[out++] = argv[i];
+    }
+  }
+  argc = out;
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+BenchmarkHarness::usage( std::ostream & out )
+{
+  out << "  -warmup <n>      Untimed calls before sampling (default 3)\n"
+      << "  -reps <n>        Number of timed samples (default 10)\n"
+      << "  -mintime <s>     Minimum duration of one sample in seconds (default 0.05)\n"
+      << "  -filter <str>    Only run benchmarks whose name contains <str>\n"
+      << "  -json <file>     Write results as JSON to <file> (\"-\" for stdout)\n";
+}
@@ -0,0 +1,132 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef STANDALONE_BENCHMARKS_BENCHMARKHARNESS_H
+#define STANDALONE_BENCHMARKS_BENCHMARKHARNESS_H
+
+/*
+ *  BenchmarkHarness: repeatable timing of small kernels.
+ *
+ *  Each registered benchmark is a callable that performs one unit of
+ *  work (a "call").  The harness
+ *
+ *    - runs a number of warmup calls and uses them to pick how many
+ *      calls make up one sample, so every sample lasts at least
+ *      the requested minimum time,
+ *    - collects the requested number of samples,
+ *    - reports min/max/mean/median/stddev of the time per call and the
+ *      throughput (items per second, using the median),
+ *    - optionally writes all results, including the raw samples, as JSON
+ *      so runs on different builds/machines can be diffed by scripts.
+ *
+ *  Optional setup/teardown callbacks run once per sample outside the
+ *  timed region (for example to reset a data structure the benchmark
+ *  consumes).
+ */
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+class BenchmarkHarness {
+
+public:
+
+  struct Options {
+    int         warmup      {3};      // untimed calls before sampling
+    int         repetitions {10};     // number of timed samples
+    double      minTime     {0.05};   // minimum duration of one sample (s)
+    std::string filter      {};       // only run benchmarks whose name contains this
+    std::string jsonFile    {};       // "" = no JSON, "-" = stdout
+  };
+
+  struct Result {
+    std::string         name;
+    std::string         units;
+    double              items        {1.0};   // work items per call
+    int                 callsPerSample {1};
+    std::vector<double> samples;              // seconds per call
+    double              min    {0.0};
+    double              max    {0.0};
+    double              mean   {0.0};
+    double              median {0.0};
+    double              stddev {0.0};
+  };
+
+  using Body = std::function<void()>;
+
+  BenchmarkHarness( const Options & options ) : m_options(options) {}
+
+  // Register a benchmark; 'items' is the work done by one call of
+  // 'body', counted in 'units' (cells, particles, bytes, tasks, ...).
+  void add( const std::string & name
+          , double              items
+          , const std::string & units
+          , Body                body
+          , Body                setup    = nullptr
+          , Body                teardown = nullptr
+          );
+
+  // Run every registered benchmark that matches the filter.
+  void run( std::ostream & log );
+
+  void writeJSON( std::ostream & out ) const;
+
+  // Writes the JSON report if one was requested in the options.
+  void finish( std::ostream & log ) const;
+
+  const std::vector<Result> & results() const { return m_results; }
+
+  // Consumes the harness options (-warmup, -reps, -mintime, -filter,
+  // -json) from argv, leaving the remaining arguments in place.
+  // Returns false on a malformed option.
+  static bool parseArgs( int & argc, char ** argv, Options & options );
+
+  static void usage( std::ostream & out );
+
+private:
+
+  struct Entry {
+    std::string name;
+    std::string units;
+    double      items;
+    Body        body;
+    Body        setup;
+    Body        teardown;
+  };
+
+  static void computeStatistics( Result & r );
+
+  Options             m_options;
+  std::vector<Entry>  m_entries;
+  std::vector<Result> m_results;
+};
+
+} // end namespace Uintah
+
+#endif // STANDALONE_BENCHMARKS_BENCHMARKHARNESS_H
@@ -0,0 +1,623 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  CoreKernels.cc: Micro benchmarks of the Core/Grid and scheduler kernels
+ *                  that dominate the non-physics part of a time step.
+ *
+ *    - stencil      7-point Laplacian on a CCVariable, CellIterator versus
+ *                   BlockRange serial_for/parallel_for
+ *    - ghost        GridVariable::copyPatch of the six ghost layers
+ *    - interp       ParticleInterpolator weights (and weights + gradients)
+ *                   for each interpolator
+ *    - relocate     Particle variable pack/unpack as done by Relocate
+ *    - io           Variable::emit/read, uncompressed and gzip
+ *    - dwdb         DWDatabase lookups from several threads
+ *    - tasks        DetailedTasks internal ready queue throughput
+ *
+ *  Timing, warmup, statistics and the JSON report are handled by
+ *  BenchmarkHarness.
+ */
+
+#include <StandAlone/Benchmarks/BenchmarkHarness.h>
+
+#include <CCA/Components/Schedulers/DetailedTask.h>
+#include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/DWDatabase.h>
+#include <CCA/Ports/InputContext.h>
+#include <CCA/Ports/OutputContext.h>
+
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/Grid/AxiGIMPInterpolator.h>
+#include <Core/Grid/AxiLinearInterpolator.h>
+#include <Core/Grid/BSplineInterpolator.h>
+#include <Core/Grid/GIMPInterpolator.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/LinearInterpolator.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/TOBSplineInterpolator.h>
+#include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/BlockRange.hpp>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/CellIterator.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Grid/Variables/VarLabel.h>
+#include <Core/Grid/axiCpdiInterpolator.h>
+#include <Core/Grid/axiCptiInterpolator.h>
+#include <Core/Grid/cpdiInterpolator.h>
+#include <Core/Grid/cptiInterpolator.h>
+#include <Core/Grid/fastCpdiInterpolator.h>
+#include <Core/Math/Matrix3.h>
+#include <Core/Parallel/LoopTileExecutor.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ProcessorGroup.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int CELLS_DEFAULT     = 64;
+const int PARTICLES_DEFAULT = 100000;
+const int THREADS_DEFAULT   = 4;
+
+void usage( void )
+{
+  cerr << "Usage: CoreKernels [options] [<cells> [<particles> [<threads>]]]" << endl;
+  cerr << endl;
+  cerr << "  <cells>      Cells per side of the benchmark patch (default " << CELLS_DEFAULT << ")." << endl;
+  cerr << "  <particles>  Number of particles (default " << PARTICLES_DEFAULT << ")." << endl;
+  cerr << "  <threads>    Maximum number of threads for the threaded benchmarks (default " << THREADS_DEFAULT << ")." << endl;
+  cerr << endl;
+  BenchmarkHarness::usage(cerr);
+}
+
+//______________________________________________________________________
+//  Idle "scheduler" threads feeding the threaded BlockRange loops
+class LoopHelpers {
+public:
+  LoopHelpers( int num )
+  {
+    LoopTileExecutor::setEnabled(true);
+    LoopTileExecutor::setNumHelpers(num);
+    for (int i = 0; i < num; i++) {
+      m_threads.emplace_back([this]() {
+        while (!m_stop.load(std::memory_order_relaxed)) {
+          if (!LoopTileExecutor::help()) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+  }
+
+  ~LoopHelpers()
+  {
+    m_stop = true;
+    for (auto & t : m_threads) {
+      t.join();
+    }
+    LoopTileExecutor::setNumHelpers(0);
+  }
+
+private:
+  std::atomic<bool>        m_stop {false};
+  std::vector<std::thread> m_threads;
+};
+
+//______________________________________________________________________
+//
+void addStencilBenchmarks( BenchmarkHarness & h, const Patch * patch, int maxThreads )
+{
+  auto phi = std::make_shared<CCVariable<double>>();
+  auto lap = std::make_shared<CCVariable<double>>();
+  phi->allocate(patch, IntVector(1,1,1));
+  lap->allocate(patch, IntVector(0,0,0));
+
+  for (CellIterator iter(phi->getLowIndex(), phi->getHighIndex()); !iter.done(); iter++) {
+    const IntVector & c = *iter;
+    (*phi)[c] = std::sin(0.1 * c.x()) * std::cos(0.07 * c.y()) + 0.01 * c.z();
+  }
+
+  const IntVector lo = patch->getCellLowIndex();
+  const IntVector hi = patch->getCellHighIndex();
+  const double ncells = patch->getNumCells();
+
+  h.add("stencil/CellIterator", ncells, "cells", [=]() {
+    CCVariable<double> & L = *lap;
+    const CCVariable<double> & P = *phi;
+    for (CellIterator iter = patch->getCellIterator(); !iter.done(); iter++) {
+      const IntVector & c = *iter;
+      L[c] = P[c + IntVector(1,0,0)] + P[c - IntVector(1,0,0)]
+           + P[c + IntVector(0,1,0)] + P[c - IntVector(0,1,0)]
+           + P[c + IntVector(0,0,1)] + P[c - IntVector(0,0,1)]
+           - 6.0 * P[c];
+    }
+  });
+
+  auto kernel = [=]( int i, int j, int k ) {
+    CCVariable<double> & L = *lap;
+    const CCVariable<double> & P = *phi;
+    L(i,j,k) = P(i+1,j,k) + P(i-1,j,k)
+             + P(i,j+1,k) + P(i,j-1,k)
+             + P(i,j,k+1) + P(i,j,k-1)
+             - 6.0 * P(i,j,k);
+  };
+
+  h.add("stencil/BlockRange serial_for", ncells, "cells", [=]() {
+    serial_for(BlockRange(lo, hi), kernel);
+  });
+
+  for (int nt = 1; nt <= maxThreads; nt *= 2) {
+    auto helpers = std::make_shared<std::unique_ptr<LoopHelpers>>();
+    ostringstream name;
+    name << "stencil/BlockRange parallel_for " << nt << "t";
+    h.add(name.str(), ncells, "cells",
+          [=]() { parallel_for(BlockRange(lo, hi), kernel); },
+          [=]() { helpers->reset(scinew LoopHelpers(nt - 1)); },
+          [=]() { helpers->reset(); });
+  }
+}
+
+//______________________________________________________________________
+//  Copy the six ghost layers of one patch from a neighbor's variable
+void addGhostCopyBenchmarks( BenchmarkHarness & h, const Patch * patch )
+{
+  for (int ngc : {1, 2}) {
+    auto src = std::make_shared<CCVariable<double>>();
+    auto dst = std::make_shared<CCVariable<double>>();
+    src->allocate(patch, IntVector(ngc,ngc,ngc));
+    dst->allocate(patch, IntVector(ngc,ngc,ngc));
+    src->initialize(1.0);
+    dst->initialize(0.0);
+
+    const IntVector lo = patch->getCellLowIndex();
+    const IntVector hi = patch->getCellHighIndex();
+    const IntVector glo = lo - IntVector(ngc,ngc,ngc);
+    const IntVector ghi = hi + IntVector(ngc,ngc,ngc);
+
+    // faces, x faces span the full ghosted extent in y and z
+    std::vector<std::pair<IntVector, IntVector>> regions;
+    regions.push_back({ glo, IntVector(lo.x(), ghi.y(), ghi.z()) });
+    regions.push_back({ IntVector(hi.x(), glo.y(), glo.z()), ghi });
+    regions.push_back({ IntVector(lo.x(), glo.y(), glo.z()), IntVector(hi.x(), lo.y(), ghi.z()) });
+    regions.push_back({ IntVector(lo.x(), hi.y(), glo.z()),  IntVector(hi.x(), ghi.y(), ghi.z()) });
+    regions.push_back({ IntVector(lo.x(), lo.y(), glo.z()),  IntVector(hi.x(), hi.y(), lo.z()) });
+    regions.push_back({ IntVector(lo.x(), lo.y(), hi.z()),   IntVector(hi.x(), hi.y(), ghi.z()) });
+
+    double ncopied = 0.0;
+    for (const auto & r : regions) {
+      IntVector d = r.second - r.first;
+      ncopied += double(d.x()) * d.y() * d.z();
+    }
+
+    ostringstream name;
+    name << "ghost/copyPatch " << ngc << " layer" << (ngc > 1 ? "s" : "");
+    h.add(name.str(), ncopied, "cells", [=]() {
+      for (const auto & r : regions) {
+        dst->copyPatch(*src, r.first, r.second);
+      }
+    });
+  }
+}
+
+//______________________________________________________________________
+//
+void addInterpolatorBenchmarks( BenchmarkHarness & h, const Patch * patch, int nparticles )
+{
+  struct Particles {
+    std::vector<Point>   x;
+    std::vector<Matrix3> size;
+  };
+  auto parts = std::make_shared<Particles>();
+
+  // random positions inside the patch, stay a cell away from the
+  // boundary so the larger stencils don't leave the domain
+  std::mt19937 gen(12345);
+  const Point  lo = patch->getLevel()->getCellPosition(patch->getCellLowIndex()  + IntVector(1,1,1));
+  const Point  hi = patch->getLevel()->getCellPosition(patch->getCellHighIndex() - IntVector(2,2,2));
+  std::uniform_real_distribution<double> ux(lo.x(), hi.x()), uy(lo.y(), hi.y()), uz(lo.z(), hi.z());
+
+  Matrix3 psize(0.5, 0.0, 0.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.5);   // 2 particles per cell per direction
+  for (int p = 0; p < nparticles; p++) {
+    parts->x.push_back(Point(ux(gen), uy(gen), uz(gen)));
+    parts->size.push_back(psize);
+  }
+
+  std::vector<std::pair<std::string, ParticleInterpolator*>> interpolators = {
+      { "linear",       scinew LinearInterpolator(patch)      }
+    , { "gimp",         scinew GIMPInterpolator(patch)        }
+    , { "cpdi",         scinew cpdiInterpolator(patch)        }
+    , { "fast_cpdi",    scinew fastCpdiInterpolator(patch)    }
+    , { "cpti",         scinew cptiInterpolator(patch)        }
+    , { "3rdorderBS",   scinew BSplineInterpolator(patch)     }
+    , { "4thorderBS",   scinew TOBSplineInterpolator(patch)   }
+    , { "axi_linear",   scinew AxiLinearInterpolator(patch)   }
+    , { "axi_gimp",     scinew AxiGIMPInterpolator(patch)     }
+    , { "axi_cpdi",     scinew axiCpdiInterpolator(patch)     }
+    , { "axi_cpti",     scinew axiCptiInterpolator(patch)     }
+  };
+
+  for (auto & entry : interpolators) {
+    std::shared_ptr<ParticleInterpolator> interp(entry.second);
+
+    h.add("interp/" + entry.first + " weights", nparticles, "particles", [=]() {
+      std::vector<IntVector> ni(interp->size());
+      std::vector<double>    S(interp->size());
+      for (size_t p = 0; p < parts->x.size(); p++) {
+        interp->findCellAndWeights(parts->x[p], ni, S, parts->size[p]);
+      }
+    });
+
+    h.add("interp/" + entry.first + " weights+gradients", nparticles, "particles", [=]() {
+      std::vector<IntVector> ni(interp->size());
+      std::vector<double>    S(interp->size());
+      std::vector<Vector>    d_S(interp->size());
+      for (size_t p = 0; p < parts->x.size(); p++) {
+        interp->findCellAndWeightsAndShapeDerivatives(parts->x[p], ni, S, d_S, parts->size[p]);
+      }
+    });
+  }
+}
+
+//______________________________________________________________________
+//  The MPI pack/unpack of a typical MPM particle state, as done by
+//  Relocate for the particles leaving a patch
+void addRelocateBenchmarks( BenchmarkHarness & h, const Patch * patch,
+                            const ProcessorGroup * pg, int nparticles )
+{
+  struct State {
+    ParticleSubset*                pset {nullptr};
+    ParticleVariable<Point>        x,    x_in;
+    ParticleVariable<Vector>       v,    v_in;
+    ParticleVariable<double>       m,    m_in;
+    ParticleVariable<Matrix3>      F,    F_in;
+    ParticleVariable<long64>       id,   id_in;
+    std::vector<char>              buffer;
+    int                            position {0};
+
+    ~State() { if (pset && pset->removeReference()) { delete pset; } }
+  };
+  auto s = std::make_shared<State>();
+
+  s->pset = scinew ParticleSubset(nparticles, 0, patch);
+  s->pset->addReference();
+
+  s->x.allocate(s->pset);  s->x_in.allocate(s->pset);
+  s->v.allocate(s->pset);  s->v_in.allocate(s->pset);
+  s->m.allocate(s->pset);  s->m_in.allocate(s->pset);
+  s->F.allocate(s->pset);  s->F_in.allocate(s->pset);
+  s->id.allocate(s->pset); s->id_in.allocate(s->pset);
+
+  Matrix3 one;
+  one.Identity();
+  for (int p = 0; p < nparticles; p++) {
+    s->x[p]  = Point(p, 0.5 * p, 0.25 * p);
+    s->v[p]  = Vector(1.0, 2.0, 3.0);
+    s->m[p]  = 1.0e-3;
+    s->F[p]  = one;
+    s->id[p] = p;
+  }
+
+  int size = 0;
+  s->x.packsizeMPI(&size, pg, s->pset);
+  s->v.packsizeMPI(&size, pg, s->pset);
+  s->m.packsizeMPI(&size, pg, s->pset);
+  s->F.packsizeMPI(&size, pg, s->pset);
+  s->id.packsizeMPI(&size, pg, s->pset);
+  s->buffer.resize(size);
+
+  auto pack = [=]() {
+    int bufsize = s->buffer.size();
+    s->position = 0;
+    s->x.packMPI(s->buffer.data(), bufsize, &s->position, pg, s->pset, patch);
+    s->v.packMPI(s->buffer.data(), bufsize, &s->position, pg, s->pset);
+    s->m.packMPI(s->buffer.data(), bufsize, &s->position, pg, s->pset);
+    s->F.packMPI(s->buffer.data(), bufsize, &s->position, pg, s->pset);
+    s->id.packMPI(s->buffer.data(), bufsize, &s->position, pg, s->pset);
+  };
+
+  h.add("relocate/pack", nparticles, "particles", pack);
+
+  h.add("relocate/unpack", nparticles, "particles", [=]() {
+    int bufsize = s->buffer.size();
+    int position = 0;
+    s->x_in.unpackMPI(s->buffer.data(), bufsize, &position, pg, s->pset);
+    s->v_in.unpackMPI(s->buffer.data(), bufsize, &position, pg, s->pset);
+    s->m_in.unpackMPI(s->buffer.data(), bufsize, &position, pg, s->pset);
+    s->F_in.unpackMPI(s->buffer.data(), bufsize, &position, pg, s->pset);
+    s->id_in.unpackMPI(s->buffer.data(), bufsize, &position, pg, s->pset);
+  }, pack);
+}
+
+//______________________________________________________________________
+//  Variable::emit to a scratch file and Variable::read back from memory
+void addIOBenchmarks( BenchmarkHarness & h, const Patch * patch )
+{
+  struct State {
+    CCVariable<double> var;
+    CCVariable<double> in;
+    ProblemSpecP       varnode;
+    std::string        filename;
+    int                fd {-1};
+    std::string        contents;
+    std::string        compression;
+
+    ~State()
+    {
+      if (fd >= 0) {
+        close(fd);
+        unlink(filename.c_str());
+      }
+    }
+  };
+
+  const IntVector lo = patch->getExtraCellLowIndex();
+  const IntVector hi = patch->getExtraCellHighIndex();
+  const double    nbytes = patch->getNumExtraCells() * sizeof(double);
+
+  for (std::string mode : { "none", "gzip" }) {
+    auto s = std::make_shared<State>();
+
+    char name[] = "/tmp/CoreKernelsXXXXXX";
+    s->fd = mkstemp(name);
+    if (s->fd < 0) {
+      cerr << "Unable to create a scratch file, skipping the io benchmarks\n";
+      return;
+    }
+    s->filename = name;
+
+    s->var.allocate(patch, IntVector(0,0,0));
+    s->in.allocate(patch, IntVector(0,0,0));
+    for (CellIterator iter = patch->getExtraCellIterator(); !iter.done(); iter++) {
+      const IntVector & c = *iter;
+      s->var[c] = std::sin(0.1 * c.x()) * std::cos(0.07 * c.y()) + 0.01 * c.z();
+    }
+
+    auto newVarnode = [=]() { s->varnode = scinew ProblemSpec("<Variable/>"); };
+
+    auto emit = [=]() {
+      lseek(s->fd, 0, SEEK_SET);
+      OutputContext oc(s->fd, s->filename.c_str(), 0, s->varnode);
+      s->var.emit(oc, lo, hi, mode);
+    };
+
+    h.add("io/emit " + mode, nbytes, "bytes", emit, newVarnode);
+
+    // keep a copy of what was written, and how, for the read benchmark
+    newVarnode();
+    emit();
+    ProblemSpecP comp = s->varnode->findBlock("compression");
+    if (comp) {
+      s->compression = comp->getNodeValue();
+    }
+    s->contents.resize(lseek(s->fd, 0, SEEK_CUR));
+    if (pread(s->fd, &s->contents[0], s->contents.size(), 0) != static_cast<ssize_t>(s->contents.size())) {
+      cerr << "Unable to read back " << s->filename << ", skipping the io benchmarks\n";
+      return;
+    }
+
+    h.add("io/read " + mode, nbytes, "bytes", [=]() {
+      InputContext ic(s->contents.data(), 0, s->filename.c_str(), 0);
+      static_cast<Variable&>(s->in).read(ic, s->contents.size(), false, sizeof(void*), s->compression);
+    });
+  }
+}
+
+//______________________________________________________________________
+//  DWDatabase get() from several threads, all contending for the key
+//  database lock
+void addDWDatabaseBenchmarks( BenchmarkHarness & h, const Patch * patch, int maxThreads )
+{
+  const int nlabels  = 64;
+  const int nmatls   = 8;
+  const int nlookups = 100000;   // per thread
+
+  struct State {
+    std::vector<VarLabel*>  labels;
+    KeyDatabase<Patch>      keys;
+    DWDatabase<Patch>       db;
+
+    ~State()
+    {
+      db.clear();
+      for (auto label : labels) {
+        VarLabel::destroy(label);
+      }
+    }
+  };
+  auto s = std::make_shared<State>();
+
+  for (int l = 0; l < nlabels; l++) {
+    ostringstream name;
+    name << "CoreKernels_var" << l;
+    s->labels.push_back(VarLabel::create(name.str(), CCVariable<double>::getTypeDescription()));
+    for (int m = 0; m < nmatls; m++) {
+      s->keys.insert(s->labels.back(), m, patch);
+    }
+  }
+  s->db.doReserve(&s->keys);
+  for (int l = 0; l < nlabels; l++) {
+    for (int m = 0; m < nmatls; m++) {
+      s->db.put(s->labels[l], m, patch, scinew CCVariable<double>(), true, false);
+    }
+  }
+
+  for (int nt = 1; nt <= maxThreads; nt *= 2) {
+    ostringstream name;
+    name << "dwdb/get " << nt << "t";
+    h.add(name.str(), double(nt) * nlookups, "lookups", [=]() {
+      auto lookups = [=]( int seed ) {
+        unsigned int key = seed;
+        for (int i = 0; i < nlookups; i++) {
+          key = key * 1664525u + 1013904223u;
+          const int l = (key >> 8) % nlabels;
+          const int m = (key >> 20) % nmatls;
+          if (s->db.get(s->labels[l], m, patch) == nullptr) {
+            SCI_THROW(InternalError("DWDatabase lookup failed", __FILE__, __LINE__));
+          }
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (int t = 1; t < nt; t++) {
+        threads.emplace_back(lookups, t);
+      }
+      lookups(0);
+      for (auto & t : threads) {
+        t.join();
+      }
+    });
+  }
+}
+
+//______________________________________________________________________
+//  Reset and drain of the DetailedTasks internal ready queue, drained by
+//  several threads contending for the queue lock
+void addTaskQueueBenchmarks( BenchmarkHarness & h, const ProcessorGroup * pg, int maxThreads )
+{
+  const int ntasks = 10000;
+
+  struct State {
+    std::unique_ptr<Task>          task;
+    std::unique_ptr<DetailedTasks> dts;
+  };
+  auto s = std::make_shared<State>();
+
+  s->task.reset(scinew Task("CoreKernels_task", Task::Normal));
+  s->dts.reset(scinew DetailedTasks(nullptr, pg, nullptr, std::unordered_set<int>(), false));
+  for (int i = 0; i < ntasks; i++) {
+    DetailedTask* dtask = scinew DetailedTask(s->task.get(), nullptr, nullptr, s->dts.get());
+    dtask->assignResource(pg->myRank());
+    s->dts->add(dtask);
+  }
+  s->dts->computeLocalTasks();
+
+  for (int nt = 1; nt <= maxThreads; nt *= 2) {
+    ostringstream name;
+    name << "tasks/initTimestep+drain " << nt << "t";
+    h.add(name.str(), ntasks, "tasks", [=]() {
+      s->dts->initTimestep();
+
+      auto drain = [=]() {
+        while (s->dts->getNextInternalReadyTask() != nullptr) {
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (int t = 1; t < nt; t++) {
+        threads.emplace_back(drain);
+      }
+      drain();
+      for (auto & t : threads) {
+        t.join();
+      }
+    });
+  }
+}
+
+//______________________________________________________________________
+//
+int main( int argc, char *argv[] )
+{
+  BenchmarkHarness::Options options;
+  if (!BenchmarkHarness::parseArgs(argc, argv, options)) {
+    usage();
+    exit(1);
+  }
+
+  int cells      = CELLS_DEFAULT;
+  int particles  = PARTICLES_DEFAULT;
+  int maxThreads = THREADS_DEFAULT;
+
+  if (argc > 1) {
+    if (string(argv[1]) == "-h" || string(argv[1]) == "-help") {
+      usage();
+      exit(0);
+    }
+    cells = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    particles = atoi(argv[2]);
+  }
+  if (argc > 3) {
+    maxThreads = atoi(argv[3]);
+  }
+  if (cells < 4 || particles < 1 || maxThreads < 1) {
+    usage();
+    exit(1);
+  }
+
+  Uintah::Parallel::initializeManager(argc, argv);
+  const ProcessorGroup* world = Uintah::Parallel::getRootProcessorGroup();
+
+  int status = 0;
+  try {
+    // one patch with a layer of extra cells, unit cells
+    GridP  grid  = scinew Grid();
+    Level* level = grid->addLevel(Point(0,0,0), Vector(1,1,1), 0);
+    level->addPatch(IntVector(-1,-1,-1), IntVector(cells+1,cells+1,cells+1),
+                    IntVector(0,0,0), IntVector(cells,cells,cells), grid.get_rep(), 0);
+    level->finalizeLevel();
+    const Patch* patch = level->getPatch(0);
+
+    cout << "CoreKernels: " << cells << "^3 cells, " << particles << " particles, up to "
+         << maxThreads << " threads" << endl;
+
+    BenchmarkHarness harness(options);
+
+    addStencilBenchmarks(harness, patch, maxThreads);
+    addGhostCopyBenchmarks(harness, patch);
+    addInterpolatorBenchmarks(harness, patch, particles);
+    addRelocateBenchmarks(harness, patch, world, particles);
+    addIOBenchmarks(harness, patch);
+    addDWDatabaseBenchmarks(harness, patch, maxThreads);
+    addTaskQueueBenchmarks(harness, world, maxThreads);
+
+    harness.run(cout);
+    harness.finish(cout);
+  }
+  catch (Exception & e) {
+    cerr << "Caught exception: " << e.message() << endl;
+    status = 1;
+  }
+
+  Uintah::Parallel::finalizeManager();
+  return status;
+}
@@ -36,6 +36,7 @@
 #include <Core/Geometry/IntVector.h>
 #include <Core/Grid/Variables/CellIterator.h>
 #include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/RowRange.h>
 #include <Core/Util/Timers/Timers.hpp>
 
 #include <iostream>
@@ -82,6 +83,24 @@ void bench2(int loop, const IntVector& low, const IntVector& high,
   }
 }
 
+void bench3(int loop, const IntVector& low, const IntVector& high,
+	   CCVariable<double>& result, double a,
+	   CCVariable<double>& x, CCVariable<double>& b)
+{
+  RowAccessor<double>       rr( result );
+  RowAccessor<const double> xx( x );
+  RowAccessor<const double> bb( b );
+
+  for ( int i = 0; i < loop; i++ )
+    for_each_row( RowRange(low, high), [&]( int j, int k, int ib, int ie ) {
+      double*       r  = rr.row(j,k);
+      const double* xr = xx.row(j,k);
+      const double* br = bb.row(j,k);
+      for ( int n = ib; n < ie; n++ )
+        r[n] = a * xr[n] + br[n];
+    });
+}
+
 int main ( int argc, char** argv )
 {
   int size = SIZE_DEFAULT;
@@ -150,6 +169,15 @@ int main ( int argc, char** argv )
   
   megaFlops = (loop * size * size * size * 2.0) / 1000000.0 / timer().seconds();
 
+  cout << "Completed in " << timer().seconds() << " seconds.";
+  cout << " (" << megaFlops << " MFLOPS)" << endl;
+
+  timer.reset( true );
+  bench3(loop, low, high, result, a, x, b);
+  timer.stop();
+
+  megaFlops = (loop * size * size * size * 2.0) / 1000000.0 / timer().seconds();
+
   cout << "Completed in " << timer().seconds() << " seconds.";
   cout << " (" << megaFlops << " MFLOPS)" << endl;
   
@@ -0,0 +1,457 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  StressUpdate.cc: Benchmark of the scalar and batched MPM stress update
+ *                   kernels.
+ *
+ *  Every particle gets a random velocity gradient and the deformation
+ *  gradient is advanced with it for a number of steps, giving a
+ *  synthetic deformation history that mixes stretch, shear and
+ *  rotation.  At each step the scalar (reference) and block versions of
+ *
+ *    - the Matrix3 kernels (determinant, polar decomposition, exponential)
+ *    - the UCNH stress update, elastic and with plasticity
+ *    - the ElasticPlasticHP sub-models (melt temperature, shear modulus,
+ *      Johnson-Cook and isotropic hardening flow stress)
+ *
+ *  are timed and their results compared.
+ */
+
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/UCNH.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/FlowModel.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/FlowStressModelFactory.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/MeltingTempModel.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/MeltingTempModelFactory.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/PlasticityStateBlock.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/ShearModulusModel.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/PlasticityModels/ShearModulusModelFactory.h>
+
+#include <Core/Math/Matrix3.h>
+#include <Core/Math/Matrix3Block.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int PARTICLES_DEFAULT = 100000;
+const int STEPS_DEFAULT     = 10;
+
+void usage( void )
+{
+  cerr << "Usage: StressUpdate [<particles> [<steps>]]" << endl;
+  cerr << endl;
+  cerr << "  <particles>  Number of particles (default " << PARTICLES_DEFAULT << ")." << endl;
+  cerr << "  <steps>      Number of deformation steps (default " << STEPS_DEFAULT << ")." << endl;
+}
+
+//______________________________________________________________________
+//  Timing and agreement of one scalar/block kernel pair
+struct Result {
+  std::string name;
+  double      scalar {0.0};
+  double      block  {0.0};
+  double      maxRelDiff {0.0};
+};
+
+void report( const Result & r, int evaluations )
+{
+  cout << "  " << setw(34) << left << r.name << right
+       << setw(12) << setprecision(4) << r.scalar*1.e9/evaluations << " ns"
+       << setw(12) << setprecision(4) << r.block*1.e9/evaluations  << " ns"
+       << setw(10) << setprecision(3) << (r.block > 0.0 ? r.scalar/r.block : 0.0) << "x"
+       << setw(14) << setprecision(3) << r.maxRelDiff << endl;
+}
+
+double relDiff( const Matrix3 & a, const Matrix3 & b )
+{
+  return (a - b).Norm()/std::max(1.0, a.Norm());
+}
+
+double relDiff( double a, double b )
+{
+  return fabs(a - b)/std::max(1.0, fabs(a));
+}
+
+//______________________________________________________________________
+//  The particle data advanced by the synthetic deformation history
+struct Particles {
+  std::vector<Matrix3> L;         // velocity gradient (constant per particle)
+  std::vector<Matrix3> F;         // deformation gradient at t_n
+  std::vector<Matrix3> F_new;     // deformation gradient at t_n+1
+  std::vector<Matrix3> bElBar;    // UCNH elastic left Cauchy-Green (isochoric)
+  std::vector<double>  alpha;     // plastic strain
+  std::vector<double>  T;         // temperature
+  std::vector<int>     idx;       // particle index (identity map)
+
+  Particles( int n, double delT, unsigned seed )
+    : L(n), F(n), F_new(n), bElBar(n), alpha(n, 0.0), T(n), idx(n)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> rate(-1.0, 1.0);
+    std::uniform_real_distribution<double> temp(294.0, 1200.0);
+
+    Matrix3 one; one.Identity();
+    for (int p = 0; p < n; p++) {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          L[p](i,j) = rate(gen)*1.0e3;
+        }
+      }
+      F[p]      = one;
+      F_new[p]  = one + L[p]*delT;
+      bElBar[p] = one;
+      T[p]      = temp(gen);
+      idx[p]    = p;
+    }
+  }
+
+  void advance( double delT )
+  {
+    Matrix3 one; one.Identity();
+    for (size_t p = 0; p < F.size(); p++) {
+      F[p]     = F_new[p];
+      F_new[p] = (one + L[p]*delT)*F[p];
+    }
+  }
+};
+
+//______________________________________________________________________
+//
+void benchMatrixKernels( Particles & parts, std::vector<Result> & results )
+{
+  const int W = 8;
+  int n = parts.F.size();
+
+  std::vector<double>  det_s(n), det_b(n);
+  std::vector<Matrix3> R_s(n), R_b(n), E_s(n), E_b(n);
+  Timers::Simple timer;
+
+  Result & rdet = results[0];
+  Result & rpol = results[1];
+  Result & rexp = results[2];
+
+  // Determinant
+  timer.reset(true);
+  for (int p = 0; p < n; p++) {
+    det_s[p] = parts.F_new[p].Determinant();
+  }
+  rdet.scalar += timer().seconds();
+
+  timer.reset(true);
+  {
+    Matrix3Block<W> F;
+    double det[W];
+    for (int start = 0; start < n; start += W) {
+      int m = std::min(W, n - start);
+      F.gather(parts.F_new, &parts.idx[start], m);
+      determinant(F, det);
+      std::copy(det, det + m, &det_b[start]);
+    }
+  }
+  rdet.block += timer().seconds();
+
+  // Polar decomposition
+  timer.reset(true);
+  for (int p = 0; p < n; p++) {
+    Matrix3 U;
+    parts.F_new[p].polarDecompositionRMB(U, R_s[p]);
+  }
+  rpol.scalar += timer().seconds();
+
+  timer.reset(true);
+  {
+    Matrix3Block<W> F, U, R;
+    for (int start = 0; start < n; start += W) {
+      int m = std::min(W, n - start);
+      F.gather(parts.F_new, &parts.idx[start], m);
+      if (!polarDecompositionRMB(F, U, R)) {
+        for (int l = 0; l < m; l++) {
+          Matrix3 Ul, Rl;
+          parts.F_new[start + l].polarDecompositionRMB(Ul, Rl);
+          R.set(l, Rl);
+        }
+      }
+      R.scatter(R_b, &parts.idx[start], m);
+    }
+  }
+  rpol.block += timer().seconds();
+
+  // Exponential of L*dt, as used by the incremental deformation gradient
+  // update
+  const int terms = 10;
+  timer.reset(true);
+  for (int p = 0; p < n; p++) {
+    E_s[p] = (parts.L[p]*1.e-4).Exponential(terms);
+  }
+  rexp.scalar += timer().seconds();
+
+  timer.reset(true);
+  {
+    Matrix3Block<W> A, E;
+    for (int start = 0; start < n; start += W) {
+      int m = std::min(W, n - start);
+      A.gather(parts.L, &parts.idx[start], m);
+      for (int k = 0; k < 9; k++) {
+        double * a = A.component(k);
+        for (int l = 0; l < W; l++) {
+          a[l] *= 1.e-4;
+        }
+      }
+      exponential(A, terms, E);
+      E.scatter(E_b, &parts.idx[start], m);
+    }
+  }
+  rexp.block += timer().seconds();
+
+  for (int p = 0; p < n; p++) {
+    rdet.maxRelDiff = std::max(rdet.maxRelDiff, relDiff(det_s[p], det_b[p]));
+    rpol.maxRelDiff = std::max(rpol.maxRelDiff, relDiff(R_s[p], R_b[p]));
+    rexp.maxRelDiff = std::max(rexp.maxRelDiff, relDiff(E_s[p], E_b[p]));
+  }
+}
+
+//______________________________________________________________________
+//  One step of UCNH from the same state with both kernels; the scalar
+//  result is carried forward.
+void benchUCNH( Particles & parts, const UCNH::StressParams & params,
+                double flowStress, Result & r )
+{
+  const int W = UCNH::blockWidth;
+  int n = parts.F.size();
+
+  std::vector<Matrix3> b_s(n), b_b(n), sig_s(n), sig_b(n);
+  std::vector<double>  alpha_s(parts.alpha), alpha_b(parts.alpha);
+  std::vector<double>  J(n);
+  Timers::Simple timer;
+
+  timer.reset(true);
+  for (int p = 0; p < n; p++) {
+    UCNH::updateStress(params, parts.F[p], parts.F_new[p], parts.bElBar[p],
+                       flowStress, alpha_s[p], J[p], b_s[p], sig_s[p]);
+  }
+  r.scalar += timer().seconds();
+
+  timer.reset(true);
+  {
+    Matrix3Block<W> F, F_new, b, b_new, sig;
+    double flow[W], alpha[W], Jb[W];
+    std::fill(flow, flow + W, flowStress);
+
+    for (int start = 0; start < n; start += W) {
+      int m = std::min(W, n - start);
+      const int * ids = &parts.idx[start];
+      F.gather(parts.F,         ids, m);
+      F_new.gather(parts.F_new, ids, m);
+      b.gather(parts.bElBar,    ids, m);
+      for (int l = 0; l < W; l++) {
+        alpha[l] = (l < m) ? alpha_b[start + l] : 0.0;
+      }
+      UCNH::updateStressBlock(params, F, F_new, b, flow, alpha, Jb, b_new, sig);
+      b_new.scatter(b_b, ids, m);
+      sig.scatter(sig_b, ids, m);
+      std::copy(alpha, alpha + m, &alpha_b[start]);
+    }
+  }
+  r.block += timer().seconds();
+
+  for (int p = 0; p < n; p++) {
+    double scale = std::max(1.0, sig_s[p].Norm());
+    r.maxRelDiff = std::max(r.maxRelDiff, (sig_s[p] - sig_b[p]).Norm()/scale);
+    r.maxRelDiff = std::max(r.maxRelDiff, relDiff(alpha_s[p], alpha_b[p]));
+  }
+
+  parts.bElBar = b_s;
+  parts.alpha  = alpha_s;
+}
+
+//______________________________________________________________________
+//  The ElasticPlasticHP sub-model chain: melt temperature -> shear
+//  modulus -> flow stress
+void benchSubModels( Particles & parts, double delT,
+                     MeltingTempModel * melt, ShearModulusModel * shear,
+                     FlowModel * flow, Result & r )
+{
+  const int W = PlasticityStateBlock::width;
+  int n = parts.F.size();
+  double tol = 1.e-10;
+
+  std::vector<double> sigy_s(n), sigy_b(n);
+  std::vector<PlasticityState> states(n);
+
+  for (int p = 0; p < n; p++) {
+    PlasticityState & state = states[p];
+    Matrix3 D = (parts.L[p] + parts.L[p].Transpose())*0.5;
+    state.strainRate          = sqrt(2.0/3.0)*D.Norm();
+    state.plasticStrainRate   = state.strainRate;
+    state.plasticStrain       = parts.alpha[p] + 1.e-3*(p % 100);
+    state.temperature         = parts.T[p];
+    state.initialTemperature  = 294.0;
+    state.density             = 8930.0/parts.F_new[p].Determinant();
+    state.initialDensity      = 8930.0;
+    state.bulkModulus         = 1.3e11;
+    state.initialBulkModulus  = 1.3e11;
+    state.shearModulus        = 4.6e10;
+    state.initialShearModulus = 4.6e10;
+    state.meltingTemp         = 1356.0;
+    state.initialMeltTemp     = 1356.0;
+  }
+
+  Timers::Simple timer;
+
+  timer.reset(true);
+  for (int p = 0; p < n; p++) {
+    PlasticityState state(states[p]);
+    state.meltingTemp  = melt->computeMeltingTemp(&state);
+    state.shearModulus = shear->computeShearModulus(&state);
+    sigy_s[p] = flow->computeFlowStress(&state, delT, tol, nullptr, p);
+  }
+  r.scalar += timer().seconds();
+
+  timer.reset(true);
+  {
+    PlasticityStateBlock block;
+    double Tm[W], mu[W];
+    for (int start = 0; start < n; start += W) {
+      int m = std::min(W, n - start);
+      block.size = m;
+      for (int l = 0; l < m; l++) {
+        block.idx[l] = start + l;
+        block.set(l, states[start + l]);
+      }
+      melt->computeMeltingTempBlock(block, Tm);
+      std::copy(Tm, Tm + m, block.meltingTemp);
+      shear->computeShearModulusBlock(block, mu);
+      std::copy(mu, mu + m, block.shearModulus);
+      flow->computeFlowStressBlock(block, delT, tol, nullptr, &sigy_b[start]);
+    }
+  }
+  r.block += timer().seconds();
+
+  for (int p = 0; p < n; p++) {
+    r.maxRelDiff = std::max(r.maxRelDiff, relDiff(sigy_s[p], sigy_b[p]));
+  }
+}
+
+//______________________________________________________________________
+//
+int main( int argc, char** argv )
+{
+  int numParticles = PARTICLES_DEFAULT;
+  int numSteps     = STEPS_DEFAULT;
+
+  if (argc > 1) {
+    numParticles = atoi(argv[1]);
+    if (argc > 2) {
+      numSteps = atoi(argv[2]);
+    }
+  }
+  if (numParticles <= 0 || numSteps <= 0) {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  const double delT = 1.0e-6;
+
+  cout << "Stress Update Benchmark: " << endl;
+  cout << numParticles << " particles, " << numSteps << " steps, "
+       << "block width " << PlasticityStateBlock::width << endl;
+
+  // The sub-models, as ElasticPlasticHP would create them
+  ProblemSpecP cm_ps = scinew ProblemSpec(
+    "<constitutive_model>"
+    "  <flow_model type=\"johnson_cook\">"
+    "    <A>89.63e6</A> <B>291.64e6</B> <C>0.025</C> <n>0.31</n> <m>1.09</m>"
+    "    <T_r>294</T_r> <T_m>1356.5</T_m> <epdot_0>1.0</epdot_0>"
+    "  </flow_model>"
+    "  <shear_modulus_model type=\"constant_shear\"/>"
+    "  <melting_temp_model type=\"constant_Tm\"/>"
+    "</constitutive_model>" );
+
+  ProblemSpecP iso_ps = scinew ProblemSpec(
+    "<constitutive_model>"
+    "  <flow_model type=\"isotropic_hardening\">"
+    "    <K>2.1e8</K> <sigma_Y>4.0e8</sigma_Y>"
+    "  </flow_model>"
+    "</constitutive_model>" );
+
+  FlowModel         * jcFlow  = FlowStressModelFactory::create(cm_ps);
+  FlowModel         * isoFlow = FlowStressModelFactory::create(iso_ps);
+  ShearModulusModel * shear   = ShearModulusModelFactory::create(cm_ps);
+  MeltingTempModel  * melt    = MeltingTempModelFactory::create(cm_ps);
+
+  UCNH::StressParams elastic = { 1.17e11, 4.4e10, 0.0,   false };
+  UCNH::StressParams plastic = { 1.17e11, 4.4e10, 1.0e8, true  };
+
+  std::vector<Result> results(7);
+  results[0].name = "Matrix3 determinant";
+  results[1].name = "Matrix3 polar decomposition (RMB)";
+  results[2].name = "Matrix3 exponential (10 terms)";
+  results[3].name = "UCNH elastic";
+  results[4].name = "UCNH plastic";
+  results[5].name = "EPHP sub-models, Johnson-Cook";
+  results[6].name = "EPHP sub-models, iso. hardening";
+
+  Particles elasticParts(numParticles, delT, 1234);
+  Particles plasticParts(numParticles, delT, 1234);
+
+  for (int step = 0; step < numSteps; step++) {
+    benchMatrixKernels(elasticParts, results);
+    benchUCNH(elasticParts, elastic, 0.0,   results[3]);
+    benchUCNH(plasticParts, plastic, 1.0e8, results[4]);
+    benchSubModels(plasticParts, delT, melt, shear, jcFlow,  results[5]);
+    benchSubModels(plasticParts, delT, melt, shear, isoFlow, results[6]);
+
+    elasticParts.advance(delT);
+    plasticParts.advance(delT);
+  }
+
+  int evaluations = numParticles*numSteps;
+
+  cout << endl;
+  cout << "  " << setw(34) << left << "kernel" << right
+       << setw(15) << "scalar" << setw(15) << "block"
+       << setw(11) << "speedup" << setw(14) << "max rel diff" << endl;
+  for (const Result & r : results) {
+    report(r, evaluations);
+  }
+
+  delete jcFlow;
+  delete isoFlow;
+  delete shear;
+  delete melt;
+
+  return EXIT_SUCCESS;
+}
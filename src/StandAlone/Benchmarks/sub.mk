@@ -67,4 +67,28 @@ endif
 
 include $(SCIRUN_SCRIPTS)/program.mk
 
+##############################################
+# Stress Update Benchmark (scalar vs batched MPM constitutive kernels)
+
+SRCS    := $(SRCDIR)/StressUpdate.cc
+
+PROGRAM := $(SRCDIR)/StressUpdate
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
+##############################################
+# Core kernel micro benchmarks (grid iteration, ghost copies, interpolators,
+# particle pack/unpack, variable I/O, DW lookups, task queues)
+
+SRCS    := $(SRCDIR)/BenchmarkHarness.cc \
+           $(SRCDIR)/CoreKernels.cc
+
+PROGRAM := $(SRCDIR)/CoreKernels
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
 SimpleMath: prereqs StandAlone/Benchmarks/SimpleMath
+
+StressUpdate: prereqs StandAlone/Benchmarks/StressUpdate
+
+CoreKernels: prereqs StandAlone/Benchmarks/CoreKernels
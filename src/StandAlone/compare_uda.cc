@@ -50,6 +50,8 @@
 #include <Core/Grid/Variables/PerPatch.h>
 #include <Core/Grid/Variables/Stencil7.h>
 #include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ThreadExecutor.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <Core/Math/Matrix3.h>
 #include <Core/Math/MinMax.h>
 #include <Core/OS/Dir.h>
@@ -57,11 +59,16 @@
 #include <Core/Util/ProgressiveWarning.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
+#include <fstream>
 #include <iomanip>
 #include <iterator>
 #include <iostream>
-
+#include <limits>
+#include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -113,7 +120,10 @@ usage(const std::string& badarg, const std::string& progname)
   cerr << "  -skip_unknown_types              (Skip variable comparisons of unknown types without error)\n";
   cerr << "  -ignoreVariables [var1,var2....] (Skip these variables. Comma delimited list, no spaces.)\n";
   cerr << "  -compareVariables[var1,var2....] (Only these variables are compared. Comma delimited list, no spaces.)\n";
-  cerr << "  -dont_sort                       (Don't sort the variable names before comparing them)";
+  cerr << "  -dont_sort                       (Don't sort the variable names before comparing them)\n";
+  cerr << "  -nthreads [int]                  (Number of threads comparing the patches of grid variables, default: 1)\n";
+  cerr << "  -summary [filename]              (Write a JSON summary with the max abs/rel error of each variable)\n";
+  cerr << "\nWhen run with mpirun the patches of the grid variables are distributed over the ranks.\n";
   cerr << "\nNote: The absolute and relative tolerance tests must both fail\n"
        << "      for a comparison to fail.\n\n";
   cerr << "  Exit values:\n";
@@ -132,9 +142,20 @@ usage(const std::string& badarg, const std::string& progname)
 string d_filebase1;
 string d_filebase2;
 bool d_tolerance_as_warnings = false;
-bool d_tolerance_error       = false;
+std::atomic<bool> d_tolerance_error{false};
 bool d_concise               = false; // If true (and d_tolerance_error), only print 1st error per var.
 bool d_strict_types          = true;
+int  d_nThreads              = 1;     // threads comparing the patches of grid variables
+int  d_myRank                = 0;
+int  d_nRanks                = 1;
+string d_summaryFile         = "";
+vector<string> d_summaryVars;         // variables listed in the summary
+
+std::mutex d_outputLock;              // serializes the difference reports of the threads
+thread_local bool t_isWorker = false; // true while a thread compares patches in compareGridVariable()
+
+void reduceStats();
+void writeSummary();
 
 //______________________________________________________________________
 //
@@ -163,12 +184,44 @@ abort_uncomparable(std::ostringstream& warn)
 void
 tolerance_failure()
 {
+  d_tolerance_error = true;
+
   if (d_tolerance_as_warnings) {
-    d_tolerance_error = true;
     cerr << endl;
   }
-  else
+  // Otherwise the comparison stops in checkToleranceFailure(), once the
+  // statistics of the variable are in the summary.
+}
+//______________________________________________________________________
+//  A tolerance failure that isn't treated as a warning stops the comparison
+bool
+stopComparing()
+{
+  return d_tolerance_error && !d_tolerance_as_warnings;
+}
+
+//______________________________________________________________________
+//  Stops the comparison after a tolerance failure, called once the
+//  statistics of a variable have been added.  With several ranks it is
+//  called by all ranks, which then write the summary and exit together.
+void
+checkToleranceFailure()
+{
+  if( d_tolerance_as_warnings ) {
+    return;
+  }
+
+  int failed = d_tolerance_error ? 1 : 0;
+  if( d_nRanks > 1 ) {
+    Uintah::MPI::Allreduce( MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD );
+  }
+
+  if( failed ) {
+    reduceStats();
+    writeSummary();
+    Parallel::finalizeManager();
     Parallel::exitAll(2);
+  }
 }
 //______________________________________________________________________
 //
@@ -340,6 +393,217 @@ compare( const Matrix3 & a,
   }
 }
 
+//______________________________________________________________________
+//  Absolute and relative difference between two values, used for the
+//  error statistics of the summary.  NaNs count as an infinite error.
+void
+difference( double a, double b, double & absErr, double & relErr )
+{
+  if( std::isnan(a) || std::isnan(b) ) {
+    absErr = relErr = std::numeric_limits<double>::infinity();
+    return;
+  }
+  absErr = fabs(a - b);
+  double max_abs = std::max( fabs(a), fabs(b) );
+  relErr = (max_abs > 0) ? absErr / max_abs : 0.0;
+}
+
+void
+difference( float a, float b, double & absErr, double & relErr )
+{
+  difference( (double)a, (double)b, absErr, relErr );
+}
+
+void
+difference( int a, int b, double & absErr, double & relErr )
+{
+  difference( (double)a, (double)b, absErr, relErr );
+}
+
+void
+difference( long64 a, long64 b, double & absErr, double & relErr )
+{
+  difference( (double)a, (double)b, absErr, relErr );
+}
+
+void
+difference( const Vector & a, const Vector & b, double & absErr, double & relErr )
+{
+  absErr = relErr = 0;
+  for( int i = 0; i < 3; i++ ) {
+    double abs_i, rel_i;
+    difference( a[i], b[i], abs_i, rel_i );
+    absErr = std::max( absErr, abs_i );
+    relErr = std::max( relErr, rel_i );
+  }
+}
+
+void
+difference( const IntVector & a, const IntVector & b, double & absErr, double & relErr )
+{
+  difference( a.asVector(), b.asVector(), absErr, relErr );
+}
+
+void
+difference( const Point & a, const Point & b, double & absErr, double & relErr )
+{
+  difference( a.asVector(), b.asVector(), absErr, relErr );
+}
+
+void
+difference( const Stencil7 & a, const Stencil7 & b, double & absErr, double & relErr )
+{
+  const double va[7] = { a.p, a.n, a.s, a.e, a.w, a.t, a.b };
+  const double vb[7] = { b.p, b.n, b.s, b.e, b.w, b.t, b.b };
+
+  absErr = relErr = 0;
+  for( int i = 0; i < 7; i++ ) {
+    double abs_i, rel_i;
+    difference( va[i], vb[i], abs_i, rel_i );
+    absErr = std::max( absErr, abs_i );
+    relErr = std::max( relErr, rel_i );
+  }
+}
+
+// consistent with compare(Matrix3), the norms are compared
+void
+difference( const Matrix3 & a, const Matrix3 & b, double & absErr, double & relErr )
+{
+  difference( a.Norm(), b.Norm(), absErr, relErr );
+}
+
+//______________________________________________________________________
+//  Per variable statistics, reported in the summary
+struct VarStats {
+  long   nCompared   {0};     // values compared element by element
+  long   nFailures   {0};     // values outside the tolerances
+  double maxAbsError {0};
+  double maxRelError {0};
+
+  template <class T>
+  void update( const T & a, const T & b, bool passed )
+  {
+    double absErr, relErr;
+    difference( a, b, absErr, relErr );
+
+    nCompared++;
+    nFailures  += passed ? 0 : 1;
+    maxAbsError = std::max( maxAbsError, absErr );
+    maxRelError = std::max( maxRelError, relErr );
+  }
+
+  void merge( const VarStats & s )
+  {
+    nCompared  += s.nCompared;
+    nFailures  += s.nFailures;
+    maxAbsError = std::max( maxAbsError, s.maxAbsError );
+    maxRelError = std::max( maxRelError, s.maxRelError );
+  }
+};
+
+map<string, VarStats> d_varStats;
+std::mutex            d_statsLock;
+
+void
+addStats( const string & var, const VarStats & stats )
+{
+  std::lock_guard<std::mutex> lock( d_statsLock );
+  d_varStats[var].merge( stats );
+}
+
+//______________________________________________________________________
+//  Combine the statistics of all ranks, the result is on every rank
+void
+reduceStats()
+{
+  if( d_nRanks == 1 ) {
+    return;
+  }
+
+  const int nVars = d_summaryVars.size();
+  vector<long>   counts( 2*nVars + 1 );
+  vector<double> errors( 2*nVars );
+
+  for( int v = 0; v < nVars; v++ ) {
+    const VarStats & s = d_varStats[ d_summaryVars[v] ];
+    counts[2*v]   = s.nCompared;
+    counts[2*v+1] = s.nFailures;
+    errors[2*v]   = s.maxAbsError;
+    errors[2*v+1] = s.maxRelError;
+  }
+  counts[2*nVars] = d_tolerance_error ? 1 : 0;
+
+  Uintah::MPI::Allreduce( MPI_IN_PLACE, counts.data(), counts.size(), MPI_LONG,   MPI_SUM, MPI_COMM_WORLD );
+  Uintah::MPI::Allreduce( MPI_IN_PLACE, errors.data(), errors.size(), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD );
+
+  for( int v = 0; v < nVars; v++ ) {
+    VarStats & s = d_varStats[ d_summaryVars[v] ];
+    s.nCompared   = counts[2*v];
+    s.nFailures   = counts[2*v+1];
+    s.maxAbsError = errors[2*v];
+    s.maxRelError = errors[2*v+1];
+  }
+  d_tolerance_error = ( counts[2*nVars] > 0 );
+}
+
+//______________________________________________________________________
+//  Machine readable (JSON) summary of the comparison, written by rank 0
+string
+jsonString( const string & s )
+{
+  string result = "\"";
+  for( char c : s ) {
+    if( c == '"' || c == '\\' ) {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+string
+jsonNumber( double x )
+{
+  if( !std::isfinite(x) ) {
+    return "null";
+  }
+  ostringstream out;
+  out << setprecision(17) << x;
+  return out.str();
+}
+
+void
+writeSummary()
+{
+  if( d_summaryFile == "" || d_myRank != 0 ) {
+    return;
+  }
+
+  ofstream out( d_summaryFile.c_str() );
+  if( !out ) {
+    cerr << "Could not open the summary file (" << d_summaryFile << ")\n";
+    return;
+  }
+
+  out << "{\n"
+      << "  \"uda1\": "   << jsonString( d_filebase1 ) << ",\n"
+      << "  \"uda2\": "   << jsonString( d_filebase2 ) << ",\n"
+      << "  \"passed\": " << ( d_tolerance_error ? "false" : "true" ) << ",\n"
+      << "  \"variables\": [";
+
+  for( unsigned int v = 0; v < d_summaryVars.size(); v++ ) {
+    const VarStats & s = d_varStats[ d_summaryVars[v] ];
+
+    out << ( v == 0 ? "\n" : ",\n" )
+        << "    { \"name\": "          << jsonString( d_summaryVars[v] )
+        << ", \"compared\": "          << s.nCompared
+        << ", \"failures\": "          << s.nFailures
+        << ", \"max_abs_error\": "     << jsonNumber( s.maxAbsError )
+        << ", \"max_rel_error\": "     << jsonNumber( s.maxRelError )
+        << " }";
+  }
+  out << "\n  ]\n}\n";
+}
 
 /**********************************************************************
  * MaterialParticleVarData and MaterialParticleData are for comparing
@@ -523,7 +787,7 @@ void MaterialParticleData::compare(MaterialParticleData& data2,
   map<string, MaterialParticleVarData>::iterator varIter  = vars_.begin();
   map<string, MaterialParticleVarData>::iterator varIter2 = data2.vars_.begin();
 
-  for ( ; (varIter != vars_.end()) && (varIter2 != data2.vars_.end()) ;
+  for ( ; (varIter != vars_.end()) && (varIter2 != data2.vars_.end()) && !stopComparing();
         varIter++, varIter2++) {
 
     // should catch this earlier -- vars/materials do not match
@@ -537,7 +801,8 @@ void MaterialParticleData::compare(MaterialParticleData& data2,
                                abs_tolerance, rel_tolerance);
   }
   // should catch this earlier -- vars/materials do not match
-  ASSERT((varIter == vars_.end()) && (varIter2 == data2.vars_.end()));
+  ASSERT(stopComparing() ||
+         ((varIter == vars_.end()) && (varIter2 == data2.vars_.end())));
 }
 
 //__________________________________
@@ -715,8 +980,13 @@ MaterialParticleVarData::compare( MaterialParticleVarData & data2,
   // Assumes that the particleVariables are in corresponding order --
   // not necessarily by their particle set order.  This is what the
   // sort/gather achieves.
+  VarStats stats;
+
   for( unsigned int i = 0; i < pset1->numParticles(); i++ ) {
-    if (!(::compare((*value1)[i], (*value2)[i], abs_tolerance, rel_tolerance))) {
+    bool passed = ::compare((*value1)[i], (*value2)[i], abs_tolerance, rel_tolerance);
+    stats.update( (*value1)[i], (*value2)[i], passed );
+
+    if ( !passed ) {
       if (d_name != "p.particleID") {
         ASSERT(getParticleID(i) == data2.getParticleID(i));
       }
@@ -739,13 +1009,14 @@ MaterialParticleVarData::compare( MaterialParticleVarData & data2,
       cerr << d_filebase2 << ":\n" << (*value2)[i] << endl;
 
       tolerance_failure();
-      if( d_concise ) {
+      if( d_concise || stopComparing() ) {
         break;
       }
 
       passes = false;
     }
   }
+  addStats( d_name, stats );
 
   return passes;
 }
@@ -900,8 +1171,13 @@ compareParticles( DataArchive  * da1,
   ParticleSubset::iterator iter1 = pset1->begin();
   ParticleSubset::iterator iter2 = pset2->begin();
 
+  VarStats stats;
+
   for ( ; iter1 != pset1->end() && iter2 != pset2->end(); iter1++, iter2++) {
-    if (!compare( var1[*iter1], var2[*iter2], abs_tolerance, rel_tolerance)) {
+    bool passed = compare( var1[*iter1], var2[*iter2], abs_tolerance, rel_tolerance );
+    stats.update( var1[*iter1], var2[*iter2], passed );
+
+    if ( !passed ) {
       cerr << "\nValues differ too much.\n";
       displayProblemLocation( cerr, var_name, matl, patch1, time );
       cerr << d_filebase1 << ":\n";
@@ -910,14 +1186,16 @@ compareParticles( DataArchive  * da1,
       print( cerr, var2[ *iter2 ] );
       cerr << endl;
       tolerance_failure();
-      if( d_concise ) {
+      if( d_concise || stopComparing() ) {
         break;
       }
     }
   }
+  addStats( var_name, stats );
 
   // this should be true if both sets are the same size
-  ASSERT( iter1 == pset1->end() && iter2 == pset2->end() );
+  ASSERT( d_concise || stopComparing() ||
+          ( iter1 == pset1->end() && iter2 == pset2->end() ) );
 }
 
 //______________________________________________________________________
@@ -940,7 +1218,13 @@ comparePerPatch( DataArchive  * da1,
   da1->query( var1, var_name, matl, patch1, timestep );
   da2->query( var2, var_name, matl, patch2, timestep );
 
-  if (!compare( var1, var2, abs_tolerance, rel_tolerance)) {
+  bool passed = compare( var1.get(), var2.get(), abs_tolerance, rel_tolerance );
+
+  VarStats stats;
+  stats.update( var1.get(), var2.get(), passed );
+  addStats( var_name, stats );
+
+  if ( !passed ) {
       cerr << "\nValues differ too much.\n";
       displayProblemLocation( cerr, var_name, matl, patch1, time );
       cerr << d_filebase1 << ":\n";
@@ -999,6 +1283,7 @@ class FieldComparator
 public:
 
   virtual ~FieldComparator() {};
+
   virtual void
   compareFields(DataArchive* da1,
                 DataArchive* da2,
@@ -1009,7 +1294,8 @@ public:
                 double time,
                 int timestep,
                 double abs_tolerance,
-                double rel_tolerance) = 0;
+                double rel_tolerance,
+                VarStats& stats) = 0;
 
   static FieldComparator*
   makeFieldComparator(const Uintah::TypeDescription* td,
@@ -1034,7 +1320,8 @@ public:
                 const Array3<const Patch*>& patch2Map,
                 double time, int timestep,
                 double abs_tolerance,
-                double rel_tolerance);
+                double rel_tolerance,
+                VarStats& stats);
 private:
   Iterator d_begin;
 };
@@ -1148,18 +1435,20 @@ SpecificFieldComparator<Field, Iterator>::compareFields( DataArchive
                                                          double                       time1,
                                                          int                          timestep,
                                                          double                       abs_tolerance,
-                                                         double                       rel_tolerance )
+                                                         double                       rel_tolerance,
+                                                         VarStats                   & stats )
 {
   Field* field2;
   bool firstMatl = true;
 
   //__________________________________
   //  Matl loop
-  for( ConsecutiveRangeSet::iterator matlIter = matls.begin(); matlIter != matls.end(); matlIter++ ) {
+  for( ConsecutiveRangeSet::iterator matlIter = matls.begin(); matlIter != matls.end() && !stopComparing(); matlIter++ ) {
 
     int matl = *matlIter;
 
     Field field;
+
     bool found = da1->query( field, var_name, matl, patch, timestep );
 
     if( !found ) {
@@ -1192,7 +1481,11 @@ SpecificFieldComparator<Field, Iterator>::compareFields( DataArchive
         field2 = (*findIter).second;
       }
 
-      if (!compare(field[*iter], (*field2)[*iter], abs_tolerance, rel_tolerance)) {
+      bool passed = compare(field[*iter], (*field2)[*iter], abs_tolerance, rel_tolerance);
+      stats.update( field[*iter], (*field2)[*iter], passed );
+
+      if ( !passed ) {
+        std::lock_guard<std::mutex> lock( d_outputLock );
 
         cerr << "DIFFERENCE " << *iter << "  ";
         displayProblemLocation( cerr, var_name, matl, patch, patch2, time1 );
@@ -1204,7 +1497,7 @@ SpecificFieldComparator<Field, Iterator>::compareFields( DataArchive
         cerr << endl;
 
         tolerance_failure();
-        if( d_concise ) {
+        if( d_concise || stopComparing() ) {
           break; // Exit for() loop as we are only displaying first error per variable.
         }
       }
@@ -1219,6 +1512,83 @@ SpecificFieldComparator<Field, Iterator>::compareFields( DataArchive
 }
 
 
+//______________________________________________________________________
+//  Compare a grid variable on the patches of a level.  The patches are
+//  distributed round robin over the MPI ranks, and the patches of a rank
+//  are handed out to d_nThreads threads.  A thread holds one patch of uda 1
+//  and the patches of uda 2 overlapping it at a time.
+void
+compareGridVariable( DataArchive                * da1,
+                     DataArchive                * da2,
+                     const string               & var,
+                     const Uintah::TypeDescription * td,
+                     const Uintah::TypeDescription * subtype,
+                     const LevelP               & level,
+                     const Array3<const Patch*> & patch2Map,
+                     double                       time1,
+                     int                          tstep,
+                     double                       abs_tolerance,
+                     double                       rel_tolerance )
+{
+  vector<const Patch*> myPatches;
+
+  int p = 0;
+  for( Level::const_patch_iterator iter = level->patchesBegin(); iter != level->patchesEnd(); iter++, p++ ) {
+    if( p % d_nRanks != d_myRank ) {
+      continue;
+    }
+    myPatches.push_back( *iter );
+  }
+
+  std::atomic<int>   next{0};
+  std::exception_ptr error;
+  std::mutex         errorLock;
+
+  auto worker = [&]( bool isWorker ) {
+    const bool outer = t_isWorker;
+    t_isWorker = isWorker;
+    VarStats stats;
+
+    try {
+      int i;
+      while( !stopComparing() && ( i = next++ ) < (int) myPatches.size() ) {
+        const Patch* patch = myPatches[i];
+
+        ConsecutiveRangeSet matls = da1->queryMaterials( var, patch, tstep );
+
+        FieldComparator* comparator = FieldComparator::makeFieldComparator( td, subtype, patch );
+
+        if (comparator != 0) {
+          comparator->compareFields( da1, da2, var, matls, patch,
+                                     patch2Map, time1, tstep,
+                                     abs_tolerance, rel_tolerance, stats );
+          delete comparator;
+        }
+      }
+    }
+    catch( ... ) {
+      std::lock_guard<std::mutex> lock( errorLock );
+      error = std::current_exception();
+      next  = myPatches.size();
+    }
+    addStats( var, stats );
+    t_isWorker = outer;
+  };
+
+  if( d_nThreads == 1 ) {
+    worker( false );
+  }
+  else {
+    ThreadExecutor::runTasks( d_nThreads, [&]( int ) { worker( true ); }, d_nThreads );
+  }
+
+  if( error ) {
+    std::rethrow_exception( error );
+  }
+
+  checkToleranceFailure();    // exits, now from the main thread
+}
+
 //______________________________________________________________________
 // map nodes to their owning patch in a level.
 // Nodes are used because I am assuming that whoever owns the node at
@@ -1312,6 +1682,9 @@ main( int argc, char** argv )
 {
   Uintah::Parallel::initializeManager(argc, argv);
 
+  d_myRank = Uintah::Parallel::getMPIRank();
+  d_nRanks = Uintah::Parallel::getMPISize();
+
   vector<string> ignoreVars;
   vector<string> compareVars;
   double rel_tolerance  = 1e-6; // Default
@@ -1348,6 +1721,25 @@ main( int argc, char** argv )
     else if(s == "-dont_sort") {
       sortVariables = false;
     }
+    else if(s == "-nthreads") {
+      if (++i == argc){
+        usage("-nthreads, no value given", argv[0]);
+      }
+      else{
+        d_nThreads = atoi(argv[i]);
+        if( d_nThreads < 1 ){
+          usage("-nthreads, must be >= 1", argv[0]);
+        }
+      }
+    }
+    else if(s == "-summary") {
+      if (++i == argc){
+        usage("-summary, no filename given", argv[0]);
+      }
+      else{
+        d_summaryFile = argv[i];
+      }
+    }
     else if(s == "-skip_unknown_types") {
       d_strict_types = false;
     }
@@ -1417,6 +1809,10 @@ main( int argc, char** argv )
   cerr << "Using absolute tolerance: " << abs_tolerance << endl;
   cerr << "Using relative tolerance: " << rel_tolerance << endl;
 
+  if( d_nThreads > 1 || d_nRanks > 1 ){
+    cerr << "Comparing the grid variables with " << d_nRanks << " rank(s) x " << d_nThreads << " thread(s)" << endl;
+  }
+
   if( udaLevels[0] != -9 ){
     cerr << "Comparing uda1: Level("<< udaLevels[0] << ") against uda2: level(" << udaLevels[1] << ")" << endl;
   }
@@ -1595,6 +1991,8 @@ main( int argc, char** argv )
       }
     }
 
+    d_summaryVars = vars;
+
     vector<int>     ts_index;
     vector<double>  times;
     vector<int>     ts_index2;
@@ -1616,7 +2014,9 @@ main( int argc, char** argv )
 
       double time1 = times[tstep];
       double time2 = times2[tstep];
-      cerr << "time = " << time1 << "\n";
+      if (d_myRank == 0) {
+        cerr << "time = " << time1 << "\n";
+      }
 
       GridP grid  = da1->queryGrid(tstep);
       GridP grid2 = da2->queryGrid(tstep);
@@ -1754,8 +2154,8 @@ main( int argc, char** argv )
       }
 
       //______________________________________________________________________
-      // Compare Particle and PerPatch Variables
-      if (hasPerPatchData || (hasParticleData && !hasParticleIDs)) {
+      // Compare Particle and PerPatch Variables, only rank 0 compares them
+      if (d_myRank == 0 && (hasPerPatchData || (hasParticleData && !hasParticleIDs))) {
 
         // Compare particle variables without p.particleID -- patches
         // must be consistent.
@@ -1768,7 +2168,8 @@ main( int argc, char** argv )
 	  cerr << endl;
 	}
 	
-        for(int v=0;v<(int)vars.size();v++){
+        // stop at the first tolerance failure, see checkToleranceFailure()
+        for(int v=0;v<(int)vars.size() && !stopComparing();v++){
           std::string var = vars[v];
 
           const Uintah::TypeDescription* td = types[v];
@@ -1927,7 +2328,7 @@ main( int argc, char** argv )
           }
         }
       }
-      else if (hasParticleIDs) {
+      else if (d_myRank == 0 && hasParticleIDs) {
         // Compare Particle variables with p.particleID -- patches don't
         // need to be cosistent.  It will gather and sort the particles
         // so they can be compared in particleID order.
@@ -1949,7 +2350,7 @@ main( int argc, char** argv )
           matlIter2 = matlParticleDataMap2.begin();
 
           for (; (matlIter  != matlParticleDataMap1.end()) &&
-                 (matlIter2 != matlParticleDataMap2.end()); matlIter++, matlIter2++) {
+                 (matlIter2 != matlParticleDataMap2.end()) && !stopComparing(); matlIter++, matlIter2++) {
 
             // This assert should already have been check above whan comparing
             // material sets.
@@ -1960,11 +2361,15 @@ main( int argc, char** argv )
           }
           // This assert should already have been check above whan comparing
           // material sets.
-          ASSERT(matlIter == matlParticleDataMap1.end() &&
-                 matlIter2 == matlParticleDataMap2.end());
+          ASSERT(stopComparing() ||
+                 (matlIter == matlParticleDataMap1.end() &&
+                  matlIter2 == matlParticleDataMap2.end()));
         }
       }
 
+      // rank 0 may have failed comparing the particle and PerPatch variables
+      checkToleranceFailure();
+
 
       for(int v=0;v<(int)vars.size();v++){
         std::string var = vars[v];
@@ -1975,7 +2380,9 @@ main( int argc, char** argv )
         if (td->getType() == Uintah::TypeDescription::ParticleVariable ||
 	    td->getType() == Uintah::TypeDescription::PerPatch)
           continue;
-        cerr << "\tVariable: " << var << ", type " << td->getName() << "\n";
+        if (d_myRank == 0) {
+          cerr << "\tVariable: " << var << ", type " << td->getName() << "\n";
+        }
 
         if (td->getName() == string("-- unknown type --")) {
           cerr << "\t\tParticleVariable or PerPatch of unknown type";
@@ -2042,22 +2449,9 @@ main( int argc, char** argv )
             }
           });
 
-          Level::const_patch_iterator iter;
-
-          for(iter = level->patchesBegin();iter != level->patchesEnd(); iter++) {
-            const Patch* patch = *iter;
-
-            ConsecutiveRangeSet matls = da1->queryMaterials(var, patch, tstep);
-
-            FieldComparator* comparator = FieldComparator::makeFieldComparator(td, subtype, patch);
-
-            if (comparator != 0) {
-              comparator->compareFields( da1, da2, var, matls, patch,
-                                         patch2Map, time1, tstep,
-                                         abs_tolerance, rel_tolerance );
-              delete comparator;
-            }
-          }
+          compareGridVariable( da1, da2, var, td, subtype, level,
+                               patch2Map, time1, tstep,
+                               abs_tolerance, rel_tolerance );
         } // end for (l)
       } // end for (v)
     } // end for(tstep)
@@ -2082,6 +2476,9 @@ main( int argc, char** argv )
 
     delete da1;
     delete da2;
+
+    reduceStats();
+    writeSummary();
   } catch (Exception& e) {
     cerr << "Caught exception: " << e.message() << '\n';
     abort();
@@ -2090,11 +2487,13 @@ main( int argc, char** argv )
     abort();
   }
 
+  Parallel::finalizeManager();
+
   if (d_tolerance_error) {
     cerr << "\nComparison did NOT fully pass.\n";
     Parallel::exitAll(2);
   }
-  else
+  else if (d_myRank == 0)
     cerr << "\nComparison fully passed!\n";
 
   return 0;
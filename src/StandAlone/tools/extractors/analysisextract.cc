@@ -0,0 +1,297 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  analysisextract.cc: dump the binary output (.uab) written by the
+ *                      on-the-fly analysis modules as text columns
+ *
+ *  The file format is described in
+ *  CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h
+ */
+
+#include <CCA/Components/OnTheFlyAnalysis/AnalysisOutput.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace Uintah;
+
+void
+usage(const std::string& badarg, const std::string& progname)
+{
+  if(badarg != "")
+    cerr << "Error parsing argument: " << badarg << endl;
+  cerr << "Usage: " << progname << " [options] <file.uab>\n\n";
+  cerr << "Valid options are:\n";
+  cerr << "  -h,      --help\n";
+  cerr << "  -schema                      (print the columns and exit)\n";
+  cerr << "  -series  <int>               (only output rows of this series)\n";
+  cerr << "  -columns <name,name,...>     (only output these columns, series and time are always written)\n";
+  cerr << "  -tmin    <double>            (only output rows with time >= tmin)\n";
+  cerr << "  -tmax    <double>            (only output rows with time <= tmax)\n";
+  cerr << "  -sort                        (sort the rows by series and time)\n";
+  cerr << "  -o,      --out               <outputfilename> [defaults to stdout]\n";
+  exit(1);
+}
+
+//______________________________________________________________________
+//
+template<class T>
+bool
+readValue( ifstream& in, T& val )
+{
+  in.read( reinterpret_cast<char*>(&val), sizeof(T) );
+  return in.good();
+}
+
+//______________________________________________________________________
+//
+int
+main( int argc, char** argv )
+{
+  string filename;
+  string outFile;
+  string columnList;
+  bool   schemaOnly = false;
+  bool   doSort     = false;
+  bool   useSeries  = false;
+  long long series  = 0;
+  double tmin       = -DBL_MAX;
+  double tmax       =  DBL_MAX;
+
+  for( int i = 1; i < argc; i++ ){
+    string s = argv[i];
+    if( s == "-h" || s == "--help" ){
+      usage( "", argv[0] );
+    }
+    else if( s == "-schema" ){
+      schemaOnly = true;
+    }
+    else if( s == "-sort" ){
+      doSort = true;
+    }
+    else if( s == "-series" ){
+      if( ++i == argc ) usage( s, argv[0] );
+      series    = atoll( argv[i] );
+      useSeries = true;
+    }
+    else if( s == "-columns" ){
+      if( ++i == argc ) usage( s, argv[0] );
+      columnList = argv[i];
+    }
+    else if( s == "-tmin" ){
+      if( ++i == argc ) usage( s, argv[0] );
+      tmin = atof( argv[i] );
+    }
+    else if( s == "-tmax" ){
+      if( ++i == argc ) usage( s, argv[0] );
+      tmax = atof( argv[i] );
+    }
+    else if( s == "-o" || s == "--out" ){
+      if( ++i == argc ) usage( s, argv[0] );
+      outFile = argv[i];
+    }
+    else if( s[0] == '-' ){
+      usage( s, argv[0] );
+    }
+    else {
+      filename = s;
+    }
+  }
+
+  if( filename == "" ){
+    usage( "", argv[0] );
+  }
+
+  ifstream in( filename.c_str(), ios::binary );
+  if( !in ){
+    cerr << "Error: could not open " << filename << endl;
+    exit(1);
+  }
+
+  //__________________________________
+  //  header
+  char     magic[8];
+  uint32_t endian;
+  uint32_t nCols;
+  in.read( magic, 8 );
+
+  if( !in || memcmp( magic, AnalysisOutput::MAGIC, 8 ) != 0 ){
+    cerr << "Error: " << filename << " is not an analysis output file\n";
+    exit(1);
+  }
+
+  readValue( in, endian );
+  if( endian != AnalysisOutput::ENDIAN_TAG ){
+    cerr << "Error: " << filename << " was written on a machine with a different byte order\n";
+    exit(1);
+  }
+  readValue( in, nCols );
+
+  vector<string>   names( nCols );
+  vector<uint32_t> types( nCols );
+
+  for( uint32_t c = 0; c < nCols; c++ ){
+    uint32_t len;
+    readValue( in, types[c] );
+    readValue( in, len );
+    names[c].resize( len );
+    in.read( &names[c][0], len );
+  }
+
+  if( !in ){
+    cerr << "Error: truncated header in " << filename << endl;
+    exit(1);
+  }
+
+  if( schemaOnly ){
+    for( uint32_t c = 0; c < nCols; c++ ){
+      cout << c << "  " << names[c] << "  "
+           << ( types[c] == AnalysisOutput::INT64 ? "int64" : "double" ) << "\n";
+    }
+    exit(0);
+  }
+
+  //__________________________________
+  //  columns to output, series and time are columns 0 and 1
+  vector<int> cols;
+  if( columnList == "" ){
+    for( uint32_t c = 2; c < nCols; c++ ){
+      cols.push_back( c );
+    }
+  }
+  else {
+    istringstream ss( columnList );
+    string name;
+    while( getline( ss, name, ',' ) ){
+      auto it = find( names.begin(), names.end(), name );
+      if( it == names.end() ){
+        cerr << "Error: unknown column " << name << " (use -schema to list them)\n";
+        exit(1);
+      }
+      cols.push_back( it - names.begin() );
+    }
+  }
+
+  ofstream fout;
+  if( outFile != "" ){
+    fout.open( outFile.c_str() );
+    if( !fout ){
+      cerr << "Error: could not open " << outFile << endl;
+      exit(1);
+    }
+  }
+  ostream& out = ( outFile != "" ) ? fout : cout;
+  out.precision( 15 );
+  out << scientific;
+
+  out << "# series time";
+  for( size_t i = 0; i < cols.size(); i++ ){
+    out << " " << names[ cols[i] ];
+  }
+  out << "\n";
+
+  //__________________________________
+  //  blocks, stored column by column
+  struct Row {
+    int64_t        series;
+    double         time;
+    vector<double> values;
+  };
+  vector<Row> rows;
+
+  vector< vector<double> > block( nCols );
+
+  while( true ){
+    uint32_t tag[2];
+    uint64_t nRows;
+    if( !readValue( in, tag ) || !readValue( in, nRows ) ){
+      break;
+    }
+    if( tag[0] != AnalysisOutput::BLOCK_TAG ){
+      cerr << "Warning: corrupt block in " << filename << ", stopping\n";
+      break;
+    }
+
+    for( uint32_t c = 0; c < nCols; c++ ){
+      block[c].resize( nRows );
+      in.read( reinterpret_cast<char*>( block[c].data() ), nRows * sizeof(double) );
+    }
+    if( !in ){
+      cerr << "Warning: incomplete block at the end of " << filename << endl;
+      break;
+    }
+
+    for( uint64_t r = 0; r < nRows; r++ ){
+      Row row;
+      memcpy( &row.series, &block[0][r], sizeof(int64_t) );
+      row.time = block[1][r];
+
+      if( ( useSeries && row.series != series ) || row.time < tmin || row.time > tmax ){
+        continue;
+      }
+
+      for( size_t i = 0; i < cols.size(); i++ ){
+        row.values.push_back( block[ cols[i] ][r] );
+      }
+
+      if( doSort ){
+        rows.push_back( row );
+        continue;
+      }
+
+      out << row.series << " " << row.time;
+      for( size_t i = 0; i < row.values.size(); i++ ){
+        out << " " << row.values[i];
+      }
+      out << "\n";
+    }
+  }
+
+  if( doSort ){
+    stable_sort( rows.begin(), rows.end(), []( const Row& a, const Row& b ){
+        return ( a.series < b.series ) || ( a.series == b.series && a.time < b.time );
+      } );
+
+    for( size_t r = 0; r < rows.size(); r++ ){
+      out << rows[r].series << " " << rows[r].time;
+      for( size_t i = 0; i < rows[r].values.size(); i++ ){
+        out << " " << rows[r].values[i];
+      }
+      out << "\n";
+    }
+  }
+  return 0;
+}
@@ -108,6 +108,14 @@ PROGRAM := $(SRCDIR)/partextract
 
 include $(SCIRUN_SCRIPTS)/program.mk
 
+##############################################
+# analysisextract
+
+SRCS    := $(SRCDIR)/analysisextract.cc
+PROGRAM := $(SRCDIR)/analysisextract
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
 ##############################################
 # lineextract
 
@@ -0,0 +1,382 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2020 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Exceptions/ProblemSetupException.h>
+#include <Core/GeometryPiece/ChunkedPointFile.h>
+#include <Core/Geometry/Point.h>
+#include <Core/Util/Endian.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+/*
+pts2chunk converts a point file used by the "file" geometry piece (text, lsb,
+msb or bin format, optionally with the per point <var> columns) into the
+spatially indexed "chunked" format (see Core/GeometryPiece/ChunkedPointFile.h).
+
+The conversion streams through the input and never holds more than one
+batch of points in memory, so it can be used on point sets that do not fit
+in memory:
+
+  pass 1: bounding box (skipped with -pfs, the PFS header already has it)
+  pass 2: count the points in each Morton bucket
+  pass 3: scatter batches of points into their bucket's slot in the output
+
+Every non-empty bucket becomes one chunk.  Increase -level to get smaller
+chunks, i.e. a finer spatial index.
+*/
+
+void usage( char *prog_name );
+
+//______________________________________________________________________
+//  Sequential reader of point records (x, y, z, columns...)
+class PointReader {
+public:
+  PointReader( const string & file_name, const string & format, int ncols, bool pfs )
+    : d_format( format ), d_ncols( ncols ), d_pfs( pfs )
+  {
+    const bool iamlittle = isLittleEndian();
+    d_needflip = (iamlittle && format == "msb") || (!iamlittle && format == "lsb");
+
+    if( format == "text" ){
+      d_source.open( file_name.c_str() );
+    } else {
+      d_source.open( file_name.c_str(), ios::in | ios::binary );
+    }
+    if( !d_source ){
+      throw ProblemSetupException("ERROR: opening point file '"+file_name+"'", __FILE__, __LINE__);
+    }
+    rewind();
+  }
+
+  // go back to the first record, reading the PFS bounding box header if any
+  void rewind()
+  {
+    d_source.clear();
+    d_source.seekg( 0, ios::beg );
+    if( d_pfs ){
+      double bb[6];
+      for( int i = 0; i < 6; i++ ){
+        readDouble( bb[i] );
+      }
+      d_header_box = Box( Point( bb[0], bb[1], bb[2] ), Point( bb[3], bb[4], bb[5] ) );
+    }
+  }
+
+  bool next( double * rec )
+  {
+    if( !readDouble( rec[0] ) ){
+      return false;
+    }
+    for( int c = 1; c < 3 + d_ncols; c++ ){
+      if( !readDouble( rec[c] ) ){
+        throw ProblemSetupException("ERROR: truncated point record in point file", __FILE__, __LINE__);
+      }
+    }
+    return true;
+  }
+
+  const Box & headerBox() const { return d_header_box; }
+
+private:
+  bool readDouble( double & val )
+  {
+    if( d_format == "text" ){
+      d_source >> val;
+    } else {
+      d_source.read( (char*)&val, sizeof(double) );
+      if( d_needflip ){
+        swapbytes( val );
+      }
+    }
+    return !d_source.fail();
+  }
+
+  ifstream d_source;
+  string   d_format;
+  int      d_ncols;
+  bool     d_pfs;
+  bool     d_needflip;
+  Box      d_header_box;
+};
+
+//______________________________________________________________________
+//
+struct BucketGrid {
+  Point  low;
+  Vector inv_dx;
+  int    n;
+
+  uint64_t bucket( const double * rec ) const
+  {
+    uint32_t ijk[3];
+    for( int d = 0; d < 3; d++ ){
+      int i = (int)( ( rec[d] - low(d) ) * inv_dx[d] );
+      ijk[d] = std::min( std::max( i, 0 ), n-1 );
+    }
+    return ChunkedPointFile::mortonKey( ijk[0], ijk[1], ijk[2] );
+  }
+};
+
+template<class T>
+static void
+writeValue( ofstream & dest, const T & val )
+{
+  dest.write( (const char*)&val, sizeof(T) );
+}
+
+//______________________________________________________________________
+//
+int
+main( int argc, char *argv[] )
+{
+  try {
+    string format = "text";
+    int    ncols  = 0;
+    int    level  = 6;
+    bool   pfs    = false;
+    size_t batch  = 1 << 20;
+
+    //__________________________________
+    // parse the command arguments
+    if( argc < 3 ){
+      usage( argv[0] );
+    }
+    for( int i = 1; i < argc-2; i++ ){
+      string s = argv[i];
+      if( s == "-format" ){
+        format = argv[++i];
+      }
+      else if( s == "-ncols" ){
+        ncols = atoi( argv[++i] );
+      }
+      else if( s == "-level" ){
+        level = atoi( argv[++i] );
+      }
+      else if( s == "-batch" ){
+        batch = atol( argv[++i] );
+      }
+      else if( s == "-pfs" ){
+        pfs = true;
+      }
+      else {
+        cout << "\nERROR invalid input (" << s << ")" << endl;
+        usage( argv[0] );
+      }
+    }
+    string infile  = argv[argc-2];
+    string outfile = argv[argc-1];
+
+    if( format == "bin" ){
+      format = isLittleEndian() ? "lsb" : "msb";
+    }
+    if( format != "text" && format != "lsb" && format != "msb" ){
+      cout << "\nERROR unknown format (" << format << ")" << endl;
+      usage( argv[0] );
+    }
+    // counts and chunkOf below hold 16 bytes for each of the 2^(3*level)
+    // buckets, 2 GB at level 9
+    const int maxLevel = 9;
+    if( level < 0 || level > maxLevel ){
+      cout << "\nERROR -level must be between 0 and " << maxLevel << " (" << level << ")" << endl;
+      usage( argv[0] );
+    }
+    if( ncols < 0 || batch == 0 ){
+      usage( argv[0] );
+    }
+
+    const int nvals = 3 + ncols;
+    vector<double> rec( nvals );
+
+    PointReader source( infile, format, ncols, pfs );
+
+    //__________________________________
+    //  pass 1: bounding box
+    Point low( 1e30, 1e30, 1e30 );
+    Point high( -1e30, -1e30, -1e30 );
+    if( pfs ){
+      low  = source.headerBox().lower();
+      high = source.headerBox().upper();
+    } else {
+      while( source.next( &rec[0] ) ){
+        Point p( rec[0], rec[1], rec[2] );
+        low  = Min( low,  p );
+        high = Max( high, p );
+      }
+      source.rewind();
+    }
+
+    BucketGrid grid;
+    grid.n   = 1 << level;
+    grid.low = low;
+    for( int d = 0; d < 3; d++ ){
+      double extent = high(d) - low(d);
+      grid.inv_dx[d] = ( extent > 0 ) ? grid.n / extent : 0.0;
+    }
+
+    //__________________________________
+    //  pass 2: count the points in every bucket
+    const uint64_t nbuckets = (uint64_t)grid.n * grid.n * grid.n;
+    vector<uint64_t> counts( nbuckets, 0 );
+    uint64_t npoints = 0;
+
+    while( source.next( &rec[0] ) ){
+      counts[ grid.bucket( &rec[0] ) ]++;
+      npoints++;
+    }
+    source.rewind();
+
+    // every non-empty bucket becomes a chunk, in Morton order
+    vector<uint64_t> chunkOf( nbuckets, 0 );
+    vector<ChunkedPointFile::Chunk> chunks;
+    for( uint64_t b = 0; b < nbuckets; b++ ){
+      if( counts[b] > 0 ){
+        chunkOf[b] = chunks.size();
+        ChunkedPointFile::Chunk chunk;
+        chunk.numPoints = counts[b];
+        chunk.box       = Box( Point( 1e30, 1e30, 1e30 ), Point( -1e30, -1e30, -1e30 ) );
+        chunks.push_back( chunk );
+      }
+    }
+    vector<uint64_t>().swap( counts );
+
+    uint64_t offset = ChunkedPointFile::headerSize( chunks.size() );
+    for( unsigned int c = 0; c < chunks.size(); c++ ){
+      chunks[c].offset = offset;
+      offset += chunks[c].numPoints * nvals * sizeof(double);
+    }
+
+    ofstream dest( outfile.c_str(), ios::out | ios::binary | ios::trunc );
+    if( !dest ){
+      throw ProblemSetupException("ERROR: opening output file '"+outfile+"'", __FILE__, __LINE__);
+    }
+
+    //__________________________________
+    //  pass 3: scatter batches of points into their chunks.
+    //  Sorting a batch by chunk turns the scatter into one write per
+    //  chunk per batch.
+    vector<uint64_t> written( chunks.size(), 0 );
+    vector< pair<uint64_t, size_t> > order;
+    vector<double> buffer;
+    buffer.reserve( batch * nvals );
+    order.reserve( batch );
+
+    bool more = true;
+    while( more ){
+      buffer.clear();
+      order.clear();
+
+      while( order.size() < batch && ( more = source.next( &rec[0] ) ) ){
+        uint64_t c = chunkOf[ grid.bucket( &rec[0] ) ];
+        order.push_back( make_pair( c, order.size() ) );
+        buffer.insert( buffer.end(), rec.begin(), rec.end() );
+
+        Box & cbox = chunks[c].box;
+        Point p( rec[0], rec[1], rec[2] );
+        cbox = Box( Min( cbox.lower(), p ), Max( cbox.upper(), p ) );
+      }
+
+      sort( order.begin(), order.end() );
+
+      vector<double> run;
+      for( size_t i = 0; i < order.size(); ){
+        const uint64_t c = order[i].first;
+        run.clear();
+        for( ; i < order.size() && order[i].first == c; i++ ){
+          const double * r = &buffer[ order[i].second * nvals ];
+          run.insert( run.end(), r, r + nvals );
+        }
+        dest.seekp( chunks[c].offset + written[c] * nvals * sizeof(double), ios::beg );
+        dest.write( (const char*)&run[0], run.size() * sizeof(double) );
+        written[c] += run.size() / nvals;
+      }
+    }
+
+    //__________________________________
+    //  header and chunk index
+    dest.seekp( 0, ios::beg );
+    dest.write( ChunkedPointFile::MAGIC, sizeof(ChunkedPointFile::MAGIC) );
+    writeValue( dest, (uint32_t)ChunkedPointFile::ENDIAN_TAG );
+    writeValue( dest, (uint32_t)ncols );
+    writeValue( dest, npoints );
+    writeValue( dest, (uint64_t)chunks.size() );
+    for( int d = 0; d < 3; d++ ){
+      writeValue( dest, low(d) );
+    }
+    for( int d = 0; d < 3; d++ ){
+      writeValue( dest, high(d) );
+    }
+    for( unsigned int c = 0; c < chunks.size(); c++ ){
+      for( int d = 0; d < 3; d++ ){
+        writeValue( dest, chunks[c].box.lower()(d) );
+      }
+      for( int d = 0; d < 3; d++ ){
+        writeValue( dest, chunks[c].box.upper()(d) );
+      }
+      writeValue( dest, chunks[c].offset );
+      writeValue( dest, chunks[c].numPoints );
+    }
+
+    if( !dest ){
+      throw ProblemSetupException("ERROR: failed while writing '"+outfile+"'", __FILE__, __LINE__);
+    }
+    dest.close();
+
+    cout << "Wrote " << npoints << " points in " << chunks.size() << " chunks to " << outfile << endl;
+
+  } catch (Exception& e) {
+    cerr << "Caught exception: " << e.message() << '\n';
+    if(e.stackTrace())
+      cerr << "Stack trace: " << e.stackTrace() << '\n';
+    return 1;
+  } catch(...){
+    cerr << "Caught unknown exception\n";
+    return 1;
+  }
+  return 0;
+}
+
+//______________________________________________________________________
+//
+void
+usage( char *prog_name )
+{
+  cout << "Usage: " << prog_name << " [options] <input point file> <output chunked file>\n";
+  cout << "options:" << endl;
+  cout << "-format <text|lsb|msb|bin>: format of the input point file [default text]\n";
+  cout << "-ncols <n>:                 number of values following x y z per point (1 per scalar <var>, 3 per vector <var>)\n";
+  cout << "-pfs:                       the input file starts with a bounding box header (pfs output)\n";
+  cout << "-level <l>:                 2^l Morton buckets per direction, at most 9 [default 6]\n";
+  cout << "-batch <n>:                 number of points held in memory at a time [default 1048576]\n";
+  exit( 1 );
+}
@@ -81,3 +81,10 @@ PROGRAM := $(SRCDIR)/ImageFromGeom
 
 include $(SCIRUN_SCRIPTS)/program.mk
 
+###############################################
+# pts2chunk
+
+SRCS    := $(SRCDIR)/pts2chunk.cc
+PROGRAM := $(SRCDIR)/pts2chunk
+
+include $(SCIRUN_SCRIPTS)/program.mk